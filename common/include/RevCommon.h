@@ -26,6 +26,8 @@
 #define _REV_INVALID_HART_ID_ ( unsigned( ~0 ) )
 #endif
 
+#define _REV_INVALID_CORE_ID_ ( unsigned( ~0 ) )
+
 #define _INVALID_ADDR_   ( ~uint64_t{ 0 } )
 
 #define _INVALID_TID_    ( uint32_t{ 0 } )
@@ -118,7 +120,8 @@ enum class RmtMemOp : uint8_t {
   AMORqst         = 12,  ///< xbgasNicEvent: Atomic Memory Operation request
   AMOResp         = 13,  ///< xbgasNicEvent: Atomic Memory Operation response
   FENCE           = 14,  ///< xbgasNicEvent: FENCE request
-  Unknown         = 15,  ///< xbgasNicEvent: Unknown operation
+  SegACK          = 15,  ///< xbgasNicEvent: Segment acknowledgement (returns a transfer credit)
+  Unknown         = 16,  ///< xbgasNicEvent: Unknown operation
 };
 
 std::ostream& operator<<( std::ostream& os, MemOp op );
@@ -166,7 +169,7 @@ struct MemReq {
     bool                                 isOutstanding,
     std::function<void( const MemReq& )> MarkLoadCompleteFunc
   )
-    : Addr( Addr ), SrcId( SrcId ), PktId( PktId ), isOutstanding( isOutstanding ),
+    : Addr( Addr ), ReqType( ReqType ), SrcId( SrcId ), PktId( PktId ), isOutstanding( isOutstanding ),
       MarkLoadCompleteFunc( std::move( MarkLoadCompleteFunc ) ) {}
 
   void MarkLoadComplete() const { MarkLoadCompleteFunc( *this ); }
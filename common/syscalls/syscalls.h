@@ -79,6 +79,18 @@ typedef struct {
 #define CLONE_NEWNET         0x40000000 /* New network namespace */
 #define CLONE_IO             0x80000000 /* Clone I/O Context */
 
+/* Futex operations */
+#ifndef FUTEX_WAIT
+#define FUTEX_WAIT           0
+#define FUTEX_WAKE           1
+#define FUTEX_WAIT_BITSET    9
+#define FUTEX_WAKE_BITSET    10
+#define FUTEX_PRIVATE_FLAG   128
+#define FUTEX_CLOCK_REALTIME 256
+#define FUTEX_WAIT_PRIVATE   ( FUTEX_WAIT | FUTEX_PRIVATE_FLAG )
+#define FUTEX_WAKE_PRIVATE   ( FUTEX_WAKE | FUTEX_PRIVATE_FLAG )
+#endif
+
 /* AIO Flags */
 #define IOCB_CMD_PREAD 0
 #define IOCB_CMD_PWRITE 1
@@ -416,6 +428,7 @@ REV_SYSCALL(   59, int rev_pipe2(int *fildes, int flags) );
 REV_SYSCALL(   60, int rev_quotactl(unsigned int cmd, const char *special, qid_t id, void *addr) );
 REV_SYSCALL(   61, ssize_t rev_getdents64(unsigned int fd, struct linux_dirent64 *dirent, unsigned int count) );
 REV_SYSCALL(   62, int rev_llseek(unsigned int fd, unsigned long offset_high, unsigned long offset_low, loff_t *result, unsigned int whence) );
+REV_SYSCALL(   62, off_t rev_lseek(unsigned int fd, off_t offset, unsigned int whence) );
 REV_SYSCALL(   63, ssize_t rev_read(unsigned int fd, char *buf, size_t count) );
 REV_SYSCALL(   64, ssize_t rev_write(unsigned int fd, const char *buf, size_t count) );
 REV_SYSCALL(   65, ssize_t rev_readv(unsigned long fd, const struct iovec *vec, unsigned long vlen) );
@@ -676,6 +689,17 @@ REV_SYSCALL( 9005, void dump_valid_mem_to_file( const char* outputFile ) );
 REV_SYSCALL( 9006, void dump_thread_mem( ) );
 REV_SYSCALL( 9007, void dump_thread_mem_to_file( const char* outputFile ) );
 
+// ==================== REV CHECKPOINT
+// Requests a checkpoint of the whole simulation (see the RevCPU checkpoint
+// parameter); returns 0 once the request is queued
+REV_SYSCALL( 9020, int rev_checkpoint( void ) );
+
+// ==================== REV XBGAS
+// Split-phase remote get: copies nbytes from src in namespace nmspace into the
+// local buffer dest without blocking the hart; *counter is incremented once
+// the data has landed
+REV_SYSCALL( 9200, int rev_xbgas_get_nb( void* dest, uint64_t nmspace, const void* src, size_t nbytes, uint64_t* counter ) );
+
 // clang-format on
 
 // ==================== REV PRINT UTILITIES
@@ -12,8 +12,10 @@
 #define _SST_REVCPU_H_
 
 // -- Standard Headers
+#include <deque>
 #include <functional>
 #include <list>
+#include <map>
 #include <memory>
 #include <queue>
 #include <random>
@@ -22,6 +24,7 @@
 #include <string>
 #include <time.h>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -38,6 +41,7 @@
 #include "RevOpts.h"
 #include "RevRand.h"
 #include "RevThread.h"
+#include "RevThreadPool.h"
 
 namespace SST::RevCPU {
 
@@ -96,6 +100,13 @@ public:
     { "machine",         "RISC-V machine model of the target core",      "core:G" },
     { "memCost",         "Memory latency range in cycles min:max",       "core:0:10" },
     { "prefetchDepth",   "Instruction prefetch depth per core",          "core:1" },
+    { "issueWidth",      "Instructions issued per cycle per core (1 is the scalar model)", "core:1" },
+    { "fuLatency",       "ALU, MUL/DIV, FPU and LSU latencies per core (0: table cost; multi-issue model only)", "core:0:0:0:0" },
+    { "wideIssue",       "Use the multi-issue timing model on cores with issueWidth 1", "0" },
+    { "hartPolicy",      "Hart interleaving: switch-on-stall, switch-on-hazard, round-robin or icount", "switch-on-stall" },
+    { "quantum",         "Cycles a thread runs before it may be preempted for a ready thread (0 disables)", "0" },
+    { "coreAffinity",    "Queue new threads on their creating core and others on the core they last ran on", "1" },
+    { "workStealing",    "Idle cores steal ready threads queued on other cores", "1" },
     { "table",           "Instruction cost table",                       "core:/path/to/table" },
     { "enable_nic",      "Enable the internal RevNIC",                   "0" },
     { "enable_pan",      "Enable PAN network endpoint",                  "0" },
@@ -114,6 +125,27 @@ public:
     { "trcOp",           "Tracer instruction trigger",                   "slli" },
     { "trcLimit",        "Max trace lines per core (0 no limit)",        "0" },
     { "trcStartCycle",   "Starting tracer cycle (disables trcOp)",       "0" },
+    { "trcBinary",       "Binary trace file prefix; <prefix>.core<N>.rbt per core (empty for text)", "" },
+    { "trcCompress",     "Binary trace compression: none or zstd",       "none" },
+    { "trcAsync",        "Format and write traces on a writer thread",   "0" },
+    { "trcRingSize",     "Writer thread ring entries per core",          "65536" },
+    { "trcRingDrop",     "Drop trace records instead of stalling when the ring is full", "0" },
+    { "trcSampleEvery",  "Trace 1 of every N instructions (0 traces all)", "0" },
+    { "trcSampleWindow", "Instructions traced at the start of each trcSamplePeriod", "0" },
+    { "trcSamplePeriod", "Window sampling period in cycles (0 disables)", "0" },
+    { "trcROI",          "Functions to trace; on at entry, off at return", "[]" },
+    { "trcHarts",        "Harts to trace (empty for all)",               "[]" },
+    { "trcThreads",      "Thread ids to trace (empty for all)",          "[]" },
+    { "profile",         "Per-PC profile file prefix; <prefix>.core<N>.flat and .folded per core (empty disables)", "" },
+    { "profileInterval", "Profile every Nth cycle, weighted by N",       "1" },
+    { "saveSnapshot",    "Save the memory and loader state after program load to this file (empty disables)", "" },
+    { "loadSnapshot",    "Start from a saveSnapshot or checkpoint file instead of loading the program (empty disables)", "" },
+    { "checkpoint",      "Checkpoint file prefix; checkpoints are written to <prefix>.<component>.<cycle>.ckpt", "checkpoint" },
+    { "checkpointPeriod", "Write a checkpoint every N cycles (0 disables; rev_checkpoint() requests one)", "0" },
+    { "memDumpFormat",   "Format of memory dump files: text or binary (see scripts/rev-dump-convert.py)", "text" },
+    { "memDumpCompress", "Binary memory dump compression: none or zstd",  "none" },
+    { "parallelThreads", "Host threads ticking the cores; cores about to issue only ALU, memory and branch instructions", "1" },
+    { "parallelValidate", "Report accesses where the parallel core order could differ from the sequential one", "0" },
     { "splash",          "Display the splash logo",                      "0" },
     { "independentCoprocClock",  "Enables each coprocessor to register its own clock handler", "0" },
     { "enable_xbgas",            "Enable xBGAS",                         "0"},
@@ -202,6 +234,21 @@ public:
     { "FloatsExec",          "Total SP or DP float instructions executed",           "count",  1 },
     { "TLBHitsPerCore",      "TLB hits per core",                                    "count",  1 },
     { "TLBMissesPerCore",    "TLB misses per core",                                  "count",  1 },
+    { "StallFetch",          "Cycles stalled on instruction fetch",                  "count",  1 },
+    { "StallLoadHazard",     "Cycles stalled on a RAW hazard with a local load",     "count",  1 },
+    { "StallRmtLoadHazard",  "Cycles stalled on a RAW hazard with a remote load",    "count",  1 },
+    { "StallScoreboard",     "Cycles stalled on a scoreboard (FP/long latency) hazard", "count", 1 },
+    { "StallEcall",          "Cycles stalled with an ECALL in progress",             "count",  1 },
+    { "StallCoProc",         "Cycles stalled by the coprocessor",                    "count",  1 },
+    { "StallNoThread",       "Cycles with no thread assigned",                       "count",  1 },
+    { "ContextSwitches",     "Threads preempted at the end of their quantum",        "count",  1 },
+    { "ThreadsStolen",       "Ready threads taken from another core's queue",        "count",  1 },
+    { "ThreadRuntime",       "Cycles each completed thread spent assigned to a hart", "cycles", 1 },
+    { "IsolatedTicks",       "Cycles the core was ticked apart from the others (parallelThreads)", "count", 1 },
+    { "ParallelConflicts",   "Isolated core ticks that could differ from the sequential order (parallelValidate)", "count", 1 },
+    { "EcallCalls",          "Completed ECALLs of one syscall code",                 "count",  1 },
+    { "EcallCycles",         "Cycles spent in ECALLs of one syscall code",           "cycles", 1 },
+    { "LoadTime",            "Host time to load the program or restore a snapshot",  "us",     1 },
 
     { "TLBHits",             "TLB hits",                                             "count",  1 },
     { "TLBMisses",           "TLB misses",                                           "count",  1 },
@@ -222,11 +269,17 @@ private:
   //  unsigned          RDMAPerCycle{};  ///< RevCPU: number of RDMA messages per cycle to inject into PAN network
   //  unsigned          testStage{};     ///< RevCPU: controls the PAN Test harness staging
   //  unsigned          testIters{};     ///< RevCPU: the number of message iters for each PAN Test
-  std::unique_ptr<RevOpts>              Opts;     ///< RevCPU: Simulation options object
-  std::unique_ptr<RevMem>               Mem;      ///< RevCPU: RISC-V main memory object
-  std::unique_ptr<RevLoader>            Loader;   ///< RevCPU: RISC-V loader
-  std::vector<std::unique_ptr<RevCore>> Procs;    ///< RevCPU: RISC-V processor objects
-  std::vector<bool>                     Enabled;  ///< RevCPU: Completion structure
+  std::unique_ptr<RevOpts>              Opts;        ///< RevCPU: Simulation options object
+  std::unique_ptr<RevMem>               Mem;         ///< RevCPU: RISC-V main memory object
+  std::unique_ptr<RevLoader>            Loader;      ///< RevCPU: RISC-V loader
+  std::vector<std::unique_ptr<RevCore>> Procs;       ///< RevCPU: RISC-V processor objects
+  std::vector<bool>                     Enabled;     ///< RevCPU: Completion structure
+  std::vector<uint8_t>                  CoreActive;  ///< RevCPU: result of each core's ClockTick this cycle
+
+  std::vector<std::unique_ptr<RevTracer>> Tracers{};  ///< RevCPU: per-core execution tracers
+
+  std::vector<std::unique_ptr<RevProfiler>> Profilers{};      ///< RevCPU: per-core profilers
+  std::string                               ProfilePrefix{};  ///< RevCPU: profile output file prefix
 
   // Initializes a RevThread object.
   // - Adds it's ThreadID to the ThreadQueue to be scheduled
@@ -255,15 +308,89 @@ private:
   // it does this by seeing if a given thread's WaitingOnTID has completed
   bool ThreadCanProceed( const std::unique_ptr<RevThread>& Thread );
 
-  // vector of Threads which are ready to be scheduled
-  std::vector<std::unique_ptr<RevThread>> ReadyThreads{};
+  // Adds a READY thread to the ready queue of Core (default: the core it last ran on) with coreAffinity,
+  // else to ReadyThreads
+  void PushReadyThread( std::unique_ptr<RevThread>&& Thread, unsigned Core = _REV_INVALID_CORE_ID_ );
+
+  // Removes the oldest thread ProcID may run: the older head of its own queue and ReadyThreads,
+  // else (with workStealing) a thread stolen from the longest core queue; nullptr if nothing is ready
+  std::unique_ptr<RevThread> PopReadyThread( uint32_t ProcID );
+
+  // Returns the number of threads in all ready queues
+  size_t NumReadyThreads() const { return ReadyThreads.size() + CoreQueued; }
+
+  // queue of Threads which are ready to be scheduled on any core
+  std::deque<std::unique_ptr<RevThread>> ReadyThreads{};
+
+  // per core queues of ready Threads that last ran on that core
+  std::vector<std::deque<std::unique_ptr<RevThread>>> CoreReadyThreads{};
+
+  size_t   CoreQueued{};    ///< RevCPU: number of threads in CoreReadyThreads
+  uint64_t ReadySeq{};      ///< RevCPU: order stamp of the next thread to become ready
+  uint64_t Quantum{};       ///< RevCPU: scheduling quantum in core cycles (0 disables preemption)
+  bool     CoreAffinity{};  ///< RevCPU: queue threads on their creating or last core
+  bool     WorkStealing{};  ///< RevCPU: idle cores steal threads queued on other cores
+  unsigned AssignStart{};   ///< RevCPU: first core offered ready threads this cycle
 
   // List of Threads that are currently blocked (waiting for their WaitingOnTID to be a key in CompletedThreads).
   std::list<std::unique_ptr<RevThread>> BlockedThreads{};
 
+  // Parks a thread blocked in FUTEX_WAIT on its address; it is readied at once if
+  // the address was woken after the thread read its value
+  void FutexWait( std::unique_ptr<RevThread>&& Thread );
+
+  // Readies up to Count threads waiting on a futex address; returns the number woken
+  uint32_t FutexWake( uint64_t Addr, uint32_t Count );
+
+  // Readies sleeping threads and futex waiters whose wake up cycle has been reached
+  void WakeTimedThreads( uint64_t Cycle );
+
+  // Drops the deadline of a timed futex waiter that is woken before it
+  void CancelFutexTimeout( const RevThread& Thread );
+
+  // Threads blocked in FUTEX_WAIT on an address and the number of wakes issued on it
+  struct FutexQueue {
+    uint64_t                               Wakes{};
+    std::deque<std::unique_ptr<RevThread>> Waiters{};
+  };
+
+  std::unordered_map<uint64_t, FutexQueue>               Futexes{};          ///< RevCPU: futex wait queues by address
+  size_t                                                 FutexWaiters{};     ///< RevCPU: threads in all futex wait queues
+  std::multimap<uint64_t, std::pair<uint32_t, uint64_t>> FutexTimeouts{};    ///< RevCPU: futex deadlines (cycle to thread, address)
+  std::multimap<uint64_t, std::unique_ptr<RevThread>>    SleepingThreads{};  ///< RevCPU: sleeping threads by wake up cycle
+
   // Set of Thread IDs and their corresponding RevThread that have completed their execution on this RevCPU
   std::unordered_map<uint32_t, std::unique_ptr<RevThread>> CompletedThreads{};
 
+  // Threads taken off their harts for a pending checkpoint, by core and hart
+  std::vector<std::tuple<unsigned, unsigned, std::unique_ptr<RevThread>>> CheckpointEvicted{};
+
+  // Calls Func on every thread in the ready, blocked, futex, sleeping, completed and evicted queues
+  void ForEachThread( const std::function<void( RevThread& )>& Func );
+
+  // Puts the threads taken off for a checkpoint back on the harts they were taken from
+  void ReturnEvictedThreads();
+
+  std::string Program{};            ///< RevCPU: program executable
+  std::string CheckpointPrefix{};   ///< RevCPU: checkpoint file prefix
+  uint64_t    CheckpointPeriod{};   ///< RevCPU: cycles between periodic checkpoints (0 disables)
+  uint64_t    NextCheckpoint{};     ///< RevCPU: cycle of the next periodic checkpoint
+  bool        CheckpointPending{};  ///< RevCPU: a checkpoint is requested; threads are taken off their harts
+  bool        Restarted{};          ///< RevCPU: this run was restored from a checkpoint
+  bool        InitDumpPending{};    ///< RevCPU: the initial dump ranges are being read through memHierarchy
+  uint64_t    CycleBase{};          ///< RevCPU: cycle of the restored checkpoint; added to the SST cycle
+
+  // Host-parallel core ticking (parallelThreads, parallelValidate)
+  static constexpr uint64_t MaxConflictReports = 16;  ///< RevCPU: parallel conflicts reported as warnings
+
+  unsigned                       ParallelThreads{};    ///< RevCPU: host threads ticking the cores
+  bool                           ParallelValidate{};   ///< RevCPU: record accesses and report parallel conflicts
+  std::unique_ptr<RevThreadPool> CorePool{};           ///< RevCPU: thread pool for the isolated cores
+  std::vector<RevMem::Isolation> CoreIsolation{};      ///< RevCPU: memory accesses of each core this cycle
+  std::vector<uint8_t>           CoreIsolated{};       ///< RevCPU: cores ticked apart from the others this cycle
+  std::vector<unsigned>          IsolatedCores{};      ///< RevCPU: indices of the isolated cores this cycle
+  uint64_t                       ConflictsReported{};  ///< RevCPU: parallel conflicts found so far
+
   // Generates a new Thread ID using the RNG.
   uint32_t GetNewThreadID() { return RevRand( 0, UINT32_MAX ); }
 
@@ -382,6 +509,26 @@ private:
   std::vector<Statistic<uint64_t>*> TLBMissesPerCore{};
   std::vector<Statistic<uint64_t>*> TLBHitsPerCore{};
 
+  // ----- Per Core and Per Hart Stall Statistics, indexed by RevStall cause - 1
+  std::vector<std::array<Statistic<uint64_t>*, REV_STALL_CAUSES>> StallCycles{};      ///< RevCPU: per core
+  std::vector<std::array<Statistic<uint64_t>*, REV_STALL_CAUSES>> HartStallCycles{};  ///< RevCPU: per core and hart
+
+  // ----- Scheduler Statistics
+  std::vector<Statistic<uint64_t>*> ContextSwitches{};  ///< RevCPU: per core preemptions
+  std::vector<Statistic<uint64_t>*> ThreadsStolen{};    ///< RevCPU: per core threads taken from other cores
+  Statistic<uint64_t>*              ThreadRuntime{};    ///< RevCPU: runtime of each completed thread
+
+  // ----- Parallel Core Statistics
+  std::vector<Statistic<uint64_t>*> IsolatedTicks{};      ///< RevCPU: per core cycles ticked apart from the others
+  Statistic<uint64_t>*              ParallelConflicts{};  ///< RevCPU: isolated ticks the sequential order could change
+
+  // ----- Load Statistics
+  Statistic<uint64_t>* LoadTime{};  ///< RevCPU: host microseconds to load the program or restore a snapshot
+
+  // ----- Per Core ECALL Statistics, indexed by RevCore::GetEcallCodes() slot
+  std::vector<std::vector<Statistic<uint64_t>*>> EcallCalls{};   ///< RevCPU: per core calls by ECALL code
+  std::vector<std::vector<Statistic<uint64_t>*>> EcallCycles{};  ///< RevCPU: per core cycles by ECALL code
+
   //-------------------------------------------------------
   // -- FUNCTIONS
   //-------------------------------------------------------
@@ -419,6 +566,33 @@ private:
   /// RevCPU: updates sst statistics on a per core basis
   void UpdateCoreStatistics( unsigned coreNum );
 
+  /// RevCPU: close core i after its tick, tick its coprocessor and handle the thread state changes of the core
+  void EndCoreCycle( size_t i, SST::Cycle_t currentCycle );
+
+  /// RevCPU: tick the cores of one cycle with parallelThreads or parallelValidate
+  void TickCoresParallel( SST::Cycle_t currentCycle );
+
+  /// RevCPU: count the isolated core ticks of this cycle whose accesses overlap those of lower numbered cores
+  void CheckParallelConflicts( SST::Cycle_t currentCycle );
+
+  /// RevCPU: write the loaded program, or with Checkpoint the whole run at Cycle, to a snapshot file
+  void WriteSnapshot( const std::string& Path, bool Checkpoint, uint64_t Cycle );
+
+  /// RevCPU: request a checkpoint (rev_checkpoint and checkpointPeriod); returns 0 or -ENOTSUP
+  int RequestCheckpoint();
+
+  /// RevCPU: no thread is on a hart and no memory or network request is in flight
+  bool CheckpointQuiesced() const;
+
+  /// RevCPU: write the checkpoint <CheckpointPrefix>.<component name>.<Cycle>.ckpt
+  void WriteCheckpoint( uint64_t Cycle );
+
+  /// RevCPU: write the run section of a checkpoint: core state, open files and thread queues
+  void SaveCheckpoint( RevSnapshotOut& Snap, uint64_t Cycle );
+
+  /// RevCPU: restore the run section of a checkpoint
+  void LoadCheckpoint( RevSnapshotIn& Snap );
+
 };  // class RevCPU
 
 }  // namespace SST::RevCPU
@@ -488,6 +488,12 @@ public:
     }
     return true;
   }
+
+  /// Get the raw CSR registers (checkpoints)
+  const std::array<uint64_t, CSR_LIMIT>& GetCSRFile() const { return CSR; }
+
+  /// Get the raw CSR registers for a checkpoint restore
+  std::array<uint64_t, CSR_LIMIT>& GetCSRFile() { return CSR; }
 };  // class RevCSR
 
 }  // namespace SST::RevCPU
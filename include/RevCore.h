@@ -15,6 +15,7 @@
 #include "SST.h"
 
 // -- Standard Headers
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <cinttypes>
@@ -29,6 +30,7 @@
 #include <memory>
 #include <queue>
 #include <string>
+#include <string_view>
 #include <sys/xattr.h>
 #include <time.h>
 #include <tuple>
@@ -46,6 +48,7 @@
 #include "RevMem.h"
 #include "RevOpts.h"
 #include "RevPrefetcher.h"
+#include "RevProfiler.h"
 #include "RevRand.h"
 #include "RevThread.h"
 #include "RevTracer.h"
@@ -58,6 +61,22 @@
 namespace SST::RevCPU {
 class RevCoProc;
 
+/// RevHartPolicy: how a core picks the hart to decode each cycle
+enum class RevHartPolicy : uint8_t {
+  SwitchOnStall  = 0,  ///< RevHartPolicy: stay on the current hart until it cannot decode
+  RoundRobin     = 1,  ///< RevHartPolicy: switch to the next ready hart every cycle
+  ICount         = 2,  ///< RevHartPolicy: the ready hart with the fewest instructions and loads in flight
+  SwitchOnHazard = 3,  ///< RevHartPolicy: stay on the current hart until it cannot decode or its last decode hit a hazard
+};
+
+/// RevSchedOps: thread scheduler services RevCPU provides to the ECALLs of its cores
+struct RevSchedOps {
+  std::function<uint64_t( uint64_t )>           FutexWakeCount{};  ///< RevSchedOps: wakes issued so far on a futex address
+  std::function<uint32_t( uint64_t, uint32_t )> FutexWake{};       ///< RevSchedOps: ready up to N waiters; returns the number woken
+  std::function<size_t()>                       NumReady{};        ///< RevSchedOps: number of threads waiting for a hart
+  std::function<int()>                          Checkpoint{};      ///< RevSchedOps: request a checkpoint; 0 or -errno
+};
+
 class RevCore {
 public:
   /// RevCore: standard constructor
@@ -81,6 +100,14 @@ public:
   /// RevCore: per-processor clock function
   bool ClockTick( SST::Cycle_t currentCycle );
 
+  /// RevCore: functional unit classes of the multi-issue timing model
+  enum class RevFU : uint8_t {
+    ALU    = 0,  ///< RevFU: integer, branch and system instructions
+    MulDiv = 1,  ///< RevFU: integer multiply and divide
+    FPU    = 2,  ///< RevFU: floating point arithmetic
+    LSU    = 3,  ///< RevFU: local and remote loads, stores and atomics
+  };
+
   /// RevCore: Called by RevCPU when there is no more work to do (ie. All RevThreads are ThreadState::DONE )
   void PrintStatSummary();
 
@@ -108,8 +135,20 @@ public:
   /// RevCore: Set an optional tracer
   void SetTracer( RevTracer* T ) { Tracer = T; }
 
+  /// RevCore: Set an optional per-PC profiler
+  void SetProfiler( RevProfiler* P ) { Profiler = P; }
+
+  /// RevCore: Set the hart interleaving policy
+  void SetHartPolicy( RevHartPolicy P ) { HartPolicy = P; }
+
+  /// RevCore: Use the multi-issue timing model even at issue width 1
+  void SetWideIssue( bool W ) { WideIssue = W || IssueWidth > 1; }
+
+  /// RevCore: Set the scheduler services used by futex, nanosleep and sched_yield
+  void SetSchedOps( RevSchedOps Ops ) { SchedOps = std::move( Ops ); }
+
   /// RevCore: Retrieve a random memory cost value
-  unsigned RandCost() { return mem->RandCost( feature->GetMinCost(), feature->GetMaxCost() ); }
+  unsigned RandCost() { return feature->RandCost(); }
 
   /// RevCore: Handle register faults
   void HandleRegFault( unsigned width );
@@ -132,6 +171,8 @@ public:
     uint64_t cyclesIdle_Pipeline;
     uint64_t cyclesIdle_MemoryFetch;
     uint64_t retired;
+
+    std::array<uint64_t, REV_STALL_CAUSES> stalls;  ///< RevCoreStats: stall cycles by RevStall cause
   };
 
   auto GetAndClearStats() {
@@ -146,6 +187,8 @@ public:
            &RevCoreStats::retired } ) {
       StatsTotal.*stat += Stats.*stat;
     }
+    for( unsigned i = 0; i < REV_STALL_CAUSES; i++ )
+      StatsTotal.stalls[i] += Stats.stalls[i];
 
     auto memStats = mem->GetAndClearStats();
     auto ret      = std::make_pair( Stats, memStats );
@@ -153,6 +196,28 @@ public:
     return ret;
   }
 
+  /// RevCore: Get and clear the stall cycles of a hart by RevStall cause
+  std::array<uint64_t, REV_STALL_CAUSES> GetAndClearHartStalls( unsigned HartID ) {
+    auto ret           = HartStalls[HartID];
+    HartStalls[HartID] = {};
+    return ret;
+  }
+
+  /// RevCore: ECALL codes in statistics slot order
+  static const std::vector<uint32_t>& GetEcallCodes() { return GetEcallDispatch().codes; }
+
+  /// RevCore: Get and clear the calls and cycles of each ECALL code, by statistics slot
+  auto GetAndClearEcallStats() {
+    for( size_t i = 0; i < EcallCalls.size(); i++ ) {
+      EcallCallsTotal[i] += EcallCalls[i];
+      EcallCyclesTotal[i] += EcallCycles[i];
+    }
+    auto ret = std::make_pair( EcallCalls, EcallCycles );
+    std::fill( EcallCalls.begin(), EcallCalls.end(), 0 );
+    std::fill( EcallCycles.begin(), EcallCycles.end(), 0 );
+    return ret;
+  }
+
   RevMem& GetMem() const { return *mem; }
 
   uint64_t GetCurrentSimCycle() const { return currentSimCycle; }
@@ -263,6 +328,17 @@ public:
   ///< RevCore: Used for loading a software thread into a RevHart
   void AssignThread( std::unique_ptr<RevThread> ThreadToAssign );
 
+  ///< RevCore: Removes up to MaxThreads threads that have held their hart for at least Quantum cycles
+  ///           and returns them in the READY state; harts with work in flight are skipped
+  std::vector<std::unique_ptr<RevThread>> PreemptThreads( uint64_t Quantum, size_t MaxThreads );
+
+  ///< RevCore: Removes every thread with no work in flight for a checkpoint and returns it with its hart;
+  ///           this is not counted as a context switch and the hart keeps its time slice
+  std::vector<std::pair<unsigned, std::unique_ptr<RevThread>>> EvictThreads();
+
+  ///< RevCore: Puts a thread taken off by EvictThreads back on its hart
+  void ReturnThread( std::unique_ptr<RevThread> Thread, unsigned HartID );
+
   ///< RevCore:
   void UpdateStatusOfHarts();
 
@@ -277,12 +353,25 @@ public:
   ///           CoProc is done
   bool HasNoWork() const;
 
+  ///< RevCore: Returns true if the next cycle can be ticked apart from the other cores: every busy hart is
+  ///           about to issue only register, load, store and control transfer instructions (RevCPU parallelThreads)
+  bool CanTickIsolated() const;
+
   ///< RevCore: Returns true if there are any IdleHarts
   bool HasIdleHart() const { return IdleHarts.any(); }
 
   ///< RevCore: Returns the number of cycles executed so far
   uint64_t GetCycles() const { return cycles; }
 
+  ///< RevCore: Returns the id of this core
+  unsigned GetId() const { return id; }
+
+  ///< RevCore: Write the cycle count and the total statistics to a checkpoint; call after GetAndClearStats
+  void SaveSnapshot( RevSnapshotOut& Snap ) const;
+
+  ///< RevCore: Restore the cycle count and the total statistics of a checkpoint
+  void LoadSnapshot( RevSnapshotIn& Snap );
+
 private:
   bool           Halted      = false;  ///< RevCore: determines if the core is halted
   bool           Stalled     = false;  ///< RevCore: determines if the core is stalled on instruction fetch
@@ -301,6 +390,17 @@ private:
   std::bitset<_MAX_HARTS_>              ValidHarts{};           ///< RevCore: Bits 0 -> numHarts are 1
   std::bitset<_MAX_HARTS_>              HartsClearToDecode{};   ///< RevCore: Thread is clear to start (proceed with decode)
   std::bitset<_MAX_HARTS_>              HartsClearToExecute{};  ///< RevCore: Thread is clear to execute (no register dependencides)
+  std::vector<uint64_t>                 ReadyWords{};           ///< RevCore: HartsClearToDecode as 64-bit words for bit scans
+  std::vector<unsigned>                 HartInFlight{};         ///< RevCore: per hart instructions and loads in flight (ICount)
+  std::vector<uint64_t>                 HartSliceStart{};       ///< RevCore: cycle at which each hart received its thread
+  std::vector<uint64_t>                 HartRunStart{};         ///< RevCore: cycle from which the runtime of each thread is counted
+  std::vector<uint64_t>                 EcallCalls{};           ///< RevCore: completed ECALLs by statistics slot
+  std::vector<uint64_t>                 EcallCycles{};          ///< RevCore: cycles spent in ECALLs by statistics slot
+  std::vector<uint64_t>                 EcallCallsTotal{};      ///< RevCore: total completed ECALLs by statistics slot
+  std::vector<uint64_t>                 EcallCyclesTotal{};     ///< RevCore: total ECALL cycles by statistics slot
+
+  RevHartPolicy HartPolicy    = RevHartPolicy::SwitchOnStall;  ///< RevCore: hart interleaving policy
+  bool          DecodeStalled = false;                         ///< RevCore: HartToDecodeID stalled in its last decode
 
   unsigned   numHarts{};  ///< RevCore: Number of Harts for this core
   RevOpts*   opts{};      ///< RevCore: options object
@@ -339,11 +439,81 @@ private:
 
   std::bitset<_MAX_HARTS_> CoProcStallReq{};
 
+  RevProfiler* Profiler = nullptr;  ///< RevCore: Per-PC profiler
+
+  std::vector<std::array<uint64_t, REV_STALL_CAUSES>> HartStalls{};  ///< RevCore: per hart stall cycles by cause
+
+  unsigned                IssueWidth = 1;      ///< RevCore: instructions issued per cycle (1 is the scalar model)
+  bool                    WideIssue  = false;  ///< RevCore: use the multi-issue timing model
+  std::array<unsigned, 4> FULatency{};         ///< RevCore: latency of each RevFU in cycles (0 uses the table cost)
+  std::vector<RevFU>      InstFU{};            ///< RevCore: functional unit of each InstTable entry
+
+  /// RevCore: Classify an instruction table entry of the named extension by functional unit
+  static RevFU FUClass( const RevInstEntry& Entry, std::string_view ExtName );
+
+  /// RevCore: Fetch and decode the next instruction of HartToDecodeID; returns the hazard that blocks its issue
+  RevStall DecodeInst( RevInst& Inst );
+
+  /// RevCore: Execute a decoded instruction of HartToExecID and append it to the pipeline
+  void IssueInst( RevInst& Inst, SST::Cycle_t currentCycle );
+
+  /// RevCore: Record a stall cycle of HartToDecodeID
+  void ReportStall( RevStall Hazard );
+
+  /// RevCore: Multi-issue clock function, used when IssueWidth > 1 or WideIssue is set
+  bool ClockTickWide( SST::Cycle_t currentCycle );
+
+  /// RevCore: Count a stall cycle of a hart
+  void CountStall( unsigned HartID, RevStall Cause ) {
+    Stats.stalls[unsigned( Cause ) - 1]++;
+    HartStalls[HartID][unsigned( Cause ) - 1]++;
+  }
+
   uint64_t cycles{};  ///< RevCore: The number of cycles executed
 
   ///< RevCore: Utility function for system calls that involve reading a string from memory
   EcallStatus EcallLoadAndParseString( uint64_t straddr, std::function<void()> );
 
+  ///< RevCore: Utility function for system calls that read Len bytes of memory into the ECALL buffer at Offset
+  EcallStatus EcallLoadBytes( uint64_t Addr, size_t Len, size_t Offset );
+
+  ///< RevCore: Utility function for system calls that read Len bytes of memory at Addr into Buf, a chunk per line
+  ///           with up to REV_ECALL_MAX_INFLIGHT chunks in flight; Buf must remain valid until SUCCESS. Base is
+  ///           the value of EcallState.bytesRead when this range starts, for several ranges read in sequence
+  EcallStatus EcallReadGuest( uint64_t Addr, size_t Len, char* Buf, size_t Base = 0 );
+
+  ///< RevCore: Utility function for system calls that write Len bytes of Buf to memory at Addr
+  void EcallWriteGuest( uint64_t Addr, size_t Len, const char* Buf );
+
+  ///< RevCore: Utility function for system calls that load a guest struct iovec array into EcallState.iov
+  EcallStatus EcallLoadIovec( uint64_t Vec, uint64_t VLen );
+
+  ///< RevCore: Utility function for system calls that transfer between a host file and the guest ranges Segs,
+  ///           at file offset Offset (< 0: the file position); sets a0 to the bytes moved or -errno
+  EcallStatus EcallHostIO( int fd, const std::vector<std::pair<uint64_t, uint64_t>>& Segs, int64_t Offset, bool ToGuest );
+
+  ///< RevCore: Utility function for system calls that write the part of [Addr, Addr+Len) inside a copied MAP_SHARED
+  ///           file mapping at Base back to its file; sets a0 to 0 or -errno
+  EcallStatus EcallWriteBack( const RevMem::FileMap& Map, uint64_t Base, uint64_t Addr, uint64_t Len );
+
+  ///< RevCore: Utility function for the dump ECALLs that dumps Size bytes at Addr to the file Path (nullptr: stdout)
+  EcallStatus EcallDumpRange( const char* Path, uint64_t Addr, uint64_t Size );
+
+  ///< RevCore: Utility function for the dump ECALLs that dumps EcallState.dump under Title to the file Path (nullptr: stdout)
+  EcallStatus EcallDumpSections( const char* Path, const std::string& Title );
+
+  ///< RevCore: Utility function for system calls that block the calling thread until WakeCycle
+  ///           (0: until woken) or, with a FutexAddr, until a FUTEX_WAKE on that address
+  EcallStatus EcallBlockThread( uint64_t WakeCycle, uint64_t FutexAddr = _INVALID_ADDR_ );
+
+  ///< RevCore: Simulated time in ns as reported by clock_gettime
+  uint64_t GuestTimeNs() const;
+
+  ///< RevCore: Convert a simulated duration in ns to clock cycles (at least one)
+  uint64_t NsToCycles( uint64_t Ns ) const;
+
+  RevSchedOps SchedOps{};  ///< RevCore: scheduler services of RevCPU
+
   // - Many of these are not implemented
   // - Their existence in the ECalls table is solely to not throw errors
   // - This _should_ be a comprehensive list of system calls supported on RISC-V
@@ -684,13 +854,44 @@ private:
   EcallStatus ECALL_dump_thread_mem();         // 9006, dump_thread_mem()
   EcallStatus ECALL_dump_thread_mem_to_file(); // 9007, dump_thread_mem_to_file(const char* outputFile)
 
+  // =============== REV checkpoints
+  EcallStatus ECALL_checkpoint();              // 9020, rev_checkpoint(void)
+
   // =============== REV print utilities
   EcallStatus ECALL_fast_printf();             // 9010, rev_fast_printf(const char *, ...)
 
+  // =============== REV xBGAS utilities
+  EcallStatus ECALL_xbgas_get_nb();            // 9200, rev_xbgas_get_nb(void* dest, uint64_t nmspace, const void* src, size_t nbytes, uint64_t* counter)
+
   // clang-format on
 
+  /// RevCore: ECALL handler implementation
+  using EcallHandler = EcallStatus ( RevCore::* )();
+
   /// RevCore: Table of ecall codes w/ corresponding function pointer implementations
-  static const std::unordered_map<uint32_t, EcallStatus ( RevCore::* )()> Ecalls;
+  static const std::unordered_map<uint32_t, EcallHandler> Ecalls;
+
+  /// RevCore: ECALL codes below this are dispatched through a flat table, the rest through a sorted overflow
+  static constexpr uint32_t ECALL_TABLE_SIZE = 512;
+
+  /// RevCore: ECALL dispatch entry
+  struct EcallEntry {
+    EcallHandler handler{};  ///< EcallEntry: handler (null for unknown codes)
+    unsigned     slot{};     ///< EcallEntry: statistics slot
+  };
+
+  /// RevCore: ECALL dispatch tables, built once from Ecalls
+  struct EcallDispatch {
+    std::array<EcallEntry, ECALL_TABLE_SIZE>     table{};   ///< EcallDispatch: entries indexed by code
+    std::vector<std::pair<uint32_t, EcallEntry>> sparse{};  ///< EcallDispatch: Rev-specific codes, sorted by code
+    std::vector<uint32_t>                        codes{};   ///< EcallDispatch: ECALL code of each statistics slot
+  };
+
+  /// RevCore: Get the ECALL dispatch tables
+  static const EcallDispatch& GetEcallDispatch();
+
+  /// RevCore: Find the dispatch entry of an ECALL code (nullptr if unknown)
+  static const EcallEntry* FindEcall( uint32_t Code );
 
   /// RevCore: Execute the Ecall based on the code loaded in RegFile->GetSCAUSE()
   bool ExecEcall();
@@ -811,7 +1012,11 @@ private:
   RevInst DecodeCJInst( uint16_t Inst, unsigned Entry ) const;
 
   /// RevCore: Determine next thread to execute
-  unsigned GetNextHartToDecodeID() const;
+  unsigned GetNextHartToDecodeID();
+
+  /// RevCore: Visit the harts that are clear to decode in order From+1, ..., From (wrapping) until Visit returns true
+  template<typename F>
+  void ScanReadyHarts( unsigned From, F&& Visit ) const;
 
   /// RevCore: Whether any scoreboard bits are set
   bool AnyDependency( unsigned HartID, RevRegClass regClass = RevRegClass::RegUNKNOWN ) const {
@@ -856,8 +1061,11 @@ private:
   ///< Removes thread from Hart and returns it
   std::unique_ptr<RevThread> PopThreadFromHart( unsigned HartID );
 
-  /// RevCore: Check scoreboard for pipeline hazards
-  bool DependencyCheck( unsigned HartID, const RevInst* Inst ) const;
+  ///< RevCore: Returns true if the thread on a hart can be switched out (no instructions, loads or ECALL in flight)
+  bool HartCanSwitch( unsigned HartID ) const;
+
+  /// RevCore: Check scoreboard for pipeline hazards; returns the hazard found or RevStall::None
+  RevStall DependencyCheck( unsigned HartID, const RevInst* Inst ) const;
 
   /// RevCore: Set or clear scoreboard based on instruction destination
   void DependencySet( unsigned HartID, const RevInst* Inst, bool value = true ) {
@@ -15,6 +15,7 @@
 #include <string>
 
 // -- SST Headers
+#include "RevRand.h"
 #include "SST.h"
 
 namespace SST::RevCPU {
@@ -79,6 +80,9 @@ struct RevFeature {
   /// GetMaxCost: get the maximum cost
   auto GetMaxCost() const { return MaxCost; }
 
+  /// RandCost: draw a memory cost in [MinCost, MaxCost] from this core's generator
+  unsigned RandCost() const { return std::uniform_int_distribution<unsigned>( MinCost, MaxCost )( CostRNG ); }
+
   /// IsRV64: Is the device an RV64
   bool IsRV64() const { return xlen >= 64; }
 
@@ -109,6 +113,7 @@ private:
   unsigned           HartToExecID{};          ///< RevFeature: The current executing Hart on RevCore
   RevFeatureType     features{ RV_UNKNOWN };  ///< RevFeature: feature elements
   unsigned           xlen{};                  ///< RevFeature: RISC-V Xlen
+  mutable RevRNG     CostRNG;                 ///< RevFeature: memory cost generator, seeded with the ProcID
 
   /// ParseMachineModel: parse the machine model string
   bool ParseMachineModel();
@@ -170,7 +170,7 @@ bool load( const RevFeature* F, RevRegFile* R, RevMem* M, const RevInst& Inst )
   }
 
   // update the cost
-  R->cost += M->RandCost( F->GetMinCost(), F->GetMaxCost() );
+  R->cost += F->RandCost();
   R->AdvancePC( Inst );
   return true;
 }
@@ -217,7 +217,7 @@ bool fload( const RevFeature* F, RevRegFile* R, RevMem* M, const RevInst& Inst )
     M->ReadVal( F->GetHartToExecID(), rs1 + Inst.ImmSignExt( 12 ), &R->SPF[Inst.rd], std::move( req ), RevFlag::F_NONE );
   }
   // update the cost
-  R->cost += M->RandCost( F->GetMinCost(), F->GetMaxCost() );
+  R->cost += F->RandCost();
   R->AdvancePC( Inst );
   return true;
 }
@@ -562,7 +562,7 @@ bool eload( const RevFeature* F, RevRegFile* R, RevMem* M, const RevInst& Inst )
     R->RmtLSQueue->insert( req.LSQHashPair() );
     M->RmtRead( F->GetHartToExecID(), Nmspace, SrcAddr, DestReg, std::move( req ), Flags );
     // update the cost
-    R->cost += M->RandCost( F->GetMinCost(), F->GetMaxCost() );
+    R->cost += F->RandCost();
     R->AdvancePC( Inst );
     return true;
   }
@@ -617,7 +617,7 @@ bool erload( const RevFeature* F, RevRegFile* R, RevMem* M, const RevInst& Inst
     M->RmtRead( F->GetHartToExecID(), Nmspace, SrcAddr, DestReg, std::move( req ), Flags );
   }
   // update the cost
-  R->cost += M->RandCost( F->GetMinCost(), F->GetMaxCost() );
+  R->cost += F->RandCost();
   R->AdvancePC( Inst );
   return true;
 }
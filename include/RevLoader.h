@@ -16,6 +16,7 @@
 #include <cstring>
 #include <fcntl.h>
 #include <map>
+#include <memory>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string>
@@ -273,6 +274,107 @@ struct ElfInfo {
   uint64_t instret0;
 };
 
+/// RevElfImage: an executable parsed once per process; every RevLoader of the same file
+///              (path, inode, size and mtime) shares its symbol tables and its initial page image
+class RevElfImage {
+public:
+  /// RevElfImage: program header
+  struct Segment {
+    uint32_t Type{};    ///< Segment: p_type
+    uint64_t Addr{};    ///< Segment: p_paddr
+    uint64_t Offset{};  ///< Segment: p_offset
+    uint64_t FileSz{};  ///< Segment: p_filesz
+    uint64_t MemSz{};   ///< Segment: p_memsz
+  };
+
+  /// RevElfImage: consecutive guest pages whose initial contents are held in the page image
+  struct PageRun {
+    uint64_t Addr{};    ///< PageRun: guest address of the first page
+    uint64_t Len{};     ///< PageRun: bytes, a whole number of pages
+    uint64_t Offset{};  ///< PageRun: offset in the page image
+  };
+
+  /// RevElfImage: the image of Exe for guest pages of PageSize bytes, parsed on first use
+  static std::shared_ptr<const RevElfImage> Get( const std::string& Exe, uint64_t PageSize, SST::Output* Output );
+
+  /// RevElfImage: symbol tables restored from a snapshot; not cached and without a page image
+  explicit RevElfImage( RevSnapshotIn& Snap );
+
+  /// RevElfImage: unmap and close the page image
+  ~RevElfImage();
+
+  /// RevElfImage: disallow copying and assignment
+  RevElfImage( const RevElfImage& )            = delete;
+  RevElfImage& operator=( const RevElfImage& ) = delete;
+
+  /// RevElfImage: true for an Elf64 binary
+  bool Is64() const { return is64; }
+
+  /// RevElfImage: entry point
+  uint64_t GetEntry() const { return entry; }
+
+  /// RevElfImage: TLS segment address (0: none)
+  uint64_t GetTLSBaseAddr() const { return tlsBase; }
+
+  /// RevElfImage: TLS segment size
+  uint64_t GetTLSSize() const { return tlsSize; }
+
+  /// RevElfImage: end of .bss, .data or .text, whichever is found first
+  uint64_t GetStaticDataEnd() const { return staticDataEnd; }
+
+  /// RevElfImage: ELF info describing the program header table
+  const ElfInfo& GetInfo() const { return info; }
+
+  /// RevElfImage: raw program header table, as copied below the initial stack
+  const std::vector<uint8_t>& GetPhdrs() const { return phdrs; }
+
+  /// RevElfImage: program headers
+  const std::vector<Segment>& GetSegments() const { return segments; }
+
+  /// RevElfImage: guest pages held in the page image
+  const std::vector<PageRun>& GetPageRuns() const { return runs; }
+
+  /// RevElfImage: file of the page image for copy-on-write mappings (-1: none)
+  int GetImageFd() const { return imageFd; }
+
+  /// RevElfImage: the file contents of Seg within the page image
+  const char* GetSegmentData( const Segment& Seg ) const;
+
+  /// RevElfImage: symbol name to address
+  const std::map<std::string, uint64_t>& GetSymbols() const { return symtable; }
+
+  /// RevElfImage: address to symbol name for the tracer and profiler
+  const std::map<uint64_t, std::string>& GetTraceSymbols() const { return tracer_symbols; }
+
+  /// RevElfImage: write the symbol tables to a snapshot
+  void SaveSymbols( RevSnapshotOut& Snap ) const;
+
+private:
+  RevElfImage() = default;
+
+  bool                            is64{};            ///< RevElfImage: Elf64 binary
+  uint64_t                        entry{};           ///< RevElfImage: entry point
+  uint64_t                        tlsBase{};         ///< RevElfImage: TLS segment address
+  uint64_t                        tlsSize{};         ///< RevElfImage: TLS segment size
+  uint64_t                        staticDataEnd{};   ///< RevElfImage: end of the static data
+  ElfInfo                         info{};            ///< RevElfImage: program header info
+  std::vector<uint8_t>            phdrs{};           ///< RevElfImage: raw program header table
+  std::vector<Segment>            segments{};        ///< RevElfImage: program headers
+  std::vector<PageRun>            runs{};            ///< RevElfImage: guest pages held in the page image
+  int                             imageFd{ -1 };     ///< RevElfImage: page image file
+  char*                           imageBase{};       ///< RevElfImage: read-only mapping of the page image
+  size_t                          imageLen{};        ///< RevElfImage: bytes of the page image
+  std::map<std::string, uint64_t> symtable{};        ///< RevElfImage: symbol name to address
+  std::map<uint64_t, std::string> tracer_symbols{};  ///< RevElfImage: address to symbol name
+
+  /// RevElfImage: parse the headers and symbol table of an Elf32 or Elf64 binary
+  template<typename Ehdr, typename Phdr, typename Shdr, typename Sym>
+  void Parse( const char* membuf, size_t sz, SST::Output* output );
+
+  /// RevElfImage: copy the file contents of the loadable segments into a page image of PageSize pages
+  void BuildImage( const char* membuf, uint64_t PageSize, SST::Output* output );
+};  // class RevElfImage
+
 class RevLoader {
 public:
   /// RevLoader: standard constructor
@@ -282,6 +384,9 @@ public:
       output->fatal( CALL_INFO, -1, "Error: failed to load executable into memory\n" );
   }
 
+  /// RevLoader: restore a loaded program from a snapshot, after RevMem::LoadSnapshot
+  RevLoader( RevSnapshotIn& Snap, RevMem* mem, SST::Output* output );
+
   /// RevLoader: standard destructor
   ~RevLoader()                             = default;
 
@@ -290,13 +395,13 @@ public:
   RevLoader& operator=( const RevLoader& ) = delete;
 
   /// RevLoader: retrieves the address for the target symbol; 0x00ull if the symbol doesn't exist
-  uint64_t GetSymbolAddr( std::string Symbol );
+  uint64_t GetSymbolAddr( const std::string& Symbol ) const;
 
   /// RevLoader: retrieves the elf info structure
   ElfInfo GetInfo() { return elfinfo; }
 
   ///  RevLoader: symbol lookup for tracer
-  std::map<uint64_t, std::string>* GetTraceSymbols();
+  const std::map<uint64_t, std::string>* GetTraceSymbols() const { return &image->GetTraceSymbols(); }
 
   /// RevLoader: Gets TLS base address
   const uint64_t& GetTLSBaseAddr() { return TLSBaseAddr; }
@@ -304,6 +409,9 @@ public:
   /// RevLoader: Gets TLS size
   const uint64_t& GetTLSSize() { return TLSSize; }
 
+  /// RevLoader: write the entry points, ELF info and symbol tables to a snapshot
+  void SaveSnapshot( RevSnapshotOut& Snap ) const;
+
   // friend std::ostream& operator<<(std::ostream &os, const Elf64_Ehdr &header){ };
 
 private:
@@ -316,9 +424,8 @@ private:
   uint64_t TLSBaseAddr{};
   uint64_t TLSSize{};
 
-  ElfInfo                         elfinfo{};         ///< RevLoader: elf info from the loaded program
-  std::map<std::string, uint64_t> symtable{};        ///< RevLoader: loaded symbol table
-  std::map<uint64_t, std::string> tracer_symbols{};  ///< RevLoader: address to symbol for tracer
+  ElfInfo                            elfinfo{};  ///< RevLoader: elf info from the loaded program
+  std::shared_ptr<const RevElfImage> image{};    ///< RevLoader: parsed executable, shared with other loaders
 
   /// Loads the target executable into memory
   bool LoadElf( const std::string& exe, const std::vector<std::string>& args );
@@ -327,29 +434,8 @@ private:
   template<typename XLEN>
   bool LoadProgramArgs( const std::string& exe, const std::vector<std::string>& args );
 
-  /// Determines if the target header is an Elf header
-  bool IsElf( const Elf64_Ehdr eh64 );
-
-  /// Determines if the target header is an Elf32 header
-  bool IsRVElf32( const Elf64_Ehdr eh64 );
-
-  /// Determines if the target header is an Elf64 header
-  bool IsRVElf64( const Elf64_Ehdr eh64 );
-
-  /// Determines if the target header is little endian
-  bool IsRVLittle( const Elf64_Ehdr eh64 );
-
-  /// Determines if the target header is big endian
-  bool IsRVBig( const Elf64_Ehdr eh64 );
-
-  /// Loads a 32bit Elf binary
-  bool LoadElf32( char* MemBuf, size_t Size );
-
-  /// Loads a 64bit Elf binary
-  bool LoadElf64( char* MemBuf, size_t Size );
-
-  ///< Breaks bulk writes into cache lines
-  bool WriteCacheLine( uint64_t Addr, size_t Len, const void* Data );
+  /// Loads the segments of the shared image, mapping its pages copy-on-write where possible
+  void LoadSegments();
 
   ///< RevLoader: Replaces first MemSegment (initialized to entire memory space) with the static memory
   void InitStaticMem();
@@ -32,15 +32,21 @@
 #include <utility>
 #include <vector>
 
+// -- System Headers
+#include <sys/mman.h>
+#include <sys/uio.h>
+
 // -- SST Headers
 #include "SST.h"
 
 // -- RevCPU Headers
 #include "RevCommon.h"
 #include "RevMemCtrl.h"
+#include "RevMemDump.h"
 #include "RevOpts.h"
 #include "RevRand.h"
 #include "RevRmtMemCtrl.h"
+#include "RevSnapshot.h"
 #include "RevTracer.h"
 
 #ifndef _REVMEM_BASE_
@@ -60,7 +66,7 @@ public:
   RevMem( uint64_t memSize, RevOpts* opts, RevMemCtrl* ctrl, SST::Output* output );
 
   /// RevMem: standard destructor
-  ~RevMem() { delete[] physMem; }
+  ~RevMem();
 
   /// RevMem: set the remote memory controller for xBGAS
   void setRmtMemCtrl( RevRmtMemCtrl* RmtCtrl ) { rmtCtrl = RmtCtrl; }
@@ -168,6 +174,12 @@ public:
   /// RevMem: retrieves the cache line size.  Returns 0 if no cache is configured
   unsigned getLineSize() { return ctrl ? ctrl->getLineSize() : 64; }
 
+  /// RevMem: bulk transfer chunk size; one cache line with a memory controller, one page with the internal model
+  uint64_t getChunkSize() {
+    unsigned Line = getLineSize();
+    return ctrl ? ( Line ? Line : 64 ) : pageSize;
+  }
+
   /// RevMem: Enable tracing of load and store instructions.
   void SetTracer( RevTracer* tracer ) { Tracer = tracer; }
 
@@ -177,9 +189,56 @@ public:
   /// RevMem: write to the target memory location with the target flags
   bool WriteMem( unsigned Hart, uint64_t Addr, size_t Len, const void* Data, RevFlag flags = RevFlag::F_NONE );
 
+  /// RevMem: write to the target memory location and mark req complete once the write has been performed
+  bool WriteMem( unsigned Hart, uint64_t Addr, size_t Len, const void* Data, const MemReq& req, RevFlag flags = RevFlag::F_NONE );
+
+  /// RevMem: set the initial contents of [Addr, Addr+Len) (Data nullptr: zeros) before the simulation starts;
+  ///         one copy per page with the internal model, untimed backing store writes with a memory controller
+  void InitMem( uint64_t Addr, uint64_t Len, const void* Data );
+
   /// RevMem: read data from the target memory location
   bool ReadMem( unsigned Hart, uint64_t Addr, size_t Len, void* Target, const MemReq& req, RevFlag flags = RevFlag::F_NONE );
 
+  /// RevMem: append host pointers to the internal model's backing memory of [Addr, Addr+Len) to Spans,
+  ///         merging physically adjacent pages; returns false with a memory controller, which holds the data
+  bool GetHostSpans( uint64_t Addr, uint64_t Len, std::vector<iovec>& Spans );
+
+  /// RevMem: account for Len bytes at Addr read (Write: written) by the host outside ReadMem/WriteMem
+  void HostAccess( unsigned Hart, uint64_t Addr, uint64_t Len, bool Write );
+
+  /// RevMem: file-backed mapping created by the mmap ECALL
+  struct FileMap {
+    uint64_t SegBase{};  ///< FileMap: base of the allocated segment (may precede the mapping for page alignment)
+    uint64_t SegSize{};  ///< FileMap: size of the allocated segment
+    uint64_t Len{};      ///< FileMap: bytes mapped
+    uint64_t FileLen{};  ///< FileMap: bytes backed by the file; the rest reads as zero
+    uint64_t Offset{};   ///< FileMap: file offset of the first byte
+    int      Fd{ -1 };   ///< FileMap: host descriptor for writing back a copied MAP_SHARED mapping
+    bool     Shared{};   ///< FileMap: MAP_SHARED
+    char*    Host{};     ///< FileMap: host mapping of the file over the backing pages (nullptr: contents copied)
+    size_t   HostLen{};  ///< FileMap: bytes of the host mapping
+  };
+
+  /// RevMem: map FileLen bytes of host file Fd at Offset onto fresh backing pages of a new Len byte segment;
+  ///         returns the guest address, or 0 if the mapping must be copied instead
+  uint64_t MapFile( uint64_t Len, int Fd, uint64_t Offset, uint64_t FileLen, bool Shared, bool Writable );
+
+  /// RevMem: map Len bytes (whole pages) of the loader's page image Fd at Offset copy-on-write onto fresh
+  ///         backing pages at Addr; returns false, leaving memory untouched, if the pages must be written instead
+  bool MapImage( uint64_t Addr, uint64_t Len, int Fd, uint64_t Offset );
+
+  /// RevMem: record a file mapping whose contents are copied into guest memory at Addr
+  void AddFileMap( uint64_t Addr, const FileMap& Map ) { FileMaps[Addr] = Map; }
+
+  /// RevMem: the file mapping containing Addr and its guest address in Base (nullptr: none)
+  const FileMap* FindFileMap( uint64_t Addr, uint64_t& Base ) const;
+
+  /// RevMem: remove the file mapping at Addr, restore anonymous backing memory and free its segment
+  void UnmapFile( uint64_t Addr );
+
+  /// RevMem: flush [Addr, Addr+Len) of the host mapping of Map at Base to its file; returns 0 or -errno
+  int SyncFile( const FileMap& Map, uint64_t Base, uint64_t Addr, uint64_t Len, bool Sync );
+
   /// RevMem: flush a cache line
   bool FlushLine( unsigned Hart, uint64_t Addr );
 
@@ -217,9 +276,9 @@ public:
   template<typename T>
   void Write( unsigned Hart, uint64_t Addr, T Value ) {
     if( std::is_same_v<T, float> ) {
-      memStats.floatsWritten++;
+      LiveStats().floatsWritten++;
     } else if( std::is_same_v<T, double> ) {
-      memStats.doublesWritten++;
+      LiveStats().doublesWritten++;
     }
 
     if( !WriteMem( Hart, Addr, sizeof( T ), &Value ) ) {
@@ -247,6 +306,13 @@ public:
     rmtCtrl->sendRmtBulkReadRqst( Hart, Nmspace, SrcAddr, Size, Nelem, DestAddr, Target, RevFlag::F_NONE );
   }
 
+  /// RevMem: split-phase remote get; Counter is incremented in local memory once the data has landed
+  void RmtGetNB(
+    unsigned Hart, uint64_t Nmspace, uint64_t SrcAddr, size_t Size, uint32_t Nelem, uint64_t DestAddr, uint64_t Counter
+  ) {
+    rmtCtrl->sendRmtGetNBRqst( Hart, Nmspace, SrcAddr, Size, Nelem, DestAddr, Counter );
+  }
+
   // ----------------------------------------------------
   // ---- xBGAS Remote Write Memory Interfaces
   // ----------------------------------------------------
@@ -302,9 +368,6 @@ public:
   /// RevMem: Interrogates the target address and returns 'true' if a future reservation is present [RV64P only]
   bool StatusFuture( uint64_t Addr );
 
-  /// RevMem: Randomly assign a memory cost
-  unsigned RandCost( unsigned Min, unsigned Max ) { return RevRand( Min, Max ); }
-
   /// RevMem: Used to access & incremenet the global software PID counter
   uint32_t GetNewThreadPID();
 
@@ -312,11 +375,14 @@ public:
   void SetTLBSize( unsigned numEntries ) { tlbSize = numEntries; }
 
   /// RevMem: Used to set the size of the TLBSize
-  void SetMaxHeapSize( const unsigned MaxHeapSize ) { maxHeapSize = MaxHeapSize; }
+  void SetMaxHeapSize( const uint64_t MaxHeapSize ) { maxHeapSize = MaxHeapSize; }
 
   /// RevMem: Get memSize value set in .py file
   uint64_t GetMemSize() const { return memSize; }
 
+  /// RevMem: size of a backing page
+  uint64_t GetPageSize() const { return pageSize; }
+
   ///< RevMem: Get MemSegs vector
   std::vector<std::shared_ptr<MemSegment>>& GetMemSegs() { return MemSegs; }
 
@@ -374,6 +440,12 @@ public:
 
   const uint64_t& GetTLSSize() { return TLSSize; }
 
+  /// RevMem: write the memory layout and the contents of every touched page to a snapshot
+  void SaveSnapshot( RevSnapshotOut& Snap ) const;
+
+  /// RevMem: restore the layout and pages of a snapshot into this freshly constructed memory
+  void LoadSnapshot( RevSnapshotIn& Snap );
+
   struct RevMemStats {
     uint64_t TLBHits;
     uint64_t TLBMisses;
@@ -406,11 +478,70 @@ public:
 
   RevMemStats GetMemStatsTotal() const { return memStatsTotal; }
 
+  /// RevMem: restore the totals of a checkpoint
+  void SetMemStatsTotal( const RevMemStats& Stats ) { memStatsTotal = Stats; }
+
+  /// RevMem: bytes read and written since the last GetAndClearStats, including those of the calling thread's isolation
+  uint64_t GetBytesAccessed() const {
+    uint64_t Bytes = memStats.bytesRead + memStats.bytesWritten;
+    if( Isolated )
+      Bytes += Isolated->Stats.bytesRead + Isolated->Stats.bytesWritten;
+    return Bytes;
+  }
+
+  /// RevMem: memory accesses of one core while the cores of a RevCPU are ticked apart (parallelThreads)
+  struct Isolation {
+    /// Isolation: a buffered store of Len bytes at StoreData[Offset]
+    struct Store {
+      unsigned Hart{};
+      uint64_t Addr{};
+      size_t   Len{};
+      size_t   Offset{};
+      RevFlag  Flags{};
+    };
+
+    bool                                       Buffer{};     ///< Isolation: buffer stores; loads see memory as of the last commit
+    bool                                       Record{};     ///< Isolation: record the address ranges read and written
+    std::vector<Store>                         Stores{};     ///< Isolation: buffered stores in program order
+    std::vector<uint8_t>                       StoreData{};  ///< Isolation: data of the buffered stores
+    RevMemStats                                Stats{};      ///< Isolation: statistics of the buffered accesses
+    std::vector<std::pair<uint64_t, uint64_t>> Reads{};      ///< Isolation: recorded [start, end) ranges read
+    std::vector<std::pair<uint64_t, uint64_t>> Writes{};     ///< Isolation: recorded [start, end) ranges written
+
+    /// Isolation: forget the accesses of the previous cycle
+    void Clear() {
+      Stores.clear();
+      StoreData.clear();
+      Stats = {};
+      Reads.clear();
+      Writes.clear();
+    }
+  };
+
+  /// RevMem: route the memory accesses of the calling host thread through Iso (nullptr: access memory directly)
+  static void SetIsolation( Isolation* Iso ) { Isolated = Iso; }
+
+  /// RevMem: perform the buffered stores of Iso in program order and account for its accesses
+  void CommitIsolation( Isolation& Iso );
+
+  /// RevMem: copy [Addr, Addr+Len) of the internal model into Data without allocating pages or touching the TLB;
+  ///         pages that were never touched read as zeros
+  void PeekMem( uint64_t Addr, uint64_t Len, void* Data ) const;
+
   /// RevMem: Dump the memory contents
   void DumpMem(
     const uint64_t startAddr, const uint64_t numBytes, const uint64_t bytesPerRow = 16, std::ostream& outputStream = std::cout
   );
 
+  /// RevMem: Dump a host copy of the memory starting at startAddr
+  static void DumpBytes(
+    const uint64_t startAddr,
+    const uint8_t* data,
+    const uint64_t numBytes,
+    const uint64_t bytesPerRow  = 16,
+    std::ostream&  outputStream = std::cout
+  );
+
   void DumpValidMem( const uint64_t bytesPerRow = 16, std::ostream& outputStream = std::cout );
 
   void DumpMemSeg(
@@ -419,6 +550,31 @@ public:
 
   void DumpThreadMem( const uint64_t bytesPerRow = 16, std::ostream& outputStream = std::cout );
 
+  /// RevMem: sections of DumpValidMem and DumpThreadMem
+  std::vector<RevMemDumpSection> GetValidMemSections();
+  std::vector<RevMemDumpSection> GetThreadMemSections();
+
+  /// RevMem: write the title and the sections in the text format
+  void WriteDump(
+    const std::string& Title, const std::vector<RevMemDumpSection>& Sections, uint64_t bytesPerRow, std::ostream& outputStream
+  ) const;
+
+  /// RevMem: write the title and the sections to the file Path in the format chosen by SetDumpFormat
+  void WriteDumpFile( const std::string& Path, const std::string& Title, const std::vector<RevMemDumpSection>& Sections ) const;
+
+  /// RevMem: write every dump range to {Name}{Suffix}; with a memory controller the ranges
+  /// are read through it first, and this returns false until they have all arrived
+  bool WriteDumpRanges( const std::string& Suffix );
+
+  /// RevMem: select binary dump files, optionally zstd compressed, or the text format
+  void SetDumpFormat( bool Binary, bool Compress ) {
+    DumpBinary   = Binary;
+    DumpCompress = Compress;
+  }
+
+  /// RevMem: determine whether the memory contents are held by a memory controller
+  bool HasMemCtrl() const { return ctrl != nullptr; }
+
 protected:
   char* physMem = nullptr;  ///< RevMem: memory container
 
@@ -426,9 +582,17 @@ private:
   RevMemStats memStats{};
   RevMemStats memStatsTotal{};
 
+  static thread_local Isolation* Isolated;  ///< RevMem: isolation of the core ticked on this host thread
+
+  /// RevMem: statistics updated by an access of the calling thread
+  RevMemStats& LiveStats() { return Isolated && Isolated->Buffer ? Isolated->Stats : memStats; }
+
+  /// RevMem: read Len bytes at Addr as of the last commit, overlaid with the stores buffered in Iso
+  void ReadBuffered( Isolation& Iso, uint64_t Addr, size_t Len, char* Data ) const;
+
   unsigned long memSize{};      ///< RevMem: size of the target memory
   unsigned      tlbSize{};      ///< RevMem: number of entries in the TLB
-  unsigned      maxHeapSize{};  ///< RevMem: maximum size of the heap
+  uint64_t      maxHeapSize{};  ///< RevMem: maximum size of the heap
   std::unordered_map<uint64_t, std::pair<uint64_t, std::list<uint64_t>::iterator>> TLB{};
   std::list<uint64_t> LRUQueue{};  ///< RevMem: List ordered by last access for implementing LRU policy when TLB fills up
   RevOpts*            opts{};      ///< RevMem: options object
@@ -440,6 +604,19 @@ private:
   std::vector<std::shared_ptr<MemSegment>> FreeMemSegs{};    // MemSegs that have been unallocated
   std::vector<std::shared_ptr<MemSegment>> ThreadMemSegs{};  // For each RevThread there is a corresponding MemSeg (TLS & Stack)
   std::map<std::string, std::shared_ptr<MemSegment>> DumpRanges{};  // Mem ranges to dump at points specified in the configuration
+  std::map<uint64_t, FileMap>                         FileMaps{};    // File-backed mappings by guest address
+
+  bool                 DumpBinary{};        ///< RevMem: dump files use the binary format
+  bool                 DumpCompress{};      ///< RevMem: binary dump chunks are zstd compressed
+  std::vector<uint8_t> DumpRangeData{};     ///< RevMem: dump ranges read through the memory controller
+  uint64_t             DumpRangeIssued{};   ///< RevMem: bytes of DumpRangeData requested so far
+  uint64_t             DumpRangePending{};  ///< RevMem: dump range reads in flight
+
+  /// RevMem: host bytes of Addr in Sec up to the end of its page, or nullptr if the page was never touched
+  const uint8_t* PeekDump( const RevMemDumpSection& Sec, uint64_t Addr ) const;
+
+  /// RevMem: section of a memory segment with the label of DumpMemSeg
+  static RevMemDumpSection SegSection( const MemSegment& Seg, const std::string& Prefix = "" );
 
   uint64_t TLSBaseAddr       = 0;                   ///< RevMem: TLS Base Address
   uint64_t TLSSize           = sizeof( uint32_t );  ///< RevMem: TLS Size (minimum size is enough to write the TID)
@@ -453,7 +630,7 @@ private:
     CalcPhysAddr( uint64_t pageNum, uint64_t vAddr );  ///< RevMem: Used to calculate the physical address based on virtual address
   std::tuple<uint64_t, uint64_t, uint64_t>
        AdjPageAddr( uint64_t Addr, uint64_t Len );  ///< RevMem: Used to adjust address crossing pages
-  bool isValidVirtAddr( uint64_t vAddr );           ///< RevMem: Used to check if a virtual address exists in MemSegs
+  bool isValidVirtAddr( uint64_t vAddr ) const;     ///< RevMem: Used to check if a virtual address exists in MemSegs
 
   std::map<uint64_t, std::pair<uint32_t, bool>> pageMap{};    ///< RevMem: map of logical to pair<physical addresses, allocated>
   uint32_t                                      pageSize{};   ///< RevMem: size of allocated pages
@@ -242,6 +242,11 @@ public:
   /// RevMemCtrl: send a write request
   virtual bool sendWRITERequest( unsigned Hart, uint64_t Addr, uint64_t PAddr, uint32_t Size, char* buffer, RevFlag flags ) = 0;
 
+  /// RevMemCtrl: send a write request whose response marks req complete
+  virtual bool sendWRITERequest(
+    unsigned Hart, uint64_t Addr, uint64_t PAddr, uint32_t Size, char* buffer, const MemReq& req, RevFlag flags
+  ) = 0;
+
   /// RevMemCtrl: send an AMO request
   virtual bool sendAMORequest(
     unsigned Hart, uint64_t Addr, uint64_t PAddr, uint32_t Size, char* buffer, void* target, const MemReq& req, RevFlag flags
@@ -274,6 +279,9 @@ public:
   /// RevMemCtrl: send a FENCE request
   virtual bool sendFENCE( unsigned Hart )                      = 0;
 
+  /// RevMemCtrl: queue initial memory contents (nullptr: zeros), written untimed to the backing store in init()
+  virtual void sendINITData( uint64_t Addr, uint64_t Len, const void* Data ) = 0;
+
   /// RevMemCtrl: handle a read response
   virtual void handleReadResp( StandardMem::ReadResp* ev )     = 0;
 
@@ -474,6 +482,11 @@ public:
     unsigned Hart, uint64_t Addr, uint64_t PAddr, uint32_t Size, char* buffer, RevFlag flags = RevFlag::F_NONE
   ) override;
 
+  /// RevBasicMemCtrl: send a write request whose response marks req complete
+  virtual bool sendWRITERequest(
+    unsigned Hart, uint64_t Addr, uint64_t PAddr, uint32_t Size, char* buffer, const MemReq& req, RevFlag flags
+  ) override;
+
   /// RevBasicMemCtrl: send an AMO request
   virtual bool sendAMORequest(
     unsigned Hart, uint64_t Addr, uint64_t PAddr, uint32_t Size, char* buffer, void* target, const MemReq& req, RevFlag flags
@@ -508,6 +521,9 @@ public:
   // RevBasicMemCtrl: send a FENCE request
   virtual bool sendFENCE( unsigned Hart ) override;
 
+  /// RevBasicMemCtrl: queue initial memory contents (nullptr: zeros), written untimed to the backing store in init()
+  virtual void sendINITData( uint64_t Addr, uint64_t Len, const void* Data ) override;
+
   /// RevBasicMemCtrl: handle a read response
   virtual void handleReadResp( StandardMem::ReadResp* ev ) override;
 
@@ -665,6 +681,7 @@ private:
   std::vector<StandardMem::Request::id_t>         requests{};     ///< outstanding StandardMem requests
   std::vector<RevMemOp*>                          rqstQ{};        ///< queued memory requests
   std::map<StandardMem::Request::id_t, RevMemOp*> outstanding{};  ///< map of outstanding requests
+  std::vector<StandardMem::Request*>              initData{};     ///< untimed writes of the initial memory contents
 
 #define AMOTABLE_HART   0
 #define AMOTABLE_BUFFER 1
@@ -699,7 +716,7 @@ void ApplyAMO( RevFlag flags, void* Target, T value ) {
 
   // Table mapping atomic operations to executable code
   // clang-format off
-  static const std::pair<RevCPU::RevFlag, std::function<void()>> table[] = {
+  const std::pair<RevCPU::RevFlag, std::function<void()>> table[] = {
     { RevFlag::F_AMOADD,  [&]{ *TmpTarget += TmpBuf; } },
     { RevFlag::F_AMOXOR,  [&]{ *TmpTarget ^= TmpBuf; } },
     { RevFlag::F_AMOAND,  [&]{ *TmpTarget &= TmpBuf; } },
@@ -0,0 +1,177 @@
+//
+// _RevMemDump_h_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVMEMDUMP_H_
+#define _SST_REVCPU_REVMEMDUMP_H_
+
+// -- Standard Headers
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef REV_DUMP_ZSTD
+#include <zstd.h>
+#endif
+
+// -- SST Headers
+#include "SST.h"
+
+namespace SST::RevCPU {
+
+// Binary memory dump format
+// A binary dump starts with a MemDumpFileHdr_t and 'titleLen' bytes of title
+// text, followed by the section table: 'nsects' MemDumpSect_t entries, each
+// followed by 'labelLen' bytes of label text. The contents of the sections
+// follow in table order as chunks that never cross a guest page. Each chunk
+// is a MemDumpChunk_t followed by 'stored' bytes; untouched and all-zero
+// chunks store nothing. Values are in host byte order (little endian on all
+// supported hosts). scripts/rev-dump-convert.py renders a binary dump in the
+// text format of RevMem::DumpBytes.
+constexpr char     MEM_DUMP_MAGIC[8] = { 'R', 'E', 'V', 'M', 'D', 'M', 'P', '1' };
+constexpr uint32_t MEM_DUMP_VERSION  = 1;
+
+/// Dump range reads in flight to a memory controller
+constexpr size_t REV_DUMP_MAX_INFLIGHT = 256;
+
+enum class MemDumpEnc : uint8_t {
+  Zero = 0,  // all zero or never touched; no data stored
+  Raw  = 1,  // 'len' bytes of data
+  Zstd = 2,  // one zstd frame of 'stored' bytes holding 'len' bytes of data
+};
+
+struct MemDumpFileHdr_t {
+  char     magic[8];     // MEM_DUMP_MAGIC
+  uint32_t version;      // MEM_DUMP_VERSION
+  uint32_t pageSize;     // guest page size; no chunk crosses a page
+  uint32_t bytesPerRow;  // bytes per line of the text format
+  uint32_t titleLen;     // length of the title that follows
+  uint64_t nsects;       // section table entries
+};
+
+static_assert( sizeof( MemDumpFileHdr_t ) == 32, "MemDumpFileHdr_t must be 32 bytes" );
+
+struct MemDumpSect_t {
+  uint64_t base;      // first address of the section
+  uint64_t size;      // bytes in the section
+  uint32_t labelLen;  // length of the label that follows
+  uint32_t rsvd;      // reserved
+};
+
+static_assert( sizeof( MemDumpSect_t ) == 24, "MemDumpSect_t must be 24 bytes" );
+
+struct MemDumpChunk_t {
+  uint64_t addr;     // first address of the chunk
+  uint32_t len;      // bytes of memory in the chunk
+  uint32_t stored;   // bytes of data that follow
+  uint8_t  enc;      // MemDumpEnc
+  uint8_t  rsvd[7];  // reserved
+};
+
+static_assert( sizeof( MemDumpChunk_t ) == 24, "MemDumpChunk_t must be 24 bytes" );
+
+/// RevMemDumpSection: a labeled address range of a memory dump
+struct RevMemDumpSection {
+  std::string    Label{};  ///< RevMemDumpSection: comment line(s) written before the range; empty for none
+  uint64_t       Base{};   ///< RevMemDumpSection: first address
+  uint64_t       Size{};   ///< RevMemDumpSection: bytes in the range
+  const uint8_t* Data{};   ///< RevMemDumpSection: host copy of the range, or nullptr to read the memory model
+};
+
+/// RevMemDumpOut: binary memory dump writer; sections are streamed a chunk at a time
+class RevMemDumpOut {
+public:
+  /// RevMemDumpOut: create the file and write the header and the section table
+  RevMemDumpOut(
+    const std::string&                    Path,
+    const std::string&                    Title,
+    const std::vector<RevMemDumpSection>& Sections,
+    uint32_t                              PageSize,
+    uint32_t                              BytesPerRow,
+    bool                                  Compress
+  )
+    : compress( Compress ) {
+    os.open( Path, std::ios::binary | std::ios::trunc );
+    MemDumpFileHdr_t Hdr{};
+    memcpy( Hdr.magic, MEM_DUMP_MAGIC, sizeof( Hdr.magic ) );
+    Hdr.version     = MEM_DUMP_VERSION;
+    Hdr.pageSize    = PageSize;
+    Hdr.bytesPerRow = BytesPerRow;
+    Hdr.titleLen    = uint32_t( Title.size() );
+    Hdr.nsects      = Sections.size();
+    Write( &Hdr, sizeof( Hdr ) );
+    Write( Title.data(), Title.size() );
+    for( const auto& Sec : Sections ) {
+      MemDumpSect_t Ent{ Sec.Base, Sec.Size, uint32_t( Sec.Label.size() ), 0 };
+      Write( &Ent, sizeof( Ent ) );
+      Write( Sec.Label.data(), Sec.Label.size() );
+    }
+  }
+
+  /// RevMemDumpOut: disallow copying and assignment
+  RevMemDumpOut( const RevMemDumpOut& )            = delete;
+  RevMemDumpOut& operator=( const RevMemDumpOut& ) = delete;
+
+  /// RevMemDumpOut: determine whether the file was created and every write succeeded
+  bool Good() const { return bool( os ); }
+
+  /// RevMemDumpOut: determine whether compression support was compiled in
+  static bool HasCompression() {
+#ifdef REV_DUMP_ZSTD
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /// RevMemDumpOut: append the next chunk; Data is nullptr for memory that was never touched
+  void PutChunk( uint64_t Addr, uint32_t Len, const uint8_t* Data ) {
+    MemDumpChunk_t Chunk{};
+    Chunk.addr = Addr;
+    Chunk.len  = Len;
+    Chunk.enc  = uint8_t( MemDumpEnc::Zero );
+    if( !Data || std::all_of( Data, Data + Len, []( uint8_t b ) { return b == 0; } ) ) {
+      Write( &Chunk, sizeof( Chunk ) );
+      return;
+    }
+#ifdef REV_DUMP_ZSTD
+    if( compress ) {
+      zbuf.resize( ZSTD_compressBound( Len ) );
+      size_t Size = ZSTD_compress( zbuf.data(), zbuf.size(), Data, Len, 1 );
+      if( !ZSTD_isError( Size ) && Size < Len ) {
+        Chunk.stored = uint32_t( Size );
+        Chunk.enc    = uint8_t( MemDumpEnc::Zstd );
+        Write( &Chunk, sizeof( Chunk ) );
+        Write( zbuf.data(), Size );
+        return;
+      }
+    }
+#endif
+    Chunk.stored = Len;
+    Chunk.enc    = uint8_t( MemDumpEnc::Raw );
+    Write( &Chunk, sizeof( Chunk ) );
+    Write( Data, Len );
+  }
+
+private:
+  std::ofstream        os{};        ///< RevMemDumpOut: dump file
+  bool                 compress{};  ///< RevMemDumpOut: compress chunks with zstd
+  std::vector<uint8_t> zbuf{};      ///< RevMemDumpOut: compressed chunk staging
+
+  /// RevMemDumpOut: write raw bytes
+  void Write( const void* Data, size_t Len ) { os.write( static_cast<const char*>( Data ), std::streamsize( Len ) ); }
+};  // class RevMemDumpOut
+
+}  // namespace SST::RevCPU
+
+#endif  // _SST_REVCPU_REVMEMDUMP_H_
@@ -15,6 +15,7 @@
 #include "SST.h"
 
 // -- Standard Headers
+#include <array>
 #include <cinttypes>
 #include <map>
 #include <string>
@@ -58,6 +59,12 @@ public:
   /// RevOpts: initialize the prefetch depths
   bool InitPrefetchDepth( const std::vector<std::string>& Depths );
 
+  /// RevOpts: initialize the issue widths
+  bool InitIssueWidths( const std::vector<std::string>& Widths );
+
+  /// RevOpts: initialize the functional unit latencies
+  bool InitFULatencies( const std::vector<std::string>& Latencies );
+
   /// RevOpts: retrieve the start address for the target core
   bool GetStartAddr( unsigned Core, uint64_t& StartAddr );
 
@@ -76,6 +83,12 @@ public:
   /// RevOpts: retrieve the prefetch depth for the target core
   bool GetPrefetchDepth( unsigned Core, unsigned& Depth );
 
+  /// RevOpts: retrieve the issue width for the target core
+  bool GetIssueWidth( unsigned Core, unsigned& Width );
+
+  /// RevOpts: retrieve the ALU, MUL/DIV, FPU and LSU latencies for the target core (0 uses the table cost)
+  bool GetFULatency( unsigned Core, std::array<unsigned, 4>& Latency );
+
   /// RevOpts: set the argv array
   void SetArgs( const SST::Params& params );
 
@@ -95,14 +108,16 @@ private:
   unsigned numHarts{};   ///< RevOpts: number of harts per core
   int      verbosity{};  ///< RevOpts: verbosity level
 
-  std::unordered_map<unsigned, uint64_t>     startAddr{};      ///< RevOpts: map of core id to starting address
-  std::unordered_map<unsigned, std::string>  startSym{};       ///< RevOpts: map of core id to starting symbol
-  std::unordered_map<unsigned, std::string>  machine{};        ///< RevOpts: map of core id to machine model
-  std::unordered_map<unsigned, std::string>  table{};          ///< RevOpts: map of core id to inst table
-  std::unordered_map<unsigned, unsigned>     prefetchDepth{};  ///< RevOpts: map of core id to prefretch depth
-  std::vector<std::pair<unsigned, unsigned>> memCosts{};       ///< RevOpts: vector of memory cost ranges
-  std::vector<std::string>                   Argv{};           ///< RevOpts: vector of function arguments
-  std::vector<std::string>                   MemDumpRanges{};  ///< RevOpts: vector of function arguments
+  std::unordered_map<unsigned, uint64_t>                startAddr{};      ///< RevOpts: map of core id to starting address
+  std::unordered_map<unsigned, std::string>             startSym{};       ///< RevOpts: map of core id to starting symbol
+  std::unordered_map<unsigned, std::string>             machine{};        ///< RevOpts: map of core id to machine model
+  std::unordered_map<unsigned, std::string>             table{};          ///< RevOpts: map of core id to inst table
+  std::unordered_map<unsigned, unsigned>                prefetchDepth{};  ///< RevOpts: map of core id to prefretch depth
+  std::unordered_map<unsigned, unsigned>                issueWidth{};     ///< RevOpts: map of core id to issue width
+  std::unordered_map<unsigned, std::array<unsigned, 4>> fuLatency{};      ///< RevOpts: map of core id to functional unit latencies
+  std::vector<std::pair<unsigned, unsigned>>            memCosts{};       ///< RevOpts: vector of memory cost ranges
+  std::vector<std::string>                              Argv{};           ///< RevOpts: vector of function arguments
+  std::vector<std::string>                              MemDumpRanges{};  ///< RevOpts: vector of function arguments
 
 };  // class RevOpts
 
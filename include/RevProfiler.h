@@ -0,0 +1,188 @@
+//
+// _RevProfiler_h_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVPROFILER_H_
+#define _SST_REVCPU_REVPROFILER_H_
+
+// -- Standard Headers
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SST::RevCPU {
+
+/// RevStall: reason a hart could not issue an instruction in a cycle
+enum class RevStall : uint8_t {
+  None          = 0,  ///< RevStall: no stall
+  Fetch         = 1,  ///< RevStall: instruction fetch did not complete
+  LoadHazard    = 2,  ///< RevStall: RAW hazard on an outstanding local load
+  RmtLoadHazard = 3,  ///< RevStall: RAW hazard on an outstanding remote (xBGAS) load
+  Scoreboard    = 4,  ///< RevStall: RAW hazard on a long latency (FP, mul/div) result
+  Ecall         = 5,  ///< RevStall: ECALL in progress
+  CoProc        = 6,  ///< RevStall: hart stalled by the coprocessor
+  NoThread      = 7,  ///< RevStall: no thread assigned (never charged to a PC)
+};
+
+/// RevStall: number of stall causes, excluding None
+constexpr unsigned REV_STALL_CAUSES = 7;
+
+/// RevStall: number of stall causes charged to an instruction address (Fetch through CoProc)
+constexpr unsigned REV_PC_STALL_CAUSES = 6;
+
+/// RevStall: short name of a stall cause
+const char* RevStallName( RevStall Cause );
+
+/// RevProfEntry: per-PC profile counters
+struct RevProfEntry {
+  uint64_t pc{};                           ///< RevProfEntry: instruction address
+  uint64_t retired{};                      ///< RevProfEntry: instructions executed
+  uint64_t bytes{};                        ///< RevProfEntry: memory bytes read and written
+  uint64_t stalls[REV_PC_STALL_CAUSES]{};  ///< RevProfEntry: stall cycles by cause
+
+  /// RevProfEntry: cycles attributed to this PC
+  uint64_t Cycles() const {
+    uint64_t c = retired;
+    for( uint64_t s : stalls )
+      c += s;
+    return c;
+  }
+
+  /// RevProfEntry: accumulate another entry
+  void Add( const RevProfEntry& e ) {
+    retired += e.retired;
+    bytes += e.bytes;
+    for( unsigned i = 0; i < REV_PC_STALL_CAUSES; i++ )
+      stalls[i] += e.stalls[i];
+  }
+};
+
+class RevProfiler {
+public:
+  /// RevProfiler: constructor; every 'Interval'th cycle is sampled and weighted by 'Interval'
+  RevProfiler( unsigned Harts, uint64_t Interval, const std::map<uint64_t, std::string>* Symbols );
+
+  /// RevProfiler: disallow copying and assignment
+  RevProfiler( const RevProfiler& )            = delete;
+  RevProfiler& operator=( const RevProfiler& ) = delete;
+
+  /// RevProfiler: start a core cycle; decides whether the cycle is sampled
+  void Tick() {
+    Sampled = ++Phase >= Interval;
+    if( Sampled )
+      Phase = 0;
+  }
+
+  /// RevProfiler: record an executed instruction and follow calls and returns
+  void Exec( unsigned Hart, uint64_t PC, uint64_t NextPC, uint64_t Link, unsigned Size, uint64_t Bytes ) {
+    if( NextPC != PC + Size )
+      Branch( Hart, PC, NextPC, Link, Size );
+    if( Sampled ) {
+      RevProfEntry& e = Lookup( PC );
+      e.retired += Interval;
+      e.bytes += Bytes;
+      NodeCycles( Hart, PC ) += Interval;
+    }
+  }
+
+  /// RevProfiler: record a stall cycle of the instruction at 'PC'
+  void Stall( unsigned Hart, uint64_t PC, RevStall Cause ) {
+    if( Sampled && Cause != RevStall::None && unsigned( Cause ) <= REV_PC_STALL_CAUSES ) {
+      Lookup( PC ).stalls[unsigned( Cause ) - 1] += Interval;
+      NodeCycles( Hart, PC ) += Interval;
+    }
+  }
+
+  /// RevProfiler: forget the call stack of a hart when it receives a new thread
+  void ResetHart( unsigned Hart );
+
+  /// RevProfiler: write the flat profile by function and by PC
+  void WriteFlat( std::ostream& os, unsigned Core ) const;
+
+  /// RevProfiler: write folded call stacks (one "f0;f1;f2 cycles" line per stack)
+  void WriteFolded( std::ostream& os ) const;
+
+private:
+  /// RevProfiler: call stack node; children are interned in StackIndex
+  struct StackNode {
+    uint32_t parent{};  ///< StackNode: parent node (0 is the root)
+    uint64_t func{};    ///< StackNode: function entry address
+    uint64_t cycles{};  ///< StackNode: cycles sampled with this node on top of the stack
+  };
+
+  /// RevProfiler: shadow call stack of a hart
+  struct HartStack {
+    uint32_t              node{};     ///< HartStack: current stack node (0 before the first sample)
+    std::vector<uint64_t> returns{};  ///< HartStack: return addresses of the active calls
+  };
+
+  /// RevProfiler: find or insert the entry for 'PC' (open addressing, linear probing)
+  RevProfEntry& Lookup( uint64_t PC ) {
+    size_t mask = Table.size() - 1;
+    for( size_t i = Hash( PC ) & mask;; i = ( i + 1 ) & mask ) {
+      RevProfEntry& e = Table[i];
+      if( e.pc == PC )
+        return e;
+      if( e.pc == EMPTY ) {
+        if( ++Used * 2 > Table.size() ) {
+          Grow();
+          return Lookup( PC );
+        }
+        e.pc = PC;
+        return e;
+      }
+    }
+  }
+
+  /// RevProfiler: hash an instruction address
+  static size_t Hash( uint64_t PC ) { return size_t( ( PC >> 1 ) * 0x9E3779B97F4A7C15ULL >> 20 ); }
+
+  /// RevProfiler: double the hash table
+  void Grow();
+
+  /// RevProfiler: update the shadow call stack on a control transfer
+  void Branch( unsigned Hart, uint64_t PC, uint64_t NextPC, uint64_t Link, unsigned Size );
+
+  /// RevProfiler: cycle counter of the current stack node of a hart
+  uint64_t& NodeCycles( unsigned Hart, uint64_t PC ) {
+    HartStack& h = Stacks[Hart];
+    if( h.node == 0 )
+      h.node = Child( 0, FuncOf( PC ) );
+    return Nodes[h.node].cycles;
+  }
+
+  /// RevProfiler: find or create a child stack node
+  uint32_t Child( uint32_t Parent, uint64_t Func );
+
+  /// RevProfiler: entry address of the function containing 'PC' (0 if unknown)
+  uint64_t FuncOf( uint64_t PC ) const;
+
+  /// RevProfiler: symbol name of a function entry address
+  std::string FuncName( uint64_t Func ) const;
+
+  static constexpr uint64_t EMPTY     = ~0ULL;  ///< RevProfiler: unused hash table slot
+  static constexpr size_t   MAX_DEPTH = 1024;   ///< RevProfiler: shadow call stack limit
+
+  uint64_t                                          Interval;      ///< RevProfiler: sampling interval in cycles
+  uint64_t                                          Phase{};       ///< RevProfiler: cycles since the last sample
+  bool                                              Sampled{};     ///< RevProfiler: the current cycle is sampled
+  const std::map<uint64_t, std::string>*            Symbols;       ///< RevProfiler: loader symbols (address to name)
+  std::vector<RevProfEntry>                         Table;         ///< RevProfiler: per-PC hash table
+  size_t                                            Used{};        ///< RevProfiler: occupied hash table slots
+  std::vector<StackNode>                            Nodes;         ///< RevProfiler: interned call stack nodes
+  std::map<std::pair<uint32_t, uint64_t>, uint32_t> StackIndex{};  ///< RevProfiler: (parent, func) to node
+  std::vector<HartStack>                            Stacks;        ///< RevProfiler: per hart shadow call stacks
+};  // class RevProfiler
+
+}  // namespace SST::RevCPU
+
+#endif  // _SST_REVCPU_REVPROFILER_H_
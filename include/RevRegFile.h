@@ -133,6 +133,8 @@ enum class RevExceptionCause : int32_t {
 
 class RevCore;
 class RevTracer;
+class RevSnapshotOut;
+class RevSnapshotIn;
 
 class RevRegFile : public RevCSR {
   RevCore* const Core;       ///< RevRegFile: Owning core of this register file's hart
@@ -405,6 +407,12 @@ public:
     }
   }
 
+  /// RevRegFile: write the architectural state (PC, registers, exception state and CSRs) to a checkpoint
+  void SaveSnapshot( RevSnapshotOut& Snap ) const;
+
+  /// RevRegFile: restore the architectural state written by SaveSnapshot
+  void LoadSnapshot( RevSnapshotIn& Snap );
+
   // Friend functions and classes to access internal register state
   template<typename INT, typename FP>
   friend bool fcvtif( const class RevFeature* F, RevRegFile* R, class RevMem* M, const class RevInst& Inst );
@@ -12,6 +12,7 @@
 #define _SST_REVCPU_REVRMTMEMCTRL_H_
 
 // -- C++ Headers
+#include <deque>
 #include <list>
 #include <stdio.h>
 #include <stdlib.h>
@@ -122,6 +123,9 @@ public:
   /// RevRmtMemOp: retrieve the remote memory request
   const RmtMemReq& getRmtMemReq() const { return ProcReq; }
 
+  /// RevRmtMemOp: retrieve the local completion counter address of a split-phase get
+  uint64_t getCounter() const { return Counter; }
+
   /// RevRmtMemOp: set the hart id
   void setHart( unsigned H ) { Hart = H; }
 
@@ -143,6 +147,9 @@ public:
   /// RevRmtMemOp: set the memory operation request
   void setRmtMemReq( const RmtMemReq& Req ) { ProcReq = Req; }
 
+  /// RevRmtMemOp: set the local completion counter address of a split-phase get
+  void setCounter( uint64_t C ) { Counter = C; }
+
 private:
   unsigned             Hart{};      ///< RevRmtMemOp: hart id
   uint64_t             Nmspace{};   ///< RevRmtMemOp: target namespace
@@ -155,6 +162,8 @@ private:
   void*                Target{};    ///< RevRmtMemOp: Target register pointer
   std::vector<uint8_t> Membuf{};    ///< RevRmtMemOp: Buffer
   RmtMemReq            ProcReq{};   ///< RevRmtMemOp: remote memory request from RevProc
+
+  uint64_t Counter = _INVALID_ADDR_;  ///< RevRmtMemOp: local completion counter of a split-phase get
 };
 
 // xBGAS memory local load records
@@ -220,6 +229,71 @@ struct LocalLoadRecord {
       Target( T ), Buffer( B ), Op( O ), ReqPurp( P ) {}
 };
 
+// xBGAS segmented bulk transfer record. Large bulk transfers are read from
+// local memory one segment at a time and injected into the network under a
+// credit window; each SegACK returned by the receiver releases one credit.
+struct RmtSegXfer {
+  uint32_t              Id{};        // xBGAS NIC event ID of the transfer
+  uint32_t              SrcId{};     // xBGAS node that allocated the transfer ID
+  uint32_t              DestId{};    // xBGAS node receiving the segments
+  uint64_t              SrcAddr{};   // xBGAS local source address
+  uint64_t              DestAddr{};  // xBGAS remote destination address
+  size_t                Size{};      // xBGAS size of each element
+  uint32_t              Nelem{};     // xBGAS total number of elements
+  RevFlag               Flags{};     // xBGAS flag
+  void*                 Target{};    // xBGAS target pointer (bulk write completion)
+  uint8_t*              Buffer{};    // xBGAS staging buffer for the whole transfer
+  RmtMemOp              ReqPurp{};   // xBGAS BulkREADResp or BulkWRITERqst
+  uint32_t              SegNelem{};  // xBGAS number of elements in a full segment
+  uint32_t              SegSz{};     // xBGAS number of segments
+  uint32_t              NextLoad{};  // xBGAS next segment to read from local memory
+  uint32_t              NextSend{};  // xBGAS next segment to inject into the network
+  uint32_t              InFlight{};  // xBGAS segments sent but not yet acknowledged
+  uint32_t              Acked{};     // xBGAS segments acknowledged by the receiver
+  bool                  Pumping{};   // xBGAS guards against re-entrant progress
+  std::vector<uint32_t> Loaded{};    // xBGAS number of elements loaded per segment
+
+  /// RmtSegXfer: number of elements carried by segment Seg
+  uint32_t getSegNelem( uint32_t Seg ) const { return Seg == SegSz - 1 ? Nelem - Seg * SegNelem : SegNelem; }
+};
+
+// xBGAS remote AMO request waiting on a combined read-modify-write
+struct RmtAMOCombineOp {
+  uint32_t Id{};       // xBGAS NIC event ID of the request
+  uint32_t SrcId{};    // xBGAS requesting node
+  uint64_t Operand{};  // xBGAS AMO operand
+};
+
+// xBGAS remote AMO combining group. Commutative AMOs of the same kind and
+// size that target the same address are folded into a single local
+// read-modify-write; the individual old values are reconstructed in arrival
+// order when the combined operation completes.
+struct RmtAMOGroup {
+  RevFlag                      Flags{};    // xBGAS AMO flags shared by every request in the group
+  size_t                       Size{};     // xBGAS operand size
+  unsigned                     Hart{};     // xBGAS hart used for the local operation
+  uint64_t                     Opened{};   // xBGAS cycle at which the group was opened
+  uint64_t                     Operand{};  // xBGAS combined operand
+  uint64_t                     Old{};      // xBGAS value read by the combined operation
+  std::vector<RmtAMOCombineOp> Ops{};      // xBGAS requests in arrival order
+};
+
+// xBGAS split-phase get that has not yet incremented its completion counter.
+// The increment waits until every segment has arrived and local memory has
+// acknowledged every data write of the get.
+struct RmtCounterGet {
+  uint64_t Counter{};        // xBGAS local address of the completion counter
+  uint32_t PendingWrites{};  // xBGAS data writes not yet acknowledged by local memory
+  bool     Received{};       // xBGAS every segment of the get has arrived
+};
+
+// xBGAS completion counter increment in flight
+struct RmtCounterInc {
+  uint32_t Id{};          // xBGAS request ID of the get being counted
+  uint64_t Operand{ 1 };  // xBGAS AMO operand
+  uint64_t Old{};         // xBGAS value read by the AMO
+};
+
 // ----------------------------------------
 // RevRmtMemCtrl
 // ----------------------------------------
@@ -259,6 +333,9 @@ public:
   // RevRmtMemCtrl: determines if outstanding requests exist
   virtual uint64_t getTotalRqsts()        = 0;
 
+  /// RevRmtMemCtrl: no local or remote operation is queued, in flight or holding a lock (checkpoints)
+  virtual bool isQuiesced()               = 0;
+
   /// RevRmtMemCtrl: set the local memory object
   virtual void setMem( RevMem* mem )      = 0;
 
@@ -291,6 +368,11 @@ public:
     unsigned Hart, uint64_t Nmspace, uint64_t SrcAddr, size_t Size, uint32_t Nelem, uint64_t DestAddr, void* Target, RevFlag Flags
   ) = 0;
 
+  /// RevRmtMemCtrl: send a split-phase remote get that increments a local counter on completion
+  virtual bool sendRmtGetNBRqst(
+    unsigned Hart, uint64_t Nmspace, uint64_t SrcAddr, size_t Size, uint32_t Nelem, uint64_t DestAddr, uint64_t Counter
+  ) = 0;
+
   /// RevRmtMemCtrl: send a remote memory write request
   virtual bool
     sendRmtWriteRqst( unsigned Hart, uint64_t Nmspace, uint64_t DestAddr, size_t Size, uint8_t* Buffer, RevFlag Flags ) = 0;
@@ -362,6 +444,9 @@ public:
   /// RevRmtMemCtrl: handle a remote AMO response
   virtual void handleAMOResp( xbgasNicEvent* ev )                                                                       = 0;
 
+  /// RevRmtMemCtrl: handle a segment acknowledgement
+  virtual void handleSegACK( xbgasNicEvent* ev )                                                                        = 0;
+
   /// RevRmtMemCtrl: handle flags for read responses
   virtual void handleFlagResp( RevRmtMemOp* op )                                                                        = 0;
 
@@ -394,7 +479,11 @@ public:
     { "max_stores", "Set the maximum number of outstanding stores", "64" },
     { "max_readlock", "Set the maximum number of outstanding read locks", "64" },
     { "max_writeunlock", "Set the maximum number of outstanding write unlocks", "64" },
-    { "ops_per_cycle", "Set the maximum number of operations to issue per cycle", "2" }
+    { "ops_per_cycle", "Set the maximum number of operations to issue per cycle", "2" },
+    { "mtu", "Set the maximum payload of a single xBGAS packet in bytes; larger bulk transfers are segmented", "4096" },
+    { "seg_window", "Set the maximum number of unacknowledged segments in flight per bulk transfer", "8" },
+    { "amo_combine", "Combine commutative remote AMOs to the same address into a single local operation", "1" },
+    { "amo_combine_window", "Set the number of cycles a remote AMO waits for others to combine with; 0 issues immediately", "0" }
   )
 
   SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS( { "xbgasNicIface", "xBGAS Network interface to a network", "SST::RevCPU::xbgasNicAPI" } )
@@ -417,7 +506,12 @@ public:
     { "RmtAMOInFlight", "Counts the number of AMO requests in flight", "count", 1 },
     { "RmtAMOPending", "Counts the number of AMO requests pending", "count", 1 },
     { "RmtAMOBytes", "Counts the number of bytes of AMO requests", "bytes", 1 },
-    { "RmtFencePending", "Counts the number of FENCE requests pending", "count", 1 }
+    { "RmtFencePending", "Counts the number of FENCE requests pending", "count", 1 },
+    { "RmtSegsSent", "Counts the number of bulk transfer segments sent", "count", 1 },
+    { "RmtSegCreditStalls", "Counts the number of times a loaded segment waited for a transfer credit", "count", 1 },
+    { "RmtAMOCombined", "Counts the number of remote AMOs folded into another AMO's local operation", "count", 1 },
+    { "RmtAMOGroups", "Counts the number of local read-modify-write operations issued for remote AMOs", "count", 1 },
+    { "RmtGetNB", "Counts the number of split-phase remote gets issued", "count", 1 }
   )
 
   enum RmtMemCtrlStats : uint32_t {
@@ -437,6 +531,11 @@ public:
     RmtAMOPending          = 13,
     RmtAMOBytes            = 14,
     RmtFencePending        = 15,
+    RmtSegsSent            = 16,
+    RmtSegCreditStalls     = 17,
+    RmtAMOCombined         = 18,
+    RmtAMOGroups           = 19,
+    RmtGetNB               = 20,
   };
 
   /// RevBasicRmtMemCtrl: constructor
@@ -469,6 +568,9 @@ public:
   // RevBasicRmtMemCtrl: determines if outstanding requests exist
   uint64_t getTotalRqsts() { return num_read_rqst + num_write_rqst + num_read_lock_rqst + num_write_unlock_rqst; };
 
+  /// RevBasicRmtMemCtrl: no local or remote operation is queued, in flight or holding a lock
+  bool isQuiesced() override;
+
   /// RevBasicRmtMemCtrl: xBGAS event processing handler
   // void processEvent( xbgasNicEvent *ev );
 
@@ -505,6 +607,11 @@ public:
     unsigned Hart, uint64_t Nmspace, uint64_t SrcAddr, size_t Size, uint32_t Nelem, uint64_t DestAddr, void* Target, RevFlag Flags
   ) override;
 
+  /// RevBasicRmtMemCtrl: send a split-phase remote get that increments a local counter on completion
+  bool sendRmtGetNBRqst(
+    unsigned Hart, uint64_t Nmspace, uint64_t SrcAddr, size_t Size, uint32_t Nelem, uint64_t DestAddr, uint64_t Counter
+  ) override;
+
   /// RevBasicRmtMemCtrl: send a remote memory write request
   bool sendRmtWriteRqst( unsigned Hart, uint64_t Nmspace, uint64_t DestAddr, size_t Size, uint8_t* Buffer, RevFlag Flags ) override;
 
@@ -576,6 +683,9 @@ public:
   /// RevBasicRmtMemCtrl: handle a remote AMO response
   void handleAMOResp( xbgasNicEvent* ev ) override;
 
+  /// RevBasicRmtMemCtrl: handle a segment acknowledgement
+  void handleSegACK( xbgasNicEvent* ev ) override;
+
   /// RevBasicRmtMemCtrl: handle flags for read responses
   void handleFlagResp( RevRmtMemOp* op ) override { RevHandleFlagResp( op->getTarget(), op->getSize(), op->getFlags() ); }
 
@@ -626,6 +736,51 @@ private:
   /// RevBasicRmtMemCtrl: function to mark a local load as complete
   void MarkLocalLoadComplete( const MemReq& Req );
 
+  /// RevBasicRmtMemCtrl: signal the completion of a bulk read to the requesting hart
+  void completeBulkRead( RevRmtMemOp* Op, uint32_t Id );
+
+  /// RevBasicRmtMemCtrl: function to mark a data write of a split-phase get as complete
+  void MarkCounterWriteComplete( const MemReq& Req );
+
+  /// RevBasicRmtMemCtrl: queue the counter increment of a split-phase get whose data is in memory
+  void queueCounterInc( uint32_t Id );
+
+  /// RevBasicRmtMemCtrl: issue the next queued increment of a completion counter
+  void issueCounterInc( uint64_t Counter );
+
+  /// RevBasicRmtMemCtrl: function to mark a completion counter increment as complete
+  void MarkCounterIncComplete( const MemReq& Req );
+
+  /// RevBasicRmtMemCtrl: determine if a bulk transfer must be segmented
+  bool isSegmented( size_t Size, uint32_t Nelem ) const { return Size * Nelem > mtu; }
+
+  /// RevBasicRmtMemCtrl: start a segmented bulk transfer
+  void startSegXfer( RmtSegXfer&& Xfer );
+
+  /// RevBasicRmtMemCtrl: issue local reads and send segments as credits allow
+  void pumpSegXfer( uint64_t Key );
+
+  /// RevBasicRmtMemCtrl: send a single segment of a bulk transfer
+  void sendSegment( RmtSegXfer& Xfer, uint32_t Seg );
+
+  /// RevBasicRmtMemCtrl: function to mark a local load of a segment as complete
+  void MarkSegLoadComplete( const MemReq& Req );
+
+  /// RevBasicRmtMemCtrl: determine if an AMO may be combined with others of the same kind
+  static bool isCombinableAMO( RevFlag Flags );
+
+  /// RevBasicRmtMemCtrl: fold Operand into the running operand of a combining group
+  static void foldAMO( RevFlag Flags, size_t Size, uint64_t& Acc, uint64_t Operand );
+
+  /// RevBasicRmtMemCtrl: issue the next pending AMO group for an address
+  void issueAMOGroup( uint64_t Addr );
+
+  /// RevBasicRmtMemCtrl: issue AMO groups whose combining window has expired
+  void progressAMOGroups();
+
+  /// RevBasicRmtMemCtrl: function to mark a combined AMO as complete
+  void MarkAMOGroupComplete( const MemReq& Req );
+
   // -- private data members;
   RevMem*                      Mem{};       ///< RevBasicRmtMemCtrl: pointer to the memory object
   xbgasNicAPI*                 xbgasNic{};  ///< RevBasicRmtMemCtrl: xBGAS NIC interface
@@ -641,6 +796,11 @@ private:
   unsigned max_readlock{};     ///< RevBasicRmtMemCtrl: maximum number of outstanding read locks
   unsigned max_writeunlock{};  ///< RevBasicRmtMemCtrl: maximum number of outstanding write unlocks
   unsigned max_ops{};          ///< RevBasicRmtMemCtrl: maximum number of operations per cycle
+  unsigned mtu{};              ///< RevBasicRmtMemCtrl: maximum payload of a single packet in bytes
+  unsigned seg_window{};       ///< RevBasicRmtMemCtrl: maximum number of unacknowledged segments per transfer
+  bool     amo_combine{};      ///< RevBasicRmtMemCtrl: combine commutative remote AMOs to the same address
+  unsigned amo_window{};       ///< RevBasicRmtMemCtrl: cycles a remote AMO group stays open for combining
+  uint64_t currentCycle{};     ///< RevBasicRmtMemCtrl: current clock cycle
 
   uint64_t num_read_rqst{};          ///< RevBasicRmtMemCtrl: number of remote read requests
   uint64_t num_write_rqst{};         ///< RevBasicRmtMemCtrl: number of remote write requests
@@ -657,7 +817,13 @@ private:
   std::unordered_map<uint64_t, LocalLoadRecord> LocalLoadTrack{
   };  ///< RevBasicRmtMemCtrl: the association between hashed id and local load record
   std::unordered_map<uint64_t, uint32_t> LocalLoadCount{};  ///< RevBasicRmtMemCtrl: the number of local load operations
-  std::unordered_map<uint64_t, uint32_t> PacketSegCount{};  ///< RevBasicRmtMemCtrl: the number of segments for a packet
+  std::unordered_map<uint64_t, uint32_t> PacketSegCount{};  ///< RevBasicRmtMemCtrl: received segments keyed by (source, id)
+  std::unordered_map<uint64_t, RmtSegXfer> SegXferTrack{};  ///< RevBasicRmtMemCtrl: outgoing segmented transfers
+  std::unordered_map<uint64_t, std::deque<RmtAMOGroup>> AMOPending{};      ///< RevBasicRmtMemCtrl: queued AMO groups per address
+  std::unordered_map<uint64_t, RmtAMOGroup>             AMOActive{};       ///< RevBasicRmtMemCtrl: in-flight AMO group per address
+  std::unordered_map<uint32_t, RmtCounterGet>           CounterGets{};     ///< RevBasicRmtMemCtrl: split-phase gets by request id
+  std::unordered_map<uint64_t, std::deque<uint32_t>>    CounterPending{};  ///< RevBasicRmtMemCtrl: queued increments per counter
+  std::unordered_map<uint64_t, RmtCounterInc>           CounterActive{};   ///< RevBasicRmtMemCtrl: in-flight increment per counter
 
   std::vector<std::pair<uint64_t, size_t>> RmtLRSC{};  ///< RevBasicRmtMemCtrl: remote load-reserve/store-conditional container
   std::vector<xbgasNicEvent*>              PendingRmtLRSC{};  ///< RevBasicRmtMemCtrl: remote memory events container
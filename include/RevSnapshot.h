@@ -0,0 +1,195 @@
+//
+// _RevSnapshot_h_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVSNAPSHOT_H_
+#define _SST_REVCPU_REVSNAPSHOT_H_
+
+// -- Standard Headers
+#include <cinttypes>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// -- SST Headers
+#include "SST.h"
+
+namespace SST::RevCPU {
+
+/// RevSnapshot: file signature and format version
+constexpr char     REV_SNAPSHOT_MAGIC[8] = { 'R', 'E', 'V', 'S', 'N', 'A', 'P', '\0' };
+constexpr uint32_t REV_SNAPSHOT_VERSION  = 3;
+
+/// RevSnapshot: section tags
+constexpr uint32_t REV_SNAPSHOT_TAG_CPU   = 0x20555043;  ///< RevSnapshot: "CPU "
+constexpr uint32_t REV_SNAPSHOT_TAG_MEM   = 0x204d454d;  ///< RevSnapshot: "MEM "
+constexpr uint32_t REV_SNAPSHOT_TAG_PAGES = 0x53454750;  ///< RevSnapshot: "PGES"
+constexpr uint32_t REV_SNAPSHOT_TAG_ELF   = 0x20464c45;  ///< RevSnapshot: "ELF "
+constexpr uint32_t REV_SNAPSHOT_TAG_RUN   = 0x204e5552;  ///< RevSnapshot: "RUN " (checkpoints only)
+constexpr uint32_t REV_SNAPSHOT_TAG_CORE  = 0x45524f43;  ///< RevSnapshot: "CORE" (checkpoints only)
+
+/// RevSnapshotOut: binary snapshot writer; values are written in host byte order
+class RevSnapshotOut {
+public:
+  /// RevSnapshotOut: create the file and write the header
+  RevSnapshotOut( const std::string& Path, SST::Output* Output ) : path( Path ), output( Output ) {
+    os.open( Path, std::ios::binary | std::ios::trunc );
+    if( !os )
+      output->fatal( CALL_INFO, -1, "Error: could not create snapshot %s\n", Path.c_str() );
+    Write( REV_SNAPSHOT_MAGIC, sizeof( REV_SNAPSHOT_MAGIC ) );
+    Put( REV_SNAPSHOT_VERSION );
+  }
+
+  /// RevSnapshotOut: disallow copying and assignment
+  RevSnapshotOut( const RevSnapshotOut& )            = delete;
+  RevSnapshotOut& operator=( const RevSnapshotOut& ) = delete;
+
+  /// RevSnapshotOut: write raw bytes
+  void Write( const void* Data, size_t Len ) {
+    if( !os.write( static_cast<const char*>( Data ), std::streamsize( Len ) ) )
+      output->fatal( CALL_INFO, -1, "Error: failed writing snapshot %s\n", path.c_str() );
+  }
+
+  /// RevSnapshotOut: write a trivially copyable value
+  template<typename T>
+  void Put( const T& Val ) {
+    static_assert( std::is_trivially_copyable_v<T> );
+    Write( &Val, sizeof( T ) );
+  }
+
+  /// RevSnapshotOut: write a string
+  void Put( const std::string& Str ) {
+    Put( uint64_t( Str.size() ) );
+    Write( Str.data(), Str.size() );
+  }
+
+  /// RevSnapshotOut: write a vector
+  template<typename T>
+  void Put( const std::vector<T>& Vec ) {
+    Put( uint64_t( Vec.size() ) );
+    for( const auto& Val : Vec )
+      Put( Val );
+  }
+
+  /// RevSnapshotOut: write a map
+  template<typename K, typename V>
+  void Put( const std::map<K, V>& Map ) {
+    Put( uint64_t( Map.size() ) );
+    for( const auto& [Key, Val] : Map ) {
+      Put( Key );
+      Put( Val );
+    }
+  }
+
+  /// RevSnapshotOut: flush the file and report write errors
+  void Close() {
+    os.close();
+    if( !os )
+      output->fatal( CALL_INFO, -1, "Error: failed writing snapshot %s\n", path.c_str() );
+  }
+
+private:
+  std::ofstream os{};      ///< RevSnapshotOut: snapshot file
+  std::string   path;      ///< RevSnapshotOut: snapshot file name
+  SST::Output*  output{};  ///< RevSnapshotOut: output handler
+};  // class RevSnapshotOut
+
+/// RevSnapshotIn: binary snapshot reader
+class RevSnapshotIn {
+public:
+  /// RevSnapshotIn: open the file and check the header
+  RevSnapshotIn( const std::string& Path, SST::Output* Output ) : path( Path ), output( Output ) {
+    is.open( Path, std::ios::binary );
+    if( !is )
+      output->fatal( CALL_INFO, -1, "Error: could not open snapshot %s\n", Path.c_str() );
+    char     Magic[sizeof( REV_SNAPSHOT_MAGIC )];
+    uint32_t Version;
+    Read( Magic, sizeof( Magic ) );
+    Get( Version );
+    if( memcmp( Magic, REV_SNAPSHOT_MAGIC, sizeof( Magic ) ) || Version != REV_SNAPSHOT_VERSION )
+      output->fatal( CALL_INFO, -1, "Error: %s is not a version %" PRIu32 " snapshot\n", Path.c_str(), REV_SNAPSHOT_VERSION );
+  }
+
+  /// RevSnapshotIn: disallow copying and assignment
+  RevSnapshotIn( const RevSnapshotIn& )            = delete;
+  RevSnapshotIn& operator=( const RevSnapshotIn& ) = delete;
+
+  /// RevSnapshotIn: read raw bytes
+  void Read( void* Data, size_t Len ) {
+    if( !is.read( static_cast<char*>( Data ), std::streamsize( Len ) ) )
+      output->fatal( CALL_INFO, -1, "Error: snapshot %s is truncated\n", path.c_str() );
+  }
+
+  /// RevSnapshotIn: read a trivially copyable value
+  template<typename T>
+  void Get( T& Val ) {
+    static_assert( std::is_trivially_copyable_v<T> );
+    Read( &Val, sizeof( T ) );
+  }
+
+  /// RevSnapshotIn: read a string
+  void Get( std::string& Str ) {
+    uint64_t Len;
+    Get( Len );
+    Str.resize( Len );
+    Read( Str.data(), Len );
+  }
+
+  /// RevSnapshotIn: read a vector
+  template<typename T>
+  void Get( std::vector<T>& Vec ) {
+    uint64_t Len;
+    Get( Len );
+    Vec.resize( Len );
+    for( auto& Val : Vec )
+      Get( Val );
+  }
+
+  /// RevSnapshotIn: read a map
+  template<typename K, typename V>
+  void Get( std::map<K, V>& Map ) {
+    uint64_t Len;
+    Get( Len );
+    Map.clear();
+    while( Len-- ) {
+      K Key;
+      V Val;
+      Get( Key );
+      Get( Val );
+      Map.emplace( std::move( Key ), std::move( Val ) );
+    }
+  }
+
+  /// RevSnapshotIn: check that the next section is 'Tag'
+  void Expect( uint32_t Tag, const char* Name ) {
+    uint32_t Found;
+    Get( Found );
+    if( Found != Tag )
+      output->fatal( CALL_INFO, -1, "Error: snapshot %s has no %s section where expected\n", path.c_str(), Name );
+  }
+
+  /// RevSnapshotIn: output handler for reporting mismatches
+  SST::Output* GetOutput() const { return output; }
+
+  /// RevSnapshotIn: snapshot file name
+  const std::string& GetPath() const { return path; }
+
+private:
+  std::ifstream is{};      ///< RevSnapshotIn: snapshot file
+  std::string   path;      ///< RevSnapshotIn: snapshot file name
+  SST::Output*  output{};  ///< RevSnapshotIn: output handler
+};  // class RevSnapshotIn
+
+}  // namespace SST::RevCPU
+
+#endif  // _SST_REVCPU_REVSNAPSHOT_H_
@@ -18,29 +18,65 @@
 // -- Standard Headers
 #include <array>
 #include <string>
+#include <utility>
+#include <vector>
 
 // -- RevCPU Headers
 #include "RevCommon.h"
+#include "RevMemDump.h"
 
 namespace SST::RevCPU {
 
+class RevCore;
+
 enum class EcallStatus {
   SUCCESS,
   CONTINUE,
   ERROR,
 };
 
+// Futex operations (linux/futex.h)
+constexpr int REV_FUTEX_WAIT        = 0;
+constexpr int REV_FUTEX_WAKE        = 1;
+constexpr int REV_FUTEX_WAIT_BITSET = 9;
+constexpr int REV_FUTEX_WAKE_BITSET = 10;
+constexpr int REV_FUTEX_CMD_MASK    = 0x7f;  // clears FUTEX_PRIVATE_FLAG and FUTEX_CLOCK_REALTIME
+
+// clock_nanosleep flag: the request is an absolute time
+constexpr int REV_TIMER_ABSTIME = 1;
+
+// mmap and msync flags (asm-generic/mman-common.h)
+constexpr int REV_PROT_WRITE    = 0x2;
+constexpr int REV_MAP_SHARED    = 0x01;
+constexpr int REV_MAP_PRIVATE   = 0x02;
+constexpr int REV_MAP_FIXED     = 0x10;
+constexpr int REV_MAP_ANONYMOUS = 0x20;
+constexpr int REV_MS_SYNC       = 4;
+
+// Chunks of an ECALL memory transfer kept in flight at once
+constexpr size_t REV_ECALL_MAX_INFLIGHT = 32;
+
 // State information for ECALLs
 struct EcallState {
-  std::array<char, 64> buf{};
-  std::string          string{};
-  std::string          path_string{};
-  size_t               bytesRead{};
+  std::array<char, 64>                       buf{};
+  std::string                                string{};
+  std::string                                path_string{};
+  size_t                                     bytesRead{};
+  uint64_t                                   waitSeq{};  // futex: wake count of the address when its value was read
+  std::vector<std::pair<uint64_t, uint64_t>> iov{};      // guest struct iovec array: base and length
+  std::vector<RevMemDumpSection>             dump{};     // dump_valid_mem and dump_thread_mem: sections to dump
+  EcallStatus ( RevCore::*handler )(){};                 // handler resolved on the first cycle of the ECALL
+  unsigned                                   slot{};     // statistics slot of the ECALL code
+  uint64_t                                   start{};    // core cycle at which the ECALL was resolved
 
   void clear() {
     string.clear();
     path_string.clear();
     bytesRead = 0;
+    waitSeq   = 0;
+    iov.clear();
+    dump.clear();
+    handler = nullptr;
   }
 
   explicit EcallState() = default;
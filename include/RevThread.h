@@ -25,6 +25,8 @@
 
 namespace SST::RevCPU {
 
+class RevCore;
+
 class RevThread {
 public:
   using RevVirtRegState = RevRegFile;
@@ -105,6 +107,55 @@ public:
   ///< RevThread: Remove a child thread ID from this thread
   void RemoveChildID( uint32_t tid ) { ChildrenIDs.erase( tid ); }
 
+  ///< RevThread: Add cycles this thread spent assigned to a hart
+  void AddRuntime( uint64_t Cycles ) { Runtime += Cycles; }
+
+  ///< RevThread: Get the cycles this thread spent assigned to a hart
+  uint64_t GetRuntime() const { return Runtime; }
+
+  ///< RevThread: Count a preemption of this thread
+  void AddContextSwitch() { ContextSwitches++; }
+
+  ///< RevThread: Get the number of times this thread was preempted
+  uint64_t GetContextSwitches() const { return ContextSwitches; }
+
+  ///< RevThread: Get the core this thread last ran on (_REV_INVALID_CORE_ID_ if it never ran)
+  unsigned GetLastCore() const { return LastCore; }
+
+  ///< RevThread: Set the core this thread last ran on
+  void SetLastCore( unsigned Core ) { LastCore = Core; }
+
+  ///< RevThread: Get the order in which this thread became ready
+  uint64_t GetReadySeq() const { return ReadySeq; }
+
+  ///< RevThread: Set the order in which this thread became ready
+  void SetReadySeq( uint64_t Seq ) { ReadySeq = Seq; }
+
+  ///< RevThread: Get the futex address this thread waits on (_INVALID_ADDR_ if none)
+  uint64_t GetFutexAddr() const { return FutexAddr; }
+
+  ///< RevThread: Get the number of wakes its futex address had seen when the thread read its value
+  uint64_t GetFutexSeq() const { return FutexSeq; }
+
+  ///< RevThread: Set the futex address this thread waits on and the wake count read with it
+  void SetFutexWait( uint64_t Addr, uint64_t Seq ) {
+    FutexAddr = Addr;
+    FutexSeq  = Seq;
+  }
+
+  ///< RevThread: Get the cycle at which a sleeping or timed waiting thread wakes (0 if none)
+  uint64_t GetWakeCycle() const { return WakeCycle; }
+
+  ///< RevThread: Set the cycle at which a sleeping or timed waiting thread wakes
+  void SetWakeCycle( uint64_t Cycle ) { WakeCycle = Cycle; }
+
+  ///< RevThread: Write this thread and its register state to a checkpoint
+  void SaveSnapshot( RevSnapshotOut& Snap ) const;
+
+  ///< RevThread: Restore a thread written by SaveSnapshot; its register file is bound to the same core of Procs
+  static std::unique_ptr<RevThread>
+    LoadSnapshot( RevSnapshotIn& Snap, RevMem* Mem, const std::vector<std::unique_ptr<RevCore>>& Procs );
+
   ///< RevThread: Overload the ostream printing
   friend std::ostream& operator<<( std::ostream& os, const RevThread& Thread );
 
@@ -131,6 +182,14 @@ private:
   ///< RevThread: ID of the thread this thread is waiting to join
   uint32_t WaitingToJoinTID = _INVALID_TID_;
 
+  uint64_t Runtime{};                         // Cycles assigned to a hart
+  uint64_t ContextSwitches{};                 // Number of preemptions
+  unsigned LastCore = _REV_INVALID_CORE_ID_;  // Core this thread last ran on
+  uint64_t ReadySeq{};                        // Ready queue order
+  uint64_t FutexAddr = _INVALID_ADDR_;        // Futex address this thread waits on
+  uint64_t FutexSeq{};                        // Futex wake count when the value was read
+  uint64_t WakeCycle{};                       // Wake up cycle when sleeping
+
 };  // class RevThread
 
 }  // namespace SST::RevCPU
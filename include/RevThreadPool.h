@@ -0,0 +1,72 @@
+//
+// _RevThreadPool_h_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVTHREADPOOL_H_
+#define _SST_REVCPU_REVTHREADPOOL_H_
+
+// -- Standard Headers
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SST::RevCPU {
+
+/// RevThreadPool: host threads that run the iterations of a loop; built for
+/// one short loop per simulated cycle, so idle workers spin briefly before
+/// they sleep
+class RevThreadPool {
+public:
+  /// RevThreadPool: start Threads - 1 workers; the thread calling Run is the last one
+  explicit RevThreadPool( unsigned Threads );
+
+  /// RevThreadPool: stop and join the workers
+  ~RevThreadPool();
+
+  /// RevThreadPool: disallow copying and assignment
+  RevThreadPool( const RevThreadPool& )            = delete;
+  RevThreadPool& operator=( const RevThreadPool& ) = delete;
+
+  /// RevThreadPool: number of threads that run iterations, including the caller of Run
+  unsigned GetThreads() const { return unsigned( workers.size() ) + 1; }
+
+  /// RevThreadPool: call Func( i ) for every i in [0, N) and return once every call has returned;
+  ///                the calls run in any order and on any thread
+  void Run( size_t N, const std::function<void( size_t )>& Func );
+
+private:
+  /// RevThreadPool: yields of an idle worker before it sleeps until the next Run
+  static constexpr unsigned SpinLimit = 4096;
+
+  std::vector<std::thread>             workers{};     ///< RevThreadPool: worker threads
+  std::mutex                           sleepMutex{};  ///< RevThreadPool: guards sleeping workers against a lost wake up
+  std::condition_variable              sleepCV{};     ///< RevThreadPool: wakes sleeping workers
+  const std::function<void( size_t )>* job{};         ///< RevThreadPool: loop body of the current Run
+  size_t                               jobSize{};     ///< RevThreadPool: iterations of the current Run
+  bool                                 stop{};        ///< RevThreadPool: workers exit at the next generation
+  std::atomic<size_t>                  next{};        ///< RevThreadPool: next iteration to claim
+  std::atomic<size_t>                  done{};        ///< RevThreadPool: iterations completed
+  std::atomic<uint64_t>                generation{};  ///< RevThreadPool: odd while a Run is being published
+  std::atomic<unsigned>                active{};      ///< RevThreadPool: workers that may be reading the current Run
+
+  /// RevThreadPool: worker thread body
+  void WorkerLoop();
+
+  /// RevThreadPool: claim and run iterations until none are left
+  void Work();
+};  // class RevThreadPool
+
+}  // namespace SST::RevCPU
+
+#endif
@@ -16,13 +16,22 @@
 #include "SST.h"
 
 // -- Standard Headers
+#include <atomic>
 #include <cstdint>
+#include <cstdio>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <ostream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
+#ifdef REV_TRACE_ZSTD
+#include <zstd.h>
+#endif
+
 // -- Rev Headers
 #include "RevCommon.h"
 
@@ -123,12 +132,13 @@ union TraceEvents_t {
 };
 
 enum TraceKeyword_t {
-  RegRead,       // register read (non-fp)
-  RegWrite,      // register write (non-fp)
-  MemLoad,       // issue load request (simple mem)
-  MemStore,      // issue store request (simple mem)
-  MemhSendLoad,  // issue load request (memh)
-  PcWrite,       // write program counter
+  RegRead,        // register read (non-fp)
+  RegWrite,       // register write (non-fp)
+  MemLoad,        // issue load request (simple mem)
+  MemStore,       // issue store request (simple mem)
+  MemhSendLoad,   // issue load request (memh)
+  PcWrite,        // write program counter
+  MemCompletion,  // load data returning to a register (memh, binary trace only)
 };
 
 // Generic record so we can preserve code ordering of events in trace
@@ -183,6 +193,113 @@ struct CompletionRec_t {
   }
 };
 
+// Captured state of one Render call. With asynchronous output these are the
+// ring entries consumed by the writer thread; the record vectors are swapped
+// with the tracer capture buffers so their storage is recycled.
+struct TraceSlot_t {
+  uint64_t                     cycle{};     // core cycle of the Render call
+  uint64_t                     pc{};        // instruction address
+  uint32_t                     insn{};      // instruction word
+  unsigned                     id{};        // core id
+  unsigned                     hart{};      // hart id
+  unsigned                     tid{};       // thread id
+  std::string                  mnemonic{};  // fallback disassembly
+  TraceEvents_t                events{};    // flow control events
+  bool                         enabled{};   // trace output state after the user controls
+  bool                         inst{};      // an instruction line is rendered
+  std::vector<TraceRec_t>      recs{};      // instruction effects
+  std::vector<CompletionRec_t> comps{};     // memory completions
+};
+
+// Binary trace format
+// A binary trace is one file per core starting with a TraceBinFileHdr_t and
+// the tracer name, followed by a stream of records. Each record starts with
+// a TraceBinHdr_t. Inst and Completion records are followed by 'nrecs'
+// TraceBinRec_t effect records; String and Symbol records are followed by
+// 'insn' bytes of text. When compressed, the whole file is a zstd stream.
+// scripts/rev-trace-decode.py renders a binary trace in the text format.
+constexpr char     TRC_BIN_MAGIC[8]    = { 'R', 'E', 'V', 'T', 'R', 'C', 'B', '1' };
+constexpr uint32_t TRC_BIN_VERSION     = 1;
+constexpr uint32_t TRC_BIN_SPIKE_REGS  = 0x1;  // register names use the spike ABI names
+constexpr size_t   TRC_BIN_BUFFER_SIZE = 1 << 20;
+
+enum class TraceBinKind : uint8_t {
+  Inst       = 1,  // executed instruction (*I)
+  Completion = 2,  // asynchronous load completion (*A)
+  String     = 3,  // disassembly text for string id 'str'
+  Symbol     = 4,  // ELF symbol at address 'pcDelta'
+};
+
+struct TraceBinFileHdr_t {
+  char     magic[8];  // TRC_BIN_MAGIC
+  uint32_t version;   // TRC_BIN_VERSION
+  uint32_t core;      // core id
+  uint32_t flags;     // TRC_BIN_* flags
+  uint32_t nameLen;   // length of the tracer name that follows
+};
+
+static_assert( sizeof( TraceBinFileHdr_t ) == 24, "TraceBinFileHdr_t must be 24 bytes" );
+
+struct TraceBinHdr_t {
+  uint8_t  kind;        // TraceBinKind
+  uint8_t  event;       // trace control event character or 0
+  uint16_t nrecs;       // effect records that follow
+  uint32_t insn;        // instruction word; text length for String and Symbol
+  uint32_t hart;        // hart id
+  uint32_t tid;         // thread id
+  uint32_t str;         // string id of the disassembly
+  uint32_t rsvd;        // reserved
+  uint64_t cycleDelta;  // cycles since the previous Inst or Completion record
+  uint64_t pcDelta;     // pc minus the previous pc (mod 2^64); address for Symbol
+};
+
+static_assert( sizeof( TraceBinHdr_t ) == 40, "TraceBinHdr_t must be 40 bytes" );
+
+struct TraceBinRec_t {
+  uint16_t key;  // TraceKeyword_t
+  uint16_t reg;  // register number
+  uint32_t len;  // memory access length
+  uint64_t a;    // register value or memory address
+  uint64_t b;    // memory data (limited to 8 bytes)
+};
+
+static_assert( sizeof( TraceBinRec_t ) == 24, "TraceBinRec_t must be 24 bytes" );
+
+class RevTraceBinWriter {
+public:
+  /// RevTraceBinWriter: open a binary trace file, optionally zstd compressed
+  RevTraceBinWriter( const std::string& path, bool compress );
+  /// RevTraceBinWriter: flush remaining records and close the file
+  ~RevTraceBinWriter();
+
+  /// RevTraceBinWriter: determine whether the file was opened
+  bool IsOpen() const { return file != nullptr; }
+  /// RevTraceBinWriter: determine whether compression support was compiled in
+  static bool HasCompression();
+
+  /// RevTraceBinWriter: append raw bytes to the trace
+  void Write( const void* data, size_t len ) {
+    if( buf.size() + len > TRC_BIN_BUFFER_SIZE )
+      Flush( false );
+    const uint8_t* p = static_cast<const uint8_t*>( data );
+    buf.insert( buf.end(), p, p + len );
+  }
+
+  /// RevTraceBinWriter: write buffered bytes to the file; 'end' closes the compressed frame
+  void Flush( bool end );
+
+private:
+  FILE*                file{};  ///< RevTraceBinWriter: output file
+  std::vector<uint8_t> buf{};   ///< RevTraceBinWriter: pending bytes
+#ifdef REV_TRACE_ZSTD
+  ZSTD_CCtx*           cctx{};  ///< RevTraceBinWriter: compression context
+  std::vector<uint8_t> zbuf{};  ///< RevTraceBinWriter: compressed output staging
+#endif
+  /// RevTraceBinWriter: Disallow copying and assignment
+  RevTraceBinWriter( const RevTraceBinWriter& )            = delete;
+  RevTraceBinWriter& operator=( const RevTraceBinWriter& ) = delete;
+};  // class RevTraceBinWriter
+
 class RevTracer {
 public:
   /// RevTracer: standard constructor standard constructor
@@ -193,11 +310,25 @@ public:
   /// RevTracer: assign disassembler. Returns 0 if successful
   int SetDisassembler( std::string machine );
   /// RevTracer: assign trace symbol lookup map
-  void SetTraceSymbols( std::map<uint64_t, std::string>* TraceSymbols );
+  void SetTraceSymbols( const std::map<uint64_t, std::string>* TraceSymbols );
   /// RevTracer: assign cycle where trace will start (user param)
   void SetStartCycle( uint64_t c );
   /// RevTracer: assign maximum output lines (user param)
   void SetCycleLimit( uint64_t c );
+  /// RevTracer: trace 1 of every 'every' instructions and/or the first 'window' instructions of every 'period' cycles
+  void SetSampling( uint64_t every, uint64_t window, uint64_t period );
+  /// RevTracer: add a function to the region of interest. Returns 0 if the symbol was found
+  int SetROI( const std::string& func );
+  /// RevTracer: trace only the listed harts (empty for all)
+  void SetHartFilter( const std::vector<unsigned>& harts ) { hartFilter = harts; }
+  /// RevTracer: trace only the listed thread ids (empty for all)
+  void SetThreadFilter( const std::vector<unsigned>& tids ) { threadFilter = tids; }
+  /// RevTracer: write binary records to 'path' instead of text. Returns 0 if successful
+  int SetBinaryOutput( const std::string& path, unsigned core, bool compress );
+  /// RevTracer: format and write records on a writer thread fed by a ring of 'slots' entries. Returns 0 if successful
+  int SetAsyncOutput( size_t slots, bool drop );
+  /// RevTracer: drain the ring, stop the writer thread, flush the output and report ring statistics
+  void Finish();
   /// RevTracer:assign instruction used for trace controls
   void SetCmdTemplate( std::string cmd );
   /// RevTracer: capture instruction to be traced
@@ -260,7 +391,7 @@ private:
   /// RevTracer: saved instruction
   uint32_t insn{};
   /// RevTracer: map of instruction addresses to symbols
-  std::map<uint64_t, std::string>* traceSymbols{};
+  const std::map<uint64_t, std::string>* traceSymbols{};
   /// RevTracer: Array of supported "NOP" instructions avaible for trace controls
   uint32_t nops[NOP_COUNT]{};
   /// RevTracer: Check current state against user settings and update state
@@ -271,8 +402,32 @@ private:
   std::string fmt_reg( uint8_t r );
   /// RevTracer: Format data associated with memory access
   std::string fmt_data( unsigned len, uint64_t data );
+  /// RevTracer: Move the capture buffers into a slot
+  void Capture( TraceSlot_t& slot, uint64_t cycle, bool inst, bool comps );
+  /// RevTracer: Render a slot as text or binary records
+  void Emit( const TraceSlot_t& slot );
+  /// RevTracer: Print one text trace line
+  void EmitLine( uint64_t cycle, const std::string& line );
   /// RevTracer: Generate string from captured state
-  std::string RenderExec( const std::string& fallbackMnemonic );
+  std::string RenderExec( const TraceSlot_t& slot );
+  /// RevTracer: Write captured memory completions as binary records
+  void RenderBinCompletions( const TraceSlot_t& slot );
+  /// RevTracer: Write captured instruction state as binary records
+  void RenderBinExec( const TraceSlot_t& slot );
+  /// RevTracer: Get the string id of a disassembly, emitting its text on first use
+  uint32_t BinDisasmId( uint32_t insn, const std::string& fallbackMnemonic );
+  /// RevTracer: Emit a String or Symbol record
+  void BinText( TraceBinKind kind, uint32_t id, uint64_t addr, const std::string& text );
+  /// RevTracer: binary trace output (null for text output)
+  std::unique_ptr<RevTraceBinWriter> binWriter{};
+  /// RevTracer: binary string ids keyed by mnemonic
+  std::unordered_map<std::string, uint32_t> binStrings{};
+  /// RevTracer: binary string ids keyed by instruction word (spike disassembly)
+  std::unordered_map<uint32_t, uint32_t> binInsnStrings{};
+  /// RevTracer: cycle of the previous binary record
+  uint64_t binCycle{};
+  /// RevTracer: pc of the previous binary instruction record
+  uint64_t binPC{};
   /// RevTracer: User setting: starting cycle of trace (overrides programmtic control)
   uint64_t startCycle = 0;
   /// RevTracer: User setting: maximum number of lines to print
@@ -287,6 +442,66 @@ private:
   uint64_t traceCycles{};
   /// RevTracer: Hard disable for output
   bool disabled{};
+
+  /// RevTracer: region of interest state of one hart
+  struct RoiHart_t {
+    uint64_t              prevPC{};   ///< RevTracer: previous instruction address
+    uint32_t              prevLen{};  ///< RevTracer: previous instruction length
+    std::vector<uint64_t> returns{};  ///< RevTracer: return addresses of the active ROI calls
+  };
+
+  /// RevTracer: Update the region of interest state with the current instruction
+  void TrackROI();
+  /// RevTracer: determine whether a hart passes the hart filter and region of interest
+  bool HartSelected( unsigned hart ) const;
+  /// RevTracer: apply the filters and sampling to the current instruction
+  bool InstSelected( uint64_t cycle );
+  /// RevTracer: ROI function entry addresses mapped to the next symbol address
+  std::unordered_map<uint64_t, uint64_t> roiFuncs{};
+  /// RevTracer: per hart region of interest state
+  std::vector<RoiHart_t> roiHarts{};
+  /// RevTracer: harts to trace (empty for all)
+  std::vector<unsigned> hartFilter{};
+  /// RevTracer: thread ids to trace (empty for all)
+  std::vector<unsigned> threadFilter{};
+  /// RevTracer: User setting: trace 1 of every N instructions
+  uint64_t sampleEvery{};
+  /// RevTracer: User setting: instructions traced at the start of each sample period
+  uint64_t sampleWindow{};
+  /// RevTracer: User setting: sample period in cycles
+  uint64_t samplePeriod{};
+  /// RevTracer: instructions considered for 1 in N sampling
+  uint64_t sampleCount{};
+  /// RevTracer: current sample period
+  uint64_t sampleIdx{};
+  /// RevTracer: instructions traced in the current sample period
+  uint64_t sampleWindowCount{};
+
+  /// RevTracer: Get the next free ring slot; null if the ring is full and records are dropped
+  TraceSlot_t* AcquireSlot();
+  /// RevTracer: Writer thread body
+  void WriterLoop();
+  /// RevTracer: slot rendered in place when output is synchronous
+  TraceSlot_t syncSlot{};
+  /// RevTracer: single-producer single-consumer ring of captured states
+  std::vector<TraceSlot_t> ring{};
+  /// RevTracer: slots published by Render (producer owned)
+  std::atomic<uint64_t> ringHead{};
+  /// RevTracer: slots consumed by the writer (consumer owned)
+  std::atomic<uint64_t> ringTail{};
+  /// RevTracer: set by Finish once the last slot has been published
+  std::atomic<bool> ringStop{};
+  /// RevTracer: drop records instead of blocking when the ring is full
+  bool ringDrop{};
+  /// RevTracer: Render calls that found the ring full and waited
+  uint64_t ringStalls{};
+  /// RevTracer: Render calls dropped because the ring was full
+  uint64_t ringDropped{};
+  /// RevTracer: highest ring occupancy seen by the producer
+  uint64_t ringHighWater{};
+  /// RevTracer: formats and writes ring slots
+  std::thread writer{};
+
   /// RevTracer: Disasllow copying and assignment
   RevTracer( const RevTracer& )            = delete;
   RevTracer& operator=( const RevTracer& ) = delete;
@@ -90,6 +90,12 @@ protected:
 public:
   /// RevZicntr: Increment the number of retired instructions
   void IncrementInstRet() { ++InstRet; }
+
+  /// RevZicntr: Get the number of retired instructions
+  uint64_t GetInstRet() const { return InstRet; }
+
+  /// RevZicntr: Set the number of retired instructions (checkpoint restore)
+  void SetInstRet( uint64_t Val ) { InstRet = Val; }
 };  // class RevZicntr
 
 }  // namespace SST::RevCPU
@@ -12,6 +12,9 @@
 #define _SST_XBGASNIC_H_
 
 // -- Standard Headers
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <queue>
 #include <string>
 #include <tuple>
@@ -26,24 +29,46 @@
 #include "../common/include/RevCommon.h"
 #include "RevMemCtrl.h"
 
+// Default MTU of a single xBGAS packet payload in bytes (see the "mtu" parameter
+// of RevBasicRmtMemCtrl); bulk transfers larger than this are segmented
 #define _MAX_PAYLOAD_ 4096
 
 namespace SST::RevCPU {
 
 using namespace SST::Interfaces;
 
+/**
+ * xbgasNicWireHdr : fixed layout header of a serialized xbgasNicEvent
+ *
+ * Every field of the event is packed into these seven words; the payload
+ * follows the header as a single raw block of DataLen bytes.
+ */
+struct xbgasNicWireHdr {
+  uint64_t SrcAddr;   ///< xbgasNicWireHdr: source address
+  uint64_t DestAddr;  ///< xbgasNicWireHdr: destination address
+  uint32_t Id;        ///< xbgasNicWireHdr: packet Id
+  uint32_t SrcId;     ///< xbgasNicWireHdr: source node Id
+  uint32_t Size;      ///< xbgasNicWireHdr: element size
+  uint32_t Nelem;     ///< xbgasNicWireHdr: number of elements
+  uint32_t SegSz;     ///< xbgasNicWireHdr: segment count
+  uint32_t Flags;     ///< xbgasNicWireHdr: memory request flags
+  uint32_t Hart;      ///< xbgasNicWireHdr: Hart ID
+  uint32_t DataLen;   ///< xbgasNicWireHdr: payload length in bytes
+  uint8_t  Opcode;    ///< xbgasNicWireHdr: remote memory operation code
+  uint8_t  isSeg;     ///< xbgasNicWireHdr: segmented packet flag
+  uint16_t Rsvd0;     ///< xbgasNicWireHdr: reserved
+  uint32_t Rsvd1;     ///< xbgasNicWireHdr: reserved
+};
+
+static_assert( sizeof( xbgasNicWireHdr ) == 7 * sizeof( uint64_t ) );
+
 /**
  * xbgasNicEvent : inherited class to handle the individual network events for XbgasNIC
  */
 class xbgasNicEvent : public SST::Event {
 public:
   /// xbgasNicEvent: standard constructor
-  xbgasNicEvent( std::string name )
-    : Event(), Id( 0 ), SrcName( name ), SrcId( 0 ), SrcAddr( 0 ), DestAddr( 0 ), Size( 0 ), Nelem( 0 ), Data(),
-      Opcode( RmtMemOp::Unknown ), Flags( RevFlag::F_NONE ), isSeg( false ), SegSz( 0 ) {}
-
-  /// xbgasNicEvent: secondary constructor
-  xbgasNicEvent() : Event() {}
+  xbgasNicEvent() : Event(), Opcode( RmtMemOp::Unknown ), Flags( RevFlag::F_NONE ) {}
 
   ~xbgasNicEvent() {}
 
@@ -83,6 +108,15 @@ public:
   /// xbgasNicEvent: retrieve the segment size
   size_t getSegSz() { return SegSz; }
 
+  /// xbgasNicEvent: retrieve the number of bytes the event occupies when serialized
+  size_t getWireSize() { return sizeof( xbgasNicWireHdr ) + Data.size(); }
+
+  /// xbgasNicEvent: determine whether every field and the payload equal those of Other
+  bool isEqual( const xbgasNicEvent& Other ) const;
+
+  /// xbgasNicEvent: allocate a new packet Id without building a packet
+  static uint32_t newID() { return main_id++; }
+
   /// xbgasNicEvent: set the Hart ID
   bool setHart( unsigned H ) {
     Hart = H;
@@ -173,7 +207,7 @@ public:
 
   /// xbgasNicEvent: build a WRITE request packet that is segmented
   bool buildSegBulkWRITERqst(
-    uint32_t SegId, uint64_t DestAddr, size_t Size, uint32_t Nelem, RevFlag Fl, uint32_t SegSz, uint8_t* Buffer
+    uint64_t Id, uint64_t DestAddr, size_t Size, uint32_t Nelem, RevFlag Fl, uint32_t SegSz, uint8_t* Buffer
   );
 
   /// xbgasNicEvent: build a WRITE UNLOCK request packet
@@ -211,6 +245,9 @@ public:
   // xbgasNicEvent: build a AMO response packet
   bool buildAMOResp( uint64_t Id, size_t Size, uint8_t* Buffer );
 
+  /// xbgasNicEvent: build a segment acknowledgement for the transfer (SrcId, Id)
+  bool buildSegACK( uint64_t Id, uint32_t SrcId );
+
   /// xbgasNicEvent: virtual function to clone an event
   virtual Event* clone( void ) override {
     xbgasNicEvent* ev = new xbgasNicEvent( *this );
@@ -220,7 +257,6 @@ public:
 protected:
   unsigned             Hart{};      ///< xbgasNicEvent: Hart ID
   uint32_t             Id{};        ///< xbgasNicEvent: Id for the packet
-  std::string          SrcName{};   ///< xbgasNicEvent: Name of the sending device
   uint32_t             SrcId{};     ///< xbgasNicEvent: Source node ID
   uint64_t             SrcAddr{};   ///< xbgasNicEvent: source address for read
   uint64_t             DestAddr{};  ///< xbgasNicEvent: destination address for write
@@ -235,23 +271,24 @@ protected:
 private:
   static std::atomic<uint32_t> main_id;  ///< xbgasNicEvent: main request id counter
 
+  /// xbgasNicEvent: fill the wire header from the event fields
+  void packHdr( xbgasNicWireHdr& Hdr );
+
+  /// xbgasNicEvent: restore the event fields from the wire header and size the payload
+  void unpackHdr( const xbgasNicWireHdr& Hdr );
+
 public:
-  /// xbgasNicEvent: event serializer
+  /// xbgasNicEvent: event serializer; packs the fixed header followed by the raw payload
   void serialize_order( SST::Core::Serialization::serializer& ser ) override {
     Event::serialize_order( ser );
-    ser & Hart;
-    ser & Id;
-    ser & SrcName;
-    ser & SrcId;
-    ser & SrcAddr;
-    ser & DestAddr;
-    ser & Size;
-    ser & Nelem;
-    ser & Data;
-    ser & Opcode;
-    ser & Flags;
-    ser & isSeg;
-    ser & SegSz;
+    xbgasNicWireHdr Hdr{};
+    if( ser.mode() != SST::Core::Serialization::serializer::UNPACK )
+      packHdr( Hdr );
+    ser.raw( &Hdr, sizeof( Hdr ) );
+    if( ser.mode() == SST::Core::Serialization::serializer::UNPACK )
+      unpackHdr( Hdr );
+    if( !Data.empty() )
+      ser.raw( Data.data(), Data.size() );
   }
 
   /// xbgasNicEvent: implements the NIC serialization
@@ -319,6 +356,7 @@ public:
     { "clock", "Clock frequency of the NIC", "1Ghz" },
     { "port", "Port to use, if loaded as an anonymous subcomponent", "network" },
     { "verbose", "Verbosity for output (0 = nothing)", "0" },
+    { "serialize_bench", "Events per case for the serialization benchmark run at setup (0 = disabled)", "0" },
   )
 
   // Register the ports
@@ -381,7 +419,12 @@ protected:
 
 private:
   std::vector<SST::Interfaces::SimpleNetwork::nid_t> xbgasHosts;  ///< XbgasNIC: xbgas hosts list
-};                                                                // end XbgasNIC
+
+  uint64_t serializeBench;  ///< XbgasNIC: events per case for the serialization benchmark
+
+  /// XbgasNIC: measure serialize/deserialize throughput for typical packet shapes
+  void runSerializeBench();
+};  // end XbgasNIC
 
 }  // namespace SST::RevCPU
 
@@ -94,7 +94,7 @@ class Xamo : public RevExt {
       }
     }
     // update the cost
-    R->cost += M->RandCost( F->GetMinCost(), F->GetMaxCost() );
+    R->cost += F->RandCost();
     R->AdvancePC( Inst );
     return true;
   }
@@ -55,7 +55,7 @@ class Xlrsc : public RevExt {
       M->RmtLR( F->GetHartToExecID(), nmspace, addr, sizeof( XLEN ), target, req, flags );
     }
 
-    R->cost += M->RandCost( F->GetMinCost(), F->GetMaxCost() );
+    R->cost += F->RandCost();
     R->AdvancePC( Inst );
     return true;
   }
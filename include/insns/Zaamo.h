@@ -52,7 +52,7 @@ class Zaamo : public RevExt {
       );
     }
     // update the cost
-    R->cost += M->RandCost( F->GetMinCost(), F->GetMaxCost() );
+    R->cost += F->RandCost();
     R->AdvancePC( Inst );
     return true;
   }
@@ -47,7 +47,7 @@ class Zalrsc : public RevExt {
 
     // Create a reservation and load the data
     M->LR( F->GetHartToExecID(), addr, sizeof( TYPE ), target, req, flags );
-    R->cost += M->RandCost( F->GetMinCost(), F->GetMaxCost() );
+    R->cost += F->RandCost();
     R->AdvancePC( Inst );
     return true;
   }
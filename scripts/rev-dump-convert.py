@@ -0,0 +1,129 @@
+#!/usr/bin/python3
+#
+# Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-dump-convert.py
+#
+# Intent: Render a binary Rev memory dump (memDumpFormat=binary) in the text
+# format written by memDumpFormat=text and the dump_* ECALLs. The file layout
+# is defined next to MemDumpFileHdr_t in include/RevMemDump.h.
+#
+# Compressed dumps (memDumpCompress=zstd) require the python 'zstandard' module.
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"REVMDMP1"
+VERSION = 1
+
+FILE_HDR = struct.Struct("<8sIIIIQ")
+SECT = struct.Struct("<QQII")
+CHUNK = struct.Struct("<QIIB7x")
+
+# MemDumpEnc
+ZERO, RAW, ZSTD = 0, 1, 2
+
+# bytes shown as themselves in the character column (std::isprint)
+PRINTABLE = bytes(b if 0x20 <= b < 0x7f else ord(".") for b in range(256))
+
+
+def read_exact(f, n):
+    buf = f.read(n)
+    if len(buf) != n:
+        sys.exit("error: dump is truncated")
+    return buf
+
+
+class Rows:
+    """Formats the bytes of one section as rows aligned to its base."""
+
+    def __init__(self, out, base, per_row):
+        self.out = out
+        self.addr = base
+        self.per_row = per_row
+        self.pending = bytearray()
+
+    def row(self, data):
+        text = bytes(data).hex(" ") + " " + "   " * (self.per_row - len(data))
+        chars = bytes(data).translate(PRINTABLE).decode("ascii")
+        self.out.write("0x%016x: %s %s\n" % (self.addr, text, chars))
+        self.addr += self.per_row
+
+    def add(self, data):
+        self.pending += data
+        whole = len(self.pending) - len(self.pending) % self.per_row
+        for i in range(0, whole, self.per_row):
+            self.row(self.pending[i:i + self.per_row])
+        del self.pending[:whole]
+
+    def finish(self):
+        if self.pending:
+            self.row(self.pending)
+
+
+def convert(f, out):
+    magic, version, page_size, per_row, title_len, nsects = FILE_HDR.unpack(read_exact(f, FILE_HDR.size))
+    if magic != MAGIC:
+        sys.exit("error: not a binary Rev memory dump")
+    if version != VERSION:
+        sys.exit("error: unsupported dump version %d" % version)
+    title = read_exact(f, title_len).decode(errors="replace")
+
+    sections = []
+    for _ in range(nsects):
+        base, size, label_len, _ = SECT.unpack(read_exact(f, SECT.size))
+        sections.append((base, size, read_exact(f, label_len).decode(errors="replace")))
+
+    zstd = None
+    if title:
+        out.write(title + "\n")
+    for base, size, label in sections:
+        if label:
+            out.write(label + "\n")
+        rows = Rows(out, base, per_row)
+        done = 0
+        while done < size:
+            addr, length, stored, enc = CHUNK.unpack(read_exact(f, CHUNK.size))
+            if addr != base + done or length > size - done:
+                sys.exit("error: chunk at 0x%x does not continue the section at 0x%x" % (addr, base))
+            data = read_exact(f, stored)
+            if enc == ZERO:
+                data = bytes(length)
+            elif enc == ZSTD:
+                if zstd is None:
+                    try:
+                        import zstandard
+                    except ImportError:
+                        sys.exit("error: dump has zstd chunks; install the python 'zstandard' module")
+                    zstd = zstandard.ZstdDecompressor()
+                data = zstd.decompress(data, max_output_size=length)
+            elif enc != RAW:
+                sys.exit("error: unknown chunk encoding %d" % enc)
+            if len(data) != length:
+                sys.exit("error: chunk at 0x%x holds %d of %d bytes" % (addr, len(data), length))
+            rows.add(data)
+            done += length
+        rows.finish()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Render a binary Rev memory dump as text")
+    parser.add_argument("dump", help="binary memory dump file")
+    parser.add_argument("-o", "--output", help="output file (default: stdout)")
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as f:
+        if args.output:
+            with open(args.output, "w") as out:
+                convert(f, out)
+        else:
+            convert(f, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,187 @@
+#!/usr/bin/python3
+#
+# Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-trace-decode.py
+#
+# Intent: Render a binary Rev trace (trcBinary=<prefix>) in the text format
+# produced by the tracer at verbosity 5. The record layout is defined next
+# to TraceBinHdr_t in include/RevTracer.h. The simulation time field of the
+# logging prefix is replaced by the core cycle.
+#
+# Compressed traces (trcCompress=zstd) require the python 'zstandard' module.
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"REVTRCB1"
+VERSION = 1
+SPIKE_REGS = 0x1
+ZSTD_MAGIC = b"\x28\xb5\x2f\xfd"
+
+FILE_HDR = struct.Struct("<8sIIII")
+REC_HDR = struct.Struct("<BBHIIIIIQQ")
+EFFECT = struct.Struct("<HHIQQ")
+
+# TraceBinKind
+INST, COMPLETION, STRING, SYMBOL = 1, 2, 3, 4
+
+# TraceKeyword_t
+REG_READ, REG_WRITE, MEM_LOAD, MEM_STORE, MEMH_SEND_LOAD, PC_WRITE, MEM_COMPLETION = range(7)
+
+MASK64 = (1 << 64) - 1
+
+XPR_NAME = ["zero", "ra", "sp", "gp", "tp", "t0", "t1", "t2",
+            "s0", "s1", "a0", "a1", "a2", "a3", "a4", "a5",
+            "a6", "a7", "s2", "s3", "s4", "s5", "s6", "s7",
+            "s8", "s9", "s10", "s11", "t3", "t4", "t5", "t6"]
+
+
+def open_trace(path):
+    f = open(path, "rb")
+    head = f.read(4)
+    f.seek(0)
+    if head != ZSTD_MAGIC:
+        return f
+    try:
+        import zstandard
+    except ImportError:
+        sys.exit("error: " + path + " is zstd compressed; install the python 'zstandard' module")
+    return zstandard.ZstdDecompressor().stream_reader(f)
+
+
+def read_exact(f, n):
+    buf = b""
+    while len(buf) < n:
+        chunk = f.read(n - len(buf))
+        if not chunk:
+            break
+        buf += chunk
+    return buf
+
+
+class Decoder:
+    def __init__(self, f, out):
+        self.f = f
+        self.out = out
+        self.strings = {}
+        self.symbols = {}
+        self.cycle = 0
+        self.pc = 0
+        self.last_pc = 0
+
+        hdr = read_exact(f, FILE_HDR.size)
+        if len(hdr) != FILE_HDR.size:
+            sys.exit("error: truncated trace header")
+        magic, version, self.core, flags, name_len = FILE_HDR.unpack(hdr)
+        if magic != MAGIC or version != VERSION:
+            sys.exit("error: not a Rev binary trace (version " + str(VERSION) + ")")
+        self.spike = bool(flags & SPIKE_REGS)
+        self.name = read_exact(f, name_len).decode()
+        self.prefix = "RevCPU[" + self.name + ":Render:"
+
+    def fmt_reg(self, r):
+        r &= 0xff
+        if self.spike:
+            return XPR_NAME[r] if r < 32 else "?" + str(r)
+        return "x" + str(r)
+
+    @staticmethod
+    def fmt_data(length, d):
+        if length == 0:
+            return ""
+        if length > 8:
+            return "0x%016x..+%d" % (d, (8 - length) & 0xffffffff)
+        if length == 8:
+            return "0x%016x" % d
+        mask = MASK64 >> ((8 - length) * 8)
+        return "0x%0*x" % (length * 2, d & mask)
+
+    def effects(self, nrecs):
+        squash = False
+        rw = []
+        for _ in range(nrecs):
+            key, reg, length, a, b = EFFECT.unpack(read_exact(self.f, EFFECT.size))
+            if key == REG_READ:
+                rw.append("0x%x<-%s " % (a, self.fmt_reg(reg)))
+            elif key == REG_WRITE:
+                if squash:
+                    squash = False
+                else:
+                    rw.append("%s<-0x%x " % (self.fmt_reg(reg), a))
+            elif key == MEM_STORE:
+                rw.append("[0x%x,%d]<-%s " % (a, length, self.fmt_data(length, b)))
+            elif key == MEM_LOAD:
+                rw.append("%s<-[0x%x,%d] " % (self.fmt_data(length, b), a, length))
+            elif key == MEMH_SEND_LOAD:
+                rw.append("%s<-[0x%x,%d] " % (self.fmt_reg(reg), a, length))
+                squash = True
+            elif key == PC_WRITE:
+                if (self.last_pc + 4) & MASK64 != a:
+                    s = "pc<-0x%x" % a
+                    if a in self.symbols:
+                        s += " <" + self.symbols[a] + ">"
+                    rw.append(s + " ")
+                self.last_pc = a
+        return "".join(rw)
+
+    def inst(self, event, nrecs, insn, hart, tid, sid):
+        line = "0x%x:" % self.pc
+        if ~insn & 3:
+            line += "%04x    " % (insn & 0xffff)
+        else:
+            line += "%08x" % insn
+        line += " " + (chr(event) if event else "").rjust(2) + " " + self.strings.get(sid, "?")
+        if nrecs:
+            line += " " + self.effects(nrecs)
+        self.out.write("%s%d]: Core %d; Hart %d; Thread %d; *I %s\n" % (self.prefix, self.cycle, self.core, hart, tid, line))
+
+    def completion(self, hart, nrecs):
+        for _ in range(nrecs):
+            key, reg, length, a, b = EFFECT.unpack(read_exact(self.f, EFFECT.size))
+            data = self.fmt_data(length, b)
+            s = "%s<-[0x%x,%d] %s<-%s " % (data, a, length, self.fmt_reg(reg), data)
+            self.out.write("%s%d]: Hart %d; *A %s\n" % (self.prefix, self.cycle, hart, s))
+
+    def run(self):
+        while True:
+            raw = read_exact(self.f, REC_HDR.size)
+            if len(raw) < REC_HDR.size:
+                break
+            kind, event, nrecs, insn, hart, tid, sid, _, cdelta, pdelta = REC_HDR.unpack(raw)
+            if kind == STRING:
+                self.strings[sid] = read_exact(self.f, insn).decode()
+            elif kind == SYMBOL:
+                self.symbols[pdelta] = read_exact(self.f, insn).decode()
+            elif kind == INST:
+                self.cycle += cdelta
+                self.pc = (self.pc + pdelta) & MASK64
+                self.inst(event, nrecs, insn, hart, tid, sid)
+            elif kind == COMPLETION:
+                self.cycle += cdelta
+                self.completion(hart, nrecs)
+            else:
+                sys.exit("error: unknown record kind " + str(kind))
+
+
+parser = argparse.ArgumentParser(
+    prog="rev-trace-decode.py",
+    description="Convert a binary Rev trace to the text trace format")
+parser.add_argument('traces', nargs='+', help="binary trace files (<prefix>.core<N>.rbt)")
+parser.add_argument('-o', '--output', dest='output', required=False,
+                    help="output file (default: stdout)")
+args = parser.parse_args()
+
+out = open(args.output, "w") if args.output else sys.stdout
+for path in args.traces:
+    try:
+        f = open_trace(path)
+    except OSError:
+        print("Cannot open file " + path)
+        exit(1)
+    Decoder(f, out).run()
@@ -10,10 +10,18 @@
 
 #include "RevCPU.h"
 #include "RevMem.h"
+#include "RevSnapshot.h"
 #include "RevThread.h"
+#include <cerrno>
+#include <chrono>
+#include <climits>
 #include <cmath>
+#include <cstring>
+#include <fcntl.h>
 #include <fstream>
 #include <memory>
+#include <set>
+#include <unistd.h>
 
 namespace SST::RevCPU {
 
@@ -30,6 +38,11 @@ const char splash_msg[] = R"(
 //     //  //////    //
 )";
 
+// Statistic names of the stall causes, indexed by RevStall - 1
+const char* const StallStatNames[REV_STALL_CAUSES] = {
+  "StallFetch", "StallLoadHazard", "StallRmtLoadHazard", "StallScoreboard", "StallEcall", "StallCoProc", "StallNoThread",
+};
+
 RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params ) : SST::Component( id ) {
 
   const int Verbosity = params.find<int>( "verbose", 0 );
@@ -60,10 +73,10 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params ) : SST::Compon
   );
 
   // read the binary executable name
-  auto Exe = params.find<std::string>( "program", "a.out" );
+  Program = params.find<std::string>( "program", "a.out" );
 
   // Create the options object
-  Opts     = std::make_unique<RevOpts>( numCores, numHarts, Verbosity );
+  Opts    = std::make_unique<RevOpts>( numCores, numHarts, Verbosity );
 
   // Program arguments
   Opts->SetArgs( params );
@@ -76,6 +89,8 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params ) : SST::Compon
          std::pair( "table", &RevOpts::InitInstTables ),
          std::pair( "memCost", &RevOpts::InitMemCosts ),
          std::pair( "prefetchDepth", &RevOpts::InitPrefetchDepth ),
+         std::pair( "issueWidth", &RevOpts::InitIssueWidths ),
+         std::pair( "fuLatency", &RevOpts::InitFULatencies ),
        } ) {
     std::vector<std::string> optList;
     params.find_array( ParamName, optList );
@@ -138,8 +153,48 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params ) : SST::Compon
   const uint64_t maxHeapSize = params.find<unsigned long>( "maxHeapSize", memSize / 4 );
   Mem->SetMaxHeapSize( maxHeapSize );
 
-  // Load the binary into memory
-  Loader = std::make_unique<RevLoader>( Exe, Opts->GetArgv(), Mem.get(), &output );
+  // Load the binary into memory, or restore the loaded program or a checkpoint from a snapshot
+  const std::string              LoadSnapshot = params.find<std::string>( "loadSnapshot", "" );
+  const std::string              SaveSnapshot = params.find<std::string>( "saveSnapshot", "" );
+  auto                           LoadStart    = std::chrono::steady_clock::now();
+  std::unique_ptr<RevSnapshotIn> Snap;  // a checkpoint is read on once the cores exist
+  if( LoadSnapshot.empty() ) {
+    Loader = std::make_unique<RevLoader>( Program, Opts->GetArgv(), Mem.get(), &output );
+  } else {
+    // the program arguments are already laid out on the stack in the snapshot
+    Snap = std::make_unique<RevSnapshotIn>( LoadSnapshot, &output );
+    std::string              SnapExe;
+    std::vector<std::string> SnapArgv;
+    uint8_t                  SnapCheckpoint;
+    Snap->Expect( REV_SNAPSHOT_TAG_CPU, "CPU" );
+    Snap->Get( SnapExe );
+    Snap->Get( SnapArgv );
+    Snap->Get( SnapCheckpoint );
+    if( SnapExe != Program || SnapArgv != Opts->GetArgv() )
+      output.fatal(
+        CALL_INFO, -1, "Error: snapshot %s was saved for other program arguments (%s)\n", LoadSnapshot.c_str(), SnapExe.c_str()
+      );
+    Restarted = SnapCheckpoint;
+    Mem->LoadSnapshot( *Snap );
+    Loader = std::make_unique<RevLoader>( *Snap, Mem.get(), &output );
+  }
+  const double LoadSec = std::chrono::duration<double>( std::chrono::steady_clock::now() - LoadStart ).count();
+  output.verbose(
+    CALL_INFO,
+    2,
+    0,
+    "%s %s in %.3f s\n",
+    LoadSnapshot.empty() ? "Loaded" : Restarted ? "Restored checkpoint of" : "Restored snapshot of",
+    Program.c_str(),
+    LoadSec
+  );
+
+  if( !SaveSnapshot.empty() ) {
+    if( Restarted )
+      output.fatal( CALL_INFO, -1, "Error: saveSnapshot cannot be used when restarting from a checkpoint\n" );
+    WriteSnapshot( SaveSnapshot, false, 0 );
+    output.verbose( CALL_INFO, 2, 0, "Saved the loaded program to snapshot %s\n", SaveSnapshot.c_str() );
+  }
 
   // Create the processor objects
   Procs.reserve( Procs.size() + numCores );
@@ -147,6 +202,56 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params ) : SST::Compon
     Procs.push_back( std::make_unique<RevCore>( i, Opts.get(), numHarts, Mem.get(), Loader.get(), this->GetNewTID(), &output ) );
   }
 
+  // Hart interleaving policy
+  const std::string hartPolicy = params.find<std::string>( "hartPolicy", "switch-on-stall" );
+  RevHartPolicy     Policy     = RevHartPolicy::SwitchOnStall;
+  if( hartPolicy == "round-robin" ) {
+    Policy = RevHartPolicy::RoundRobin;
+  } else if( hartPolicy == "icount" ) {
+    Policy = RevHartPolicy::ICount;
+  } else if( hartPolicy == "switch-on-hazard" ) {
+    Policy = RevHartPolicy::SwitchOnHazard;
+  } else if( hartPolicy != "switch-on-stall" ) {
+    output.fatal(
+      CALL_INFO,
+      -1,
+      "Error: unknown hartPolicy '%s' (switch-on-stall, switch-on-hazard, round-robin or icount)\n",
+      hartPolicy.c_str()
+    );
+  }
+  for( auto& Proc : Procs )
+    Proc->SetHartPolicy( Policy );
+
+  // Multi-issue timing model; the scalar model has no functional unit latencies
+  const bool wideIssue = params.find<bool>( "wideIssue", false );
+  for( unsigned i = 0; i < numCores; i++ ) {
+    unsigned                Width = 1;
+    std::array<unsigned, 4> Latency{};
+    Opts->GetIssueWidth( i, Width );
+    Opts->GetFULatency( i, Latency );
+    if( Width == 1 && !wideIssue && Latency != std::array<unsigned, 4>{} )
+      output.fatal( CALL_INFO, -1, "Error: core %" PRIu32 " sets fuLatency but uses the scalar model (see wideIssue)\n", i );
+  }
+  for( auto& Proc : Procs )
+    Proc->SetWideIssue( wideIssue );
+
+  // Thread scheduling
+  Quantum      = params.find<uint64_t>( "quantum", 0 );
+  CoreAffinity = params.find<bool>( "coreAffinity", 1 );
+  WorkStealing = params.find<bool>( "workStealing", 1 );
+  CoreReadyThreads.resize( numCores );
+  for( auto& Proc : Procs ) {
+    Proc->SetSchedOps( {
+      [this]( uint64_t Addr ) {
+        auto it = Futexes.find( Addr );
+        return it == Futexes.end() ? uint64_t{ 0 } : it->second.Wakes;
+      },
+      [this]( uint64_t Addr, uint32_t Count ) { return FutexWake( Addr, Count ); },
+      [this]() { return NumReadyThreads(); },
+      [this]() { return RequestCheckpoint(); },
+    } );
+  }
+
   EnableCoProc = params.find<bool>( "enableCoProc", 0 );
   if( EnableCoProc ) {
     // Create the co-processor objects
@@ -160,6 +265,13 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params ) : SST::Compon
     }
   }
 
+  // Checkpoints: written every checkpointPeriod cycles and on rev_checkpoint
+  CheckpointPrefix = params.find<std::string>( "checkpoint", "checkpoint" );
+  CheckpointPeriod = params.find<uint64_t>( "checkpointPeriod", 0 );
+  NextCheckpoint   = CheckpointPeriod;
+  if( CheckpointPeriod && ( EnableMemH || EnableCoProc ) )
+    output.fatal( CALL_INFO, -1, "Error: checkpoints require the internal memory model and no co-processor\n" );
+
   // Memory dumping option(s)
   std::vector<std::string> memDumpRanges;
   params.find_array( "memDumpRanges", memDumpRanges );
@@ -194,6 +306,21 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params ) : SST::Compon
     }
   }
 
+  // Dump files are text or binary; binary chunks may be zstd compressed
+  const std::string dumpFormat   = params.find<std::string>( "memDumpFormat", "text" );
+  const std::string dumpCompress = params.find<std::string>( "memDumpCompress", "none" );
+  if( dumpFormat != "text" && dumpFormat != "binary" )
+    output.fatal(
+      CALL_INFO, -1, "Unsupported parameter [memDumpFormat=%s]. Supported values are: text binary\n", dumpFormat.c_str()
+    );
+  if( dumpCompress != "none" && dumpCompress != "zstd" )
+    output.fatal(
+      CALL_INFO, -1, "Unsupported parameter [memDumpCompress=%s]. Supported values are: none zstd\n", dumpCompress.c_str()
+    );
+  if( dumpCompress == "zstd" && !RevMemDumpOut::HasCompression() )
+    output.fatal( CALL_INFO, -1, "Error: memDumpCompress=zstd requires building with REV_DUMP_ZSTD=ON\n" );
+  Mem->SetDumpFormat( dumpFormat == "binary", dumpCompress == "zstd" );
+
   // See if we should load the xBGAS remote memory controller
   EnableXBGAS      = params.find<bool>( "enable_xbgas", 0 );
   EnableXBGASStats = params.find<bool>( "enable_xbgas_stats", 0 );
@@ -211,18 +338,41 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params ) : SST::Compon
     // Set remote memory controller for MemCtrl
     if( EnableMemH )
       Ctrl->setRmtMemCtrl( rmtCtrl.get() );
-    // Allocate the xBGAS shared memory region
-    SharedMemoryBase = Mem->AllocMem( (uint64_t) ( SharedMemorySize ) );
+    // Allocate the xBGAS shared memory region; a checkpoint has it allocated already
+    if( !Restarted )
+      SharedMemoryBase = Mem->AllocMem( (uint64_t) ( SharedMemorySize ) );
     // Get the base address of the barrier region
     BarrierBase      = _REVMEM_BASE_ + memSize - __XBRTIME_RESERVED__;
   }
 
 #ifndef NO_REV_TRACER
   // Configure tracer and assign to each core
-  if( output.getVerboseLevel() >= 5 ) {
+  // Binary traces do not go through SST::Output and are written at any verbosity
+  std::string trcBinary = params.find<std::string>( "trcBinary", "" );
+  std::string trcComp   = params.find<std::string>( "trcCompress", "none" );
+  if( trcComp != "none" && trcComp != "zstd" )
+    output.fatal( CALL_INFO, -1, "Unsupported parameter [trcCompress=%s]. Supported values are: none zstd\n", trcComp.c_str() );
+  bool     trcAsync    = params.find<bool>( "trcAsync", false );
+  uint64_t trcRingSize = params.find<uint64_t>( "trcRingSize", 65536 );
+  bool     trcRingDrop = params.find<bool>( "trcRingDrop", false );
+
+  // sampling, region of interest and hart/thread filters
+  uint64_t trcSampleEvery  = params.find<uint64_t>( "trcSampleEvery", 0 );
+  uint64_t trcSampleWindow = params.find<uint64_t>( "trcSampleWindow", 0 );
+  uint64_t trcSamplePeriod = params.find<uint64_t>( "trcSamplePeriod", 0 );
+  if( ( trcSampleWindow == 0 ) != ( trcSamplePeriod == 0 ) )
+    output.fatal( CALL_INFO, -1, "Error: trcSampleWindow and trcSamplePeriod must be set together\n" );
+  std::vector<std::string> trcROI;
+  std::vector<unsigned>    trcHarts;
+  std::vector<unsigned>    trcThreads;
+  params.find_array( "trcROI", trcROI );
+  params.find_array( "trcHarts", trcHarts );
+  params.find_array( "trcThreads", trcThreads );
+  if( output.getVerboseLevel() >= 5 || !trcBinary.empty() ) {
     for( unsigned i = 0; i < numCores; i++ ) {
       // Each core gets its very own tracer
-      RevTracer*  trc = new RevTracer( getName(), &output );
+      Tracers.push_back( std::make_unique<RevTracer>( getName(), &output ) );
+      RevTracer*  trc = Tracers.back().get();
       std::string diasmType;
       Opts->GetMachineModel( 0, diasmType );  // TODO first param is core
       if( trc->SetDisassembler( diasmType ) )
@@ -235,9 +385,34 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params ) : SST::Compon
       trc->SetCycleLimit( params.find<uint64_t>( "trcLimit", 0 ) );
       trc->SetCmdTemplate( params.find<std::string>( "trcOp", TRC_OP_DEFAULT ).c_str() );
 
+      // sampling and ROI traces start enabled unless a start cycle is given
+      trc->SetSampling( trcSampleEvery, trcSampleWindow, trcSamplePeriod );
+      for( const std::string& func : trcROI ) {
+        if( trc->SetROI( func ) )
+          output.fatal( CALL_INFO, -1, "Error: trcROI function %s was not found in the symbol table\n", func.c_str() );
+      }
+      trc->SetHartFilter( trcHarts );
+      trc->SetThreadFilter( trcThreads );
+      if( ( trcSampleEvery > 1 || trcSamplePeriod || !trcROI.empty() ) && params.find<uint64_t>( "trcStartCycle", 0 ) == 0 )
+        trc->SetOutputEnable( true );
+
+      // binary trace sink, one file per core
+      if( !trcBinary.empty() ) {
+        std::string path = trcBinary + ".core" + std::to_string( i ) + ".rbt";
+        int         rc   = trc->SetBinaryOutput( path, i, trcComp == "zstd" );
+        if( rc == 2 )
+          output.fatal( CALL_INFO, -1, "Error: trcCompress=zstd requires building with REV_TRACE_ZSTD=ON\n" );
+        else if( rc )
+          output.fatal( CALL_INFO, -1, "Error: could not open binary trace file %s\n", path.c_str() );
+      }
+
       // clear trace states
       trc->Reset();
 
+      // hand formatting and file output to a writer thread
+      if( trcAsync && trc->SetAsyncOutput( trcRingSize, trcRingDrop ) )
+        output.fatal( CALL_INFO, -1, "Error: could not start the trace writer; trcRingSize must be greater than 0\n" );
+
       // Assign to components
       Procs[i]->SetTracer( trc );
       if( Ctrl )
@@ -245,6 +420,31 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params ) : SST::Compon
     }
   }
 #endif
+
+  // Configure the per-PC profilers, one per core
+  ProfilePrefix = params.find<std::string>( "profile", "" );
+  if( !ProfilePrefix.empty() ) {
+    uint64_t interval = params.find<uint64_t>( "profileInterval", 1 );
+    for( unsigned i = 0; i < numCores; i++ ) {
+      Profilers.push_back( std::make_unique<RevProfiler>( numHarts, interval, Loader->GetTraceSymbols() ) );
+      Procs[i]->SetProfiler( Profilers.back().get() );
+    }
+  }
+
+  // Tick the cores on host threads; see TickCoresParallel
+  ParallelThreads  = params.find<unsigned>( "parallelThreads", 1 );
+  ParallelValidate = params.find<bool>( "parallelValidate", 0 );
+  if( ParallelThreads > 1 || ParallelValidate ) {
+    if( EnableMemH || EnableCoProc || EnableXBGAS || !Tracers.empty() )
+      output.fatal(
+        CALL_INFO, -1, "Error: parallelThreads and parallelValidate do not support memHierarchy, coprocessors, xBGAS or tracing\n"
+      );
+    CoreIsolation.resize( numCores );
+    CoreIsolated.resize( numCores );
+    if( ParallelThreads > 1 )
+      CorePool = std::make_unique<RevThreadPool>( std::min( ParallelThreads, numCores ) );
+  }
+
   // Setup timeConverter
   for( size_t i = 0; i < Procs.size(); i++ ) {
     Procs[i]->SetTimeConverter( timeConverter );
@@ -302,7 +502,13 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params ) : SST::Compon
 
   output.verbose( CALL_INFO, 11, 0, "Start address is 0x%" PRIx64 "\n", StartAddr );
 
-  InitMainThread( MainThreadID, StartAddr );
+  // A checkpoint restores every thread instead of the main thread
+  if( Restarted ) {
+    LoadCheckpoint( *Snap );
+    Snap.reset();
+  } else {
+    InitMainThread( MainThreadID, StartAddr );
+  }
 
   // setup the per-proc statistics
   TotalCycles.reserve( numCores );
@@ -330,13 +536,40 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params ) : SST::Compon
     FloatsExec.push_back( registerStatistic<uint64_t>( "FloatsExec", core ) );
     TLBHitsPerCore.push_back( registerStatistic<uint64_t>( "TLBHitsPerCore", core ) );
     TLBMissesPerCore.push_back( registerStatistic<uint64_t>( "TLBMissesPerCore", core ) );
+
+    // stall causes per core (core_N) and per hart (core_N_hart_M)
+    auto& stalls = StallCycles.emplace_back();
+    for( unsigned c = 0; c < REV_STALL_CAUSES; c++ )
+      stalls[c] = registerStatistic<uint64_t>( StallStatNames[c], core );
+    for( unsigned h = 0; h < numHarts; h++ ) {
+      auto& hartStalls = HartStallCycles.emplace_back();
+      for( unsigned c = 0; c < REV_STALL_CAUSES; c++ )
+        hartStalls[c] = registerStatistic<uint64_t>( StallStatNames[c], core + "_hart_" + std::to_string( h ) );
+    }
+
+    ContextSwitches.push_back( registerStatistic<uint64_t>( "ContextSwitches", core ) );
+    ThreadsStolen.push_back( registerStatistic<uint64_t>( "ThreadsStolen", core ) );
+    IsolatedTicks.push_back( registerStatistic<uint64_t>( "IsolatedTicks", core ) );
+
+    // calls and cycles per ECALL code (core_N_ecall_CODE)
+    auto& calls  = EcallCalls.emplace_back();
+    auto& cycles = EcallCycles.emplace_back();
+    for( uint32_t code : RevCore::GetEcallCodes() ) {
+      calls.push_back( registerStatistic<uint64_t>( "EcallCalls", core + "_ecall_" + std::to_string( code ) ) );
+      cycles.push_back( registerStatistic<uint64_t>( "EcallCycles", core + "_ecall_" + std::to_string( code ) ) );
+    }
   }
+  ThreadRuntime     = registerStatistic<uint64_t>( "ThreadRuntime" );
+  ParallelConflicts = registerStatistic<uint64_t>( "ParallelConflicts" );
+  LoadTime          = registerStatistic<uint64_t>( "LoadTime" );
+  LoadTime->addData( uint64_t( LoadSec * 1e6 ) );
 
   // determine whether we need to enable/disable manual coproc clocking
   DisableCoprocClock    = params.find<bool>( "independentCoprocClock", 0 );
 
   // Create the completion array
   Enabled               = std::vector<bool>( numCores );
+  CoreActive            = std::vector<uint8_t>( numCores );
 
   const unsigned Splash = params.find<bool>( "splash", 0 );
 
@@ -346,10 +579,11 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params ) : SST::Compon
   // Done with initialization
   output.verbose( CALL_INFO, 1, 0, "Initialization of RevCPUs complete.\n" );
 
-  for( const auto& [Name, Seg] : Mem->GetDumpRanges() ) {
-    // Open a file called '{Name}.init.dump'
-    std::ofstream dumpFile( Name + ".dump.init", std::ios::binary );
-    Mem->DumpMemSeg( Seg, 16, dumpFile );
+  // With memHierarchy the ranges are read once the program has been loaded into it
+  if( Ctrl ) {
+    InitDumpPending = !Mem->GetDumpRanges().empty();
+  } else {
+    Mem->WriteDumpRanges( ".dump.init" );
   }
 }
 
@@ -454,6 +688,8 @@ void RevCPU::setup() {
   }
   if( EnableXBGAS ) {
     rmtCtrl->setup();
+  }
+  if( EnableXBGAS && !Restarted ) {
     // Setup the extended registers to have the xBGAS PE ID and total number of PEs
     // e10 = contains the PE id
     // e11 = contains the number of PEs
@@ -473,7 +709,24 @@ void RevCPU::setup() {
   }
 }
 
-void RevCPU::finish() {}
+void RevCPU::finish() {
+  // drain and report any asynchronous trace writers
+  for( auto& trc : Tracers )
+    trc->Finish();
+
+  // write the flat and folded-stack profiles
+  for( unsigned i = 0; i < Profilers.size(); i++ ) {
+    std::string   base = ProfilePrefix + ".core" + std::to_string( i );
+    std::ofstream flat( base + ".flat" );
+    std::ofstream folded( base + ".folded" );
+    if( !flat || !folded ) {
+      output.verbose( CALL_INFO, 1, 0, "Warning: could not write profile %s.{flat,folded}\n", base.c_str() );
+      continue;
+    }
+    Profilers[i]->WriteFlat( flat, i );
+    Profilers[i]->WriteFolded( folded );
+  }
+}
 
 void RevCPU::init( unsigned int phase ) {
   if( EnableNIC )
@@ -598,37 +851,74 @@ void RevCPU::UpdateCoreStatistics( unsigned coreNum ) {
   FloatsExec[coreNum]->addData( stats.floatsExec );
   TLBHitsPerCore[coreNum]->addData( memStats.TLBHits );
   TLBMissesPerCore[coreNum]->addData( memStats.TLBMisses );
+  for( unsigned c = 0; c < REV_STALL_CAUSES; c++ )
+    StallCycles[coreNum][c]->addData( stats.stalls[c] );
+  for( unsigned h = 0; h < numHarts; h++ ) {
+    auto hartStalls = Procs[coreNum]->GetAndClearHartStalls( h );
+    for( unsigned c = 0; c < REV_STALL_CAUSES; c++ )
+      HartStallCycles[coreNum * numHarts + h][c]->addData( hartStalls[c] );
+  }
+  auto [ecallCalls, ecallCycles] = Procs[coreNum]->GetAndClearEcallStats();
+  for( size_t slot = 0; slot < ecallCalls.size(); slot++ ) {
+    if( ecallCalls[slot] ) {
+      EcallCalls[coreNum][slot]->addData( ecallCalls[slot] );
+      EcallCycles[coreNum][slot]->addData( ecallCycles[slot] );
+    }
+  }
 }
 
 bool RevCPU::clockTick( SST::Cycle_t currentCycle ) {
   bool rtn = true;
 
+  // A restored run continues counting from the cycle of its checkpoint
+  currentCycle += CycleBase;
+
   output.verbose( CALL_INFO, 8, 0, "Cycle: %" PRIu64 "\n", currentCycle );
 
-  // Execute each enabled core
-  for( size_t i = 0; i < Procs.size(); i++ ) {
-    // Check if we have more work to assign and places to put it
-    UpdateThreadAssignments( i );
-    if( Enabled[i] ) {
-      if( !Procs[i]->ClockTick( currentCycle ) ) {
-        if( EnableCoProc && !CoProcs.empty() ) {
-          CoProcs[i]->Teardown();
-        }
-        UpdateCoreStatistics( i );
-        Enabled[i] = false;
-        output.verbose( CALL_INFO, 5, 0, "Closing Processor %zu at Cycle: %" PRIu64 "\n", i, currentCycle );
-      }
-      if( EnableCoProc && !CoProcs[i]->ClockTick( currentCycle ) && !DisableCoprocClock ) {
-        output.verbose( CALL_INFO, 5, 0, "Closing Co-Processor %zu at Cycle: %" PRIu64 "\n", i, currentCycle );
-      }
+  // Hold the cores until the initial dump ranges have arrived from memHierarchy
+  if( InitDumpPending ) {
+    InitDumpPending = !Mem->WriteDumpRanges( ".dump.init" );
+    return false;
+  }
+
+  // Periodic checkpoints
+  if( CheckpointPeriod && currentCycle >= NextCheckpoint ) {
+    RequestCheckpoint();
+    NextCheckpoint += CheckpointPeriod;
+  }
+
+  // Wake threads whose sleep or futex timeout has expired
+  WakeTimedThreads( currentCycle );
+
+  // Check if we have more work to assign and places to put it; the first
+  // core to pick from the ready queues rotates so no core is favored.
+  // No thread is started while a checkpoint is pending.
+  if( !CheckpointPending ) {
+    for( unsigned c = 0; c < numCores; c++ ) {
+      UpdateThreadAssignments( ( AssignStart + c ) % numCores );
     }
+    AssignStart = ( AssignStart + 1 ) % numCores;
+  }
 
-    // See if any of the threads on this proc changes state
-    HandleThreadStateChangesForProc( i );
+  // Execute each enabled core
+  if( ParallelThreads > 1 || ParallelValidate ) {
+    TickCoresParallel( currentCycle );
+  } else {
+    for( size_t i = 0; i < Procs.size(); i++ ) {
+      if( Enabled[i] )
+        CoreActive[i] = Procs[i]->ClockTick( currentCycle );
+      EndCoreCycle( i, currentCycle );
+    }
+  }
 
-    if( Procs[i]->HasNoBusyHarts() ) {
-      Enabled[i] = false;
+  // Write a pending checkpoint once nothing is in flight
+  if( CheckpointPending ) {
+    if( CheckpointQuiesced() ) {
+      WriteCheckpoint( currentCycle );
+      ReturnEvictedThreads();
+      CheckpointPending = false;
     }
+    rtn = false;
   }
 
   // check to see if we need to inject a fault
@@ -653,13 +943,22 @@ bool RevCPU::clockTick( SST::Cycle_t currentCycle ) {
 
   // If all Procs are disabled (ie. rtn == false at this point)
   // check to see if there are threads to assign
-  if( ReadyThreads.size() ) {
+  if( NumReadyThreads() ) {
     rtn = false;
   } else if( BlockedThreads.size() ) {
     CheckBlockedThreads();
     rtn = false;
   }
 
+  // Sleeping threads and timed futex waits will be woken
+  if( !SleepingThreads.empty() || !FutexTimeouts.empty() ) {
+    rtn = false;
+  } else if( FutexWaiters && !NumReadyThreads() && CheckpointEvicted.empty() &&
+             std::none_of( Enabled.begin(), Enabled.end(), []( bool e ) { return e; } ) ) {
+    // No thread is left that could wake the futex waiters
+    output.fatal( CALL_INFO, -1, "Error: deadlock; %zu thread(s) wait on futexes and no thread can wake them\n", FutexWaiters );
+  }
+
   // check to see if the network has any outstanding messages: fixme
   if( !TrackTags.empty() || !ZeroRqst.empty() ) {
     rtn = false;
@@ -674,17 +973,16 @@ bool RevCPU::clockTick( SST::Cycle_t currentCycle ) {
     rtn = false;
   }
 
+  // The final dump ranges are written once memHierarchy has returned them
+  if( rtn && CompletedThreads.size() && !Mem->WriteDumpRanges( ".dump.final" ) ) {
+    rtn = false;
+  }
+
   if( rtn && CompletedThreads.size() ) {
     for( unsigned i = 0; i < numCores; i++ ) {
       UpdateCoreStatistics( i );
       Procs[i]->PrintStatSummary();
     }
-
-    for( const auto& [Name, Seg] : Mem->GetDumpRanges() ) {
-      // Open a file called '{Name}.init.dump'
-      std::ofstream dumpFile( Name + ".dump.final", std::ios::binary );
-      Mem->DumpMemSeg( Seg, 16, dumpFile );
-    }
     primaryComponentOKToEndSim();
     output.verbose( CALL_INFO, 5, 0, "OK to end sim at cycle: %" PRIu64 "\n", static_cast<uint64_t>( currentCycle ) );
   } else {
@@ -710,7 +1008,133 @@ void RevCPU::InitThread( std::unique_ptr<RevThread>&& ThreadToInit ) {
   ThreadToInit->SetState( ThreadState::READY );
   output.verbose( CALL_INFO, 4, 0, "Initializing Thread %" PRIu32 "\n", ThreadToInit->GetID() );
   output.verbose( CALL_INFO, 11, 0, "Thread Information: %s", ThreadToInit->to_string().c_str() );
-  ReadyThreads.emplace_back( std::move( ThreadToInit ) );
+  PushReadyThread( std::move( ThreadToInit ) );
+}
+
+// Adds a READY thread to a ready queue. With core affinity a thread is queued
+// on 'Core' (the creating core of a new thread) or else on the core it last
+// ran on, so it finds its cache state there.
+void RevCPU::PushReadyThread( std::unique_ptr<RevThread>&& Thread, unsigned Core ) {
+  Thread->SetState( ThreadState::READY );
+  Thread->SetReadySeq( ReadySeq++ );
+  if( Core >= numCores )
+    Core = Thread->GetLastCore();
+  if( CoreAffinity && Core < numCores ) {
+    CoreReadyThreads[Core].emplace_back( std::move( Thread ) );
+    CoreQueued++;
+  } else {
+    ReadyThreads.emplace_back( std::move( Thread ) );
+  }
+}
+
+// Removes the next thread for core 'ProcID'. Threads are served in the order
+// they became ready. When neither its own queue nor the shared queue has work
+// an idle core steals the oldest thread of the core with the longest queue.
+std::unique_ptr<RevThread> RevCPU::PopReadyThread( uint32_t ProcID ) {
+  std::deque<std::unique_ptr<RevThread>>* Queue = nullptr;
+  auto& Own                                     = CoreReadyThreads[ProcID];
+  if( !Own.empty() )
+    Queue = &Own;
+  if( !ReadyThreads.empty() && ( !Queue || ReadyThreads.front()->GetReadySeq() < Queue->front()->GetReadySeq() ) )
+    Queue = &ReadyThreads;
+
+  unsigned Victim = ProcID;
+  if( !Queue && WorkStealing && CoreQueued ) {
+    for( unsigned c = 0; c < numCores; c++ ) {
+      if( CoreReadyThreads[c].size() > CoreReadyThreads[Victim].size() )
+        Victim = c;
+    }
+    Queue = &CoreReadyThreads[Victim];
+  }
+  if( !Queue || Queue->empty() )
+    return nullptr;
+
+  std::unique_ptr<RevThread> Thread = std::move( Queue->front() );
+  Queue->pop_front();
+  if( Queue != &ReadyThreads )
+    CoreQueued--;
+  if( Victim != ProcID ) {
+    output.verbose(
+      CALL_INFO, 6, 0, "Core %" PRIu32 " stole Thread %" PRIu32 " from Core %" PRIu32 "\n", ProcID, Thread->GetID(), Victim
+    );
+    ThreadsStolen[ProcID]->addData( 1 );
+  }
+  return Thread;
+}
+
+void RevCPU::FutexWait( std::unique_ptr<RevThread>&& Thread ) {
+  FutexQueue& Futex = Futexes[Thread->GetFutexAddr()];
+  if( Futex.Wakes != Thread->GetFutexSeq() ) {
+    // Woken between reading the futex value and blocking; return as if woken
+    Thread->SetFutexWait( _INVALID_ADDR_, 0 );
+    Thread->SetWakeCycle( 0 );
+    PushReadyThread( std::move( Thread ) );
+    return;
+  }
+  if( Thread->GetWakeCycle() ) {
+    FutexTimeouts.emplace( Thread->GetWakeCycle(), std::make_pair( Thread->GetID(), Thread->GetFutexAddr() ) );
+  }
+  output.verbose(
+    CALL_INFO, 8, 0, "Thread %" PRIu32 " waits on futex 0x%" PRIx64 "\n", Thread->GetID(), Thread->GetFutexAddr()
+  );
+  Futex.Waiters.emplace_back( std::move( Thread ) );
+  FutexWaiters++;
+}
+
+uint32_t RevCPU::FutexWake( uint64_t Addr, uint32_t Count ) {
+  FutexQueue& Futex = Futexes[Addr];
+  Futex.Wakes++;
+  uint32_t Woken = 0;
+  while( Woken < Count && !Futex.Waiters.empty() ) {
+    std::unique_ptr<RevThread> Thread = std::move( Futex.Waiters.front() );
+    Futex.Waiters.pop_front();
+    FutexWaiters--;
+    CancelFutexTimeout( *Thread );
+    Thread->SetFutexWait( _INVALID_ADDR_, 0 );
+    Thread->SetWakeCycle( 0 );
+    PushReadyThread( std::move( Thread ) );
+    Woken++;
+  }
+  output.verbose( CALL_INFO, 8, 0, "Futex 0x%" PRIx64 " woke %" PRIu32 " thread(s)\n", Addr, Woken );
+  return Woken;
+}
+
+void RevCPU::WakeTimedThreads( uint64_t Cycle ) {
+  while( !SleepingThreads.empty() && SleepingThreads.begin()->first <= Cycle ) {
+    std::unique_ptr<RevThread> Thread = std::move( SleepingThreads.begin()->second );
+    SleepingThreads.erase( SleepingThreads.begin() );
+    Thread->SetWakeCycle( 0 );
+    PushReadyThread( std::move( Thread ) );
+  }
+
+  // Timed out futex waiters return -ETIMEDOUT; a woken waiter has dropped its deadline
+  while( !FutexTimeouts.empty() && FutexTimeouts.begin()->first <= Cycle ) {
+    auto [ID, Addr] = FutexTimeouts.begin()->second;
+    FutexTimeouts.erase( FutexTimeouts.begin() );
+    auto& Waiters = Futexes[Addr].Waiters;
+    auto  it      = std::find_if( Waiters.begin(), Waiters.end(), [ID = ID]( const auto& T ) { return T->GetID() == ID; } );
+    if( it == Waiters.end() )
+      output.fatal( CALL_INFO, -1, "Error: thread %" PRIu32 " timed out on futex 0x%" PRIx64 " it does not wait on\n", ID, Addr );
+    std::unique_ptr<RevThread> Thread = std::move( *it );
+    Waiters.erase( it );
+    FutexWaiters--;
+    Thread->GetVirtRegState()->SetX( RevReg::a0, -ETIMEDOUT );
+    Thread->SetFutexWait( _INVALID_ADDR_, 0 );
+    Thread->SetWakeCycle( 0 );
+    PushReadyThread( std::move( Thread ) );
+  }
+}
+
+void RevCPU::CancelFutexTimeout( const RevThread& Thread ) {
+  if( !Thread.GetWakeCycle() )
+    return;
+  auto [First, Last] = FutexTimeouts.equal_range( Thread.GetWakeCycle() );
+  for( auto it = First; it != Last; ++it ) {
+    if( it->second.first == Thread.GetID() ) {
+      FutexTimeouts.erase( it );
+      return;
+    }
+  }
 }
 
 // Assigns a RevThred to a specific Proc which then loads it into a RevHart
@@ -753,7 +1177,7 @@ void RevCPU::CheckBlockedThreads() {
   // Iterate over all block threads
   for( auto it = BlockedThreads.begin(); it != BlockedThreads.end(); ) {
     if( ThreadCanProceed( *it ) ) {
-      ReadyThreads.emplace_back( std::move( *it ) );
+      PushReadyThread( std::move( *it ) );
       it = BlockedThreads.erase( it );
     } else {
       ++it;
@@ -763,22 +1187,16 @@ void RevCPU::CheckBlockedThreads() {
 }
 
 // Checks core 'i' to see if it has any available harts to assign work to
-// if it does and there is work to assign (ie. ReadyThreads is not empty)
-// assign it and enable the processor if not already enabled.
+// if it does and there is work to assign (ie. a ready queue is not empty)
+// fill its idle harts and enable the processor if not already enabled.
 void RevCPU::UpdateThreadAssignments( uint32_t ProcID ) {
-  // Check if we have anything to assign
-  if( ReadyThreads.empty() ) {
-    return;
-  }
-
-  // There is work to assign, check if this proc has room
-  if( Procs[ProcID]->HasIdleHart() ) {
-    // There is room, assign a thread
-    // Get the next thread to assign
-    Procs[ProcID]->AssignThread( std::move( ReadyThreads.front() ) );
-
-    // Remove thread from ready threads vector
-    ReadyThreads.erase( ReadyThreads.begin() );
+  // Assign a thread to every idle hart of this proc while there is work
+  while( Procs[ProcID]->HasIdleHart() && NumReadyThreads() ) {
+    std::unique_ptr<RevThread> Thread = PopReadyThread( ProcID );
+    if( !Thread ) {
+      break;
+    }
+    AssignThread( std::move( Thread ), ProcID );
 
     // Proc has a thread assigned to it, enable it
     Enabled[ProcID] = true;
@@ -788,6 +1206,142 @@ void RevCPU::UpdateThreadAssignments( uint32_t ProcID ) {
 
 // Checks for state changes in the threads of a given processor index 'i'
 // and handle appropriately
+void RevCPU::EndCoreCycle( size_t i, SST::Cycle_t currentCycle ) {
+  if( Enabled[i] ) {
+    if( !CoreActive[i] ) {
+      if( EnableCoProc && !CoProcs.empty() ) {
+        CoProcs[i]->Teardown();
+      }
+      UpdateCoreStatistics( i );
+      Enabled[i] = false;
+      output.verbose( CALL_INFO, 5, 0, "Closing Processor %zu at Cycle: %" PRIu64 "\n", i, currentCycle );
+    }
+    if( EnableCoProc && !CoProcs[i]->ClockTick( currentCycle ) && !DisableCoprocClock ) {
+      output.verbose( CALL_INFO, 5, 0, "Closing Co-Processor %zu at Cycle: %" PRIu64 "\n", i, currentCycle );
+    }
+  }
+
+  // See if any of the threads on this proc changes state
+  HandleThreadStateChangesForProc( i );
+
+  // Switch out threads whose quantum expired while other threads are waiting
+  if( Quantum && Enabled[i] ) {
+    if( size_t Waiting = NumReadyThreads() ) {
+      for( auto& Thread : Procs[i]->PreemptThreads( Quantum, Waiting ) ) {
+        ContextSwitches[i]->addData( 1 );
+        PushReadyThread( std::move( Thread ) );
+      }
+    }
+  }
+
+  // Take every thread off its hart as soon as it has no work in flight
+  if( CheckpointPending ) {
+    for( auto& [Hart, Thread] : Procs[i]->EvictThreads() ) {
+      CheckpointEvicted.emplace_back( i, Hart, std::move( Thread ) );
+    }
+  }
+
+  if( Procs[i]->HasNoBusyHarts() ) {
+    Enabled[i] = false;
+  }
+}
+
+// Cores that are about to issue only register, load, store and control
+// transfer instructions are ticked first, apart from each other and on the
+// thread pool: their loads see memory as of the start of the cycle and their
+// own stores, which are buffered and then performed in core order. The other
+// cores are ticked afterwards in core order, each followed by the thread
+// state changes of its core as in the sequential loop. Every shared side
+// effect happens in an order that does not depend on the thread count.
+void RevCPU::TickCoresParallel( SST::Cycle_t currentCycle ) {
+  IsolatedCores.clear();
+  for( size_t i = 0; i < Procs.size(); i++ ) {
+    CoreIsolated[i] = Enabled[i] && Procs[i]->CanTickIsolated();
+    CoreIsolation[i].Clear();
+    CoreIsolation[i].Buffer = CoreIsolated[i];
+    CoreIsolation[i].Record = ParallelValidate;
+    if( CoreIsolated[i] )
+      IsolatedCores.push_back( unsigned( i ) );
+  }
+
+  auto TickIsolated = [this, currentCycle]( size_t n ) {
+    unsigned i = IsolatedCores[n];
+    RevMem::SetIsolation( &CoreIsolation[i] );
+    CoreActive[i] = Procs[i]->ClockTick( currentCycle );
+    RevMem::SetIsolation( nullptr );
+  };
+  if( CorePool ) {
+    CorePool->Run( IsolatedCores.size(), TickIsolated );
+  } else {
+    for( size_t n = 0; n < IsolatedCores.size(); n++ )
+      TickIsolated( n );
+  }
+
+  for( unsigned i : IsolatedCores ) {
+    Mem->CommitIsolation( CoreIsolation[i] );
+    IsolatedTicks[i]->addData( 1 );
+  }
+
+  for( size_t i = 0; i < Procs.size(); i++ ) {
+    if( Enabled[i] && !CoreIsolated[i] ) {
+      // under validation the accesses of the other cores are recorded too
+      RevMem::SetIsolation( ParallelValidate ? &CoreIsolation[i] : nullptr );
+      CoreActive[i] = Procs[i]->ClockTick( currentCycle );
+      RevMem::SetIsolation( nullptr );
+    }
+    EndCoreCycle( i, currentCycle );
+  }
+
+  if( ParallelValidate )
+    CheckParallelConflicts( currentCycle );
+}
+
+// Ticked in core order, an isolated core would have seen the stores of the
+// lower numbered cores of this cycle, and its stores would have followed
+// every access of the lower numbered cores ticked in order. Without such an
+// overlap both orders read and write the same values.
+void RevCPU::CheckParallelConflicts( SST::Cycle_t currentCycle ) {
+  using Ranges = std::vector<std::pair<uint64_t, uint64_t>>;
+  auto Overlap = []( const Ranges& A, const Ranges& B ) -> const std::pair<uint64_t, uint64_t>* {
+    for( const auto& a : A )
+      for( const auto& b : B )
+        if( a.first < b.second && b.first < a.second )
+          return &a;
+    return nullptr;
+  };
+
+  Ranges LowerWrites;    // stores of the lower numbered cores
+  Ranges LowerAccesses;  // loads and stores of the lower numbered cores ticked in order
+  for( size_t i = 0; i < Procs.size(); i++ ) {
+    const RevMem::Isolation& Iso = CoreIsolation[i];
+    if( CoreIsolated[i] ) {
+      const auto* Range = Overlap( Iso.Reads, LowerWrites );
+      if( !Range )
+        Range = Overlap( Iso.Writes, LowerAccesses );
+      if( Range ) {
+        ParallelConflicts->addData( 1 );
+        if( ConflictsReported++ < MaxConflictReports ) {
+          output.verbose(
+            CALL_INFO,
+            1,
+            0,
+            "Warning: cycle %" PRIu64 ": core %zu accessed [0x%" PRIx64 ", 0x%" PRIx64 ") apart from a lower numbered core; "
+            "the sequential order could differ\n",
+            currentCycle,
+            i,
+            Range->first,
+            Range->second
+          );
+        }
+      }
+    } else {
+      LowerAccesses.insert( LowerAccesses.end(), Iso.Reads.begin(), Iso.Reads.end() );
+      LowerAccesses.insert( LowerAccesses.end(), Iso.Writes.begin(), Iso.Writes.end() );
+    }
+    LowerWrites.insert( LowerWrites.end(), Iso.Writes.begin(), Iso.Writes.end() );
+  }
+}
+
 void RevCPU::HandleThreadStateChangesForProc( uint32_t ProcID ) {
   // Handle any thread state changes for this core
   // NOTE: At this point we handle EVERY thread that changed state every cycle
@@ -798,28 +1352,42 @@ void RevCPU::HandleThreadStateChangesForProc( uint32_t ProcID ) {
     case ThreadState::DONE:
       // This thread has completed execution
       output.verbose( CALL_INFO, 8, 0, "Thread %" PRIu32 " on Core %" PRIu32 " is DONE\n", ThreadID, ProcID );
+      output.verbose(
+        CALL_INFO,
+        3,
+        0,
+        "Thread %" PRIu32 " Runtime: %" PRIu64 " cycles; Context Switches: %" PRIu64 "\n",
+        ThreadID,
+        Thread->GetRuntime(),
+        Thread->GetContextSwitches()
+      );
+      ThreadRuntime->addData( Thread->GetRuntime() );
       CompletedThreads.emplace( ThreadID, std::move( Thread ) );
       break;
 
     case ThreadState::BLOCKED:
-      // This thread is blocked (currently only caused by a rev_pthread_join)
+      // This thread is blocked (rev_pthread_join, futex wait or sleep)
       output.verbose( CALL_INFO, 8, 0, "Thread %" PRIu32 "on Core %" PRIu32 " is BLOCKED\n", ThreadID, ProcID );
 
       // Set its state to BLOCKED
       Thread->SetState( ThreadState::BLOCKED );
 
-      // Add it to BlockedThreads
-      BlockedThreads.emplace_back( std::move( Thread ) );
+      if( Thread->GetFutexAddr() != _INVALID_ADDR_ ) {
+        FutexWait( std::move( Thread ) );
+      } else if( Thread->GetWakeCycle() ) {
+        uint64_t WakeCycle = Thread->GetWakeCycle();
+        SleepingThreads.emplace( WakeCycle, std::move( Thread ) );
+      } else {
+        // Add it to BlockedThreads
+        BlockedThreads.emplace_back( std::move( Thread ) );
+      }
       break;
     case ThreadState::START:
       // A new thread was created
       output.verbose( CALL_INFO, 99, 1, "A new thread with ID = %" PRIu32 " was found on Core %" PRIu32, Thread->GetID(), ProcID );
 
-      // Mark it ready for execution
-      Thread->SetState( ThreadState::READY );
-
-      // Add it to the ReadyThreads so it is scheduled
-      ReadyThreads.emplace_back( std::move( Thread ) );
+      // Mark it ready for execution and queue it on the creating core so it is scheduled
+      PushReadyThread( std::move( Thread ), ProcID );
 
       break;
 
@@ -828,14 +1396,9 @@ void RevCPU::HandleThreadStateChangesForProc( uint32_t ProcID ) {
       break;
 
     case ThreadState::READY:
-      // If this happens we are not setting state when assigning thread somewhere
-      output.fatal(
-        CALL_INFO,
-        99,
-        "Error: Thread %" PRIu32 " on Core %" PRIu32 " is assigned but is in READY state... This is a bug\n",
-        ThreadID,
-        ProcID
-      );
+      // The thread gave up its hart in sched_yield; queue it behind the ready threads
+      output.verbose( CALL_INFO, 8, 0, "Thread %" PRIu32 " on Core %" PRIu32 " yielded\n", ThreadID, ProcID );
+      PushReadyThread( std::move( Thread ) );
       break;
     default:  // Should DEFINITELY never happen
       output.fatal(
@@ -896,7 +1459,274 @@ void RevCPU::InitMainThread( uint32_t MainThreadID, const uint64_t StartAddr ) {
   output.verbose( CALL_INFO, 11, 0, "Main thread initialized %s\n", MainThread->to_string().c_str() );
 
   // Add to ReadyThreads so it gets scheduled
-  ReadyThreads.emplace_back( std::move( MainThread ) );
+  PushReadyThread( std::move( MainThread ) );
+}
+
+// Writes a snapshot of the loaded program or, with Checkpoint, of the whole
+// run at Cycle. Memory is streamed page by page.
+void RevCPU::WriteSnapshot( const std::string& Path, bool Checkpoint, uint64_t Cycle ) {
+  RevSnapshotOut Snap( Path, &output );
+  Snap.Put( REV_SNAPSHOT_TAG_CPU );
+  Snap.Put( Program );
+  Snap.Put( Opts->GetArgv() );
+  Snap.Put( uint8_t( Checkpoint ) );
+  Mem->SaveSnapshot( Snap );
+  Loader->SaveSnapshot( Snap );
+  if( Checkpoint )
+    SaveCheckpoint( Snap, Cycle );
+  Snap.Close();
+}
+
+int RevCPU::RequestCheckpoint() {
+  if( EnableMemH || EnableCoProc )
+    return -ENOTSUP;
+  if( !CheckpointPending )
+    output.verbose( CALL_INFO, 4, 0, "Checkpoint requested; taking threads off their harts\n" );
+  CheckpointPending = true;
+  return 0;
+}
+
+bool RevCPU::CheckpointQuiesced() const {
+  for( const auto& Proc : Procs ) {
+    if( !Proc->HasNoBusyHarts() )
+      return false;
+  }
+  return TrackTags.empty() && ZeroRqst.empty() && !( Ctrl && Ctrl->getTotalRqsts() ) && !( rmtCtrl && !rmtCtrl->isQuiesced() );
+}
+
+void RevCPU::WriteCheckpoint( uint64_t Cycle ) {
+  auto        Start = std::chrono::steady_clock::now();
+  std::string Path  = CheckpointPrefix + "." + getName() + "." + std::to_string( Cycle ) + ".ckpt";
+
+  // Fold the statistics of every core into the totals that are saved
+  for( unsigned i = 0; i < numCores; i++ )
+    UpdateCoreStatistics( i );
+
+  WriteSnapshot( Path, true, Cycle );
+  output.verbose(
+    CALL_INFO,
+    2,
+    0,
+    "Wrote checkpoint %s at cycle %" PRIu64 " in %.3f s\n",
+    Path.c_str(),
+    Cycle,
+    std::chrono::duration<double>( std::chrono::steady_clock::now() - Start ).count()
+  );
+}
+
+// Calls Func on every thread known to RevCPU. At a checkpoint no thread is
+// on a hart, so this covers all of them.
+void RevCPU::ForEachThread( const std::function<void( RevThread& )>& Func ) {
+  for( auto& Thread : ReadyThreads )
+    Func( *Thread );
+  for( auto& Queue : CoreReadyThreads )
+    for( auto& Thread : Queue )
+      Func( *Thread );
+  for( auto& Thread : BlockedThreads )
+    Func( *Thread );
+  for( auto& [Addr, Futex] : Futexes )
+    for( auto& Thread : Futex.Waiters )
+      Func( *Thread );
+  for( auto& [WakeCycle, Thread] : SleepingThreads )
+    Func( *Thread );
+  for( auto& [ID, Thread] : CompletedThreads )
+    Func( *Thread );
+  for( auto& [Core, Hart, Thread] : CheckpointEvicted )
+    Func( *Thread );
+}
+
+// The threads go back where they were so that the run continues with the
+// same placement as without the checkpoint. Only the cycles the cores spent
+// draining for the checkpoint are lost.
+void RevCPU::ReturnEvictedThreads() {
+  for( auto& [Core, Hart, Thread] : CheckpointEvicted ) {
+    Procs[Core]->ReturnThread( std::move( Thread ), Hart );
+    Enabled[Core] = true;
+  }
+  CheckpointEvicted.clear();
+}
+
+void RevCPU::SaveCheckpoint( RevSnapshotOut& Snap, uint64_t Cycle ) {
+  Snap.Put( REV_SNAPSHOT_TAG_RUN );
+  Snap.Put( Cycle );
+  Snap.Put( numCores );
+  Snap.Put( numHarts );
+  Snap.Put( ReadySeq );
+  Snap.Put( AssignStart );
+  Snap.Put( SharedMemoryBase );
+  Snap.Put( Mem->GetMemStatsTotal() );
+  for( const auto& Proc : Procs )
+    Proc->SaveSnapshot( Snap );
+
+  // Host files opened by the guest, by path, flags and offset
+  std::set<int> FDs;
+  ForEachThread( [&]( RevThread& Thread ) {
+    for( int fd : Thread.GetFildes() )
+      if( fd > 2 )
+        FDs.insert( fd );
+  } );
+  std::vector<std::tuple<int, std::string, int, int64_t>> Files;
+  for( int fd : FDs ) {
+    char    Link[PATH_MAX];
+    ssize_t Len   = readlink( ( "/proc/self/fd/" + std::to_string( fd ) ).c_str(), Link, sizeof( Link ) - 1 );
+    int     Flags = fcntl( fd, F_GETFL );
+    if( Len <= 0 || Link[0] != '/' || Flags < 0 ) {
+      output.verbose( CALL_INFO, 1, 0, "Warning: descriptor %d is not an open file and is not restored from the checkpoint\n", fd );
+      continue;
+    }
+    Files.emplace_back( fd, std::string( Link, Len ), Flags, int64_t( lseek( fd, 0, SEEK_CUR ) ) );
+  }
+  Snap.Put( uint64_t( Files.size() ) );
+  for( const auto& [fd, Path, Flags, Offset] : Files ) {
+    Snap.Put( fd );
+    Snap.Put( Path );
+    Snap.Put( Flags );
+    Snap.Put( Offset );
+  }
+
+  // Thread queues
+  auto PutThreads = [&]( const auto& Queue ) {
+    Snap.Put( uint64_t( Queue.size() ) );
+    for( const auto& Thread : Queue )
+      Thread->SaveSnapshot( Snap );
+  };
+  // a restored run places the threads taken off for the checkpoint anew
+  Snap.Put( uint64_t( ReadyThreads.size() + CheckpointEvicted.size() ) );
+  for( const auto& Thread : ReadyThreads )
+    Thread->SaveSnapshot( Snap );
+  for( const auto& [Core, Hart, Thread] : CheckpointEvicted )
+    Thread->SaveSnapshot( Snap );
+  for( const auto& Queue : CoreReadyThreads )
+    PutThreads( Queue );
+  PutThreads( BlockedThreads );
+  Snap.Put( uint64_t( Futexes.size() ) );
+  for( const auto& [Addr, Futex] : Futexes ) {
+    Snap.Put( Addr );
+    Snap.Put( Futex.Wakes );
+    PutThreads( Futex.Waiters );
+  }
+  Snap.Put( uint64_t( FutexTimeouts.size() ) );
+  for( const auto& [WakeCycle, Waiter] : FutexTimeouts ) {
+    Snap.Put( WakeCycle );
+    Snap.Put( Waiter.first );
+    Snap.Put( Waiter.second );
+  }
+  Snap.Put( uint64_t( SleepingThreads.size() ) );
+  for( const auto& [WakeCycle, Thread] : SleepingThreads ) {
+    Snap.Put( WakeCycle );
+    Thread->SaveSnapshot( Snap );
+  }
+  Snap.Put( uint64_t( CompletedThreads.size() ) );
+  for( const auto& [ID, Thread] : CompletedThreads )
+    Thread->SaveSnapshot( Snap );
+}
+
+// Restores the run of a checkpoint after the cores have been created. The
+// guest files are reopened on the descriptor numbers the guest knows them by.
+void RevCPU::LoadCheckpoint( RevSnapshotIn& Snap ) {
+  uint32_t            SnapCores, SnapHarts;
+  RevMem::RevMemStats MemStats;
+  Snap.Expect( REV_SNAPSHOT_TAG_RUN, "run" );
+  Snap.Get( CycleBase );
+  Snap.Get( SnapCores );
+  Snap.Get( SnapHarts );
+  if( SnapCores != numCores || SnapHarts != numHarts )
+    output.fatal(
+      CALL_INFO,
+      -1,
+      "Error: checkpoint %s has %" PRIu32 " cores with %" PRIu32 " harts; this run has %" PRIu32 " with %" PRIu32 "\n",
+      Snap.GetPath().c_str(),
+      SnapCores,
+      SnapHarts,
+      numCores,
+      numHarts
+    );
+  Snap.Get( ReadySeq );
+  Snap.Get( AssignStart );
+  Snap.Get( SharedMemoryBase );
+  Snap.Get( MemStats );
+  Mem->SetMemStatsTotal( MemStats );
+  for( auto& Proc : Procs )
+    Proc->LoadSnapshot( Snap );
+  NextCheckpoint = CycleBase + CheckpointPeriod;
+
+  uint64_t Count;
+  Snap.Get( Count );
+  while( Count-- ) {
+    int         fd, Flags;
+    std::string Path;
+    int64_t     Offset;
+    Snap.Get( fd );
+    Snap.Get( Path );
+    Snap.Get( Flags );
+    Snap.Get( Offset );
+    if( fcntl( fd, F_GETFD ) != -1 )
+      output.fatal( CALL_INFO, -1, "Error: descriptor %d of %s is already in use; it cannot be restored\n", fd, Path.c_str() );
+    int hostfd = open( Path.c_str(), Flags & ~( O_CREAT | O_EXCL | O_TRUNC ) );
+    if( hostfd < 0 )
+      output.fatal( CALL_INFO, -1, "Error: could not reopen %s on descriptor %d: %s\n", Path.c_str(), fd, strerror( errno ) );
+    if( hostfd != fd ) {
+      dup2( hostfd, fd );
+      close( hostfd );
+    }
+    lseek( fd, Offset, SEEK_SET );
+  }
+
+  // Thread queues
+  auto GetThread  = [&]() { return RevThread::LoadSnapshot( Snap, Mem.get(), Procs ); };
+  auto GetThreads = [&]( auto& Queue ) {
+    uint64_t Len;
+    Snap.Get( Len );
+    while( Len-- )
+      Queue.emplace_back( GetThread() );
+  };
+  GetThreads( ReadyThreads );
+  for( auto& Queue : CoreReadyThreads ) {
+    GetThreads( Queue );
+    CoreQueued += Queue.size();
+  }
+  GetThreads( BlockedThreads );
+  Snap.Get( Count );
+  while( Count-- ) {
+    uint64_t Addr;
+    Snap.Get( Addr );
+    FutexQueue& Futex = Futexes[Addr];
+    Snap.Get( Futex.Wakes );
+    GetThreads( Futex.Waiters );
+    FutexWaiters += Futex.Waiters.size();
+  }
+  Snap.Get( Count );
+  while( Count-- ) {
+    uint64_t WakeCycle, Addr;
+    uint32_t ID;
+    Snap.Get( WakeCycle );
+    Snap.Get( ID );
+    Snap.Get( Addr );
+    FutexTimeouts.emplace( WakeCycle, std::make_pair( ID, Addr ) );
+  }
+  Snap.Get( Count );
+  while( Count-- ) {
+    uint64_t WakeCycle;
+    Snap.Get( WakeCycle );
+    SleepingThreads.emplace( WakeCycle, GetThread() );
+  }
+  Snap.Get( Count );
+  while( Count-- ) {
+    std::unique_ptr<RevThread> Thread = GetThread();
+    uint32_t                   ID     = Thread->GetID();
+    CompletedThreads.emplace( ID, std::move( Thread ) );
+  }
+
+  output.verbose(
+    CALL_INFO,
+    2,
+    0,
+    "Restarting at cycle %" PRIu64 " with %zu ready, %zu blocked and %zu completed thread(s)\n",
+    CycleBase,
+    NumReadyThreads(),
+    BlockedThreads.size() + FutexWaiters + SleepingThreads.size(),
+    CompletedThreads.size()
+  );
 }
 
 }  // namespace SST::RevCPU
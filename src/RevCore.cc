@@ -59,6 +59,15 @@ RevCore::RevCore(
     ) );
     ValidHarts.set( i, true );
   }
+  HartStalls.resize( numHarts );
+  ReadyWords.resize( ( numHarts + 63 ) / 64 );
+  HartInFlight.resize( numHarts );
+  HartSliceStart.resize( numHarts );
+  HartRunStart.resize( numHarts );
+  EcallCalls.resize( GetEcallCodes().size() );
+  EcallCycles.resize( GetEcallCodes().size() );
+  EcallCallsTotal.resize( GetEcallCodes().size() );
+  EcallCyclesTotal.resize( GetEcallCodes().size() );
 
   unsigned Depth = 0;
   opts->GetPrefetchDepth( id, Depth );
@@ -66,6 +75,11 @@ RevCore::RevCore(
     Depth = 16;
   }
 
+  // multi-issue timing model; width 1 keeps the scalar pipeline unless SetWideIssue selects it
+  opts->GetIssueWidth( id, IssueWidth );
+  opts->GetFULatency( id, FULatency );
+  WideIssue = IssueWidth > 1;
+
   sfetch =
     std::make_unique<RevPrefetcher>( mem, feature, Depth, LSQueue, [=]( const MemReq& req ) { this->MarkLoadComplete( req ); } );
   if( !sfetch )
@@ -138,6 +152,7 @@ bool RevCore::EnableExt( RevExt* Ext ) {
     InstTable.reserve( InstTable.size() + Table.size() );
     for( unsigned i = 0; i < Table.size(); i++ ) {
       InstTable.push_back( Table[i] );
+      InstFU.push_back( FUClass( Table[i], Ext->GetName() ) );
       auto ExtObj = std::pair<unsigned, unsigned>( Extensions.size() - 1, i );
       EntryToExt.insert( std::pair<unsigned, std::pair<unsigned, unsigned>>( InstTable.size() - 1, ExtObj ) );
     }
@@ -155,6 +170,34 @@ bool RevCore::EnableExt( RevExt* Ext ) {
   return true;
 }
 
+RevCore::RevFU RevCore::FUClass( const RevInstEntry& Entry, std::string_view ExtName ) {
+  const uint8_t Op = Entry.opcode;
+
+  // xBGAS: everything but the extended address arithmetic accesses memory
+  if( ExtName == "RV32X" || ExtName == "RV64X" ) {
+    bool EAddr = ( Op == 0b1111011 && ( Entry.funct3 == 0b110 || Entry.funct3 == 0b101 ) ) ||  // eaddi, eaddie
+                 ( Op == 0b0000011 && Entry.funct3 == 0b111 );                                 // eaddix
+    return EAddr ? RevFU::ALU : RevFU::LSU;
+  }
+
+  // loads, stores and atomics, including floating point loads and stores
+  bool Mem;
+  if( Entry.compressed ) {
+    // quadrant 0: all but c.addi4spn; quadrant 2: the stack pointer relative loads and stores
+    Mem = ( Op == 0b00 && Entry.funct3 != 0b000 ) || ( Op == 0b10 && Entry.funct3 != 0b000 && Entry.funct3 != 0b100 );
+  } else {
+    Mem = Op == 0b0000011 || Op == 0b0100011 || Op == 0b0000111 || Op == 0b0100111 || Op == 0b0101111;
+  }
+  if( Mem )
+    return RevFU::LSU;
+
+  if( ExtName == "RV32M" || ExtName == "RV64M" )
+    return RevFU::MulDiv;
+  if( ExtName == "RV32F" || ExtName == "RV64F" || ExtName == "RV32D" || ExtName == "RV64D" || ExtName == "Zfa" )
+    return RevFU::FPU;
+  return RevFU::ALU;
+}
+
 bool RevCore::SeedInstTable() try {
   output->verbose(
     CALL_INFO, 6, 0, "Core %" PRIu32 " ; Seeding instruction table for machine model=%s\n", id, feature->GetMachineModel().data()
@@ -1558,34 +1601,38 @@ void RevCore::HandleALUFault( unsigned width ) {
   output->verbose( CALL_INFO, 5, 0, "FAULT:ALU: ALU fault injected into next retire cycle\n" );
 }
 
-bool RevCore::DependencyCheck( unsigned HartID, const RevInst* I ) const {
+RevStall RevCore::DependencyCheck( unsigned HartID, const RevInst* I ) const {
   const RevRegFile*   regFile = GetRegFile( HartID );
   const RevInstEntry* E       = &InstTable[I->entry];
 
   // For ECALL, check for any outstanding dependencies on a0-a7
   if( I->opcode == 0b1110011 && I->imm == 0 && I->funct3 == 0 && I->rd == 0 && I->rs1 == 0 ) {
     for( RevReg reg : { RevReg::a7, RevReg::a0, RevReg::a1, RevReg::a2, RevReg::a3, RevReg::a4, RevReg::a5, RevReg::a6 } ) {
-      if( LSQCheck( HartToDecodeID, RegFile, uint16_t( reg ), RevRegClass::RegGPR ) ||
-          ScoreboardCheck( RegFile, uint16_t( reg ), RevRegClass::RegGPR ) ) {
-        return true;
-      }
+      if( LSQCheck( HartToDecodeID, RegFile, uint16_t( reg ), RevRegClass::RegGPR ) )
+        return RevStall::LoadHazard;
+      if( ScoreboardCheck( RegFile, uint16_t( reg ), RevRegClass::RegGPR ) )
+        return RevStall::Scoreboard;
     }
-    return false;
+    return RevStall::None;
   }
 
-  return
-    // check LS queue for outstanding load
-    LSQCheck( HartID, regFile, I->rs1, E->rs1Class ) || LSQCheck( HartID, regFile, I->rs2, E->rs2Class ) ||
-    LSQCheck( HartID, regFile, I->rs3, E->rs3Class ) || LSQCheck( HartID, regFile, I->rd, E->rdClass ) ||
+  // check LS queue for outstanding load
+  if( LSQCheck( HartID, regFile, I->rs1, E->rs1Class ) || LSQCheck( HartID, regFile, I->rs2, E->rs2Class ) ||
+      LSQCheck( HartID, regFile, I->rs3, E->rs3Class ) || LSQCheck( HartID, regFile, I->rd, E->rdClass ) )
+    return RevStall::LoadHazard;
+
+  // xBGAS: check remote LS queue for outstanding load and store-conditional
+  if( RmtLSQCheck( HartID, regFile, I->rs1, E->rs1Class ) || RmtLSQCheck( HartID, regFile, I->rs2, E->rs2Class ) ||
+      RmtLSQCheck( HartID, regFile, I->rs3, E->rs3Class ) || RmtLSQCheck( HartID, regFile, I->rd, E->rdClass ) )
+    return RevStall::RmtLoadHazard;
 
-    // xBGAS: check remote LS queue for outstanding load and store-conditional
-    RmtLSQCheck( HartID, regFile, I->rs1, E->rs1Class ) || RmtLSQCheck( HartID, regFile, I->rs2, E->rs2Class ) ||
-    RmtLSQCheck( HartID, regFile, I->rs3, E->rs3Class ) || RmtLSQCheck( HartID, regFile, I->rd, E->rdClass ) ||
+  // Iterate through the source registers rs1, rs2, rs3 and find any dependency
+  // based on the class of the source register and the associated scoreboard
+  if( ScoreboardCheck( regFile, I->rs1, E->rs1Class ) || ScoreboardCheck( regFile, I->rs2, E->rs2Class ) ||
+      ScoreboardCheck( regFile, I->rs3, E->rs3Class ) )
+    return RevStall::Scoreboard;
 
-    // Iterate through the source registers rs1, rs2, rs3 and find any dependency
-    // based on the class of the source register and the associated scoreboard
-    ScoreboardCheck( regFile, I->rs1, E->rs1Class ) || ScoreboardCheck( regFile, I->rs2, E->rs2Class ) ||
-    ScoreboardCheck( regFile, I->rs3, E->rs3Class );
+  return RevStall::None;
 }
 
 void RevCore::ExternalStallHart( RevCorePasskey<RevCoProc>, uint16_t HartID ) {
@@ -1604,24 +1651,69 @@ void RevCore::ExternalReleaseHart( RevCorePasskey<RevCoProc>, uint16_t HartID )
   }
 }
 
-unsigned RevCore::GetNextHartToDecodeID() const {
+template<typename F>
+void RevCore::ScanReadyHarts( unsigned From, F&& Visit ) const {
+  // Bit scan the words of ReadyWords, starting just after From and wrapping
+  // around to the bits below it in the first word
+  const size_t   Words = ReadyWords.size();
+  const unsigned Start = ( From + 1 ) % numHarts;
+  const size_t   First = Start / 64;
+  const uint64_t High  = ~uint64_t{ 0 } << ( Start % 64 );
+  for( size_t n = 0; n <= Words; n++ ) {
+    size_t   w    = ( First + n ) % Words;
+    uint64_t Bits = ReadyWords[w] & ( n == 0 ? High : n == Words ? ~High : ~uint64_t{ 0 } );
+    for( ; Bits; Bits &= Bits - 1 ) {
+      if( Visit( unsigned( w * 64 + __builtin_ctzll( Bits ) ) ) )
+        return;
+    }
+  }
+}
+
+unsigned RevCore::GetNextHartToDecodeID() {
   if( HartsClearToDecode.none() ) {
     return HartToDecodeID;
   };
 
   unsigned nextID = HartToDecodeID;
-  if( HartsClearToDecode[HartToDecodeID] ) {
-    nextID = HartToDecodeID;
-  } else {
-    for( size_t tID = 0; tID < Harts.size(); tID++ ) {
-      nextID++;
-      if( nextID >= Harts.size() ) {
-        nextID = 0;
+  switch( HartPolicy ) {
+  case RevHartPolicy::SwitchOnStall:
+  case RevHartPolicy::SwitchOnHazard:
+    // stay on the current hart while it can decode; switch-on-hazard also
+    // moves on when its last decode hit a hazard
+    if( HartsClearToDecode[HartToDecodeID] && ( HartPolicy == RevHartPolicy::SwitchOnStall || !DecodeStalled ) )
+      break;
+    [[fallthrough]];
+  case RevHartPolicy::RoundRobin:
+    // the first ready hart after the current one
+    ScanReadyHarts( HartToDecodeID, [&]( unsigned h ) {
+      nextID = h;
+      return true;
+    } );
+    break;
+  case RevHartPolicy::ICount: {
+    // instructions in the pipeline and outstanding local and remote loads of each hart
+    std::fill( HartInFlight.begin(), HartInFlight.end(), 0 );
+    for( const auto& p : Pipeline )
+      HartInFlight[p.first]++;
+    for( const auto& l : *LSQueue )
+      HartInFlight[l.second.Hart]++;
+    for( const auto& l : *RmtLSQueue )
+      HartInFlight[l.second.Hart]++;
+
+    // the least loaded ready hart; ties go to the first one after the current hart
+    unsigned Fewest = ~0u;
+    ScanReadyHarts( HartToDecodeID, [&]( unsigned h ) {
+      if( HartInFlight[h] < Fewest ) {
+        Fewest = HartInFlight[h];
+        nextID = h;
       }
-      if( HartsClearToDecode[nextID] ) {
-        break;
-      };
-    }
+      return Fewest == 0;
+    } );
+    break;
+  }
+  }
+
+  if( nextID != HartToDecodeID ) {
     output->verbose(
       CALL_INFO, 6, 0, "Core %" PRIu32 "; Hart switch from %" PRIu32 " to %" PRIu32 "\n", id, HartToDecodeID, nextID
     );
@@ -1691,12 +1783,151 @@ void RevCore::MarkRmtOpComplete( const RmtMemReq& req ) {
   );
 }
 
+RevStall RevCore::DecodeInst( RevInst& Inst ) {
+  ActiveThreadID = Harts.at( HartToDecodeID )->GetAssignedThreadID();
+  RegFile        = Harts[HartToDecodeID]->RegFile.get();
+
+  feature->SetHartToExecID( HartToDecodeID );
+
+  // fetch the next instruction
+  if( !PrefetchInst() ) {
+    Stalled = true;
+    Stats.cyclesStalled++;
+  } else {
+    Stalled = false;
+  }
+
+  if( !Stalled && !CoProcStallReq[HartToDecodeID] ) {
+    Inst       = FetchAndDecodeInst();
+    Inst.entry = RegFile->GetEntry();
+  }
+
+  // Now that we have decoded the instruction, check for pipeline hazards
+  if( ExecEcall() )
+    return RevStall::Ecall;
+  if( Stalled )
+    return RevStall::Fetch;
+  RevStall Hazard = DependencyCheck( HartToDecodeID, &Inst );
+  if( Hazard == RevStall::None && CoProcStallReq[HartToDecodeID] )
+    Hazard = RevStall::CoProc;
+  return Hazard;
+}
+
+void RevCore::ReportStall( RevStall Hazard ) {
+  CountStall( HartToDecodeID, Hazard );
+  if( Profiler ) {
+    // the PC has already moved past an ECALL (never compressed)
+    uint64_t StallPC = RegFile->GetPC() - ( Hazard == RevStall::Ecall ? 4 : 0 );
+    Profiler->Stall( HartToDecodeID, StallPC, Hazard );
+  }
+}
+
+void RevCore::IssueInst( RevInst& Inst, SST::Cycle_t currentCycle ) {
+#ifdef NO_REV_TRACER
+  // pull the PC
+  output->verbose(
+    CALL_INFO,
+    6,
+    0,
+    "Core %" PRIu32 "; Hart %" PRIu32 "; Thread %" PRIu32 "; Executing PC= 0x%" PRIx64 "\n",
+    id,
+    HartToExecID,
+    ActiveThreadID,
+    ExecPC
+  );
+#endif
+
+  // Find the instruction extension
+  auto it = EntryToExt.find( RegFile->GetEntry() );
+  if( it == EntryToExt.end() ) {
+    // failed to find the extension
+    output->fatal( CALL_INFO, -1, "Error: failed to find the instruction extension at PC=%" PRIx64 ".", ExecPC );
+  }
+
+  // found the instruction extension
+  std::pair<unsigned, unsigned> EToE = it->second;
+  RevExt*                       Ext  = Extensions[EToE.first].get();
+
+  // -- BEGIN new pipelining implementation
+  Pipeline.emplace_back( std::make_pair( HartToExecID, Inst ) );
+
+  if( ( Ext->GetName() == "RV32F" ) || ( Ext->GetName() == "RV32D" ) || ( Ext->GetName() == "RV64F" ) ||
+      ( Ext->GetName() == "RV64D" ) ) {
+    Stats.floatsExec++;
+  }
+
+  // set the hazarding
+  DependencySet( HartToExecID, &( Pipeline.back().second ) );
+  // -- END new pipelining implementation
+
+#ifndef NO_REV_TRACER
+  // Tracer context; the memory is shared with the other cores
+  if( Tracer )
+    mem->SetTracer( Tracer );
+  RegFile->SetTracer( Tracer );
+#endif
+
+  // execute the instruction
+  uint64_t BytesBefore = Profiler ? mem->GetBytesAccessed() : 0;
+  if( !Ext->Execute( EToE.second, Pipeline.back().second, HartToExecID, RegFile ) ) {
+    output->fatal( CALL_INFO, -1, "Error: failed to execute instruction at PC=%" PRIx64 ".", ExecPC );
+  }
+  if( Profiler ) {
+    Profiler->Exec(
+      HartToExecID,
+      ExecPC,
+      RegFile->GetPC(),
+      RegFile->GetX<uint64_t>( RevReg::ra ),
+      Inst.instSize,
+      mem->GetBytesAccessed() - BytesBefore
+    );
+  }
+
+#ifndef NO_REV_TRACER
+  // Clear memory tracer so we don't pick up instruction fetches and other access.
+  // TODO: method to determine origin of memory access (core, cache, pan, host debugger, ... )
+  if( Tracer )
+    mem->SetTracer( nullptr );
+  // Conditionally trace after execution
+  if( Tracer )
+    Tracer->Exec( currentCycle, id, HartToExecID, ActiveThreadID, InstTable[Inst.entry].mnemonic );
+#endif
+
+#ifdef __REV_DEEP_TRACE__
+  if( feature->IsRV64() ) {
+    std::cout << "RDT: Executed PC = " << std::hex << ExecPC << " Inst: " << std::setw( 23 ) << InstTable[Inst.entry].mnemonic
+              << " r" << std::dec << (uint32_t) Inst.rd << "= " << std::hex << RegFile->RV64[Inst.rd] << " r" << std::dec
+              << (uint32_t) Inst.rs1 << "= " << std::hex << RegFile->RV64[Inst.rs1] << " r" << std::dec << (uint32_t) Inst.rs2
+              << "= " << std::hex << RegFile->RV64[Inst.rs2] << " imm = " << std::hex << Inst.imm << std::endl;
+    std::cout << "RDT: Address of RD = 0x" << std::hex << (uint64_t*) ( &RegFile->RV64[Inst.rd] ) << std::dec << std::endl;
+  } else {
+    std::cout << "RDT: Executed PC = " << std::hex << ExecPC << " Inst: " << std::setw( 23 ) << InstTable[Inst.entry].mnemonic
+              << " r" << std::dec << (uint32_t) Inst.rd << "= " << std::hex << RegFile->RV32[Inst.rd] << " r" << std::dec
+              << (uint32_t) Inst.rs1 << "= " << std::hex << RegFile->RV32[Inst.rs1] << " r" << std::dec << (uint32_t) Inst.rs2
+              << "= " << std::hex << RegFile->RV32[Inst.rs2] << " imm = " << std::hex << Inst.imm << std::endl;
+  }
+#endif
+
+  // inject the ALU fault
+  if( ALUFault ) {
+    InjectALUFault( EToE, Inst );
+  }
+
+  // if this is a singlestep, clear the singlestep and halt
+  if( SingleStep ) {
+    SingleStep = false;
+    Halted     = true;
+  }
+}
+
 bool RevCore::ClockTick( SST::Cycle_t currentCycle ) {
   RevInst Inst;
   bool    rtn = false;
   ++Stats.totalCycles;
   ++cycles;
   currentSimCycle = currentCycle;
+  if( Profiler )
+    Profiler->Tick();
 
   // -- MAIN PROGRAM LOOP --
   //
@@ -1708,33 +1939,34 @@ bool RevCore::ClockTick( SST::Cycle_t currentCycle ) {
   // ready to decode
   UpdateStatusOfHarts();
 
+  // Harts without a thread; the core stalls on NoThread only when all of them are empty
+  if( IdleHarts.any() ) {
+    for( unsigned i = 0; i < numHarts; i++ ) {
+      if( IdleHarts[i] )
+        HartStalls[i][unsigned( RevStall::NoThread ) - 1]++;
+    }
+    if( ( IdleHarts & ValidHarts ) == ValidHarts )
+      Stats.stalls[unsigned( RevStall::NoThread ) - 1]++;
+  }
+
+  // Multi-issue timing model
+  if( WideIssue )
+    return ClockTickWide( currentCycle );
+
   if( HartsClearToDecode.any() && ( !Halted ) ) {
     // Determine what hart is ready to decode
     HartToDecodeID = GetNextHartToDecodeID();
-    ActiveThreadID = Harts.at( HartToDecodeID )->GetAssignedThreadID();
-    RegFile        = Harts[HartToDecodeID]->RegFile.get();
 
-    feature->SetHartToExecID( HartToDecodeID );
-
-    // fetch the next instruction
-    if( !PrefetchInst() ) {
-      Stalled = true;
-      Stats.cyclesStalled++;
-    } else {
-      Stalled = false;
-    }
-
-    if( !Stalled && !CoProcStallReq[HartToDecodeID] ) {
-      Inst       = FetchAndDecodeInst();
-      Inst.entry = RegFile->GetEntry();
-    }
+    // Decode the instruction and check for pipeline hazards
+    RevStall Hazard = DecodeInst( Inst );
+    DecodeStalled   = Hazard != RevStall::None;
 
-    // Now that we have decoded the instruction, check for pipeline hazards
-    if( ExecEcall() || Stalled || DependencyCheck( HartToDecodeID, &Inst ) || CoProcStallReq[HartToDecodeID] ) {
+    if( Hazard != RevStall::None ) {
       RegFile->SetCost( 0 );        // We failed dependency check, so set cost to 0 - this will
       Stats.cyclesIdle_Pipeline++;  // prevent the instruction from advancing to the next stage
       HartsClearToExecute[HartToDecodeID] = false;
       HartToExecID                        = _REV_INVALID_HART_ID_;
+      ReportStall( Hazard );
     } else {
       Stats.cyclesBusy++;
       HartsClearToExecute[HartToDecodeID] = true;
@@ -1751,88 +1983,7 @@ bool RevCore::ClockTick( SST::Cycle_t currentCycle ) {
     // HartToExecID = HartToDecodeID;
     RegFile->SetTrigger( true );
 
-#ifdef NO_REV_TRACER
-    // pull the PC
-    output->verbose(
-      CALL_INFO,
-      6,
-      0,
-      "Core %" PRIu32 "; Hart %" PRIu32 "; Thread %" PRIu32 "; Executing PC= 0x%" PRIx64 "\n",
-      id,
-      HartToExecID,
-      ActiveThreadID,
-      ExecPC
-    );
-#endif
-
-    // Find the instruction extension
-    auto it = EntryToExt.find( RegFile->GetEntry() );
-    if( it == EntryToExt.end() ) {
-      // failed to find the extension
-      output->fatal( CALL_INFO, -1, "Error: failed to find the instruction extension at PC=%" PRIx64 ".", ExecPC );
-    }
-
-    // found the instruction extension
-    std::pair<unsigned, unsigned> EToE = it->second;
-    RevExt*                       Ext  = Extensions[EToE.first].get();
-
-    // -- BEGIN new pipelining implementation
-    Pipeline.emplace_back( std::make_pair( HartToExecID, Inst ) );
-
-    if( ( Ext->GetName() == "RV32F" ) || ( Ext->GetName() == "RV32D" ) || ( Ext->GetName() == "RV64F" ) ||
-        ( Ext->GetName() == "RV64D" ) ) {
-      Stats.floatsExec++;
-    }
-
-    // set the hazarding
-    DependencySet( HartToExecID, &( Pipeline.back().second ) );
-    // -- END new pipelining implementation
-
-#ifndef NO_REV_TRACER
-    // Tracer context
-    mem->SetTracer( Tracer );
-    RegFile->SetTracer( Tracer );
-#endif
-
-    // execute the instruction
-    if( !Ext->Execute( EToE.second, Pipeline.back().second, HartToExecID, RegFile ) ) {
-      output->fatal( CALL_INFO, -1, "Error: failed to execute instruction at PC=%" PRIx64 ".", ExecPC );
-    }
-
-#ifndef NO_REV_TRACER
-    // Clear memory tracer so we don't pick up instruction fetches and other access.
-    // TODO: method to determine origin of memory access (core, cache, pan, host debugger, ... )
-    mem->SetTracer( nullptr );
-    // Conditionally trace after execution
-    if( Tracer )
-      Tracer->Exec( currentCycle, id, HartToExecID, ActiveThreadID, InstTable[Inst.entry].mnemonic );
-#endif
-
-#ifdef __REV_DEEP_TRACE__
-    if( feature->IsRV64() ) {
-      std::cout << "RDT: Executed PC = " << std::hex << ExecPC << " Inst: " << std::setw( 23 ) << InstTable[Inst.entry].mnemonic
-                << " r" << std::dec << (uint32_t) Inst.rd << "= " << std::hex << RegFile->RV64[Inst.rd] << " r" << std::dec
-                << (uint32_t) Inst.rs1 << "= " << std::hex << RegFile->RV64[Inst.rs1] << " r" << std::dec << (uint32_t) Inst.rs2
-                << "= " << std::hex << RegFile->RV64[Inst.rs2] << " imm = " << std::hex << Inst.imm << std::endl;
-      std::cout << "RDT: Address of RD = 0x" << std::hex << (uint64_t*) ( &RegFile->RV64[Inst.rd] ) << std::dec << std::endl;
-    } else {
-      std::cout << "RDT: Executed PC = " << std::hex << ExecPC << " Inst: " << std::setw( 23 ) << InstTable[Inst.entry].mnemonic
-                << " r" << std::dec << (uint32_t) Inst.rd << "= " << std::hex << RegFile->RV32[Inst.rd] << " r" << std::dec
-                << (uint32_t) Inst.rs1 << "= " << std::hex << RegFile->RV32[Inst.rs1] << " r" << std::dec << (uint32_t) Inst.rs2
-                << "= " << std::hex << RegFile->RV32[Inst.rs2] << " imm = " << std::hex << Inst.imm << std::endl;
-    }
-#endif
-
-    // inject the ALU fault
-    if( ALUFault ) {
-      InjectALUFault( EToE, Inst );
-    }
-
-    // if this is a singlestep, clear the singlestep and halt
-    if( SingleStep ) {
-      SingleStep = false;
-      Halted     = true;
-    }
+    IssueInst( Inst, currentCycle );
 
     rtn = true;
   } else {
@@ -1917,14 +2068,285 @@ bool RevCore::ClockTick( SST::Cycle_t currentCycle ) {
   return rtn;
 }
 
+bool RevCore::ClockTickWide( SST::Cycle_t currentCycle ) {
+  // -- MULTI-ISSUE LOOP --
+  //
+  // Issue up to IssueWidth instructions of one hart in program order, stopping
+  // at the first hazard, taken control transfer or trap. Each instruction then
+  // occupies the pipeline for the latency of its functional unit and retires
+  // on its own, so independent instructions are not held behind a long latency
+  // one. Dependent instructions wait on the scoreboard as in the scalar model.
+  unsigned Issued = 0;
+  RevStall Hazard = RevStall::None;
+
+  if( HartsClearToDecode.any() && !Halted ) {
+    // Determine what hart is ready to decode
+    HartToDecodeID = GetNextHartToDecodeID();
+
+    while( Issued < IssueWidth && !Halted ) {
+      RevInst Inst;
+      Hazard = DecodeInst( Inst );
+      if( Hazard != RevStall::None ) {
+        RegFile->SetCost( 0 );
+        break;
+      }
+
+      HartToExecID     = HartToDecodeID;
+      ExecPC           = RegFile->GetPC();
+      unsigned Latency = FULatency[unsigned( InstFU[Inst.entry] )];
+      Inst.cost        = std::max( Latency ? Latency : RegFile->GetCost(), 1u );
+      RegFile->SetTrigger( true );
+
+      IssueInst( Inst, currentCycle );
+      Issued++;
+
+      // the hart may issue again before this instruction retires; a load's
+      // memory cost is dropped as in the scalar model, its result is tracked
+      // by the load queue
+      RegFile->SetCost( 0 );
+
+#ifndef NO_REV_TRACER
+      if( Tracer )
+        Tracer->Render( currentCycle );
+#endif
+
+      // A taken control transfer or a trap ends the issue group
+      if( RegFile->GetPC() != ExecPC + Inst.instSize || RegFile->GetSCAUSE() != RevExceptionCause::NONE )
+        break;
+    }
+
+    DecodeStalled = Hazard != RevStall::None;
+    if( Issued ) {
+      Stats.cyclesBusy++;
+    } else {
+      HartToExecID = _REV_INVALID_HART_ID_;
+      Stats.cyclesIdle_Pipeline++;
+      ReportStall( Hazard );
+    }
+    HartsClearToExecute[HartToDecodeID] = Issued > 0;
+  }
+
+  if( !Issued ) {
+    output->verbose( CALL_INFO, 9, 0, "Core %" PRIu32 " ; No instruction issued\n", id );
+    Stats.cyclesIdle_Total++;
+  }
+
+  // Advance every instruction in flight; those that complete retire out of order
+  for( auto it = Pipeline.begin(); it != Pipeline.end(); ) {
+    auto& [HartID, RetireInst] = *it;
+    if( RetireInst.cost > 1 ) {
+      RetireInst.cost--;
+      ++it;
+      continue;
+    }
+
+    ++Stats.retired;
+    RevRegFile* HartRegFile = GetRegFile( HartID );
+    HartRegFile->IncrementInstRet();
+
+    // Only clear the dependency if there is no outstanding load
+    uint64_t Hash = LSQHash( RetireInst.rd, InstTable[RetireInst.entry].rdClass, HartID );
+    if( HartRegFile->GetLSQueue()->count( Hash ) == 0 && HartRegFile->GetRmtLSQueue()->count( Hash ) == 0 ) {
+      DependencyClear( HartID, &RetireInst );
+    }
+    it = Pipeline.erase( it );
+  }
+
+  // Check for completion states; the thread is done once its instructions have drained
+  if( !IdleHarts[HartToDecodeID] && RegFile->GetPC() == 0x00ull && HartHasNoDependencies( HartToDecodeID ) &&
+      std::none_of( Pipeline.begin(), Pipeline.end(), [this]( const auto& p ) { return p.first == HartToDecodeID; } ) ) {
+    std::unique_ptr<RevThread> ActiveThread = PopThreadFromHart( HartToDecodeID );
+    ActiveThread->SetState( ThreadState::DONE );
+    HartsClearToExecute[HartToDecodeID] = false;
+    HartsClearToDecode[HartToDecodeID]  = false;
+    IdleHarts.set( HartToDecodeID );
+    AddThreadsThatChangedState( std::move( ActiveThread ) );
+  }
+
+#ifndef NO_REV_TRACER
+  // Dump trace state when no instruction was rendered above
+  if( Tracer && !Issued )
+    Tracer->Render( currentCycle );
+#endif
+
+  return true;
+}
+
 std::unique_ptr<RevThread> RevCore::PopThreadFromHart( unsigned HartID ) {
   if( HartID >= numHarts ) {
     output->fatal(
       CALL_INFO, -1, "Error: tried to pop thread from hart %" PRIu32 " but there are only %" PRIu32 " hart(s)\n", HartID, numHarts
     );
   }
-  IdleHarts[HartID] = true;
-  return Harts.at( HartID )->PopThread();
+  IdleHarts[HartID]                 = true;
+  std::unique_ptr<RevThread> Thread = Harts.at( HartID )->PopThread();
+  Thread->AddRuntime( cycles - HartRunStart[HartID] );
+  Thread->SetLastCore( id );
+  return Thread;
+}
+
+bool RevCore::HartCanSwitch( unsigned HartID ) const {
+  const RevRegFile* HartRegFile = GetRegFile( HartID );
+  if( HartRegFile->GetPC() == 0x00ull || HartRegFile->GetSCAUSE() != RevExceptionCause::NONE || CoProcStallReq[HartID] ||
+      !HartHasNoDependencies( HartID ) )
+    return false;
+  for( const auto& p : Pipeline )
+    if( p.first == HartID )
+      return false;
+  for( const auto& l : *LSQueue )
+    if( l.second.Hart == HartID )
+      return false;
+  for( const auto& l : *RmtLSQueue )
+    if( l.second.Hart == HartID )
+      return false;
+  return true;
+}
+
+// Anything else (SYSTEM, FENCE, AMO, LR/SC and custom instructions) may
+// reach state shared with other cores or wait on it, so the core is ticked
+// in order with the others
+bool RevCore::CanTickIsolated() const {
+  // LOAD, LOAD-FP, OP-IMM, AUIPC, OP-IMM-32, STORE, STORE-FP, OP, LUI, OP-32,
+  // MADD, MSUB, NMSUB, NMADD, OP-FP, BRANCH, JALR and JAL
+  static constexpr uint32_t Isolated[] = { 0x03, 0x07, 0x13, 0x17, 0x1b, 0x23, 0x27, 0x33, 0x37,
+                                           0x3b, 0x43, 0x47, 0x4b, 0x4f, 0x53, 0x63, 0x67, 0x6f };
+
+  // c.ebreak is the only compressed instruction outside these
+  constexpr uint16_t CEbreak = 0x9002;
+
+  for( unsigned HartID = 0; HartID < numHarts; HartID++ ) {
+    if( IdleHarts[HartID] )
+      continue;
+    const RevRegFile* HartRegFile = GetRegFile( HartID );
+    if( HartRegFile->GetSCAUSE() != RevExceptionCause::NONE || CoProcStallReq[HartID] )
+      return false;
+
+    // the instructions the hart may issue next in program order
+    uint64_t PC = HartRegFile->GetPC();
+    for( unsigned i = 0; PC && i < IssueWidth; i++ ) {
+      uint32_t Inst = 0;
+      mem->PeekMem( PC, sizeof( Inst ), &Inst );
+      if( ( Inst & 0b11 ) != 0b11 ) {
+        if( uint16_t( Inst ) == CEbreak )
+          return false;
+        PC += 2;
+      } else {
+        if( std::find( std::begin( Isolated ), std::end( Isolated ), Inst & 0x7f ) == std::end( Isolated ) )
+          return false;
+        PC += 4;
+      }
+    }
+  }
+  return true;
+}
+
+std::vector<std::unique_ptr<RevThread>> RevCore::PreemptThreads( uint64_t Quantum, size_t MaxThreads ) {
+  std::vector<std::unique_ptr<RevThread>> Preempted;
+  for( unsigned HartID = 0; HartID < numHarts && Preempted.size() < MaxThreads; HartID++ ) {
+    if( IdleHarts[HartID] || cycles - HartSliceStart[HartID] < Quantum || !HartCanSwitch( HartID ) )
+      continue;
+    std::unique_ptr<RevThread> Thread = PopThreadFromHart( HartID );
+    Thread->SetState( ThreadState::READY );
+    Thread->AddContextSwitch();
+    HartsClearToExecute[HartID] = false;
+    HartsClearToDecode[HartID]  = false;
+    output->verbose(
+      CALL_INFO,
+      6,
+      0,
+      "Core %" PRIu32 "; Hart %" PRIu32 "; Preempted Thread %" PRIu32 " after %" PRIu64 " cycles\n",
+      id,
+      HartID,
+      Thread->GetID(),
+      cycles - HartSliceStart[HartID]
+    );
+    Preempted.push_back( std::move( Thread ) );
+  }
+  return Preempted;
+}
+
+// Takes every thread off its hart as soon as it has no work in flight. The
+// runtime up to now is added to the thread, but the time slice of the hart
+// is left running so that a returned thread is preempted when it would
+// have been without the checkpoint.
+std::vector<std::pair<unsigned, std::unique_ptr<RevThread>>> RevCore::EvictThreads() {
+  std::vector<std::pair<unsigned, std::unique_ptr<RevThread>>> Evicted;
+  for( unsigned HartID = 0; HartID < numHarts; HartID++ ) {
+    if( IdleHarts[HartID] || !HartCanSwitch( HartID ) )
+      continue;
+    std::unique_ptr<RevThread> Thread = PopThreadFromHart( HartID );
+    Thread->SetState( ThreadState::READY );
+    HartRunStart[HartID]        = cycles;
+    HartsClearToExecute[HartID] = false;
+    HartsClearToDecode[HartID]  = false;
+    output->verbose(
+      CALL_INFO,
+      6,
+      0,
+      "Core %" PRIu32 "; Hart %" PRIu32 "; Evicted Thread %" PRIu32 " for a checkpoint\n",
+      id,
+      HartID,
+      Thread->GetID()
+    );
+    Evicted.emplace_back( HartID, std::move( Thread ) );
+  }
+  return Evicted;
+}
+
+void RevCore::ReturnThread( std::unique_ptr<RevThread> Thread, unsigned HartID ) {
+  if( !IdleHarts[HartID] )
+    output->fatal(
+      CALL_INFO,
+      -1,
+      "Error: Thread %" PRIu32 " cannot return to hart %" PRIu32 " of core %" PRIu32 "; it is busy\n",
+      Thread->GetID(),
+      HartID,
+      id
+    );
+  Harts.at( HartID )->AssignThread( std::move( Thread ) );
+  IdleHarts[HartID] = false;
+}
+
+// The per cycle statistics are flushed by GetAndClearStats before a
+// checkpoint; only the running totals (PrintStatSummary) are carried over.
+// ECALL totals are stored by code, so the slots may change between builds.
+void RevCore::SaveSnapshot( RevSnapshotOut& Snap ) const {
+  Snap.Put( REV_SNAPSHOT_TAG_CORE );
+  Snap.Put( id );
+  Snap.Put( cycles );
+  Snap.Put( StatsTotal );
+  const auto& Codes = GetEcallCodes();
+  Snap.Put( uint64_t( std::count_if( EcallCallsTotal.begin(), EcallCallsTotal.end(), []( uint64_t n ) { return n != 0; } ) ) );
+  for( size_t slot = 0; slot < EcallCallsTotal.size(); slot++ ) {
+    if( EcallCallsTotal[slot] ) {
+      Snap.Put( Codes[slot] );
+      Snap.Put( EcallCallsTotal[slot] );
+      Snap.Put( EcallCyclesTotal[slot] );
+    }
+  }
+}
+
+void RevCore::LoadSnapshot( RevSnapshotIn& Snap ) {
+  unsigned SnapId;
+  uint64_t Count;
+  Snap.Expect( REV_SNAPSHOT_TAG_CORE, "core" );
+  Snap.Get( SnapId );
+  if( SnapId != id )
+    output->fatal( CALL_INFO, -1, "Error: checkpoint %s has core %u where core %u was expected\n", Snap.GetPath().c_str(), SnapId, id );
+  Snap.Get( cycles );
+  Snap.Get( StatsTotal );
+  Snap.Get( Count );
+  while( Count-- ) {
+    uint32_t Code;
+    uint64_t Calls, Cycles;
+    Snap.Get( Code );
+    Snap.Get( Calls );
+    Snap.Get( Cycles );
+    if( const EcallEntry* Entry = FindEcall( Code ) ) {
+      EcallCallsTotal[Entry->slot]  = Calls;
+      EcallCyclesTotal[Entry->slot] = Cycles;
+    }
+  }
 }
 
 void RevCore::PrintStatSummary() {
@@ -1949,7 +2371,7 @@ void RevCore::PrintStatSummary() {
     3,
     0,
     "\t Bytes Read: %" PRIu64 " Bytes Written: %" PRIu64 " Floats Read: %" PRIu64 " Doubles Read %" PRIu64 " Floats Exec: %" PRIu64
-    " TLB Hits: %" PRIu64 " TLB Misses: %" PRIu64 " Inst Retired: %" PRIu64 "\n\n",
+    " TLB Hits: %" PRIu64 " TLB Misses: %" PRIu64 " Inst Retired: %" PRIu64 "\n",
     memStatsTotal.bytesRead,
     memStatsTotal.bytesWritten,
     memStatsTotal.floatsRead,
@@ -1959,6 +2381,40 @@ void RevCore::PrintStatSummary() {
     memStatsTotal.TLBMisses,
     StatsTotal.retired
   );
+
+  auto StallCycles = [this]( RevStall Cause ) { return StatsTotal.stalls[unsigned( Cause ) - 1]; };
+  output->verbose(
+    CALL_INFO,
+    3,
+    0,
+    "\t Stall Cycles: Fetch: %" PRIu64 " Load: %" PRIu64 " Remote Load: %" PRIu64 " Scoreboard: %" PRIu64 " ECALL: %" PRIu64
+    " CoProc: %" PRIu64 " No Thread: %" PRIu64 "\n\n",
+    StallCycles( RevStall::Fetch ),
+    StallCycles( RevStall::LoadHazard ),
+    StallCycles( RevStall::RmtLoadHazard ),
+    StallCycles( RevStall::Scoreboard ),
+    StallCycles( RevStall::Ecall ),
+    StallCycles( RevStall::CoProc ),
+    StallCycles( RevStall::NoThread )
+  );
+
+  // ECALLs by total cycles
+  const auto&           Codes = GetEcallCodes();
+  std::vector<unsigned> Slots;
+  for( unsigned Slot = 0; Slot < Codes.size(); Slot++ )
+    if( EcallCallsTotal[Slot] )
+      Slots.push_back( Slot );
+  std::sort( Slots.begin(), Slots.end(), [this]( unsigned a, unsigned b ) { return EcallCyclesTotal[a] > EcallCyclesTotal[b]; } );
+  for( unsigned Slot : Slots )
+    output->verbose(
+      CALL_INFO,
+      3,
+      0,
+      "\t ECALL %" PRIu32 ": Calls: %" PRIu64 " Cycles: %" PRIu64 "\n",
+      Codes[Slot],
+      EcallCallsTotal[Slot],
+      EcallCyclesTotal[Slot]
+    );
 }
 
 RevRegFile* RevCore::GetRegFile( unsigned HartID ) const {
@@ -2019,32 +2475,39 @@ bool RevCore::ExecEcall() {
   if( RegFile->GetSCAUSE() != RevExceptionCause::ECALL_USER_MODE )
     return false;
 
-  // ECALL in progress
-  uint32_t EcallCode = RegFile->GetX<uint32_t>( RevReg::a7 );
-  output->verbose(
-    CALL_INFO,
-    6,
-    0,
-    "Core %" PRIu32 "; Hart %" PRIu32 "; Thread %" PRIu32 " - Exception Raised: ECALL with code = %" PRIu32 "\n",
-    id,
-    HartToExecID,
-    ActiveThreadID,
-    EcallCode
-  );
+  // ECALL in progress; the handler is resolved on its first cycle
+  auto& EcallState = Harts[HartToDecodeID]->GetEcallState();
+  if( !EcallState.handler ) {
+    uint32_t EcallCode = RegFile->GetX<uint32_t>( RevReg::a7 );
+    output->verbose(
+      CALL_INFO,
+      6,
+      0,
+      "Core %" PRIu32 "; Hart %" PRIu32 "; Thread %" PRIu32 " - Exception Raised: ECALL with code = %" PRIu32 "\n",
+      id,
+      HartToDecodeID,
+      ActiveThreadID,
+      EcallCode
+    );
 
-  // TODO: Cache handler function during ECALL instruction execution
-  auto it = Ecalls.find( EcallCode );
-  if( it == Ecalls.end() ) {
-    output->fatal( CALL_INFO, -1, "Ecall Code = %" PRIu32 " not found", EcallCode );
+    const EcallEntry* Entry = FindEcall( EcallCode );
+    if( !Entry ) {
+      output->fatal( CALL_INFO, -1, "Ecall Code = %" PRIu32 " not found", EcallCode );
+    }
+    EcallState.handler = Entry->handler;
+    EcallState.slot    = Entry->slot;
+    EcallState.start   = cycles;
   }
 
   // Execute the Ecall handler
   HartToExecID   = HartToDecodeID;
-  bool completed = ( this->*it->second )() != EcallStatus::CONTINUE;
+  bool completed = ( this->*EcallState.handler )() != EcallStatus::CONTINUE;
 
-  // If we have completed, reset the EcallState and SCAUSE
+  // If we have completed, record it and reset the EcallState and SCAUSE
   if( completed ) {
-    Harts[HartToDecodeID]->GetEcallState().clear();
+    EcallCalls[EcallState.slot]++;
+    EcallCycles[EcallState.slot] += cycles - EcallState.start + 1;
+    EcallState.clear();
     RegFile->SetSCAUSE( RevExceptionCause::NONE );
   }
 
@@ -2072,6 +2535,10 @@ void RevCore::AssignThread( std::unique_ptr<RevThread> Thread ) {
 
   // Assign the thread to the hart
   Harts.at( HartToAssign )->AssignThread( std::move( Thread ) );
+  HartSliceStart[HartToAssign] = cycles;
+  HartRunStart[HartToAssign]   = cycles;
+  if( Profiler )
+    Profiler->ResetHart( HartToAssign );
 
   IdleHarts[HartToAssign] = false;
 
@@ -2132,8 +2599,10 @@ void RevCore::UpdateStatusOfHarts() {
   // A Hart is ClearToDecode if:
   //   1. It has a thread assigned to it (ie. NOT Idle)
   //   2. It's last instruction is done executing (ie. cost is set to 0)
+  std::fill( ReadyWords.begin(), ReadyWords.end(), 0 );
   for( size_t i = 0; i < Harts.size(); i++ ) {
     HartsClearToDecode[i] = !IdleHarts[i] && Harts[i]->RegFile->cost == 0;
+    ReadyWords[i / 64] |= uint64_t{ HartsClearToDecode[i] } << ( i % 64 );
   }
   return;
 }
@@ -10,164 +10,85 @@
 
 #include "RevLoader.h"
 #include "RevMem.h"
+#include <algorithm>
+#include <mutex>
+#include <tuple>
 
 namespace SST::RevCPU {
 
 using MemSegment = RevMem::MemSegment;
 
-bool RevLoader::IsElf( const Elf64_Ehdr eh64 ) {
+static bool IsElf( const Elf64_Ehdr& eh64 ) {
   if( ( eh64 ).e_ident[0] == 0x7f && ( eh64 ).e_ident[1] == 'E' && ( eh64 ).e_ident[2] == 'L' && ( eh64 ).e_ident[3] == 'F' )
     return true;
 
   return false;
 }
 
-bool RevLoader::IsRVElf32( const Elf64_Ehdr eh64 ) {
+static bool IsRVElf32( const Elf64_Ehdr& eh64 ) {
   if( IsElf( eh64 ) && ( eh64 ).e_ident[4] == 1 )
     return true;
   return false;
 }
 
-bool RevLoader::IsRVElf64( const Elf64_Ehdr eh64 ) {
+static bool IsRVElf64( const Elf64_Ehdr& eh64 ) {
   if( IsElf( eh64 ) && ( eh64 ).e_ident[4] == 2 )
     return true;
   return false;
 }
 
-bool RevLoader::IsRVLittle( const Elf64_Ehdr eh64 ) {
+static bool IsRVLittle( const Elf64_Ehdr& eh64 ) {
   if( IsElf( eh64 ) && ( eh64 ).e_ident[5] == 1 )
     return true;
   return false;
 }
 
-bool RevLoader::IsRVBig( const Elf64_Ehdr eh64 ) {
-  if( IsElf( eh64 ) && ( eh64 ).e_ident[5] == 2 )
-    return true;
-  return false;
-}
-
-// breaks the write into cache line chunks
-bool RevLoader::WriteCacheLine( uint64_t Addr, size_t Len, const void* Data ) {
-  if( Len == 0 ) {
-    // nothing to do here, move along
-    return true;
-  }
-
-  // calculate the cache line size
-  unsigned lineSize = mem->getLineSize();
-  if( lineSize == 0 ) {
-    // default to 64byte cache lines
-    lineSize = 64;
-  }
+// Elf32_Ehdr, Elf32_Phdr, Elf32_Shdr, Elf32_Sym or their Elf64 counterparts
+template<typename Ehdr, typename Phdr, typename Shdr, typename Sym>
+void RevElfImage::Parse( const char* membuf, size_t sz, SST::Output* output ) {
+  const char* Width = is64 ? "RV64" : "RV32";
 
-  // begin writing the data, if we have a small write
-  // then dispatch the write as normal.  Otherwise,
-  // block the writes as cache lines
-  // #131 added case for when Len==lineSize
-  if( Len <= lineSize ) {
-    // one cache line to write, dispatch it
-    return mem->WriteMem( 0, Addr, Len, Data );
-  }
-
-  // calculate the base address of the first cache line
-  size_t   Total         = 0;
-  bool     done          = false;
-  uint64_t BaseCacheAddr = Addr;
-  while( !done ) {
-    if( BaseCacheAddr % lineSize == 0 ) {
-      done = true;
-    } else {
-      BaseCacheAddr--;
-    }
-  }
-
-  // write the first cache line
-  size_t   TmpSize = BaseCacheAddr + lineSize - Addr;
-  uint64_t TmpData = uint64_t( Data );
-  uint64_t TmpAddr = Addr;
-  if( !mem->WriteMem( 0, TmpAddr, TmpSize, reinterpret_cast<void*>( TmpData ) ) ) {
-    output->fatal( CALL_INFO, -1, "Error: Failed to perform cache line write\n" );
-  }
-
-  TmpAddr += TmpSize;
-  TmpData += TmpSize;
-  Total += TmpSize;
-
-  // now perform the remainder of the writes
-  do {
-    if( ( Len - Total ) > lineSize ) {
-      // setup another full cache line write
-      TmpSize = lineSize;
-    } else {
-      // this is probably the final write operation
-      TmpSize = ( Len - Total );
-    }
-
-    if( !mem->WriteMem( 0, TmpAddr, TmpSize, reinterpret_cast<void*>( TmpData ) ) ) {
-      output->fatal( CALL_INFO, -1, "Error: Failed to perform cache line write\n" );
-    }
+  // Parse the ELF header
+  const Ehdr* eh    = (const Ehdr*) ( membuf );
 
-    // incrememnt the temp counters
-    TmpAddr += TmpSize;
-    TmpData += TmpSize;
-    Total += TmpSize;
+  // Check that the ELF file is valid
+  if( sz < sizeof( Ehdr ) || sz < eh->e_phoff + eh->e_phnum * sizeof( Phdr ) || sz < eh->e_shoff + eh->e_shnum * sizeof( Shdr ) )
+    output->fatal( CALL_INFO, -1, "Error: %s Elf is unrecognizable\n", Width );
 
-  } while( Total < Len );
+  // Parse the program headers
+  const Phdr* ph = (const Phdr*) ( membuf + eh->e_phoff );
 
-  return true;
-}
+  // Parse the section headers
+  const Shdr* sh = (const Shdr*) ( membuf + eh->e_shoff );
 
-// Elf32_Ehdr, Elf32_Phdr, Elf32_Shdr, Elf32_Sym, from_le
-bool RevLoader::LoadElf32( char* membuf, size_t sz ) {
-  // Parse the ELF header
-  Elf32_Ehdr* eh       = (Elf32_Ehdr*) ( membuf );
+  if( eh->e_shstrndx >= eh->e_shnum )
+    output->fatal( CALL_INFO, -1, "Error: %s Elf is unrecognizable\n", Width );
 
-  // Parse the program headers
-  Elf32_Phdr* ph       = (Elf32_Phdr*) ( membuf + eh->e_phoff );
+  if( sz < sh[eh->e_shstrndx].sh_offset + sh[eh->e_shstrndx].sh_size )
+    output->fatal( CALL_INFO, -1, "Error: %s Elf is unrecognizable\n", Width );
 
-  // Parse the section headers
-  Elf32_Shdr* sh       = (Elf32_Shdr*) ( membuf + eh->e_shoff );
-  char*       shstrtab = membuf + sh[eh->e_shstrndx].sh_offset;
+  const char* shstrtab = membuf + sh[eh->e_shstrndx].sh_offset;
 
   // Store the entry point of the program
-  RV32Entry            = eh->e_entry;
+  entry                = eh->e_entry;
 
-  // Add memory segments for each program header
+  // Keep the program headers
   for( unsigned i = 0; i < eh->e_phnum; i++ ) {
     if( sz < ph[i].p_offset + ph[i].p_filesz ) {
-      output->fatal( CALL_INFO, -1, "Error: RV64 Elf is unrecognizable\n" );
+      output->fatal( CALL_INFO, -1, "Error: %s Elf is unrecognizable\n", Width );
     }
     // Check if the program header is PT_TLS
     // - If so, save the addr & size of the TLS segment
     if( ph[i].p_type == PT_TLS ) {
-      TLSBaseAddr = ph[i].p_paddr;
-      TLSSize     = ph[i].p_memsz;
-      mem->SetTLSInfo( ph[i].p_paddr, ph[i].p_memsz );
-    }
-
-    // Add a memory segment for the program header
-    if( ph[i].p_memsz ) {
-      mem->AddRoundedMemSeg( ph[i].p_paddr, ph[i].p_memsz, __PAGE_SIZE__ );
-    }
-  }
-
-  (void) mem->AddThreadMem();
-
-  // Add memory segments for each program header
-  for( unsigned i = 0; i < eh->e_phnum; i++ ) {
-    if( sz < ph[i].p_offset + ph[i].p_filesz ) {
-      output->fatal( CALL_INFO, -1, "Error: RV32 Elf is unrecognizable\n" );
-    }
-    // Add a memory segment for the program header
-    if( ph[i].p_memsz ) {
-      mem->AddRoundedMemSeg( ph[i].p_paddr, ph[i].p_memsz, __PAGE_SIZE__ );
+      tlsBase = ph[i].p_paddr;
+      tlsSize = ph[i].p_memsz;
     }
+    segments.push_back( { ph[i].p_type, ph[i].p_paddr, ph[i].p_offset, ph[i].p_filesz, ph[i].p_memsz } );
   }
 
-  uint64_t StaticDataEnd = 0;
-  uint64_t BSSEnd        = 0;
-  uint64_t DataEnd       = 0;
-  uint64_t TextEnd       = 0;
+  uint64_t BSSEnd  = 0;
+  uint64_t DataEnd = 0;
+  uint64_t TextEnd = 0;
   for( unsigned i = 0; i < eh->e_shnum; i++ ) {
     // check if the section header name is bss
     if( strcmp( shstrtab + sh[i].sh_name, ".bss" ) == 0 ) {
@@ -182,62 +103,24 @@ bool RevLoader::LoadElf32( char* membuf, size_t sz ) {
   }
   // If BSS exists, static data ends after it
   if( BSSEnd > 0 ) {
-    StaticDataEnd = BSSEnd;
+    staticDataEnd = BSSEnd;
   } else if( DataEnd > 0 ) {
     // BSS Doesn't exist, but data does
-    StaticDataEnd = DataEnd;
+    staticDataEnd = DataEnd;
   } else if( TextEnd > 0 ) {
     // Text is last resort
-    StaticDataEnd = TextEnd;
+    staticDataEnd = TextEnd;
   } else {
     // Can't find any (Text, BSS, or Data) sections
-    output->fatal(
-      CALL_INFO,
-      -1,
-      "Error: No text, data, or bss sections --- RV64 Elf is "
-      "unrecognizable\n"
-    );
+    output->fatal( CALL_INFO, -1, "Error: No text, data, or bss sections --- %s Elf is unrecognizable\n", Width );
   }
 
-  // Check that the ELF file is valid
-  if( sz < eh->e_phoff + eh->e_phnum * sizeof( *ph ) )
-    output->fatal( CALL_INFO, -1, "Error: RV32 Elf is unrecognizable\n" );
-
-  // Write the program headers to memory
-  elfinfo.phnum     = eh->e_phnum;
-  elfinfo.phent     = sizeof( Elf32_Phdr );
-  elfinfo.phdr      = eh->e_phoff;
-  elfinfo.phdr_size = eh->e_phnum * sizeof( Elf32_Phdr );
-
-  // set the first stack pointer
-  uint32_t sp       = mem->GetStackTop() - (uint32_t) ( elfinfo.phdr_size );
-  WriteCacheLine( sp, elfinfo.phdr_size, ph );
-  mem->SetStackTop( sp );
-
-  // iterate over the program headers
-  for( unsigned i = 0; i < eh->e_phnum; i++ ) {
-    // Look for the loadable program headers
-    if( ph[i].p_type == PT_LOAD && ph[i].p_memsz ) {
-      if( ph[i].p_filesz ) {
-        if( sz < ph[i].p_offset + ph[i].p_filesz ) {
-          output->fatal( CALL_INFO, -1, "Error: RV32 Elf is unrecognizable\n" );
-        }
-        WriteCacheLine( ph[i].p_paddr, ph[i].p_filesz, (uint8_t*) ( membuf + ph[i].p_offset ) );
-      }
-      std::vector<uint8_t> zeros( ph[i].p_memsz - ph[i].p_filesz );
-      WriteCacheLine( ph[i].p_paddr + ph[i].p_filesz, ph[i].p_memsz - ph[i].p_filesz, &zeros[0] );
-    }
-  }
-
-  // Check that the ELF file is valid
-  if( sz < eh->e_shoff + eh->e_shnum * sizeof( *sh ) )
-    output->fatal( CALL_INFO, -1, "Error: RV32 Elf is unrecognizable\n" );
-
-  if( eh->e_shstrndx >= eh->e_shnum )
-    output->fatal( CALL_INFO, -1, "Error: RV32 Elf is unrecognizable\n" );
-
-  if( sz < sh[eh->e_shstrndx].sh_offset + sh[eh->e_shstrndx].sh_size )
-    output->fatal( CALL_INFO, -1, "Error: RV32 Elf is unrecognizable\n" );
+  // Keep the program header table for the initial stack
+  info.phnum     = eh->e_phnum;
+  info.phent     = sizeof( Phdr );
+  info.phdr      = eh->e_phoff;
+  info.phdr_size = eh->e_phnum * sizeof( Phdr );
+  phdrs.assign( (const uint8_t*) ph, (const uint8_t*) ph + info.phdr_size );
 
   unsigned strtabidx = 0;
   unsigned symtabidx = 0;
@@ -245,10 +128,12 @@ bool RevLoader::LoadElf32( char* membuf, size_t sz ) {
   // Iterate over every section header
   for( unsigned i = 0; i < eh->e_shnum; i++ ) {
     // If the section header is empty, skip it
-    if( sh[i].sh_type & SHT_NOBITS )
+    if( sh[i].sh_type & SHT_NOBITS ) {
       continue;
-    if( sz < sh[i].sh_offset + sh[i].sh_size )
-      output->fatal( CALL_INFO, -1, "Error: RV32 Elf is unrecognizable\n" );
+    }
+    if( sz < sh[i].sh_offset + sh[i].sh_size ) {
+      output->fatal( CALL_INFO, -1, "Error: %s Elf is unrecognizable\n", Width );
+    }
     // Find the string table index
     if( strcmp( shstrtab + sh[i].sh_name, ".strtab" ) == 0 )
       strtabidx = i;
@@ -259,182 +144,196 @@ bool RevLoader::LoadElf32( char* membuf, size_t sz ) {
 
   // If the string table index and symbol table index are valid (NonZero)
   if( strtabidx && symtabidx ) {
-    // If there is a string table and symbol table, add them as valid memory
     // Parse the string table
-    char*      strtab = membuf + sh[strtabidx].sh_offset;
-    Elf32_Sym* sym    = (Elf32_Sym*) ( membuf + sh[symtabidx].sh_offset );
+    const char* strtab = membuf + sh[strtabidx].sh_offset;
+    const Sym*  sym    = (const Sym*) ( membuf + sh[symtabidx].sh_offset );
     // Iterate over every symbol in the symbol table
-    for( unsigned i = 0; i < sh[symtabidx].sh_size / sizeof( Elf32_Sym ); i++ ) {
+    for( unsigned i = 0; i < sh[symtabidx].sh_size / sizeof( Sym ); i++ ) {
       // Calculate the maximum length of the symbol
       unsigned maxlen = sh[strtabidx].sh_size - sym[i].st_name;
       if( sym[i].st_name >= sh[strtabidx].sh_size )
-        output->fatal( CALL_INFO, -1, "Error: RV32 Elf is unrecognizable\n" );
+        output->fatal( CALL_INFO, -1, "Error: %s Elf is unrecognizable\n", Width );
       if( strnlen( strtab + sym[i].st_name, maxlen ) >= maxlen )
-        output->fatal( CALL_INFO, -1, "Error: RV32 Elf is unrecognizable\n" );
+        output->fatal( CALL_INFO, -1, "Error: %s Elf is unrecognizable\n", Width );
       // Add the symbol to the symbol table
       symtable[strtab + sym[i].st_name] = sym[i].st_value;
     }
   }
 
-  // Initialize the heap
-  mem->InitHeap( StaticDataEnd );
-
-  return true;
+  // print the symbol table entries
+  for( const auto& [Name, Addr] : symtable ) {
+    // create inverse map to allow tracer to lookup symbols
+    tracer_symbols.emplace( Addr, Name );
+    output->verbose( CALL_INFO, 6, 0, "Symbol Table Entry [%s:0x%" PRIx64 "]\n", Name.c_str(), Addr );
+  }
 }
 
-bool RevLoader::LoadElf64( char* membuf, size_t sz ) {
-  // Parse the ELF header
-  Elf64_Ehdr* eh       = (Elf64_Ehdr*) ( membuf );
-
-  // Parse the program headers
-  Elf64_Phdr* ph       = (Elf64_Phdr*) ( membuf + eh->e_phoff );
+// anonymous file for a page image, so every RevMem can map it copy-on-write
+static int CreateImageFile() {
+#ifdef __linux__
+  return memfd_create( "rev-elf-image", MFD_CLOEXEC );
+#else
+  char Name[] = "/tmp/rev-elf-image.XXXXXX";
+  int  fd     = mkstemp( Name );
+  if( fd >= 0 )
+    unlink( Name );
+  return fd;
+#endif
+}
 
-  // Parse the section headers
-  Elf64_Shdr* sh       = (Elf64_Shdr*) ( membuf + eh->e_shoff );
-  char*       shstrtab = membuf + sh[eh->e_shstrndx].sh_offset;
+void RevElfImage::BuildImage( const char* membuf, uint64_t PageSize, SST::Output* output ) {
+  // guest pages holding file contents, merged into runs of consecutive pages
+  std::vector<std::pair<uint64_t, uint64_t>> Pages;
+  for( const auto& Seg : segments )
+    if( Seg.Type == PT_LOAD && Seg.MemSz && Seg.FileSz )
+      Pages.emplace_back( Seg.Addr / PageSize, ( Seg.Addr + Seg.FileSz - 1 ) / PageSize + 1 );
+  std::sort( Pages.begin(), Pages.end() );
+  for( const auto& [First, End] : Pages ) {
+    if( !runs.empty() && First * PageSize <= runs.back().Addr + runs.back().Len ) {
+      runs.back().Len = std::max( runs.back().Len, End * PageSize - runs.back().Addr );
+    } else {
+      runs.push_back( { First * PageSize, ( End - First ) * PageSize, imageLen } );
+    }
+    imageLen = runs.back().Offset + runs.back().Len;
+  }
+  if( !imageLen )
+    return;
+
+  // without an image file the image is plain memory that every loader copies from
+  void* Base = MAP_FAILED;
+  imageFd    = CreateImageFile();
+  if( imageFd >= 0 && ftruncate( imageFd, off_t( imageLen ) ) == 0 )
+    Base = mmap( nullptr, imageLen, PROT_READ | PROT_WRITE, MAP_SHARED, imageFd, 0 );
+  if( Base == MAP_FAILED ) {
+    if( imageFd >= 0 )
+      close( imageFd );
+    imageFd = -1;
+    Base    = mmap( nullptr, imageLen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+    if( Base == MAP_FAILED )
+      output->fatal( CALL_INFO, -1, "Error: could not allocate the page image of the executable\n" );
+    output->verbose( CALL_INFO, 2, 0, "Warning: no page image file; the executable is copied into every memory\n" );
+  }
+  imageBase = static_cast<char*>( Base );
 
-  // Store the entry point of the program
-  RV64Entry            = eh->e_entry;
+  // pages of the image not covered by a segment's file contents read as zero
+  for( const auto& Seg : segments )
+    if( Seg.Type == PT_LOAD && Seg.MemSz && Seg.FileSz )
+      memcpy( const_cast<char*>( GetSegmentData( Seg ) ), membuf + Seg.Offset, Seg.FileSz );
+  mprotect( imageBase, imageLen, PROT_READ );
+}
 
-  // Add memory segments for each program header
-  for( unsigned i = 0; i < eh->e_phnum; i++ ) {
-    if( sz < ph[i].p_offset + ph[i].p_filesz ) {
-      output->fatal( CALL_INFO, -1, "Error: RV64 Elf is unrecognizable\n" );
-    }
-    // Check if the program header is PT_TLS
-    // - If so, save the addr & size of the TLS segment
-    if( ph[i].p_type == PT_TLS ) {
-      TLSBaseAddr = ph[i].p_paddr;
-      TLSSize     = ph[i].p_memsz;
-      mem->SetTLSInfo( ph[i].p_paddr, ph[i].p_memsz );
-    }
+const char* RevElfImage::GetSegmentData( const Segment& Seg ) const {
+  auto it = std::upper_bound( runs.begin(), runs.end(), Seg.Addr, []( uint64_t Addr, const PageRun& Run ) {
+    return Addr < Run.Addr;
+  } );
+  if( it == runs.begin() || Seg.Addr + Seg.FileSz > ( --it )->Addr + it->Len )
+    return nullptr;
+  return imageBase + it->Offset + ( Seg.Addr - it->Addr );
+}
 
-    // Add a memory segment for the program header
-    if( ph[i].p_memsz ) {
-      mem->AddRoundedMemSeg( ph[i].p_paddr, ph[i].p_memsz, __PAGE_SIZE__ );
-    }
+/// RevElfImage cache key: an executable is parsed again once it is replaced or rewritten
+struct RevElfImageKey {
+  std::string Path;
+  dev_t       Dev;
+  ino_t       Ino;
+  off_t       Size;
+  time_t      MTime;
+  long        MTimeNsec;
+  uint64_t    PageSize;
+
+  bool operator<( const RevElfImageKey& K ) const {
+    return std::tie( Path, Dev, Ino, Size, MTime, MTimeNsec, PageSize ) <
+           std::tie( K.Path, K.Dev, K.Ino, K.Size, K.MTime, K.MTimeNsec, K.PageSize );
   }
+};
 
-  // Add the first thread's memory
-  (void) mem->AddThreadMem();
+static std::mutex                                                  ImageCacheMutex;  // guards ImageCache
+static std::map<RevElfImageKey, std::weak_ptr<const RevElfImage>> ImageCache;       // images alive in this process
 
-  uint64_t StaticDataEnd = 0;
-  uint64_t BSSEnd        = 0;
-  uint64_t DataEnd       = 0;
-  uint64_t TextEnd       = 0;
-  for( unsigned i = 0; i < eh->e_shnum; i++ ) {
-    // check if the section header name is bss
-    if( strcmp( shstrtab + sh[i].sh_name, ".bss" ) == 0 ) {
-      BSSEnd = sh[i].sh_addr + sh[i].sh_size;
-    }
-    if( strcmp( shstrtab + sh[i].sh_name, ".text" ) == 0 ) {
-      TextEnd = sh[i].sh_addr + sh[i].sh_size;
-    }
-    if( strcmp( shstrtab + sh[i].sh_name, ".data" ) == 0 ) {
-      DataEnd = sh[i].sh_addr + sh[i].sh_size;
+std::shared_ptr<const RevElfImage> RevElfImage::Get( const std::string& Exe, uint64_t PageSize, SST::Output* output ) {
+  // open the target file
+  int         fd = open( Exe.c_str(), O_RDONLY );
+  struct stat FileStats;
+  if( fd < 0 || fstat( fd, &FileStats ) < 0 )
+    output->fatal( CALL_INFO, -1, "Error: failed to stat executable file: %s\n", Exe.c_str() );
+
+#ifdef __APPLE__
+  long MTimeNsec = FileStats.st_mtimespec.tv_nsec;
+#else
+  long MTimeNsec = FileStats.st_mtim.tv_nsec;
+#endif
+  char*          Path = realpath( Exe.c_str(), nullptr );
+  RevElfImageKey Key{
+    Path ? Path : Exe, FileStats.st_dev, FileStats.st_ino, FileStats.st_size, FileStats.st_mtime, MTimeNsec, PageSize
+  };
+  free( Path );
+
+  // every loader of the same executable shares one image; the first one parses it
+  std::lock_guard<std::mutex> Lock( ImageCacheMutex );
+  for( auto it = ImageCache.begin(); it != ImageCache.end(); )
+    it = it->second.expired() ? ImageCache.erase( it ) : std::next( it );
+  if( auto it = ImageCache.find( Key ); it != ImageCache.end() ) {
+    if( auto Image = it->second.lock() ) {
+      close( fd );
+      output->verbose( CALL_INFO, 4, 0, "Sharing the loaded image of %s\n", Exe.c_str() );
+      return Image;
     }
   }
-  // If BSS exists, static data ends after it
-  if( BSSEnd > 0 ) {
-    StaticDataEnd = BSSEnd;
-  } else if( DataEnd > 0 ) {
-    // BSS Doesn't exist, but data does
-    StaticDataEnd = DataEnd;
-  } else if( TextEnd > 0 ) {
-    // Text is last resort
-    StaticDataEnd = TextEnd;
-  } else {
-    // Can't find any (Text, BSS, or Data) sections
-    output->fatal(
-      CALL_INFO,
-      -1,
-      "Error: No text, data, or bss sections --- RV64 Elf is "
-      "unrecognizable\n"
-    );
-  }
-
-  // Check that the ELF file is valid
-  if( sz < eh->e_phoff + eh->e_phnum * sizeof( *ph ) )
-    output->fatal( CALL_INFO, -1, "Error: RV64 Elf is unrecognizable\n" );
 
-  // Write the program headers to memory
-  elfinfo.phnum     = eh->e_phnum;
-  elfinfo.phent     = sizeof( Elf64_Phdr );
-  elfinfo.phdr      = eh->e_phoff;
-  elfinfo.phdr_size = eh->e_phnum * sizeof( Elf64_Phdr );
+  size_t FileSize = FileStats.st_size;
 
-  // set the first stack pointer
-  uint64_t sp       = mem->GetStackTop() - elfinfo.phdr_size;
-  WriteCacheLine( sp, elfinfo.phdr_size, ph );
-  mem->SetStackTop( sp );
+  // check the size of the elf header
+  if( FileSize < sizeof( Elf64_Ehdr ) )
+    output->fatal( CALL_INFO, -1, "Error: Elf header is unrecognizable\n" );
 
-  // iterate over the program headers
-  for( unsigned i = 0; i < eh->e_phnum; i++ ) {
-    // Look for the loadable headers
-    if( ph[i].p_type == PT_LOAD && ph[i].p_memsz ) {
-      if( ph[i].p_filesz ) {
-        if( sz < ph[i].p_offset + ph[i].p_filesz ) {
-          output->fatal( CALL_INFO, -1, "Error: RV64 Elf is unrecognizable\n" );
-        }
-        WriteCacheLine( ph[i].p_paddr, ph[i].p_filesz, (uint8_t*) ( membuf + ph[i].p_offset ) );
-      }
-      std::vector<uint8_t> zeros( ph[i].p_memsz - ph[i].p_filesz );
-      WriteCacheLine( ph[i].p_paddr + ph[i].p_filesz, ph[i].p_memsz - ph[i].p_filesz, &zeros[0] );
-    }
-  }
+  // map the executable into memory
+  char* membuf = (char*) ( mmap( NULL, FileSize, PROT_READ, MAP_PRIVATE, fd, 0 ) );
+  if( membuf == MAP_FAILED )
+    output->fatal( CALL_INFO, -1, "Error: failed to map executable file: %s\n", Exe.c_str() );
 
-  // Check that the ELF file is valid
-  if( sz < eh->e_shoff + eh->e_shnum * sizeof( *sh ) )
-    output->fatal( CALL_INFO, -1, "Error: RV64 Elf is unrecognizable\n" );
+  // close the target file
+  close( fd );
 
-  if( eh->e_shstrndx >= eh->e_shnum )
-    output->fatal( CALL_INFO, -1, "Error: RV64 Elf is unrecognizable\n" );
+  Elf64_Ehdr eh64;
+  memcpy( &eh64, membuf, sizeof( eh64 ) );
 
-  if( sz < sh[eh->e_shstrndx].sh_offset + sh[eh->e_shstrndx].sh_size )
-    output->fatal( CALL_INFO, -1, "Error: RV64 Elf is unrecognizable\n" );
+  if( !IsRVElf32( eh64 ) && !IsRVElf64( eh64 ) )
+    output->fatal( CALL_INFO, -1, "Error: Cannot determine Elf32 or Elf64 from header\n" );
 
-  unsigned strtabidx = 0;
-  unsigned symtabidx = 0;
+  if( !IsRVLittle( eh64 ) )
+    output->fatal( CALL_INFO, -1, "Error: Not in little endian format\n" );
 
-  // Iterate over every section header
-  for( unsigned i = 0; i < eh->e_shnum; i++ ) {
-    // If the section header is empty, skip it
-    if( sh[i].sh_type & SHT_NOBITS ) {
-      continue;
-    }
-    if( sz < sh[i].sh_offset + sh[i].sh_size ) {
-      output->fatal( CALL_INFO, -1, "Error: RV64 Elf is unrecognizable\n" );
-    }
-    // Find the string table index
-    if( strcmp( shstrtab + sh[i].sh_name, ".strtab" ) == 0 )
-      strtabidx = i;
-    // Find the symbol table index
-    if( strcmp( shstrtab + sh[i].sh_name, ".symtab" ) == 0 )
-      symtabidx = i;
+  std::shared_ptr<RevElfImage> Image( new RevElfImage );
+  Image->is64 = IsRVElf64( eh64 );
+  if( Image->is64 ) {
+    Image->Parse<Elf64_Ehdr, Elf64_Phdr, Elf64_Shdr, Elf64_Sym>( membuf, FileSize, output );
+  } else {
+    Image->Parse<Elf32_Ehdr, Elf32_Phdr, Elf32_Shdr, Elf32_Sym>( membuf, FileSize, output );
   }
+  Image->BuildImage( membuf, PageSize, output );
 
-  // If the string table index and symbol table index are valid (NonZero)
-  if( strtabidx && symtabidx ) {
-    // Parse the string table
-    char*      strtab = membuf + sh[strtabidx].sh_offset;
-    Elf64_Sym* sym    = (Elf64_Sym*) ( membuf + sh[symtabidx].sh_offset );
-    // Iterate over every symbol in the symbol table
-    for( unsigned i = 0; i < sh[symtabidx].sh_size / sizeof( Elf64_Sym ); i++ ) {
-      // Calculate the maximum length of the symbol
-      unsigned maxlen = sh[strtabidx].sh_size - sym[i].st_name;
-      if( sym[i].st_name >= sh[strtabidx].sh_size )
-        output->fatal( CALL_INFO, -1, "Error: RV64 Elf is unrecognizable\n" );
-      if( strnlen( strtab + sym[i].st_name, maxlen ) >= maxlen )
-        output->fatal( CALL_INFO, -1, "Error: RV64 Elf is unrecognizable\n" );
-      // Add the symbol to the symbol table
-      symtable[strtab + sym[i].st_name] = sym[i].st_value;
-    }
-  }
+  // unmap the file
+  munmap( membuf, FileSize );
 
-  // Initialize the heap
-  mem->InitHeap( StaticDataEnd );
+  ImageCache[Key] = Image;
+  return Image;
+}
 
-  return true;
+RevElfImage::RevElfImage( RevSnapshotIn& Snap ) {
+  Snap.Get( symtable );
+  Snap.Get( tracer_symbols );
+}
+
+RevElfImage::~RevElfImage() {
+  if( imageBase )
+    munmap( imageBase, imageLen );
+  if( imageFd >= 0 )
+    close( imageFd );
+}
+
+void RevElfImage::SaveSymbols( RevSnapshotOut& Snap ) const {
+  Snap.Put( symtable );
+  Snap.Put( tracer_symbols );
 }
 
 template<typename XLEN>
@@ -515,13 +414,13 @@ bool RevLoader::LoadProgramArgs( const std::string& exe, const std::vector<std::
     XLEN Target = ArgArrayBase + ArgvOffset;
 
     // Write the address &argv[i][0] into argv[i]
-    WriteCacheLine( ArgArray, sizeof( XLEN ), &Target );
+    mem->InitMem( ArgArray, sizeof( XLEN ), &Target );
 
     // Advance ArgArray sizeof(XLEN) to the next argv[i]
     ArgArray += sizeof( XLEN );
 
     // Write the contents of argv[i] string into &argv[i][0]
-    WriteCacheLine( Target, Len, arg.c_str() );
+    mem->InitMem( Target, Len, arg.c_str() );
 
     // Advance ArgvOffset the string length rounded up to a multiple of sizeof( XLEN )
     ArgvOffset += ( ( Len - 1 ) | ( sizeof( XLEN ) - 1 ) ) + 1;
@@ -537,58 +436,76 @@ bool RevLoader::LoadProgramArgs( const std::string& exe, const std::vector<std::
   return true;
 }
 
-bool RevLoader::LoadElf( const std::string& exe, const std::vector<std::string>& args ) {
-  // open the target file
-  int         fd = open( exe.c_str(), O_RDONLY );
-  struct stat FileStats;
-  if( fstat( fd, &FileStats ) < 0 )
-    output->fatal( CALL_INFO, -1, "Error: failed to stat executable file: %s\n", exe.c_str() );
+void RevLoader::LoadSegments() {
+  // whole runs of image pages are mapped copy-on-write; with a memory controller they are copied instead
+  std::vector<RevElfImage::PageRun> Mapped;
+  for( const auto& Run : image->GetPageRuns() )
+    if( mem->MapImage( Run.Addr, Run.Len, image->GetImageFd(), Run.Offset ) )
+      Mapped.push_back( Run );
 
-  size_t FileSize = FileStats.st_size;
-
-  // map the executable into memory
-  char* membuf    = (char*) ( mmap( NULL, FileSize, PROT_READ, MAP_PRIVATE, fd, 0 ) );
-  if( membuf == MAP_FAILED )
-    output->fatal( CALL_INFO, -1, "Error: failed to map executable file: %s\n", exe.c_str() );
+  // iterate over the program headers
+  for( const auto& Seg : image->GetSegments() ) {
+    // Look for the loadable headers
+    if( Seg.Type != PT_LOAD || !Seg.MemSz )
+      continue;
+    uint64_t ZeroStart = Seg.Addr + Seg.FileSz;
+    auto     InRun     = std::find_if( Mapped.begin(), Mapped.end(), [&]( const RevElfImage::PageRun& Run ) {
+      return Seg.Addr >= Run.Addr && ZeroStart <= Run.Addr + Run.Len;
+    } );
+    if( InRun != Mapped.end() ) {
+      // the file contents and the zeroed rest of their last page are already in place
+      ZeroStart = std::min( InRun->Addr + InRun->Len, Seg.Addr + Seg.MemSz );
+    } else if( Seg.FileSz ) {
+      mem->InitMem( Seg.Addr, Seg.FileSz, image->GetSegmentData( Seg ) );
+    }
+    // .bss is left to zero filled pages where the memory allows it
+    mem->InitMem( ZeroStart, Seg.Addr + Seg.MemSz - ZeroStart, nullptr );
+  }
+}
 
-  // close the target file
-  close( fd );
+bool RevLoader::LoadElf( const std::string& exe, const std::vector<std::string>& args ) {
+  // parse the executable, or share the image another loader has already parsed
+  image = RevElfImage::Get( exe, mem->GetPageSize(), output );
 
-  // check the size of the elf header
-  if( FileSize < sizeof( Elf64_Ehdr ) )
-    output->fatal( CALL_INFO, -1, "Error: Elf header is unrecognizable\n" );
+  // Store the entry point of the program
+  if( image->Is64() ) {
+    RV64Entry = image->GetEntry();
+  } else {
+    RV32Entry = uint32_t( image->GetEntry() );
+  }
+  TLSBaseAddr = image->GetTLSBaseAddr();
+  TLSSize     = image->GetTLSSize();
 
-  Elf64_Ehdr eh64;
-  memcpy( &eh64, membuf, sizeof( eh64 ) );
+  // Add memory segments for each program header
+  for( const auto& Seg : image->GetSegments() ) {
+    if( Seg.Type == PT_TLS ) {
+      mem->SetTLSInfo( Seg.Addr, Seg.MemSz );
+    }
+    if( Seg.MemSz ) {
+      mem->AddRoundedMemSeg( Seg.Addr, Seg.MemSz, __PAGE_SIZE__ );
+    }
+  }
 
-  if( !IsRVElf32( eh64 ) && !IsRVElf64( eh64 ) )
-    output->fatal( CALL_INFO, -1, "Error: Cannot determine Elf32 or Elf64 from header\n" );
+  // Add the first thread's memory
+  (void) mem->AddThreadMem();
 
-  if( !IsRVLittle( eh64 ) )
-    output->fatal( CALL_INFO, -1, "Error: Not in little endian format\n" );
+  // Write the program headers to memory
+  elfinfo     = image->GetInfo();
 
-  if( IsRVElf32( eh64 ) ) {
-    if( !LoadElf32( membuf, FileSize ) )
-      output->fatal( CALL_INFO, -1, "Error: could not load Elf32 binary\n" );
-  } else {
-    if( !LoadElf64( membuf, FileSize ) )
-      output->fatal( CALL_INFO, -1, "Error: could not load Elf64 binary\n" );
-  }
+  // set the first stack pointer
+  uint64_t sp = mem->GetStackTop() - elfinfo.phdr_size;
+  if( !image->Is64() )
+    sp = uint32_t( sp );
+  mem->InitMem( sp, elfinfo.phdr_size, image->GetPhdrs().data() );
+  mem->SetStackTop( sp );
 
-  // unmap the file
-  munmap( membuf, FileSize );
+  LoadSegments();
 
-  // print the symbol table entries
-  std::map<std::string, uint64_t>::iterator it = symtable.begin();
-  while( it != symtable.end() ) {
-    // create inverse map to allow tracer to lookup symbols
-    tracer_symbols.emplace( it->second, it->first );
-    output->verbose( CALL_INFO, 6, 0, "Symbol Table Entry [%s:0x%" PRIx64 "]\n", it->first.c_str(), it->second );
-    it++;
-  }
+  // Initialize the heap
+  mem->InitHeap( image->GetStaticDataEnd() );
 
   /// load the program arguments
-  if( IsRVElf64( eh64 ) ? !LoadProgramArgs<uint64_t>( exe, args ) : !LoadProgramArgs<uint32_t>( exe, args ) )
+  if( image->Is64() ? !LoadProgramArgs<uint64_t>( exe, args ) : !LoadProgramArgs<uint32_t>( exe, args ) )
     return false;
 
   // Initiate a memory fence in order to ensure that the entire ELF
@@ -598,16 +515,31 @@ bool RevLoader::LoadElf( const std::string& exe, const std::vector<std::string>&
   return true;
 }
 
-uint64_t RevLoader::GetSymbolAddr( std::string Symbol ) {
-  uint64_t tmp = 0x00ull;
-  if( symtable.find( Symbol ) != symtable.end() ) {
-    tmp = symtable[Symbol];
-  }
-  return tmp;
+uint64_t RevLoader::GetSymbolAddr( const std::string& Symbol ) const {
+  const auto& symtable = image->GetSymbols();
+  auto        it       = symtable.find( Symbol );
+  return it == symtable.end() ? 0x00ull : it->second;
+}
+
+RevLoader::RevLoader( RevSnapshotIn& Snap, RevMem* mem, SST::Output* output ) : mem( mem ), output( output ) {
+  Snap.Expect( REV_SNAPSHOT_TAG_ELF, "ELF" );
+  Snap.Get( RV32Entry );
+  Snap.Get( RV64Entry );
+  Snap.Get( TLSBaseAddr );
+  Snap.Get( TLSSize );
+  Snap.Get( elfinfo );
+  image = std::make_shared<const RevElfImage>( Snap );
+  mem->FenceMem( 0 );
 }
 
-std::map<uint64_t, std::string>* SST::RevCPU::RevLoader::GetTraceSymbols() {
-  return &tracer_symbols;
+void RevLoader::SaveSnapshot( RevSnapshotOut& Snap ) const {
+  Snap.Put( REV_SNAPSHOT_TAG_ELF );
+  Snap.Put( RV32Entry );
+  Snap.Put( RV64Entry );
+  Snap.Put( TLSBaseAddr );
+  Snap.Put( TLSSize );
+  Snap.Put( elfinfo );
+  image->SaveSymbols( Snap );
 }
 
 }  // namespace SST::RevCPU
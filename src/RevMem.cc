@@ -10,9 +10,12 @@
 
 #include "RevMem.h"
 #include "RevRand.h"
+#include <cerrno>
 #include <cstring>
 #include <iomanip>
 #include <memory>
+#include <sstream>
+#include <unistd.h>
 #include <utility>
 
 namespace SST::RevCPU {
@@ -43,14 +46,16 @@ RevMem::RevMem( uint64_t memSize, RevOpts* opts, RevMemCtrl* ctrl, SST::Output*
 RevMem::RevMem( uint64_t MemSize, RevOpts* Opts, SST::Output* Output )
   : memSize( MemSize ), opts( Opts ), ctrl( nullptr ), output( Output ) {
 
-  // allocate the backing memory, zeroing it
-  physMem   = new char[memSize]{};
+  // allocate the backing memory as a host mapping: page aligned, so file
+  // mappings can be placed over it, and zero filled on first touch
+  void* Mem = mmap( nullptr, memSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
   pageSize  = 262144;  //Page Size (in Bytes)
   addrShift = lg( pageSize );
   nextPage  = 0;
 
-  if( !physMem )
+  if( Mem == MAP_FAILED )
     output->fatal( CALL_INFO, -1, "Error: could not allocate backing memory\n" );
+  physMem = static_cast<char*>( Mem );
 
   // We initialize StackTop to the size of memory minus 1024 bytes
   // This allocates 1024 bytes for program header information to contain
@@ -64,6 +69,14 @@ RevMem::RevMem( uint64_t MemSize, RevOpts* Opts, SST::Output* Output )
   AddMemSegAt( stacktop, __XBRTIME_RESERVED__ );
 }
 
+RevMem::~RevMem() {
+  for( auto& [Addr, Map] : FileMaps )
+    if( Map.Fd >= 0 )
+      close( Map.Fd );
+  if( physMem )
+    munmap( physMem, memSize );
+}
+
 bool RevMem::outstandingRqsts() {
   if( ctrl ) {
     return ctrl->outstandingRqsts();
@@ -278,7 +291,7 @@ uint64_t RevMem::CalcPhysAddr( uint64_t pageNum, uint64_t vAddr ) {
 }
 
 // This function will change a decent amount in an upcoming PR
-bool RevMem::isValidVirtAddr( const uint64_t vAddr ) {
+bool RevMem::isValidVirtAddr( const uint64_t vAddr ) const {
   for( const auto& Seg : MemSegs ) {
     if( Seg->contains( vAddr ) ) {
       return true;
@@ -433,7 +446,7 @@ uint64_t RevMem::AllocMem( const uint64_t& SegSize ) {
 // vector to see if there is a free segment that will fit the new data
 // If its unable to allocate at the location requested it will error. This may change in the future.
 uint64_t RevMem::AllocMemAt( const uint64_t& BaseAddr, const uint64_t& SegSize ) {
-  int ret = 0;
+  uint64_t ret = 0;
   output->verbose( CALL_INFO, 10, 99, "Attempting to allocate %" PRIu64 " bytes on the heap", SegSize );
 
   // Check if this range exists in the FreeMemSegs vector
@@ -578,6 +591,19 @@ bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, const void* Dat
   std::cout << "Writing " << Len << " Bytes Starting at 0x" << std::hex << Addr << std::dec << std::endl;
 #endif
 
+  if( Isolated ) {
+    if( Isolated->Record )
+      Isolated->Writes.emplace_back( Addr, Addr + Len );
+    if( Isolated->Buffer ) {
+      // the store is performed by CommitIsolation
+      const uint8_t* Bytes = static_cast<const uint8_t*>( Data );
+      Isolated->Stores.push_back( { Hart, Addr, Len, Isolated->StoreData.size(), flags } );
+      Isolated->StoreData.insert( Isolated->StoreData.end(), Bytes, Bytes + Len );
+      Isolated->Stats.bytesWritten += Len;
+      return true;
+    }
+  }
+
   InvalidateLRReservations( Hart, Addr, Len );
 
   TRACE_MEM_WRITE( Addr, Len, Data );
@@ -603,6 +629,46 @@ bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, const void* Dat
   return true;
 }
 
+bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, const void* Data, const MemReq& req, RevFlag flags ) {
+  if( !ctrl || Isolated ) {
+    // the internal model performs (or buffers) the write before returning
+    bool Ret = WriteMem( Hart, Addr, Len, Data, flags );
+    req.MarkLoadComplete();
+    return Ret;
+  }
+
+  InvalidateLRReservations( Hart, Addr, Len );
+
+  TRACE_MEM_WRITE( Addr, Len, Data );
+
+  RevokeFuture( Addr );  // revoke the future if it is present
+  ctrl->sendWRITERequest( Hart, Addr, 0, Len, const_cast<char*>( static_cast<const char*>( Data ) ), req, flags );
+  memStats.bytesWritten += Len;
+  return true;
+}
+
+void RevMem::InitMem( uint64_t Addr, uint64_t Len, const void* Data ) {
+  if( ctrl ) {
+    ctrl->sendINITData( Addr, Len, Data );
+    return;
+  }
+
+  // zeros only need writing to pages that are already backed; the rest
+  // are allocated zero filled on first touch
+  const char* Src = static_cast<const char*>( Data );
+  while( Len ) {
+    uint64_t Size = std::min<uint64_t>( Len, pageSize - ( Addr & ( pageSize - 1 ) ) );
+    if( Src ) {
+      memcpy( &physMem[CalcPhysAddr( Addr >> addrShift, Addr )], Src, Size );
+      Src += Size;
+    } else if( pageMap.count( Addr >> addrShift ) ) {
+      memset( &physMem[CalcPhysAddr( Addr >> addrShift, Addr )], 0, Size );
+    }
+    Addr += Size;
+    Len -= Size;
+  }
+}
+
 // RevMem: check to see if we're about to walk off the page....
 std::tuple<uint64_t, uint64_t, uint64_t> RevMem::AdjPageAddr( uint64_t Addr, uint64_t Len ) {
   if( Len > pageSize ) {
@@ -633,6 +699,18 @@ bool RevMem::ReadMem( unsigned Hart, uint64_t Addr, size_t Len, void* Target, co
 
   char* DataMem = static_cast<char*>( Target );
 
+  if( Isolated ) {
+    if( Isolated->Record )
+      Isolated->Reads.emplace_back( Addr, Addr + Len );
+    if( Isolated->Buffer ) {
+      ReadBuffered( *Isolated, Addr, Len, DataMem );
+      RevHandleFlagResp( Target, Len, flags );
+      if( MemOp::MemOpAMO != req.ReqType )
+        req.MarkLoadComplete();
+      return true;
+    }
+  }
+
   if( ctrl ) {
     // read the memory using RevMemCtrl
     TRACE_MEMH_SENDREAD( req.Addr, Len, req.DestReg );
@@ -657,6 +735,201 @@ bool RevMem::ReadMem( unsigned Hart, uint64_t Addr, size_t Len, void* Target, co
   return true;
 }
 
+bool RevMem::GetHostSpans( uint64_t Addr, uint64_t Len, std::vector<iovec>& Spans ) {
+  if( ctrl )
+    return false;
+  while( Len ) {
+    uint64_t Size = std::min<uint64_t>( Len, pageSize - ( Addr & ( pageSize - 1 ) ) );
+    char*    Host = &physMem[CalcPhysAddr( Addr >> addrShift, Addr )];
+    if( !Spans.empty() && static_cast<char*>( Spans.back().iov_base ) + Spans.back().iov_len == Host ) {
+      Spans.back().iov_len += Size;
+    } else {
+      Spans.push_back( { Host, Size } );
+    }
+    Addr += Size;
+    Len -= Size;
+  }
+  return true;
+}
+
+void RevMem::HostAccess( unsigned Hart, uint64_t Addr, uint64_t Len, bool Write ) {
+  if( Isolated && Isolated->Record )
+    ( Write ? Isolated->Writes : Isolated->Reads ).emplace_back( Addr, Addr + Len );
+  if( Write ) {
+    InvalidateLRReservations( Hart, Addr, Len );
+    RevokeFuture( Addr );  // revoke the future if it is present
+    memStats.bytesWritten += Len;
+  } else {
+    memStats.bytesRead += Len;
+  }
+}
+
+thread_local RevMem::Isolation* RevMem::Isolated = nullptr;
+
+void RevMem::PeekMem( uint64_t Addr, uint64_t Len, void* Data ) const {
+  char* Dst = static_cast<char*>( Data );
+  while( Len ) {
+    uint64_t Size = std::min<uint64_t>( Len, pageSize - ( Addr & ( pageSize - 1 ) ) );
+    auto     Page = pageMap.find( Addr >> addrShift );
+    if( Page == pageMap.end() ) {
+      memset( Dst, 0, Size );
+    } else {
+      memcpy( Dst, &physMem[( uint64_t( Page->second.first ) << addrShift ) + ( Addr & ( pageSize - 1 ) )], Size );
+    }
+    Addr += Size;
+    Dst += Size;
+    Len -= Size;
+  }
+}
+
+// Called concurrently for different cores: nothing shared is modified, so
+// pages are neither allocated nor entered in the TLB
+void RevMem::ReadBuffered( Isolation& Iso, uint64_t Addr, size_t Len, char* Data ) const {
+  if( Len > pageSize ) {
+    output->fatal(
+      CALL_INFO,
+      7,
+      "Error: Attempting to read/write %" PRIu64 " bytes > pageSize (= %" PRIu32 " bytes)\n",
+      uint64_t( Len ),
+      pageSize
+    );
+  }
+
+  // a page is allocated on its first touch, which is when CalcPhysAddr checks the address
+  for( uint64_t Byte : { Addr, Addr + Len - 1 } ) {
+    if( !pageMap.count( Byte >> addrShift ) && !isValidVirtAddr( Byte ) ) {
+      output->fatal(
+        CALL_INFO, 11, "Segmentation Fault: Virtual address 0x%" PRIx64 " was not found in any mem segments\n", Byte
+      );
+    }
+  }
+  PeekMem( Addr, Len, Data );
+
+  // overlay the stores of this core that are not yet committed
+  for( const auto& St : Iso.Stores ) {
+    uint64_t Lo = std::max( St.Addr, Addr );
+    uint64_t Hi = std::min( St.Addr + St.Len, Addr + Len );
+    if( Lo < Hi )
+      memcpy( Data + ( Lo - Addr ), &Iso.StoreData[St.Offset + ( Lo - St.Addr )], Hi - Lo );
+  }
+  Iso.Stats.bytesRead += Len;
+}
+
+void RevMem::CommitIsolation( Isolation& Iso ) {
+  for( const auto& St : Iso.Stores )
+    WriteMem( St.Hart, St.Addr, St.Len, &Iso.StoreData[St.Offset], St.Flags );
+
+  // WriteMem has counted the bytes written
+  memStats.floatsWritten += Iso.Stats.floatsWritten;
+  memStats.doublesWritten += Iso.Stats.doublesWritten;
+  memStats.bytesRead += Iso.Stats.bytesRead;
+  Iso.Stores.clear();
+  Iso.StoreData.clear();
+  Iso.Stats = {};
+}
+
+uint64_t RevMem::MapFile( uint64_t Len, int Fd, uint64_t Offset, uint64_t FileLen, bool Shared, bool Writable ) {
+  uint64_t HostPage = uint64_t( sysconf( _SC_PAGESIZE ) );
+  uint64_t Pages    = ( Len + pageSize - 1 ) >> addrShift;
+  if( ctrl || !physMem || !Len || Offset % HostPage || pageSize % HostPage || ( nextPage + Pages ) << addrShift > memSize )
+    return 0;
+
+  // allocate a page of slack so the mapping starts on a page boundary and owns all of its pages
+  uint64_t SegSize = ( Pages + 1 ) << addrShift;
+  uint64_t SegBase = AllocMem( SegSize );
+  uint64_t Addr    = ( SegBase + pageSize - 1 ) & ~uint64_t( pageSize - 1 );
+  for( uint64_t p = 0; p < Pages; p++ ) {
+    if( pageMap.count( ( Addr >> addrShift ) + p ) ) {
+      DeallocMem( SegBase, SegSize );
+      return 0;
+    }
+  }
+
+  // place the file over the next free physical pages; a read-only MAP_SHARED
+  // mapping is mapped private so stray stores cannot reach the file
+  char*  Host    = &physMem[uint64_t( nextPage ) << addrShift];
+  size_t HostLen = ( FileLen + HostPage - 1 ) / HostPage * HostPage;
+  if( HostLen ) {
+    int Flags = ( Shared && Writable ? MAP_SHARED : MAP_PRIVATE ) | MAP_FIXED;
+    if( mmap( Host, HostLen, PROT_READ | PROT_WRITE, Flags, Fd, off_t( Offset ) ) == MAP_FAILED ) {
+      mmap( Host, HostLen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0 );
+      DeallocMem( SegBase, SegSize );
+      return 0;
+    }
+  }
+
+  for( uint64_t p = 0; p < Pages; p++ )
+    pageMap[( Addr >> addrShift ) + p] = std::pair<uint32_t, bool>( nextPage + p, true );
+  nextPage += Pages;
+
+  FileMaps[Addr] = { SegBase, SegSize, Len, FileLen, Offset, -1, Shared, Host, HostLen };
+  output->verbose(
+    CALL_INFO, 8, 0, "Mapped %" PRIu64 " bytes of host file at 0x%" PRIx64 " (%" PRIu64 " pages)\n", FileLen, Addr, Pages
+  );
+  return Addr;
+}
+
+bool RevMem::MapImage( uint64_t Addr, uint64_t Len, int Fd, uint64_t Offset ) {
+  uint64_t Pages = Len >> addrShift;
+  if( ctrl || !physMem || Fd < 0 || !Len || ( Addr | Len | Offset ) & ( pageSize - 1 ) )
+    return false;
+  if( ( nextPage + Pages ) << addrShift > memSize )
+    return false;
+  for( uint64_t p = 0; p < Pages; p++ )
+    if( pageMap.count( ( Addr >> addrShift ) + p ) )
+      return false;
+
+  // the pages share the image's host pages until a store copies them
+  char* Host = &physMem[uint64_t( nextPage ) << addrShift];
+  if( mmap( Host, Len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, Fd, off_t( Offset ) ) == MAP_FAILED ) {
+    mmap( Host, Len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0 );
+    return false;
+  }
+
+  for( uint64_t p = 0; p < Pages; p++ )
+    pageMap[( Addr >> addrShift ) + p] = std::pair<uint32_t, bool>( nextPage + p, true );
+  nextPage += Pages;
+
+  output->verbose( CALL_INFO, 8, 0, "Mapped %" PRIu64 " image pages copy-on-write at 0x%" PRIx64 "\n", Pages, Addr );
+  return true;
+}
+
+const RevMem::FileMap* RevMem::FindFileMap( uint64_t Addr, uint64_t& Base ) const {
+  auto it = FileMaps.upper_bound( Addr );
+  if( it == FileMaps.begin() )
+    return nullptr;
+  --it;
+  if( Addr >= it->first + it->second.Len )
+    return nullptr;
+  Base = it->first;
+  return &it->second;
+}
+
+void RevMem::UnmapFile( uint64_t Addr ) {
+  auto it = FileMaps.find( Addr );
+  if( it == FileMaps.end() )
+    return;
+  FileMap& Map = it->second;
+
+  // MAP_SHARED stores already sit in the host page cache; replacing the
+  // mapping drops the file pages and leaves zeroed backing memory
+  if( Map.Host && Map.HostLen )
+    mmap( Map.Host, Map.HostLen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0 );
+  if( Map.Fd >= 0 )
+    close( Map.Fd );
+  DeallocMem( Map.SegBase, Map.SegSize );
+  FileMaps.erase( it );
+}
+
+int RevMem::SyncFile( const FileMap& Map, uint64_t Base, uint64_t Addr, uint64_t Len, bool Sync ) {
+  if( !Map.Host || !Map.Shared || Addr - Base >= Map.HostLen )
+    return 0;
+  uint64_t HostPage = uint64_t( sysconf( _SC_PAGESIZE ) );
+  uint64_t Start    = ( Addr - Base ) / HostPage * HostPage;
+  uint64_t End      = std::min<uint64_t>( Addr - Base + Len, Map.HostLen );
+  return msync( Map.Host + Start, End - Start, Sync ? MS_SYNC : MS_ASYNC ) ? -errno : 0;
+}
+
 bool RevMem::FlushLine( unsigned Hart, uint64_t Addr ) {
   uint64_t pageNum  = Addr >> addrShift;
   uint64_t physAddr = CalcPhysAddr( pageNum, Addr );
@@ -831,7 +1104,7 @@ uint64_t RevMem::ExpandHeap( uint64_t Size ) {
     output->fatal(
       CALL_INFO,
       7,
-      "Out Of Memory --- Attempted to expand heap to 0x%" PRIx64 " which goes beyond the maxHeapSize = 0x%x set in the "
+      "Out Of Memory --- Attempted to expand heap to 0x%" PRIx64 " which goes beyond the maxHeapSize = 0x%" PRIx64 " set in the "
       "python configuration. "
       "If unset, this value will be equal to 1/4 of memSize.\n",
       NewHeapEnd,
@@ -845,16 +1118,18 @@ uint64_t RevMem::ExpandHeap( uint64_t Size ) {
 }
 
 void RevMem::DumpMem( const uint64_t startAddr, const uint64_t numBytes, const uint64_t bytesPerRow, std::ostream& outputStream ) {
-  uint64_t       translatedStartAddr = startAddr;             //CalcPhysAddr( 0, startAddr );
-  const uint64_t endAddr             = startAddr + numBytes;  //translatedStartAddr + numBytes;
+  WriteDump( "", { { "", startAddr, numBytes, nullptr } }, bytesPerRow, outputStream );
+}
 
-  for( uint64_t addr = translatedStartAddr; addr < endAddr; addr += bytesPerRow ) {
-    outputStream << "0x" << std::setw( 16 ) << std::setfill( '0' ) << std::hex << addr << ": ";
+void RevMem::DumpBytes(
+  const uint64_t startAddr, const uint8_t* data, const uint64_t numBytes, const uint64_t bytesPerRow, std::ostream& outputStream
+) {
+  for( uint64_t row = 0; row < numBytes; row += bytesPerRow ) {
+    outputStream << "0x" << std::setw( 16 ) << std::setfill( '0' ) << std::hex << startAddr + row << ": ";
 
     for( uint64_t i = 0; i < bytesPerRow; ++i ) {
-      if( addr + i < endAddr ) {
-        uint8_t byte = physMem[addr + i];
-        outputStream << std::setw( 2 ) << std::setfill( '0' ) << std::hex << uint32_t{ byte } << " ";
+      if( row + i < numBytes ) {
+        outputStream << std::setw( 2 ) << std::setfill( '0' ) << std::hex << uint32_t{ data[row + i] } << " ";
       } else {
         outputStream << "   ";
       }
@@ -862,14 +1137,12 @@ void RevMem::DumpMem( const uint64_t startAddr, const uint64_t numBytes, const u
 
     outputStream << " ";
 
-    for( uint64_t i = 0; i < bytesPerRow; ++i ) {
-      if( addr + i < endAddr ) {
-        uint8_t byte = physMem[addr + i];
-        if( std::isprint( byte ) ) {
-          outputStream << static_cast<char>( byte );
-        } else {
-          outputStream << ".";
-        }
+    for( uint64_t i = 0; i < bytesPerRow && row + i < numBytes; ++i ) {
+      uint8_t byte = data[row + i];
+      if( std::isprint( byte ) ) {
+        outputStream << static_cast<char>( byte );
+      } else {
+        outputStream << ".";
       }
     }
     outputStream << std::endl;
@@ -877,43 +1150,279 @@ void RevMem::DumpMem( const uint64_t startAddr, const uint64_t numBytes, const u
 }
 
 void RevMem::DumpMemSeg( const std::shared_ptr<MemSegment>& MemSeg, const uint64_t bytesPerRow, std::ostream& outputStream ) {
-
-  outputStream << "// " << *MemSeg << std::endl;
-  DumpMem( MemSeg->getBaseAddr(), MemSeg->getSize(), bytesPerRow, outputStream );
+  WriteDump( "", { SegSection( *MemSeg ) }, bytesPerRow, outputStream );
 }
 
 void RevMem::DumpValidMem( const uint64_t bytesPerRow, std::ostream& outputStream ) {
+  WriteDump( "Memory Segments:", GetValidMemSections(), bytesPerRow, outputStream );
+}
 
+void RevMem::DumpThreadMem( const uint64_t bytesPerRow, std::ostream& outputStream ) {
+  WriteDump( "Thread Memory Segments:", GetThreadMemSections(), bytesPerRow, outputStream );
+}
+
+RevMemDumpSection RevMem::SegSection( const MemSegment& Seg, const std::string& Prefix ) {
+  std::ostringstream Label;
+  Label << Prefix << "// " << Seg;
+  return { Label.str(), Seg.getBaseAddr(), Seg.getSize(), nullptr };
+}
+
+// Every segment is listed with its number, then all of them again without
+// labels, then the thread segments
+std::vector<RevMemDumpSection> RevMem::GetValidMemSections() {
+  std::vector<RevMemDumpSection> Sections;
   std::sort( MemSegs.begin(), MemSegs.end() );
-  outputStream << "Memory Segments:" << std::endl;
   for( unsigned i = 0; i < MemSegs.size(); i++ ) {
-    outputStream << "// SEGMENT #" << i << *MemSegs[i] << std::endl;
-    DumpMemSeg( MemSegs[i], bytesPerRow, outputStream );
+    std::ostringstream Prefix;
+    Prefix << "// SEGMENT #" << i << *MemSegs[i] << "\n";
+    Sections.push_back( SegSection( *MemSegs[i], Prefix.str() ) );
   }
   for( const auto& MemSeg : MemSegs ) {
-    DumpMem( MemSeg->getBaseAddr(), MemSeg->getSize(), bytesPerRow, outputStream );
+    Sections.push_back( { "", MemSeg->getBaseAddr(), MemSeg->getSize(), nullptr } );
   }
-
   std::sort( ThreadMemSegs.begin(), ThreadMemSegs.end() );
   for( const auto& MemSeg : ThreadMemSegs ) {
-    outputStream << "// " << *MemSeg << std::endl;
-    DumpMem( MemSeg->getBaseAddr(), MemSeg->getSize(), bytesPerRow, outputStream );
+    Sections.push_back( SegSection( *MemSeg ) );
   }
+  return Sections;
 }
 
-void RevMem::DumpThreadMem( const uint64_t bytesPerRow, std::ostream& outputStream ) {
-
-  outputStream << "Thread Memory Segments:" << std::endl;
+std::vector<RevMemDumpSection> RevMem::GetThreadMemSections() {
+  std::vector<RevMemDumpSection> Sections;
   std::sort( ThreadMemSegs.begin(), ThreadMemSegs.end() );
   for( const auto& MemSeg : ThreadMemSegs ) {
-    outputStream << "// " << *MemSeg << std::endl;
-    DumpMem( MemSeg->getBaseAddr(), MemSeg->getSize(), bytesPerRow, outputStream );
+    Sections.push_back( SegSection( *MemSeg ) );
   }
+  return Sections;
+}
+
+const uint8_t* RevMem::PeekDump( const RevMemDumpSection& Sec, uint64_t Addr ) const {
+  if( Sec.Data )
+    return Sec.Data + ( Addr - Sec.Base );
+  if( !physMem )
+    output->fatal( CALL_INFO, -1, "Error: memory dumps through a memory controller must be read into a host copy first\n" );
+  auto Page = pageMap.find( Addr >> addrShift );
+  if( Page == pageMap.end() )
+    return nullptr;
+  uint64_t Phys = ( uint64_t( Page->second.first ) << addrShift ) + ( Addr & ( pageSize - 1 ) );
+  return reinterpret_cast<const uint8_t*>( &physMem[Phys] );
+}
+
+// Text rows stay aligned to the start of each section; they are formatted a
+// page worth at a time from the pages that hold them, untouched pages as zeros
+void RevMem::WriteDump(
+  const std::string& Title, const std::vector<RevMemDumpSection>& Sections, uint64_t bytesPerRow, std::ostream& outputStream
+) const {
+  if( !Title.empty() )
+    outputStream << Title << std::endl;
+
+  const uint64_t       Span = bytesPerRow * std::max<uint64_t>( 1, pageSize / bytesPerRow );
+  std::vector<uint8_t> Buf( Span );
+  for( const auto& Sec : Sections ) {
+    if( !Sec.Label.empty() )
+      outputStream << Sec.Label << std::endl;
+    for( uint64_t Off = 0; Off < Sec.Size; Off += Span ) {
+      uint64_t Len = std::min( Sec.Size - Off, Span );
+      for( uint64_t Done = 0; Done < Len; ) {
+        uint64_t       Addr = Sec.Base + Off + Done;
+        uint64_t       Size = std::min( Len - Done, pageSize - ( Addr & ( pageSize - 1 ) ) );
+        const uint8_t* Data = PeekDump( Sec, Addr );
+        if( Data ) {
+          memcpy( &Buf[Done], Data, Size );
+        } else {
+          memset( &Buf[Done], 0, Size );
+        }
+        Done += Size;
+      }
+      DumpBytes( Sec.Base + Off, Buf.data(), Len, bytesPerRow, outputStream );
+    }
+  }
+}
+
+void RevMem::WriteDumpFile(
+  const std::string& Path, const std::string& Title, const std::vector<RevMemDumpSection>& Sections
+) const {
+  if( !DumpBinary ) {
+    std::ofstream outputFile( Path, std::ios::out | std::ios::binary );
+    WriteDump( Title, Sections, 16, outputFile );
+    return;
+  }
+
+  // Binary chunks end at page boundaries, so untouched pages are skipped whole
+  RevMemDumpOut Dump( Path, Title, Sections, pageSize, 16, DumpCompress );
+  for( const auto& Sec : Sections ) {
+    for( uint64_t Off = 0; Off < Sec.Size; ) {
+      uint64_t Addr = Sec.Base + Off;
+      uint64_t Len  = std::min( Sec.Size - Off, pageSize - ( Addr & ( pageSize - 1 ) ) );
+      Dump.PutChunk( Addr, uint32_t( Len ), PeekDump( Sec, Addr ) );
+      Off += Len;
+    }
+  }
+  if( !Dump.Good() )
+    output->verbose( CALL_INFO, 1, 0, "Warning: failed writing memory dump %s\n", Path.c_str() );
+}
+
+// With a memory controller the ranges are read into DumpRangeData, at most
+// REV_DUMP_MAX_INFLIGHT requests at a time; the reads bypass the memory
+// statistics and the tracer
+bool RevMem::WriteDumpRanges( const std::string& Suffix ) {
+  std::vector<RevMemDumpSection> Sections;
+  uint64_t                       Total = 0;
+  for( const auto& [Name, Seg] : DumpRanges ) {
+    Sections.push_back( SegSection( *Seg ) );
+    Total += Seg->getSize();
+  }
+
+  if( ctrl ) {
+    if( DumpRangeData.size() != Total ) {
+      DumpRangeData.assign( Total, 0 );
+      DumpRangeIssued = 0;
+    }
+    const uint64_t Chunk = getChunkSize();
+    uint64_t       Off   = 0;
+    for( auto& Sec : Sections ) {
+      while( DumpRangeIssued < Off + Sec.Size && DumpRangePending < REV_DUMP_MAX_INFLIGHT ) {
+        uint64_t Addr = Sec.Base + ( DumpRangeIssued - Off );
+        uint64_t Len  = std::min( Off + Sec.Size - DumpRangeIssued, Chunk - Addr % Chunk );
+        MemReq   req{ Addr, uint16_t( 0 ), RevRegClass::RegGPR, 0, MemOp::MemOpREAD, true, [this]( const MemReq& ) {
+                       --DumpRangePending;
+                     } };
+        DumpRangePending++;
+        ctrl->sendREADRequest( 0, Addr, 0, uint32_t( Len ), &DumpRangeData[DumpRangeIssued], req, RevFlag::F_NONE );
+        DumpRangeIssued += Len;
+      }
+      Sec.Data = DumpRangeData.data() + Off;
+      Off += Sec.Size;
+    }
+    if( DumpRangeIssued < Total || DumpRangePending )
+      return false;
+  }
+
+  auto Sec = Sections.begin();
+  for( const auto& [Name, Seg] : DumpRanges ) {
+    WriteDumpFile( Name + Suffix, "", { *Sec++ } );
+  }
+  DumpRangeData.clear();
+  DumpRangeIssued = 0;
+  return true;
 }
 
 void RevMem::AddDumpRange( const std::string& Name, const uint64_t BaseAddr, const uint64_t Size ) {
   DumpRanges[Name] = std::make_shared<MemSegment>( BaseAddr, Size );
 }
+
+// Snapshot layout: the MEM section holds the address space layout and the
+// segment lists; the PAGES section holds every touched page as its virtual
+// page number and a flag, followed by the page contents unless it is all zero.
+void RevMem::SaveSnapshot( RevSnapshotOut& Snap ) const {
+  if( ctrl )
+    output->fatal( CALL_INFO, -1, "Error: memory snapshots can only be saved with the internal memory model\n" );
+
+  // Mapped files are saved by contents; they come back as private memory
+  if( !FileMaps.empty() )
+    output->verbose(
+      CALL_INFO, 1, 0, "Warning: %zu file mapping(s) are saved as memory; stores after a restore do not reach the files\n", FileMaps.size()
+    );
+
+  auto PutSegs = [&]( const std::vector<std::shared_ptr<MemSegment>>& Segs ) {
+    Snap.Put( uint64_t( Segs.size() ) );
+    for( const auto& Seg : Segs ) {
+      Snap.Put( Seg->getBaseAddr() );
+      Snap.Put( Seg->getSize() );
+    }
+  };
+
+  Snap.Put( REV_SNAPSHOT_TAG_MEM );
+  Snap.Put( uint64_t( memSize ) );
+  Snap.Put( pageSize );
+  Snap.Put( heapstart );
+  Snap.Put( heapend );
+  Snap.Put( stacktop );
+  Snap.Put( TLSBaseAddr );
+  Snap.Put( TLSSize );
+  Snap.Put( ThreadMemSize );
+  Snap.Put( NextThreadMemAddr );
+  PutSegs( MemSegs );
+  PutSegs( FreeMemSegs );
+  PutSegs( ThreadMemSegs );
+
+  Snap.Put( REV_SNAPSHOT_TAG_PAGES );
+  Snap.Put( uint64_t( pageMap.size() ) );
+  for( const auto& [Page, Phys] : pageMap ) {
+    const char* Data = &physMem[uint64_t( Phys.first ) << addrShift];
+    uint8_t     Full = std::any_of( Data, Data + pageSize, []( char c ) { return c != 0; } );
+    Snap.Put( Page );
+    Snap.Put( Full );
+    if( Full )
+      Snap.Write( Data, pageSize );
+  }
+}
+
+void RevMem::LoadSnapshot( RevSnapshotIn& Snap ) {
+  auto GetSegs = [&]( std::vector<std::shared_ptr<MemSegment>>& Segs ) {
+    uint64_t Count;
+    Snap.Get( Count );
+    Segs.clear();
+    while( Count-- ) {
+      uint64_t Base, Size;
+      Snap.Get( Base );
+      Snap.Get( Size );
+      Segs.push_back( std::make_shared<MemSegment>( Base, Size ) );
+    }
+  };
+
+  uint64_t SnapMemSize;
+  uint32_t SnapPageSize;
+  Snap.Expect( REV_SNAPSHOT_TAG_MEM, "memory" );
+  Snap.Get( SnapMemSize );
+  Snap.Get( SnapPageSize );
+  if( SnapMemSize != memSize || SnapPageSize != pageSize )
+    output->fatal(
+      CALL_INFO,
+      -1,
+      "Error: snapshot %s has memSize %" PRIu64 " and page size %" PRIu32 "; this memory has %" PRIu64 " and %" PRIu32 "\n",
+      Snap.GetPath().c_str(),
+      SnapMemSize,
+      SnapPageSize,
+      uint64_t( memSize ),
+      pageSize
+    );
+  Snap.Get( heapstart );
+  Snap.Get( heapend );
+  Snap.Get( stacktop );
+  Snap.Get( TLSBaseAddr );
+  Snap.Get( TLSSize );
+  Snap.Get( ThreadMemSize );
+  Snap.Get( NextThreadMemAddr );
+  GetSegs( MemSegs );
+  GetSegs( FreeMemSegs );
+  GetSegs( ThreadMemSegs );
+
+  // With the internal model all-zero pages are left to be allocated on first
+  // touch; a memory controller receives every page as untimed init writes
+  uint64_t Pages;
+  Snap.Expect( REV_SNAPSHOT_TAG_PAGES, "page" );
+  Snap.Get( Pages );
+  std::vector<char> Buf( pageSize );
+  FlushTLB();
+  while( Pages-- ) {
+    uint64_t Page;
+    uint8_t  Full;
+    Snap.Get( Page );
+    Snap.Get( Full );
+    if( ctrl ) {
+      if( Full )
+        Snap.Read( Buf.data(), pageSize );
+      InitMem( Page << addrShift, pageSize, Full ? Buf.data() : nullptr );
+    } else if( Full ) {
+      if( ( uint64_t( nextPage ) + 1 ) << addrShift > memSize )
+        output->fatal( CALL_INFO, -1, "Error: snapshot %s does not fit in memory\n", Snap.GetPath().c_str() );
+      pageMap[Page] = { nextPage, true };
+      Snap.Read( &physMem[uint64_t( nextPage ) << addrShift], pageSize );
+      nextPage++;
+    }
+  }
+}
 }  // namespace SST::RevCPU
 
 // EOF
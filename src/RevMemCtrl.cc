@@ -149,6 +149,8 @@ RevBasicMemCtrl::~RevBasicMemCtrl() {
   for( auto* p : rqstQ )
     delete p;
   rqstQ.clear();
+  for( auto* rqst : initData )
+    delete rqst;
   delete stdMemHandlers;
 }
 
@@ -206,6 +208,20 @@ bool RevBasicMemCtrl::sendWRITERequest( unsigned Hart, uint64_t Addr, uint64_t P
   return true;
 }
 
+bool RevBasicMemCtrl::sendWRITERequest(
+  unsigned Hart, uint64_t Addr, uint64_t PAddr, uint32_t Size, char* buffer, const MemReq& req, RevFlag flags
+) {
+  if( Size == 0 ) {
+    req.MarkLoadComplete();
+    return true;
+  }
+  RevMemOp* Op = new RevMemOp( Hart, Addr, PAddr, Size, buffer, MemOp::MemOpWRITE, flags );
+  Op->setMemReq( req );
+  rqstQ.push_back( Op );
+  recordStat( RevBasicMemCtrl::MemCtrlStats::WritePending, 1 );
+  return true;
+}
+
 bool RevBasicMemCtrl::sendAMORequest(
   unsigned Hart, uint64_t Addr, uint64_t PAddr, uint32_t Size, char* buffer, void* target, const MemReq& req, RevFlag flags
 ) {
@@ -352,6 +368,13 @@ void RevBasicMemCtrl::processMemEvent( StandardMem::Request* ev ) {
 void RevBasicMemCtrl::init( unsigned int phase ) {
   memIface->init( phase );
 
+  // the loaded program goes straight to the backing store
+  if( phase == 0 ) {
+    for( auto* rqst : initData )
+      memIface->sendUntimedData( rqst );
+    initData.clear();
+  }
+
   // query the caching infrastructure
   if( phase == 1 ) {
     lineSize = memIface->getLineSize();
@@ -365,6 +388,23 @@ void RevBasicMemCtrl::init( unsigned int phase ) {
   }
 }
 
+void RevBasicMemCtrl::sendINITData( uint64_t Addr, uint64_t Len, const void* Data ) {
+  // split at 4 KiB boundaries so no single init event grows past a page
+  constexpr uint64_t InitChunk = 4096;
+  const uint8_t*     Src       = static_cast<const uint8_t*>( Data );
+  while( Len ) {
+    uint64_t             Size = std::min<uint64_t>( Len, InitChunk - Addr % InitChunk );
+    std::vector<uint8_t> Buf( Size );
+    if( Src ) {
+      std::copy( Src, Src + Size, Buf.begin() );
+      Src += Size;
+    }
+    initData.push_back( new StandardMem::Write( Addr, Size, Buf ) );
+    Addr += Size;
+    Len -= Size;
+  }
+}
+
 void RevBasicMemCtrl::setup() {
   memIface->setup();
 }
@@ -1373,8 +1413,9 @@ void RevBasicMemCtrl::handleWriteResp( StandardMem::WriteResp* ev ) {
       // split request exists, determine how to handle it
       if( getNumSplitRqsts( op ) == 1 ) {
         // this was the last request to service, delete the op
+        // AMO writes and writes sent with a MemReq signal their completion
         const MemReq& r = op->getMemReq();
-        if( isAMO ) {
+        if( isAMO || r.MarkLoadCompleteFunc ) {
           r.MarkLoadComplete();
         }
         delete op;
@@ -1392,6 +1433,9 @@ void RevBasicMemCtrl::handleWriteResp( StandardMem::WriteResp* ev ) {
       // write the target
       std::vector<uint8_t> tempT = op->getTempT();
       r.MarkLoadComplete();
+    } else if( r.MarkLoadCompleteFunc ) {
+      // the writer asked to be told when the write has been performed
+      r.MarkLoadComplete();
     }
     delete op;
     outstanding.erase( ev->getID() );
@@ -26,12 +26,16 @@ RevOpts::RevOpts( unsigned NumCores, unsigned NumHarts, const int Verbosity )
   // -- table = internal
   // -- memCosts[core] = 0:10
   // -- prefetch depth = 16
+  // -- issue width = 1
+  // -- functional unit latencies = 0 (instruction table cost)
   for( unsigned i = 0; i < numCores; i++ ) {
     startAddr.insert( std::pair<unsigned, uint64_t>( i, 0 ) );
     machine.insert( std::pair<unsigned, std::string>( i, "G" ) );
     table.insert( std::pair<unsigned, std::string>( i, "_REV_INTERNAL_" ) );
     memCosts.push_back( InitialPair );
     prefetchDepth.insert( std::pair<unsigned, unsigned>( i, 16 ) );
+    issueWidth.insert( std::pair<unsigned, unsigned>( i, 1 ) );
+    fuLatency.insert( std::pair<unsigned, std::array<unsigned, 4>>( i, { 0, 0, 0, 0 } ) );
   }
 }
 
@@ -70,6 +74,44 @@ bool RevOpts::InitPrefetchDepth( const std::vector<std::string>& Depths ) {
   return true;
 }
 
+bool RevOpts::InitIssueWidths( const std::vector<std::string>& Widths ) {
+  std::vector<std::string> vstr;
+  for( const std::string& s : Widths ) {
+    splitStr( s, ":", vstr );
+    if( vstr.size() != 2 )
+      return false;
+
+    unsigned Core = std::stoul( vstr[0], nullptr, 0 );
+    if( Core >= numCores )
+      return false;
+
+    unsigned Width = std::stoul( vstr[1], nullptr, 0 );
+    if( Width == 0 )
+      return false;
+
+    issueWidth[Core] = Width;
+  }
+  return true;
+}
+
+bool RevOpts::InitFULatencies( const std::vector<std::string>& Latencies ) {
+  std::vector<std::string> vstr;
+  for( const std::string& s : Latencies ) {
+    // core:alu:muldiv:fpu:lsu
+    splitStr( s, ":", vstr );
+    if( vstr.size() != 5 )
+      return false;
+
+    unsigned Core = std::stoul( vstr[0], nullptr, 0 );
+    if( Core >= numCores )
+      return false;
+
+    for( unsigned i = 0; i < 4; i++ )
+      fuLatency[Core][i] = std::stoul( vstr[i + 1], nullptr, 0 );
+  }
+  return true;
+}
+
 bool RevOpts::InitStartAddrs( const std::vector<std::string>& StartAddrs ) {
   std::vector<std::string> vstr;
 
@@ -185,6 +227,28 @@ bool RevOpts::InitInstTables( const std::vector<std::string>& InstTables ) {
 bool RevOpts::InitMemCosts( const std::vector<std::string>& MemCosts ) {
   std::vector<std::string> vstr;
 
+  // check to see if we expand into multiple cores
+  if( MemCosts.size() == 1 ) {
+    std::string s = MemCosts[0];
+    splitStr( s, ":", vstr );
+    if( vstr.size() != 3 )
+      return false;
+
+    if( vstr[0] == "CORES" ) {
+      // set all cores to the target memory costs
+      unsigned Min = std::stoi( vstr[1], nullptr, 0 );
+      unsigned Max = std::stoi( vstr[2], nullptr, 0 );
+      if( ( Min == 0 ) || ( Max == 0 ) ) {
+        return false;
+      }
+      for( unsigned i = 0; i < numCores; i++ ) {
+        memCosts[i] = { Min, Max };
+      }
+      return true;
+    }
+    vstr.clear();
+  }
+
   for( unsigned i = 0; i < MemCosts.size(); i++ ) {
     std::string s = MemCosts[i];
     splitStr( s, ":", vstr );
@@ -216,6 +280,24 @@ bool RevOpts::GetPrefetchDepth( unsigned Core, unsigned& Depth ) {
   return true;
 }
 
+bool RevOpts::GetIssueWidth( unsigned Core, unsigned& Width ) {
+  auto it = issueWidth.find( Core );
+  if( it == issueWidth.end() )
+    return false;
+
+  Width = it->second;
+  return true;
+}
+
+bool RevOpts::GetFULatency( unsigned Core, std::array<unsigned, 4>& Latency ) {
+  auto it = fuLatency.find( Core );
+  if( it == fuLatency.end() )
+    return false;
+
+  Latency = it->second;
+  return true;
+}
+
 bool RevOpts::GetStartAddr( unsigned Core, uint64_t& StartAddr ) {
   if( Core > numCores )
     return false;
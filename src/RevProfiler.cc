@@ -0,0 +1,183 @@
+//
+// _RevProfiler_cc_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "RevProfiler.h"
+
+namespace SST::RevCPU {
+
+const char* RevStallName( RevStall Cause ) {
+  switch( Cause ) {
+  case RevStall::None: return "none";
+  case RevStall::Fetch: return "fetch";
+  case RevStall::LoadHazard: return "load";
+  case RevStall::RmtLoadHazard: return "rmtload";
+  case RevStall::Scoreboard: return "scoreboard";
+  case RevStall::Ecall: return "ecall";
+  case RevStall::CoProc: return "coproc";
+  case RevStall::NoThread: return "nothread";
+  }
+  return "unknown";
+}
+
+RevProfiler::RevProfiler( unsigned Harts, uint64_t Interval, const std::map<uint64_t, std::string>* Symbols )
+  : Interval( Interval ? Interval : 1 ), Symbols( Symbols ), Table( 4096 ), Nodes( 1 ), Stacks( Harts ) {
+  for( RevProfEntry& e : Table )
+    e.pc = EMPTY;
+}
+
+void RevProfiler::Grow() {
+  std::vector<RevProfEntry> Old( Table.size() * 2 );
+  Old.swap( Table );
+  for( RevProfEntry& e : Table )
+    e.pc = EMPTY;
+  Used = 0;
+  for( const RevProfEntry& e : Old ) {
+    if( e.pc == EMPTY )
+      continue;
+    RevProfEntry& n = Lookup( e.pc );
+    n               = e;
+  }
+}
+
+void RevProfiler::Branch( unsigned Hart, uint64_t PC, uint64_t NextPC, uint64_t Link, unsigned Size ) {
+  HartStack& h = Stacks[Hart];
+
+  // return: control reaches the return address of the innermost call
+  if( !h.returns.empty() && h.returns.back() == NextPC ) {
+    h.returns.pop_back();
+    h.node = Nodes[h.node].parent;
+    return;
+  }
+
+  // call: the link register holds the address following this instruction
+  if( Link == PC + Size && h.returns.size() < MAX_DEPTH ) {
+    if( h.node == 0 )
+      h.node = Child( 0, FuncOf( PC ) );
+    h.node = Child( h.node, NextPC );
+    h.returns.push_back( Link );
+  }
+}
+
+void RevProfiler::ResetHart( unsigned Hart ) {
+  Stacks[Hart].node = 0;
+  Stacks[Hart].returns.clear();
+}
+
+uint32_t RevProfiler::Child( uint32_t Parent, uint64_t Func ) {
+  auto [it, inserted] = StackIndex.try_emplace( { Parent, Func }, uint32_t( Nodes.size() ) );
+  if( inserted )
+    Nodes.push_back( { Parent, Func, 0 } );
+  return it->second;
+}
+
+uint64_t RevProfiler::FuncOf( uint64_t PC ) const {
+  if( !Symbols )
+    return 0;
+  auto it = Symbols->upper_bound( PC );
+  if( it == Symbols->begin() )
+    return 0;
+  return std::prev( it )->first;
+}
+
+std::string RevProfiler::FuncName( uint64_t Func ) const {
+  if( Symbols ) {
+    auto it = Symbols->find( Func );
+    if( it != Symbols->end() )
+      return it->second;
+  }
+  if( Func == 0 )
+    return "[unknown]";
+  std::stringstream s;
+  s << "0x" << std::hex << Func;
+  return s.str();
+}
+
+/// Write one profile row: cycles, retired, the stall causes and bytes
+static void WriteRow( std::ostream& os, const RevProfEntry& e ) {
+  os << std::setw( 14 ) << e.Cycles() << std::setw( 14 ) << e.retired;
+  for( uint64_t s : e.stalls )
+    os << std::setw( 12 ) << s;
+  os << std::setw( 14 ) << e.bytes << "  ";
+}
+
+void RevProfiler::WriteFlat( std::ostream& os, unsigned Core ) const {
+  // collect the used entries and aggregate them by function
+  std::vector<RevProfEntry>        PCs;
+  std::map<uint64_t, RevProfEntry> Funcs;
+  RevProfEntry                     Total;
+  for( const RevProfEntry& e : Table ) {
+    if( e.pc == EMPTY )
+      continue;
+    PCs.push_back( e );
+    RevProfEntry& f = Funcs[FuncOf( e.pc )];
+    f.Add( e );
+    Total.Add( e );
+  }
+  for( auto& [func, f] : Funcs )
+    f.pc = func;
+
+  auto ByCycles = []( const RevProfEntry& a, const RevProfEntry& b ) {
+    return a.Cycles() != b.Cycles() ? a.Cycles() > b.Cycles() : a.pc < b.pc;
+  };
+  std::vector<RevProfEntry> FuncList;
+  for( const auto& [func, f] : Funcs )
+    FuncList.push_back( f );
+  std::sort( FuncList.begin(), FuncList.end(), ByCycles );
+  std::sort( PCs.begin(), PCs.end(), ByCycles );
+
+  auto Header = [&os]( const char* what ) {
+    os << "#" << std::setw( 13 ) << "cycles" << std::setw( 14 ) << "retired";
+    for( unsigned i = 1; i <= REV_PC_STALL_CAUSES; i++ )
+      os << std::setw( 12 ) << RevStallName( RevStall( i ) );
+    os << std::setw( 14 ) << "bytes" << "  " << what << "\n";
+  };
+
+  os << "# Rev flat profile: core " << Core << ", sampling interval " << Interval << " cycle(s)\n";
+  os << "# cycles = retired + stall cycles; stall columns are cycles a hart waited on that cause\n";
+  os << "#\n# by function\n";
+  Header( "function" );
+  WriteRow( os, Total );
+  os << "[total]\n";
+  for( const RevProfEntry& f : FuncList ) {
+    WriteRow( os, f );
+    os << FuncName( f.pc ) << "\n";
+  }
+
+  os << "#\n# by instruction\n";
+  Header( "pc" );
+  for( const RevProfEntry& e : PCs ) {
+    WriteRow( os, e );
+    uint64_t func = FuncOf( e.pc );
+    os << "0x" << std::hex << e.pc << std::dec << " " << FuncName( func );
+    if( func )
+      os << "+0x" << std::hex << e.pc - func << std::dec;
+    os << "\n";
+  }
+}
+
+void RevProfiler::WriteFolded( std::ostream& os ) const {
+  std::vector<std::string> Frames;
+  for( size_t n = 1; n < Nodes.size(); n++ ) {
+    if( Nodes[n].cycles == 0 )
+      continue;
+    Frames.clear();
+    for( uint32_t i = uint32_t( n ); i != 0; i = Nodes[i].parent )
+      Frames.push_back( FuncName( Nodes[i].func ) );
+    for( auto it = Frames.rbegin(); it != Frames.rend(); it++ )
+      os << ( it == Frames.rbegin() ? "" : ";" ) << *it;
+    os << " " << Nodes[n].cycles << "\n";
+  }
+}
+
+}  // namespace SST::RevCPU
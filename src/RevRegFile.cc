@@ -10,6 +10,8 @@
 //
 
 #include "RevRegFile.h"
+#include "RevSnapshot.h"
+#include <algorithm>
 
 namespace SST::RevCPU {
 
@@ -63,4 +65,51 @@ std::ostream& operator<<( std::ostream& os, const RevRegFile& regFile ) {
   return os;
 }
 
+// The 64-bit members of the register unions hold the RV32 state as well.
+// Scoreboards and the instruction in flight are not saved; checkpoints are
+// only taken with every thread off its hart. Only nonzero CSRs are written.
+void RevRegFile::SaveSnapshot( RevSnapshotOut& Snap ) const {
+  Snap.Put( RV64_PC );
+  Snap.Put( RV64 );
+  Snap.Put( DPF );
+  Snap.Put( ERV64 );
+  Snap.Put( RV64_SEPC );
+  Snap.Put( SCAUSE );
+  Snap.Put( RV64_STVAL );
+  Snap.Put( GetInstRet() );
+
+  const auto& CSRFile = GetCSRFile();
+  Snap.Put( uint64_t( std::count_if( CSRFile.begin(), CSRFile.end(), []( uint64_t v ) { return v != 0; } ) ) );
+  for( uint16_t csr = 0; csr < CSRFile.size(); csr++ ) {
+    if( CSRFile[csr] ) {
+      Snap.Put( csr );
+      Snap.Put( CSRFile[csr] );
+    }
+  }
+}
+
+void RevRegFile::LoadSnapshot( RevSnapshotIn& Snap ) {
+  uint64_t InstRet, Count;
+  Snap.Get( RV64_PC );
+  Snap.Get( RV64 );
+  Snap.Get( DPF );
+  Snap.Get( ERV64 );
+  Snap.Get( RV64_SEPC );
+  Snap.Get( SCAUSE );
+  Snap.Get( RV64_STVAL );
+  Snap.Get( InstRet );
+  SetInstRet( InstRet );
+
+  auto& CSRFile = GetCSRFile();
+  CSRFile.fill( 0 );
+  Snap.Get( Count );
+  while( Count-- ) {
+    uint16_t csr;
+    Snap.Get( csr );
+    if( csr >= CSRFile.size() )
+      Snap.GetOutput()->fatal( CALL_INFO, -1, "Error: checkpoint %s has an invalid CSR 0x%" PRIx16 "\n", Snap.GetPath().c_str(), csr );
+    Snap.Get( CSRFile[csr] );
+  }
+}
+
 }  // namespace SST::RevCPU
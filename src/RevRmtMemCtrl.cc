@@ -38,6 +38,7 @@ std::ostream& operator<<( std::ostream& os, RmtMemOp op ) {
     case RmtMemOp::AMORqst:          return os << "AMORqst";
     case RmtMemOp::AMOResp:          return os << "AMOResp";
     case RmtMemOp::FENCE:            return os << "FENCE";
+    case RmtMemOp::SegACK:           return os << "SegACK";
     case RmtMemOp::Unknown:          return os << "Unknown";
   }
   // clang-format on
@@ -119,6 +120,15 @@ RevBasicRmtMemCtrl::RevBasicRmtMemCtrl( ComponentId_t id, const Params& params )
   max_readlock    = params.find<uint32_t>( "max_readlock", 64 );
   max_writeunlock = params.find<uint32_t>( "max_writeunlock", 64 );
   max_ops         = params.find<uint32_t>( "ops_per_cycle", 2 );
+  mtu             = params.find<uint32_t>( "mtu", _MAX_PAYLOAD_ );
+  seg_window      = params.find<uint32_t>( "seg_window", 8 );
+  amo_combine     = params.find<bool>( "amo_combine", true );
+  amo_window      = params.find<uint32_t>( "amo_combine_window", 0 );
+
+  if( mtu == 0 )
+    output->fatal( CALL_INFO, -1, "Error: mtu must be greater than zero\n" );
+  if( seg_window == 0 )
+    output->fatal( CALL_INFO, -1, "Error: seg_window must be greater than zero\n" );
 
   rqstQ.reserve( max_ops );
 
@@ -150,7 +160,12 @@ void RevBasicRmtMemCtrl::registerStats() {
          "RmtAMOInFlight",
          "RmtAMOPending",
          "RmtAMOBytes",
-         "RmtFencePending" } ) {
+         "RmtFencePending",
+         "RmtSegsSent",
+         "RmtSegCreditStalls",
+         "RmtAMOCombined",
+         "RmtAMOGroups",
+         "RmtGetNB" } ) {
     stats.push_back( registerStatistic<uint64_t>( stat ) );
   }
 }
@@ -176,6 +191,7 @@ void RevBasicRmtMemCtrl::rmtMemEventHandler( Event* ev ) {
   case RmtMemOp::WRITEUNLOCKResp: handleWriteUnlockResp( event ); break;
   case RmtMemOp::AMORqst: handleAMORqst( event ); break;
   case RmtMemOp::AMOResp: handleAMOResp( event ); break;
+  case RmtMemOp::SegACK: handleSegACK( event ); break;
   default: output->fatal( CALL_INFO, -1, "Error : unknown remote memory operation type\n" ); break;
   }
 }
@@ -235,6 +251,23 @@ void RevBasicRmtMemCtrl::handleBulkReadRqst( xbgasNicEvent* ev ) {
 
   uint8_t* Buffer = new uint8_t[Size * Nelem];
 
+  // Large responses are streamed back one segment at a time
+  if( isSegmented( Size, Nelem ) ) {
+    RmtSegXfer Xfer;
+    Xfer.Id       = Id;
+    Xfer.SrcId    = SrcId;
+    Xfer.DestId   = SrcId;
+    Xfer.SrcAddr  = SrcAddr;
+    Xfer.DestAddr = DestAddr;
+    Xfer.Size     = Size;
+    Xfer.Nelem    = Nelem;
+    Xfer.Flags    = Flags;
+    Xfer.Buffer   = Buffer;
+    Xfer.ReqPurp  = ReqPurp;
+    startSegXfer( std::move( Xfer ) );
+    return;
+  }
+
   LocalLoadTrack.insert(
     { RmtOpIDHash( SrcId, Id ), LocalLoadRecord( virtualHart, 0, Id, SrcId, SrcAddr, DestAddr, Size, Nelem, Flags, Buffer, ReqPurp )
     }
@@ -344,7 +377,7 @@ void RevBasicRmtMemCtrl::handleWriteRqst( xbgasNicEvent* ev ) {
   ev->getData( Buffer );
   Mem->WriteMem( virtualHart, DestAddr, Size, (void*) ( Buffer ), Flags );
 
-  xbgasNicEvent* RmtEvent = new xbgasNicEvent( getName() );
+  xbgasNicEvent* RmtEvent = new xbgasNicEvent();
   RmtEvent->buildWRITEResp( Id );
   xbgasNic->send( RmtEvent, SrcId );
   delete[] Buffer;
@@ -380,7 +413,7 @@ void RevBasicRmtMemCtrl::handleBulkWriteRqst( xbgasNicEvent* ev ) {
 
   bool isSeg = ev->isSegmented();
   if( !isSeg ) {
-    xbgasNicEvent* RmtEvent = new xbgasNicEvent( getName() );
+    xbgasNicEvent* RmtEvent = new xbgasNicEvent();
 
 #ifdef _XBGAS_RMT_DEBUG_
     std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " build Bulk WRITE Resp, "
@@ -390,23 +423,24 @@ void RevBasicRmtMemCtrl::handleBulkWriteRqst( xbgasNicEvent* ev ) {
     RmtEvent->buildBulkWRITEResp( Id );
     xbgasNic->send( RmtEvent, SrcId );
   } else {
-    if( PacketSegCount.find( Id ) != PacketSegCount.end() ) {
-      PacketSegCount[Id]++;
-      // Check if all the segments have been received
-      if( PacketSegCount[Id] == ev->getSegSz() ) {
-        PacketSegCount.erase( Id );
-        xbgasNicEvent* RmtEvent = new xbgasNicEvent( getName() );
+    // Return the credit for this segment to the sender
+    xbgasNicEvent* AckEvent = new xbgasNicEvent();
+    AckEvent->buildSegACK( Id, SrcId );
+    xbgasNic->send( AckEvent, SrcId );
+
+    // Check if all the segments have been received
+    uint64_t hashedId = RmtOpIDHash( SrcId, Id );
+    if( ++PacketSegCount[hashedId] == ev->getSegSz() ) {
+      PacketSegCount.erase( hashedId );
+      xbgasNicEvent* RmtEvent = new xbgasNicEvent();
 
 #ifdef _XBGAS_RMT_DEBUG_
-        std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " build Bulk WRITE Resp (segmented), "
-                  << "SrcId: " << std::dec << SrcId << ", Id: " << Id << std::endl;
+      std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " build Bulk WRITE Resp (segmented), "
+                << "SrcId: " << std::dec << SrcId << ", Id: " << Id << std::endl;
 #endif
 
-        RmtEvent->buildSegBulkWRITEResp( Id, ev->getSegSz() );
-        xbgasNic->send( RmtEvent, SrcId );
-      }
-    } else {
-      PacketSegCount.insert( { Id, 1 } );
+      RmtEvent->buildSegBulkWRITEResp( Id, ev->getSegSz() );
+      xbgasNic->send( RmtEvent, SrcId );
     }
   }
   delete[] Buffer;
@@ -429,7 +463,7 @@ void RevBasicRmtMemCtrl::handleWriteUnlockRqst( xbgasNicEvent* ev ) {
   // Copy the data to the buffer
   ev->getData( Buffer );
 
-  xbgasNicEvent* RmtEvent = new xbgasNicEvent( getName() );
+  xbgasNicEvent* RmtEvent = new xbgasNicEvent();
 
   rtn                     = Mem->SC( RmtHartId, DestAddr, Size, (void*) ( Buffer ), Flags );
   // Update TmpTarget with 0 if rtn is true, 1 if rtn is false.
@@ -467,10 +501,7 @@ void RevBasicRmtMemCtrl::handleAMORqst( xbgasNicEvent* ev ) {
   size_t   Size      = ev->getSize();
   RevFlag  Flags     = ev->getFlags();
   unsigned RmtHartId = HartHash( virtualHart, Hart, SrcId );
-  RmtMemOp ReqPurp   = RmtMemOp::AMOResp;
-
-  uint8_t* Buffer    = new uint8_t[Size];
-  uint8_t* TmpTarget = new uint8_t[Size];
+  uint64_t Operand   = 0;
 
 #ifdef _XBGAS_AMO_DEBUG_
   std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " handle AMO Rqst, "
@@ -478,27 +509,129 @@ void RevBasicRmtMemCtrl::handleAMORqst( xbgasNicEvent* ev ) {
             << ", Size: " << Size << ", RmtHartId: 0x" << std::hex << RmtHartId << std::endl;
 #endif
 
-  // Copy the data to the buffer
-  ev->getData( Buffer );
+  if( Size > sizeof( Operand ) )
+    output->fatal( CALL_INFO, -1, "Error: unsupported remote AMO size %zu\n", Size );
 
-  LocalLoadTrack.insert(
-    { RmtOpIDHash( SrcId, Id ), LocalLoadRecord( RmtHartId, 0, Id, SrcId, SrcAddr, 0, Size, Flags, TmpTarget, ReqPurp ) }
-  );
+  // Copy the operand out of the event
+  ev->getData( reinterpret_cast<uint8_t*>( &Operand ) );
+  delete ev;
 
-  LocalLoadCount.insert( { RmtOpIDHash( SrcId, Id ), 0 } );
+  // Join the youngest group for this address if it performs the same
+  // commutative operation; anything else starts a new group so that the
+  // arrival order of non-combinable operations is preserved
+  auto& Groups = AMOPending[SrcAddr];
+  if( amo_combine && isCombinableAMO( Flags ) && !Groups.empty() && Groups.back().Flags == Flags && Groups.back().Size == Size ) {
+    RmtAMOGroup& Group = Groups.back();
+    foldAMO( Flags, Size, Group.Operand, Operand );
+    Group.Ops.push_back( { Id, SrcId, Operand } );
+    recordStat( RmtAMOCombined, 1 );
+  } else {
+    RmtAMOGroup Group;
+    Group.Flags   = Flags;
+    Group.Size    = Size;
+    Group.Hart    = RmtHartId;
+    Group.Opened  = currentCycle;
+    Group.Operand = Operand;
+    Group.Ops.push_back( { Id, SrcId, Operand } );
+    Groups.push_back( std::move( Group ) );
+  }
+
+  // Without a combining window the group issues as soon as the address is idle;
+  // requests arriving while it is in flight gather in the next group
+  if( amo_window == 0 && AMOActive.find( SrcAddr ) == AMOActive.end() )
+    issueAMOGroup( SrcAddr );
+}
+
+bool RevBasicRmtMemCtrl::isCombinableAMO( RevFlag Flags ) {
+  for( auto Op : { RevFlag::F_AMOADD,
+                   RevFlag::F_AMOXOR,
+                   RevFlag::F_AMOAND,
+                   RevFlag::F_AMOOR,
+                   RevFlag::F_AMOMIN,
+                   RevFlag::F_AMOMAX,
+                   RevFlag::F_AMOMINU,
+                   RevFlag::F_AMOMAXU } ) {
+    if( RevFlagHas( Flags, Op ) )
+      return true;
+  }
+  return false;
+}
+
+void RevBasicRmtMemCtrl::foldAMO( RevFlag Flags, size_t Size, uint64_t& Acc, uint64_t Operand ) {
+  if( Size == sizeof( uint32_t ) ) {
+    uint32_t Acc4 = uint32_t( Acc );
+    ApplyAMO( Flags, &Acc4, uint32_t( Operand ) );
+    Acc = Acc4;
+  } else {
+    ApplyAMO( Flags, &Acc, Operand );
+  }
+}
+
+void RevBasicRmtMemCtrl::issueAMOGroup( uint64_t Addr ) {
+  auto it = AMOPending.find( Addr );
+  if( it == AMOPending.end() )
+    return;
+
+  RmtAMOGroup& Group = AMOActive.emplace( Addr, std::move( it->second.front() ) ).first->second;
+  it->second.pop_front();
+  if( it->second.empty() )
+    AMOPending.erase( it );
+
+  recordStat( RmtAMOGroups, 1 );
+
+#ifdef _XBGAS_AMO_DEBUG_
+  std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " issue AMO group, Addr: 0x" << std::hex << Addr << std::dec
+            << ", Requests: " << Group.Ops.size() << std::endl;
+#endif
 
   MemReq Req(
-    SrcAddr,                       // Memory address
-    SrcId,                         // Source ID
-    Id,                            // Packet ID
+    Addr,                          // Memory address
+    Group.Ops.front().SrcId,       // Source ID
+    Group.Ops.front().Id,          // Packet ID
     MemOp::MemOpAMO,               // Memory operation
     true,                          // Outstanding
     [this]( const MemReq& Req ) {  // Lambda function as a callback
-      RevBasicRmtMemCtrl::MarkLocalLoadComplete( Req );
+      RevBasicRmtMemCtrl::MarkAMOGroupComplete( Req );
     }
   );
 
-  Mem->AMOMem( RmtHartId, SrcAddr, Size, (void*) ( Buffer ), (void*) ( TmpTarget ), Req, Flags );
+  // Group is node-based storage and stays put until the completion erases it
+  Mem->AMOMem( Group.Hart, Addr, Group.Size, &Group.Operand, &Group.Old, Req, Group.Flags );
+}
+
+void RevBasicRmtMemCtrl::progressAMOGroups() {
+  if( amo_window == 0 || AMOPending.empty() )
+    return;
+
+  std::vector<uint64_t> Ready;
+  for( const auto& [Addr, Groups] : AMOPending ) {
+    if( AMOActive.find( Addr ) == AMOActive.end() && currentCycle - Groups.front().Opened >= amo_window )
+      Ready.push_back( Addr );
+  }
+  for( uint64_t Addr : Ready )
+    issueAMOGroup( Addr );
+}
+
+void RevBasicRmtMemCtrl::MarkAMOGroupComplete( const MemReq& Req ) {
+  auto it = AMOActive.find( Req.Addr );
+  if( it == AMOActive.end() )
+    output->fatal( CALL_INFO, -1, "Error: found unknown AMO group completion\n" );
+
+  // Replay the group in arrival order: each requester observes the value
+  // produced by the requests combined ahead of it
+  RmtAMOGroup& Group = it->second;
+  uint64_t     Cur   = Group.Old;
+  for( const auto& Op : Group.Ops ) {
+    xbgasNicEvent* RmtEvent = new xbgasNicEvent();
+    RmtEvent->buildAMOResp( Op.Id, Group.Size, reinterpret_cast<uint8_t*>( &Cur ) );
+    xbgasNic->send( RmtEvent, Op.SrcId );
+    foldAMO( Group.Flags, Group.Size, Cur, Op.Operand );
+  }
+  AMOActive.erase( it );
+
+  // Requests that arrived during the operation are waiting in the next group
+  if( amo_window == 0 )
+    issueAMOGroup( Req.Addr );
 }
 
 void RevBasicRmtMemCtrl::handleReadResp( xbgasNicEvent* ev ) {
@@ -531,7 +664,6 @@ void RevBasicRmtMemCtrl::handleBulkReadResp( xbgasNicEvent* ev ) {
     if( !Op )
       output->fatal( CALL_INFO, -1, "RevRmtMemOp is null in handleBulkReadResp\n" );
 
-    uint8_t* Target   = (uint8_t*) ( Op->getTarget() );
     uint64_t DestAddr = ev->getDestAddr();
     size_t   Size     = ev->getSize();
     uint32_t Nelem    = ev->getNelem();
@@ -540,16 +672,37 @@ void RevBasicRmtMemCtrl::handleBulkReadResp( xbgasNicEvent* ev ) {
 
     ev->getData( Buffer );
 
-    for( unsigned i = 0; i < Nelem; i++ ) {
-      Mem->WriteMem( virtualHart, DestAddr + i * Size, Size, (void*) ( &Buffer[i * Size] ), Flags );
+    uint64_t Counter = Op->getCounter();
+    if( Counter == _INVALID_ADDR_ ) {
+      for( unsigned i = 0; i < Nelem; i++ ) {
+        Mem->WriteMem( virtualHart, DestAddr + i * Size, Size, (void*) ( &Buffer[i * Size] ), Flags );
+      }
+    } else {
+      // Split-phase get: the counter may only move once memory has
+      // acknowledged the data, so track every write of the get
+      RmtCounterGet& Get = CounterGets[Id];
+      Get.Counter        = Counter;
+      Get.PendingWrites += Nelem;
+      for( unsigned i = 0; i < Nelem; i++ ) {
+        MemReq Req(
+          DestAddr + i * Size,           // Memory address
+          _INVALID_TID_,                 // Source ID
+          Id,                            // Packet ID
+          MemOp::MemOpWRITE,             // Memory operation
+          true,                          // Outstanding
+          [this]( const MemReq& Req ) {  // Lambda function as a callback
+            RevBasicRmtMemCtrl::MarkCounterWriteComplete( Req );
+          }
+        );
+        Mem->WriteMem( virtualHart, DestAddr + i * Size, Size, (void*) ( &Buffer[i * Size] ), Req, Flags );
+      }
     }
 
     delete[] Buffer;
 
     bool isSeg = ev->isSegmented();
     if( !isSeg ) {
-      // Update Target register to 1
-      *Target = 1;
+      completeBulkRead( Op, Id );
 
 #ifdef _XBGAS_RMT_DEBUG_
       std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " Mark Bulk READ Complete" << std::endl;
@@ -559,24 +712,26 @@ void RevBasicRmtMemCtrl::handleBulkReadResp( xbgasNicEvent* ev ) {
       outstanding.erase( Id );
       num_read_rqst--;
     } else {
-      if( PacketSegCount.find( Id ) != PacketSegCount.end() ) {
-        PacketSegCount[Id]++;
-        // Check if all the segments have been received
-        if( PacketSegCount[Id] == ev->getSegSz() ) {
-          PacketSegCount.erase( Id );
-          // Update Target register to 1
-          *Target = 1;
+      // Return the credit for this segment to the responder
+      uint32_t       RspId    = ev->getSrcId();
+      uint32_t       MyId     = (uint32_t) ( xbgasNic->getAddress() );
+      xbgasNicEvent* AckEvent = new xbgasNicEvent();
+      AckEvent->buildSegACK( Id, MyId );
+      xbgasNic->send( AckEvent, RspId );
+
+      // Check if all the segments have been received
+      uint64_t hashedId = RmtOpIDHash( RspId, Id );
+      if( ++PacketSegCount[hashedId] == ev->getSegSz() ) {
+        PacketSegCount.erase( hashedId );
+        completeBulkRead( Op, Id );
 
 #ifdef _XBGAS_RMT_DEBUG_
-          std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << ", Mark Bulk READ (Segmented) Complete" << std::endl;
+        std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << ", Mark Bulk READ (Segmented) Complete" << std::endl;
 #endif
 
-          requests.erase( std::find( requests.begin(), requests.end(), Id ) );
-          outstanding.erase( Id );
-          num_read_rqst--;
-        }
-      } else {
-        PacketSegCount.insert( { Id, 1 } );
+        requests.erase( std::find( requests.begin(), requests.end(), Id ) );
+        outstanding.erase( Id );
+        num_read_rqst--;
       }
     }
   } else {
@@ -609,6 +764,77 @@ void RevBasicRmtMemCtrl::handleReadLockResp( xbgasNicEvent* ev ) {
   return;
 }
 
+void RevBasicRmtMemCtrl::completeBulkRead( RevRmtMemOp* Op, uint32_t Id ) {
+  if( Op->getCounter() == _INVALID_ADDR_ ) {
+    // Update Target register to 1
+    *static_cast<uint8_t*>( Op->getTarget() ) = 1;
+    return;
+  }
+
+  // Split-phase get: the increment waits for the remaining data writes
+  auto it = CounterGets.find( Id );
+  if( it == CounterGets.end() )
+    output->fatal( CALL_INFO, -1, "Error: found unknown split-phase get completion\n" );
+  it->second.Received = true;
+  if( it->second.PendingWrites == 0 )
+    queueCounterInc( Id );
+}
+
+void RevBasicRmtMemCtrl::MarkCounterWriteComplete( const MemReq& Req ) {
+  auto it = CounterGets.find( Req.PktId );
+  if( it == CounterGets.end() )
+    output->fatal( CALL_INFO, -1, "Error: found unknown split-phase get write completion\n" );
+  if( --it->second.PendingWrites == 0 && it->second.Received )
+    queueCounterInc( Req.PktId );
+}
+
+void RevBasicRmtMemCtrl::queueCounterInc( uint32_t Id ) {
+  auto     it      = CounterGets.find( Id );
+  uint64_t Counter = it->second.Counter;
+  CounterGets.erase( it );
+
+  // The local memory controller only orders AMOs of one hart per address,
+  // so keep a single increment per counter in flight
+  CounterPending[Counter].push_back( Id );
+  if( CounterActive.find( Counter ) == CounterActive.end() )
+    issueCounterInc( Counter );
+}
+
+void RevBasicRmtMemCtrl::issueCounterInc( uint64_t Counter ) {
+  auto it = CounterPending.find( Counter );
+  if( it == CounterPending.end() )
+    return;
+
+  RmtCounterInc& Inc = CounterActive.emplace( Counter, RmtCounterInc{ it->second.front() } ).first->second;
+  it->second.pop_front();
+  if( it->second.empty() )
+    CounterPending.erase( it );
+
+  MemReq Req(
+    Counter,                       // Memory address
+    _INVALID_TID_,                 // Source ID
+    Inc.Id,                        // Packet ID
+    MemOp::MemOpAMO,               // Memory operation
+    true,                          // Outstanding
+    [this]( const MemReq& Req ) {  // Lambda function as a callback
+      RevBasicRmtMemCtrl::MarkCounterIncComplete( Req );
+    }
+  );
+
+  // Inc is node-based storage and stays put until the completion erases it
+  Mem->AMOMem( virtualHart, Counter, sizeof( uint64_t ), &Inc.Operand, &Inc.Old, Req, RevFlag::F_AMOADD );
+}
+
+void RevBasicRmtMemCtrl::MarkCounterIncComplete( const MemReq& Req ) {
+  auto it = CounterActive.find( Req.Addr );
+  if( it == CounterActive.end() )
+    output->fatal( CALL_INFO, -1, "Error: found unknown completion counter increment\n" );
+  CounterActive.erase( it );
+
+  // Gets that completed during the increment are waiting in the queue
+  issueCounterInc( Req.Addr );
+}
+
 void RevBasicRmtMemCtrl::handleWriteResp( xbgasNicEvent* ev ) {
   uint32_t Id = ev->getID();
 
@@ -726,50 +952,25 @@ void RevBasicRmtMemCtrl::MarkLocalLoadComplete( const MemReq& Req ) {
   if( LocalLoadCount[hashedId] == Nelem ) {
     switch( ReqPurp ) {
     case RmtMemOp::READResp:
-      RmtEvent = new xbgasNicEvent( getName() );
+      RmtEvent = new xbgasNicEvent();
       RmtEvent->buildREADResp( Id, DestAddr, Size, Nelem, Flags, Buffer );
       // Destination is the source of the request
       xbgasNic->send( RmtEvent, SrcId );
       break;
     case RmtMemOp::BulkREADResp:
-      // If the payload is larger than _MAX_PAYLOAD_ (4KB), segment the response
-      if( Size * Nelem > _MAX_PAYLOAD_ ) {
-        uint32_t SegSz = ( Size * Nelem ) / _MAX_PAYLOAD_;
-        uint32_t Rem   = ( Size * Nelem ) % _MAX_PAYLOAD_;
-        if( Rem != 0 )
-          SegSz++;
-
-        for( uint32_t i = 0; i < SegSz; i++ ) {
-          uint32_t SegPayload = ( Rem == 0 ) ? _MAX_PAYLOAD_ : ( i == SegSz - 1 ) ? Rem : _MAX_PAYLOAD_;
-          uint32_t SegNelem   = SegPayload / Size;
-
-#ifdef _XBGAS_DEBUG_
-          std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " Segmented READ Resp, ";
-          std::cout << "SegPayload: " << std::dec << SegPayload << ", SegNelem: " << SegNelem << std::endl;
-#endif
-          uint8_t* SegBuf = new uint8_t[SegPayload];
-          for( uint32_t j = 0; j < SegPayload; j++ ) {
-            SegBuf[j] = Buffer[i * _MAX_PAYLOAD_ + j];
-          }
-          RmtEvent = new xbgasNicEvent( getName() );
-          RmtEvent->buildSegBulkREADResp( Id, DestAddr + i * _MAX_PAYLOAD_, Size, SegNelem, Flags, SegSz, SegBuf );
-          xbgasNic->send( RmtEvent, SrcId );
-          delete[] SegBuf;
-        }
-      } else {
-        RmtEvent = new xbgasNicEvent( getName() );
-        RmtEvent->buildBulkREADResp( Id, DestAddr, Size, Nelem, Flags, Buffer );
+      // Segmented responses are streamed by pumpSegXfer
+      RmtEvent = new xbgasNicEvent();
+      RmtEvent->buildBulkREADResp( Id, DestAddr, Size, Nelem, Flags, Buffer );
 
 #ifdef _XBGAS_RMT_DEBUG_
-        std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " Bulk READ Resp, "
-                  << ", SrcId: " << std::dec << SrcId << ", Id: " << Id << std::endl;
+      std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " Bulk READ Resp, "
+                << ", SrcId: " << std::dec << SrcId << ", Id: " << Id << std::endl;
 #endif
-        // Destination is the source of the request
-        xbgasNic->send( RmtEvent, SrcId );
-      }
+      // Destination is the source of the request
+      xbgasNic->send( RmtEvent, SrcId );
       break;
     case RmtMemOp::READLOCKResp:
-      RmtEvent = new xbgasNicEvent( getName() );
+      RmtEvent = new xbgasNicEvent();
       RmtEvent->buildREADLOCKResp( Id, Size, Buffer );
       xbgasNic->send( RmtEvent, SrcId );
 
@@ -784,90 +985,181 @@ void RevBasicRmtMemCtrl::MarkLocalLoadComplete( const MemReq& Req ) {
       std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " Mark Local Load Complete for BulkWRITERqst " << std::endl;
 #endif
 
-      // If the payload is larger than _MAX_PAYLOAD_ (4KB), segment the request
-      if( Size * Nelem > _MAX_PAYLOAD_ ) {
-        uint32_t SegSz = ( Size * Nelem ) / _MAX_PAYLOAD_;
-        uint32_t Rem   = ( Size * Nelem ) % _MAX_PAYLOAD_;
-        if( Rem != 0 )
-          SegSz++;
-        for( uint32_t i = 0; i < SegSz; i++ ) {
-          uint32_t SegPayload = ( Rem == 0 ) ? _MAX_PAYLOAD_ : ( i == SegSz - 1 ) ? Rem : _MAX_PAYLOAD_;
-          uint32_t SegNelem   = SegPayload / Size;
-          uint8_t* SegBuf     = new uint8_t[SegPayload];
-          for( uint32_t j = 0; j < SegPayload; j++ ) {
-            SegBuf[j] = Buffer[i * _MAX_PAYLOAD_ + j];
-          }
-          RmtEvent = new xbgasNicEvent( getName() );
-          RmtEvent->setSrcId( SrcId );
-          RmtEvent->buildSegBulkWRITERqst( i, DestAddr + i * _MAX_PAYLOAD_, Size, SegNelem, Flags, SegSz, SegBuf );
-          if( i == 0 ) {
-            Id = RmtEvent->getID();
-            requests.push_back( Id );
-            outstanding[Id] = Op;
-          } else {
-            RmtEvent->setId( Id );
-          }
+      // Segmented requests are streamed by pumpSegXfer
+      RmtEvent = new xbgasNicEvent();
+      RmtEvent->setSrcId( SrcId );
+      RmtEvent->buildBulkWRITERqst( DestAddr, Size, Nelem, Flags, Buffer );
+      Id = RmtEvent->getID();
+      requests.push_back( Id );
+      outstanding[Id] = Op;
 
 #ifdef _XBGAS_RMT_DEBUG_
-          std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " Send out the Bulk WRITE request (segmented)"
-                    << " to SrcId: " << std::dec << SrcId << " Id: " << Id << " DestAddr: 0x" << std::hex
-                    << DestAddr + i * _MAX_PAYLOAD_ << std::dec << ", SegNelem: " << SegNelem << std::endl;
+      std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " Send out the Bulk WRITE request"
+                << " to SrcId: " << std::dec << SrcId << " Id: " << Id << " DestAddr: 0x" << std::hex << DestAddr << std::dec
+                << ", Nelem: " << Nelem << std::endl;
 #endif
 
-          xbgasNic->send( RmtEvent, DestId );
-          if( i == SegSz - 1 ) {
-            // Update the target register to 1 as the data has been copied out
-            *Target = 1;
-          }
-          recordStat( RmtWriteInFlight, 1 );
-          delete[] SegBuf;
-        }
-      } else {
-        RmtEvent = new xbgasNicEvent( getName() );
-        RmtEvent->setSrcId( SrcId );
-        RmtEvent->buildBulkWRITERqst( DestAddr, Size, Nelem, Flags, Buffer );
-        Id = RmtEvent->getID();
-        requests.push_back( Id );
-        outstanding[Id] = Op;
+      xbgasNic->send( RmtEvent, DestId );
+      // Update the target register to 1 as the data has been copied out
+      *Target = 1;
 
 #ifdef _XBGAS_RMT_DEBUG_
-        std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " Send out the Bulk WRITE request"
-                  << " to SrcId: " << std::dec << SrcId << " Id: " << Id << " DestAddr: 0x" << std::hex << DestAddr << std::dec
-                  << ", Nelem: " << Nelem << std::endl;
+      // Print the address of Target
+      std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " Target Address: " << std::hex << Target << std::dec
+                << ", Value: " << std::dec << *Target << std::endl;
 #endif
 
-        xbgasNic->send( RmtEvent, DestId );
-        // Update the target register to 1 as the data has been copied out
-        *Target = 1;
+      recordStat( RmtWriteInFlight, 1 );
+      break;
+    default: break;
+    }
+    delete[] Buffer;
+    LocalLoadTrack.erase( hashedId );
+    LocalLoadCount.erase( hashedId );
+  }
+}
+
+void RevBasicRmtMemCtrl::handleSegACK( xbgasNicEvent* ev ) {
+  uint64_t hashedId = RmtOpIDHash( ev->getSrcId(), ev->getID() );
+  auto     it       = SegXferTrack.find( hashedId );
+  if( it == SegXferTrack.end() )
+    output->fatal( CALL_INFO, -1, "Error: found unknown SegACK\n" );
+
+  RmtSegXfer& Xfer = it->second;
+  Xfer.InFlight--;
+  Xfer.Acked++;
+
+  if( Xfer.Acked == Xfer.SegSz ) {
+    // Every segment has been delivered, retire the transfer
+    delete[] Xfer.Buffer;
+    SegXferTrack.erase( it );
+  } else {
+    pumpSegXfer( hashedId );
+  }
+  delete ev;
+}
+
+void RevBasicRmtMemCtrl::startSegXfer( RmtSegXfer&& Xfer ) {
+  // Each segment carries a whole number of elements
+  Xfer.SegNelem     = std::max<uint32_t>( 1, mtu / Xfer.Size );
+  Xfer.SegSz        = ( Xfer.Nelem + Xfer.SegNelem - 1 ) / Xfer.SegNelem;
+  Xfer.Loaded.assign( Xfer.SegSz, 0 );
+
+  uint64_t hashedId = RmtOpIDHash( Xfer.SrcId, Xfer.Id );
+  if( !SegXferTrack.emplace( hashedId, std::move( Xfer ) ).second )
+    output->fatal( CALL_INFO, -1, "Error: duplicate segmented transfer\n" );
 
 #ifdef _XBGAS_RMT_DEBUG_
-        // Print the address of Target
-        std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " Target Address: " << std::hex << Target << std::dec
-                  << ", Value: " << std::dec << *Target << std::endl;
+  std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " Start segmented transfer, hashedId: 0x" << std::hex << hashedId << std::dec
+            << ", SegSz: " << SegXferTrack.at( hashedId ).SegSz << std::endl;
 #endif
 
-        recordStat( RmtWriteInFlight, 1 );
+  pumpSegXfer( hashedId );
+}
+
+void RevBasicRmtMemCtrl::pumpSegXfer( uint64_t Key ) {
+  auto it = SegXferTrack.find( Key );
+  if( it == SegXferTrack.end() )
+    output->fatal( CALL_INFO, -1, "Error: unable to find the segmented transfer\n" );
+
+  RmtSegXfer& Xfer = it->second;
+
+  // Local loads complete synchronously without memHierarchy, which would
+  // otherwise re-enter this function from MarkSegLoadComplete
+  if( Xfer.Pumping )
+    return;
+  Xfer.Pumping  = true;
+
+  bool progress = true;
+  while( progress ) {
+    progress = false;
+
+    // Send every fully loaded segment in order while credits remain
+    while( Xfer.NextSend < Xfer.NextLoad && Xfer.Loaded[Xfer.NextSend] == Xfer.getSegNelem( Xfer.NextSend ) ) {
+      if( Xfer.InFlight == seg_window ) {
+        recordStat( RmtSegCreditStalls, 1 );
+        break;
       }
-      break;
-    case RmtMemOp::AMOResp:
+      sendSegment( Xfer, Xfer.NextSend++ );
+      progress = true;
+    }
 
-#ifdef _XBGAS_AMO_DEBUG_
-      std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " Send out the AMO response"
-                << " to SrcId: " << std::dec << SrcId << " Id: " << Id << std::endl;
-      // Print the content of the buffer
-      std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " AMO Response Buffer: " << std::dec << *(int*) Buffer << std::endl;
-#endif
+    // Keep the local reads at most one window ahead of the network
+    if( Xfer.NextLoad < Xfer.SegSz && Xfer.NextLoad < Xfer.Acked + 2 * seg_window ) {
+      uint32_t Seg   = Xfer.NextLoad++;
+      uint32_t Base  = Seg * Xfer.SegNelem;
+      uint32_t Nelem = Xfer.getSegNelem( Seg );
+      for( uint32_t i = Base; i < Base + Nelem; i++ ) {
+        MemReq LocalReq(
+          Xfer.SrcAddr + i * Xfer.Size,  // Memory address
+          Xfer.SrcId,                    // Source ID
+          Xfer.Id,                       // Packet ID
+          MemOp::MemOpREAD,              // Memory operation
+          true,                          // Outstanding
+          [this]( const MemReq& Req ) {  // Lambda function as a callback
+            RevBasicRmtMemCtrl::MarkSegLoadComplete( Req );
+          }
+        );
+        Mem->ReadMem(
+          virtualHart,
+          Xfer.SrcAddr + i * Xfer.Size,
+          Xfer.Size,
+          (void*) ( &Xfer.Buffer[i * Xfer.Size] ),
+          std::move( LocalReq ),
+          Xfer.Flags
+        );
+      }
+      progress = true;
+    }
+  }
 
-      RmtEvent = new xbgasNicEvent( getName() );
-      RmtEvent->buildAMOResp( Id, Size, Buffer );
-      xbgasNic->send( RmtEvent, SrcId );
-      break;
-    default: break;
+  Xfer.Pumping = false;
+}
+
+void RevBasicRmtMemCtrl::sendSegment( RmtSegXfer& Xfer, uint32_t Seg ) {
+  uint64_t       Offset   = uint64_t( Seg ) * Xfer.SegNelem * Xfer.Size;
+  uint32_t       SegNelem = Xfer.getSegNelem( Seg );
+  xbgasNicEvent* RmtEvent = new xbgasNicEvent();
+  RmtEvent->setSrcId( (uint32_t) ( xbgasNic->getAddress() ) );
+
+  if( Xfer.ReqPurp == RmtMemOp::BulkREADResp ) {
+    RmtEvent->buildSegBulkREADResp(
+      Xfer.Id, Xfer.DestAddr + Offset, Xfer.Size, SegNelem, Xfer.Flags, Xfer.SegSz, &Xfer.Buffer[Offset]
+    );
+  } else {
+    RmtEvent->buildSegBulkWRITERqst(
+      Xfer.Id, Xfer.DestAddr + Offset, Xfer.Size, SegNelem, Xfer.Flags, Xfer.SegSz, &Xfer.Buffer[Offset]
+    );
+    recordStat( RmtWriteInFlight, 1 );
+    if( Seg == Xfer.SegSz - 1 ) {
+      // Update the target register to 1 as the data has been copied out
+      *static_cast<uint8_t*>( Xfer.Target ) = 1;
     }
-    delete[] Buffer;
-    LocalLoadTrack.erase( hashedId );
-    LocalLoadCount.erase( hashedId );
   }
+
+#ifdef _XBGAS_RMT_DEBUG_
+  std::cout << "_XBGAS_DEBUG_ : PE " << getPEID() << " Send segment " << std::dec << Seg << " of " << Xfer.SegSz << " to "
+            << Xfer.DestId << " Id: " << Xfer.Id << " DestAddr: 0x" << std::hex << Xfer.DestAddr + Offset << std::dec
+            << ", SegNelem: " << SegNelem << std::endl;
+#endif
+
+  xbgasNic->send( RmtEvent, Xfer.DestId );
+  Xfer.InFlight++;
+  recordStat( RmtSegsSent, 1 );
+}
+
+void RevBasicRmtMemCtrl::MarkSegLoadComplete( const MemReq& Req ) {
+  uint64_t hashedId = RmtOpIDHash( Req.SrcId, Req.PktId );
+  auto     it       = SegXferTrack.find( hashedId );
+  if( it == SegXferTrack.end() )
+    output->fatal( CALL_INFO, -1, "Error: unable to find the segmented transfer for a local load\n" );
+
+  RmtSegXfer& Xfer = it->second;
+  uint32_t    Seg  = uint32_t( ( Req.Addr - Xfer.SrcAddr ) / Xfer.Size / Xfer.SegNelem );
+
+  // Once a segment is fully loaded it may be sent
+  if( ++Xfer.Loaded[Seg] == Xfer.getSegNelem( Seg ) )
+    pumpSegXfer( hashedId );
 }
 
 void RevBasicRmtMemCtrl::init( unsigned int phase ) {
@@ -963,6 +1255,22 @@ bool RevBasicRmtMemCtrl::sendRmtBulkReadRqst(
   return true;
 }
 
+bool RevBasicRmtMemCtrl::sendRmtGetNBRqst(
+  unsigned Hart, uint64_t Nmspace, uint64_t SrcAddr, size_t Size, uint32_t Nelem, uint64_t DestAddr, uint64_t Counter
+) {
+  if( Size == 0 || Nelem == 0 )
+    return true;
+
+  RevRmtMemOp* Op =
+    new RevRmtMemOp( Hart, Nmspace, SrcAddr, DestAddr, Size, Nelem, RmtMemOp::BulkREADRqst, RevFlag::F_NONE, nullptr );
+  Op->setCounter( Counter );
+
+  rqstQ.push_back( Op );
+  recordStat( RevBasicRmtMemCtrl::RmtMemCtrlStats::RmtReadPending, 1 );
+  recordStat( RevBasicRmtMemCtrl::RmtMemCtrlStats::RmtGetNB, 1 );
+  return true;
+}
+
 bool RevBasicRmtMemCtrl::sendRmtWriteRqst(
   unsigned Hart, uint64_t Nmspace, uint64_t DestAddr, size_t Size, uint8_t* Buffer, RevFlag Flags
 ) {
@@ -1060,6 +1368,11 @@ bool RevBasicRmtMemCtrl::sendFENCE( unsigned Hart ) {
 }
 
 bool RevBasicRmtMemCtrl::clockTick( Cycle_t cycle ) {
+  currentCycle = cycle;
+
+  // Issue remote AMO groups whose combining window has closed
+  progressAMOGroups();
+
   // Check to see if the top request is a FENCE request
   if( num_fence > 0 ) {
 
@@ -1114,6 +1427,14 @@ bool RevBasicRmtMemCtrl::isDone() {
   return requests.size() == 0;
 }
 
+// Nothing of the controller is checkpointed: a checkpoint is only written
+// once no request of this PE is pending and no remote lock is held here
+bool RevBasicRmtMemCtrl::isQuiesced() {
+  return requests.empty() && rqstQ.empty() && outstanding.empty() && getTotalRqsts() == 0 && LocalLoadTrack.empty() &&
+         LocalLoadCount.empty() && PacketSegCount.empty() && SegXferTrack.empty() && AMOPending.empty() && AMOActive.empty() &&
+         CounterGets.empty() && CounterPending.empty() && CounterActive.empty() && RmtLRSC.empty() && PendingRmtLRSC.empty();
+}
+
 bool RevBasicRmtMemCtrl::processNextRqst(
   unsigned& t_max_loads, unsigned& t_max_stores, unsigned& t_max_readlock, unsigned& t_max_writeunlock, unsigned& t_max_ops
 
@@ -1234,7 +1555,7 @@ bool RevBasicRmtMemCtrl::buildRmtMemRqst( RevRmtMemOp* Op, bool& Success ) {
 
   switch( Op->getOp() ) {
   case RmtMemOp::READRqst:
-    RmtEvent = new xbgasNicEvent( getName() );
+    RmtEvent = new xbgasNicEvent();
     RmtEvent->setSrcId( SrcId );
     RmtEvent->buildREADRqst( SrcAddr, DestAddr, Size, Flags );
     Id = RmtEvent->getID();
@@ -1249,7 +1570,7 @@ bool RevBasicRmtMemCtrl::buildRmtMemRqst( RevRmtMemOp* Op, bool& Success ) {
 #endif
     break;
   case RmtMemOp::BulkREADRqst:
-    RmtEvent = new xbgasNicEvent( getName() );
+    RmtEvent = new xbgasNicEvent();
     RmtEvent->setSrcId( SrcId );
     RmtEvent->buildBulkREADRqst( SrcAddr, DestAddr, Size, Nelem, Flags );
     Id = RmtEvent->getID();
@@ -1264,7 +1585,7 @@ bool RevBasicRmtMemCtrl::buildRmtMemRqst( RevRmtMemOp* Op, bool& Success ) {
 #endif
     break;
   case RmtMemOp::READLOCKRqst:
-    RmtEvent = new xbgasNicEvent( getName() );
+    RmtEvent = new xbgasNicEvent();
     RmtEvent->setSrcId( SrcId );
     RmtEvent->buildREADLOCKRqst( SrcAddr, Size, Flags );
     RmtEvent->setHart( Hart );
@@ -1284,7 +1605,7 @@ bool RevBasicRmtMemCtrl::buildRmtMemRqst( RevRmtMemOp* Op, bool& Success ) {
     for( unsigned i = 0; i < Size; ++i ) {
       Buffer[i] = tmpBuf[i];
     }
-    RmtEvent = new xbgasNicEvent( getName() );
+    RmtEvent = new xbgasNicEvent();
     RmtEvent->setSrcId( SrcId );
     RmtEvent->buildWRITERqst( DestAddr, Size, Flags, Buffer );
     Id = RmtEvent->getID();
@@ -1300,6 +1621,27 @@ bool RevBasicRmtMemCtrl::buildRmtMemRqst( RevRmtMemOp* Op, bool& Success ) {
 #endif
     break;
   case RmtMemOp::BulkWRITERqst:
+    // Large writes are streamed to the destination one segment at a time
+    if( isSegmented( Size, Nelem ) ) {
+      RmtSegXfer Xfer;
+      Xfer.Id       = xbgasNicEvent::newID();
+      Xfer.SrcId    = SrcId;
+      Xfer.DestId   = DestId;
+      Xfer.SrcAddr  = SrcAddr;
+      Xfer.DestAddr = DestAddr;
+      Xfer.Size     = Size;
+      Xfer.Nelem    = Nelem;
+      Xfer.Flags    = Flags;
+      Xfer.Target   = Op->getTarget();
+      Xfer.Buffer   = new uint8_t[Size * Nelem];
+      Xfer.ReqPurp  = RmtMemOp::BulkWRITERqst;
+      requests.push_back( Xfer.Id );
+      outstanding[Xfer.Id] = Op;
+      num_write_rqst += 1;
+      startSegXfer( std::move( Xfer ) );
+      break;
+    }
+
     // The bulk write request will be sent out once the data is read from the local memory
     localId = local_read_id++;
     Buffer  = new uint8_t[Size * Nelem];
@@ -1346,7 +1688,6 @@ bool RevBasicRmtMemCtrl::buildRmtMemRqst( RevRmtMemOp* Op, bool& Success ) {
       Mem->ReadMem( virtualHart, SrcAddr + i * Size, Size, (void*) ( &Buffer[i * Size] ), std::move( LocalReq ), Flags );
     }
 
-    // Decide if the Write request should be segmented
     num_write_rqst += 1;
     break;
   case RmtMemOp::WRITEUNLOCKRqst:
@@ -1354,7 +1695,7 @@ bool RevBasicRmtMemCtrl::buildRmtMemRqst( RevRmtMemOp* Op, bool& Success ) {
     for( unsigned i = 0; i < Size; ++i ) {
       Buffer[i] = tmpBuf[i];
     }
-    RmtEvent = new xbgasNicEvent( getName() );
+    RmtEvent = new xbgasNicEvent();
     RmtEvent->setSrcId( SrcId );
     RmtEvent->buildWRITEUNLOCKRqst( DestAddr, Size, Flags, Buffer );
     RmtEvent->setHart( Hart );
@@ -1375,7 +1716,7 @@ bool RevBasicRmtMemCtrl::buildRmtMemRqst( RevRmtMemOp* Op, bool& Success ) {
     for( unsigned i = 0; i < Size; ++i ) {
       Buffer[i] = tmpBuf[i];
     }
-    RmtEvent = new xbgasNicEvent( getName() );
+    RmtEvent = new xbgasNicEvent();
     RmtEvent->setSrcId( SrcId );
     RmtEvent->buildAMORqst( SrcAddr, Size, Flags, Buffer );
     Id = RmtEvent->getID();
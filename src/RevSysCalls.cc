@@ -2,8 +2,13 @@
 #include "RevCore.h"
 #include "RevMem.h"
 #include "RevSysCalls.h"
+#include <algorithm>
 #include <bitset>
+#include <cerrno>
+#include <climits>
 #include <filesystem>
+#include <sys/stat.h>
+#include <sys/uio.h>
 #include <sys/xattr.h>
 
 namespace SST::RevCPU {
@@ -11,16 +16,18 @@ namespace SST::RevCPU {
 /// Parse a string for an ECALL starting at address straddr, updating the state
 /// as characters are read, and call action() when the end of string is reached.
 EcallStatus RevCore::EcallLoadAndParseString( uint64_t straddr, std::function<void()> action ) {
-  auto  rtval      = EcallStatus::ERROR;
-  auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
+  auto&    EcallState = Harts.at( HartToExecID )->GetEcallState();
+  auto     lsq_hash   = LSQHash( RevReg::a0, RevRegClass::RegGPR, HartToExecID );
+  uint64_t Line       = std::min<uint64_t>( mem->getLineSize() ? mem->getLineSize() : 64, EcallState.buf.size() );
 
-  if( RegFile->GetLSQueue()->count( LSQHash( RevReg::a0, RevRegClass::RegGPR, HartToExecID ) ) > 0 ) {
-    rtval = EcallStatus::CONTINUE;
-  } else {
-    // we don't know how long the path string is so read a byte (char)
-    // at a time and search for the string terminator character '\0'
+  // The internal memory model completes each read on issue, so the whole
+  // string is parsed in one pass; with memHierarchy one line is read per pass.
+  while( LSQueue->count( lsq_hash ) == 0 ) {
+    // append the last line read, up to and including the terminator
     if( EcallState.bytesRead != 0 ) {
-      EcallState.string += std::string_view( EcallState.buf.data(), EcallState.bytesRead );
+      std::string_view Chunk( EcallState.buf.data(), EcallState.bytesRead );
+      size_t           Nul = Chunk.find( '\0' );
+      EcallState.string += Chunk.substr( 0, Nul == std::string_view::npos ? Nul : Nul + 1 );
       EcallState.bytesRead = 0;
     }
 
@@ -34,27 +41,247 @@ EcallStatus RevCore::EcallLoadAndParseString( uint64_t straddr, std::function<vo
       // from the caller, such as performing a syscall using EcallState.string.
       action();
       DependencyClear( HartToExecID, RevReg::a0, RevRegClass::RegGPR );
-      rtval = EcallStatus::SUCCESS;
+      return EcallStatus::SUCCESS;
+    }
+
+    // We are in the middle of the string - read up to the end of the line.
+    // A line never crosses a page, so this stays within mapped memory.
+    uint64_t Addr = straddr + EcallState.string.size();
+    MemReq   req{
+      Addr, RevReg::a0, RevRegClass::RegGPR, HartToExecID, MemOp::MemOpREAD, true, RegFile->GetMarkLoadComplete() };
+    LSQueue->insert( req.LSQHashPair() );
+    EcallState.bytesRead = Line - Addr % Line;
+    mem->ReadMem( HartToExecID, Addr, EcallState.bytesRead, EcallState.buf.data(), req, RevFlag::F_NONE );
+  }
+  DependencySet( HartToExecID, RevReg::a0, RevRegClass::RegGPR );
+  return EcallStatus::CONTINUE;
+}
+
+/// Read Len bytes at address Addr into Buf. Each re-entry tops up the reads
+/// in flight; the range is split at chunk boundaries (cache lines with a
+/// memory controller, pages with the internal model) so no request spans two.
+/// EcallState.bytesRead - Base counts the bytes of this range requested so far.
+EcallStatus RevCore::EcallReadGuest( uint64_t Addr, size_t Len, char* Buf, size_t Base ) {
+  auto&    EcallState = Harts.at( HartToExecID )->GetEcallState();
+  auto     lsq_hash   = LSQHash( RevReg::a0, RevRegClass::RegGPR, HartToExecID );
+  uint64_t Chunk      = mem->getChunkSize();
+
+  while( EcallState.bytesRead - Base < Len && LSQueue->count( lsq_hash ) < REV_ECALL_MAX_INFLIGHT ) {
+    size_t   Done = EcallState.bytesRead - Base;
+    uint64_t Cur  = Addr + Done;
+    size_t   Size = std::min<uint64_t>( Len - Done, Chunk - Cur % Chunk );
+    MemReq   req{ Cur, RevReg::a0, RevRegClass::RegGPR, HartToExecID, MemOp::MemOpREAD, true, RegFile->GetMarkLoadComplete() };
+    LSQueue->insert( req.LSQHashPair() );
+    mem->ReadMem( HartToExecID, Cur, Size, Buf + Done, req, RevFlag::F_NONE );
+    EcallState.bytesRead += Size;
+  }
+
+  if( LSQueue->count( lsq_hash ) > 0 ) {
+    DependencySet( HartToExecID, RevReg::a0, RevRegClass::RegGPR );
+    return EcallStatus::CONTINUE;
+  }
+  DependencyClear( HartToExecID, RevReg::a0, RevRegClass::RegGPR );
+  return EcallStatus::SUCCESS;
+}
+
+/// Write Len bytes of Buf to address Addr. Writes are posted: the memory
+/// controller copies the data on issue, so nothing is left to wait for.
+void RevCore::EcallWriteGuest( uint64_t Addr, size_t Len, const char* Buf ) {
+  uint64_t Chunk = mem->getChunkSize();
+  for( size_t Done = 0; Done < Len; ) {
+    uint64_t Cur  = Addr + Done;
+    size_t   Size = std::min<uint64_t>( Len - Done, Chunk - Cur % Chunk );
+    mem->WriteMem( HartToExecID, Cur, Size, Buf + Done );
+    Done += Size;
+  }
+}
+
+/// Read Len bytes at address Addr into the ECALL buffer at Offset. Reads of
+/// one ECALL are issued in order of Offset; returns SUCCESS once the buffer
+/// holds the data up to Offset + Len.
+EcallStatus RevCore::EcallLoadBytes( uint64_t Addr, size_t Len, size_t Offset ) {
+  auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
+
+  if( RegFile->GetLSQueue()->count( LSQHash( RevReg::a0, RevRegClass::RegGPR, HartToExecID ) ) > 0 ) {
+    return EcallStatus::CONTINUE;
+  }
+  if( EcallState.bytesRead >= Offset + Len ) {
+    DependencyClear( HartToExecID, RevReg::a0, RevRegClass::RegGPR );
+    return EcallStatus::SUCCESS;
+  }
+  if( Offset + Len > EcallState.buf.size() ) {
+    output->fatal( CALL_INFO, -1, "Error: ECALL read of %zu bytes at offset %zu overflows the ECALL buffer\n", Len, Offset );
+  }
+
+  MemReq req{
+    Addr, RevReg::a0, RevRegClass::RegGPR, HartToExecID, MemOp::MemOpREAD, true, [=]( const MemReq& req ) {
+      this->MarkLoadComplete( req );
+    } };
+  LSQueue->insert( req.LSQHashPair() );
+  mem->ReadMem( HartToExecID, Addr, Len, EcallState.buf.data() + Offset, req, RevFlag::F_NONE );
+  EcallState.bytesRead = Offset + Len;
+  DependencySet( HartToExecID, RevReg::a0, RevRegClass::RegGPR );
+  return EcallStatus::CONTINUE;
+}
+
+/// Load the guest struct iovec array of VLen entries at Vec into
+/// EcallState.iov. EcallState.bytesRead is back at 0 once it is loaded.
+EcallStatus RevCore::EcallLoadIovec( uint64_t Vec, uint64_t VLen ) {
+  auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
+  if( !EcallState.iov.empty() || VLen == 0 )
+    return EcallStatus::SUCCESS;
+
+  EcallState.string.resize( VLen * 16 );
+  if( auto rtval = EcallReadGuest( Vec, VLen * 16, EcallState.string.data() ); rtval != EcallStatus::SUCCESS )
+    return rtval;
+
+  // rv64 struct iovec: void* iov_base, size_t iov_len
+  for( uint64_t i = 0; i < VLen; i++ ) {
+    uint64_t Base, Len;
+    memcpy( &Base, EcallState.string.data() + i * 16, sizeof( Base ) );
+    memcpy( &Len, EcallState.string.data() + i * 16 + 8, sizeof( Len ) );
+    EcallState.iov.emplace_back( Base, Len );
+  }
+  EcallState.string.clear();
+  EcallState.bytesRead = 0;
+  return EcallStatus::SUCCESS;
+}
+
+/// Host readv/writev (Offset < 0) or preadv/pwritev over Iov, IOV_MAX entries
+/// per call; stops at the first short transfer. Returns the bytes moved, or
+/// -errno if the first call fails.
+static ssize_t HostIOV( int fd, std::vector<iovec>& Iov, int64_t Offset, bool Read ) {
+  ssize_t Done = 0;
+  for( size_t i = 0; i < Iov.size(); i += IOV_MAX ) {
+    int     Cnt  = int( std::min<size_t>( Iov.size() - i, IOV_MAX ) );
+    ssize_t Want = 0;
+    for( int j = 0; j < Cnt; j++ )
+      Want += ssize_t( Iov[i + j].iov_len );
+
+    ssize_t rc;
+    if( Offset < 0 ) {
+      rc = Read ? readv( fd, &Iov[i], Cnt ) : writev( fd, &Iov[i], Cnt );
     } else {
-      //We are in the middle of the string - read one byte
-      MemReq req{
-        straddr + EcallState.string.size(),
-        RevReg::a0,
-        RevRegClass::RegGPR,
-        HartToExecID,
-        MemOp::MemOpREAD,
-        true,
-        [=]( const MemReq& req ) { this->MarkLoadComplete( req ); } };
-      LSQueue->insert( req.LSQHashPair() );
-      mem->ReadVal( HartToExecID, straddr + EcallState.string.size(), EcallState.buf.data(), req, RevFlag::F_NONE );
-      EcallState.bytesRead = 1;
-      DependencySet( HartToExecID, RevReg::a0, RevRegClass::RegGPR );
-      rtval = EcallStatus::CONTINUE;
+      rc = Read ? preadv( fd, &Iov[i], Cnt, Offset + Done ) : pwritev( fd, &Iov[i], Cnt, Offset + Done );
+    }
+    if( rc < 0 )
+      return Done ? Done : -errno;
+    Done += rc;
+    if( rc < Want )
+      break;
+  }
+  return Done;
+}
+
+/// Transfer between the host file fd and the guest ranges Segs: into guest
+/// memory if ToGuest, out of it otherwise. With the internal memory model the
+/// host call reads or writes the backing pages directly. With memHierarchy
+/// the data is staged in EcallState.string: gathered with EcallReadGuest
+/// before a host write, or scattered with EcallWriteGuest after a host read.
+EcallStatus RevCore::EcallHostIO( int fd, const std::vector<std::pair<uint64_t, uint64_t>>& Segs, int64_t Offset, bool ToGuest ) {
+  auto&              EcallState = Harts.at( HartToExecID )->GetEcallState();
+  ssize_t            rc;
+  std::vector<iovec> Host;
+  bool               Direct = true;
+  for( const auto& [Addr, Len] : Segs ) {
+    if( !mem->GetHostSpans( Addr, Len, Host ) ) {
+      Direct = false;
+      break;
+    }
+  }
+
+  if( Direct ) {
+    rc = HostIOV( fd, Host, Offset, ToGuest );
+    uint64_t Left = rc > 0 ? uint64_t( rc ) : 0;
+    for( auto Seg = Segs.begin(); Left && Seg != Segs.end(); ++Seg ) {
+      uint64_t Len = std::min( Left, Seg->second );
+      mem->HostAccess( HartToExecID, Seg->first, Len, ToGuest );
+      Left -= Len;
+    }
+  } else {
+    size_t Total = 0;
+    for( const auto& Seg : Segs )
+      Total += Seg.second;
+    EcallState.string.resize( Total );
+
+    if( !ToGuest ) {
+      size_t Base = 0;
+      for( const auto& [Addr, Len] : Segs ) {
+        auto rtval = EcallReadGuest( Addr, Len, EcallState.string.data() + Base, Base );
+        if( EcallState.bytesRead < Base + Len )
+          return rtval;
+        Base += Len;
+      }
+      if( LSQueue->count( LSQHash( RevReg::a0, RevRegClass::RegGPR, HartToExecID ) ) > 0 )
+        return EcallStatus::CONTINUE;
+    }
+
+    std::vector<iovec> Stage{ { EcallState.string.data(), Total } };
+    rc = HostIOV( fd, Stage, Offset, ToGuest );
+
+    if( ToGuest ) {
+      size_t Base = 0;
+      for( auto Seg = Segs.begin(); rc > 0 && Base < size_t( rc ) && Seg != Segs.end(); ++Seg ) {
+        EcallWriteGuest( Seg->first, std::min<size_t>( Seg->second, size_t( rc ) - Base ), EcallState.string.data() + Base );
+        Base += Seg->second;
+      }
     }
   }
+
+  RegFile->SetX( RevReg::a0, rc );
+  DependencyClear( HartToExecID, RevReg::a0, RevRegClass::RegGPR );
+  return EcallStatus::SUCCESS;
+}
+
+/// Write the part of [Addr, Addr+Len) backed by the file of a copied
+/// MAP_SHARED mapping back to the file; a0 is 0 on success.
+EcallStatus RevCore::EcallWriteBack( const RevMem::FileMap& Map, uint64_t Base, uint64_t Addr, uint64_t Len ) {
+  uint64_t Lo = std::max( Addr, Base );
+  uint64_t Hi = std::min( Addr + Len, Base + Map.FileLen );
+  if( Lo >= Hi ) {
+    RegFile->SetX( RevReg::a0, 0 );
+    return EcallStatus::SUCCESS;
+  }
+  auto rtval = EcallHostIO( Map.Fd, { { Lo, Hi - Lo } }, int64_t( Map.Offset + ( Lo - Base ) ), false );
+  if( rtval == EcallStatus::SUCCESS && RegFile->GetX<int64_t>( RevReg::a0 ) > 0 )
+    RegFile->SetX( RevReg::a0, 0 );
   return rtval;
 }
 
+/// Move the calling thread off its hart and hand it to RevCPU as BLOCKED.
+/// RevCPU readies it at WakeCycle, or on a FUTEX_WAKE of FutexAddr.
+EcallStatus RevCore::EcallBlockThread( uint64_t WakeCycle, uint64_t FutexAddr ) {
+  if( !HartHasNoDependencies( HartToExecID ) ) {
+    return EcallStatus::CONTINUE;
+  }
+  std::unique_ptr<RevThread> BlockedThread = PopThreadFromHart( HartToExecID );
+  BlockedThread->SetState( ThreadState::BLOCKED );
+  BlockedThread->SetWakeCycle( WakeCycle );
+  BlockedThread->SetFutexWait( FutexAddr, Harts.at( HartToExecID )->GetEcallState().waitSeq );
+  AddThreadsThatChangedState( std::move( BlockedThread ) );
+  return EcallStatus::SUCCESS;
+}
+
+uint64_t RevCore::GuestTimeNs() const {
+  return timeConverter ? timeConverter->convertToCoreTime( Stats.totalCycles ) / 1000 : Stats.totalCycles;
+}
+
+uint64_t RevCore::NsToCycles( uint64_t Ns ) const {
+  uint64_t Cycles = timeConverter ? timeConverter->convertFromCoreTime( Ns * 1000 ) : Ns;
+  return Cycles ? Cycles : 1;
+}
+
+/// Decode a guest struct __kernel_timespec (64-bit seconds, nanoseconds in the low word) to ns
+static uint64_t TimespecNs( const char* buf ) {
+  int64_t  sec;
+  uint32_t nsec;
+  memcpy( &sec, buf, sizeof( sec ) );
+  memcpy( &nsec, buf + 8, sizeof( nsec ) );
+  if( sec < 0 || nsec >= 1000000000u )
+    return ~uint64_t{ 0 };
+  return uint64_t( sec ) * 1000000000u + nsec;
+}
+
 // 0, rev_io_setup(unsigned nr_reqs, aio_context_t  *ctx)
 EcallStatus RevCore::ECALL_io_setup() {
   output->verbose(
@@ -686,11 +913,21 @@ EcallStatus RevCore::ECALL_getdents64() {
   return EcallStatus::SUCCESS;
 }
 
-// 62, rev_llseek(unsigned int fd, unsigned long offset_high, unsigned long offset_low, loff_t  *result, unsigned int whence)
+// 62, rev_lseek(unsigned int fd, off_t offset, unsigned int whence)
 EcallStatus RevCore::ECALL_lseek() {
   output->verbose(
     CALL_INFO, 2, 0, "ECALL: lseek called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
   );
+  auto fd     = RegFile->GetX<int>( RevReg::a0 );
+  auto offset = RegFile->GetX<int64_t>( RevReg::a1 );
+  auto whence = RegFile->GetX<int>( RevReg::a2 );
+
+  if( !Harts.at( HartToExecID )->Thread->FindFD( fd ) ) {
+    RegFile->SetX( RevReg::a0, -EBADF );
+    return EcallStatus::SUCCESS;
+  }
+  off_t rc = lseek( fd, offset, whence );
+  RegFile->SetX( RevReg::a0, rc < 0 ? -errno : rc );
   return EcallStatus::SUCCESS;
 }
 
@@ -720,18 +957,8 @@ EcallStatus RevCore::ECALL_read() {
     return EcallStatus::SUCCESS;
   }
 
-  // This buffer is an intermediate buffer for storing the data read from host
-  // for later use in writing to RevMem
-  std::vector<char> TmpBuf( BufSize );
-
-  // Do the read on the host
-  int rc = read( fd, &TmpBuf[0], BufSize );
-
-  // Write that data to the buffer inside of Rev
-  mem->WriteMem( HartToExecID, BufAddr, BufSize, &TmpBuf[0] );
-
-  RegFile->SetX( RevReg::a0, rc );
-  return EcallStatus::SUCCESS;
+  // Do the read on the host, straight into the buffer inside of Rev where possible
+  return EcallHostIO( fd, { { BufAddr, BufSize } }, -1, true );
 }
 
 EcallStatus RevCore::ECALL_write() {
@@ -741,112 +968,166 @@ EcallStatus RevCore::ECALL_write() {
       CALL_INFO, 2, 0, "ECALL: write called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
     );
   }
-  auto fd       = RegFile->GetX<int>( RevReg::a0 );
-  auto addr     = RegFile->GetX<uint64_t>( RevReg::a1 );
-  auto nbytes   = RegFile->GetX<uint64_t>( RevReg::a2 );
+  auto fd     = RegFile->GetX<int>( RevReg::a0 );
+  auto addr   = RegFile->GetX<uint64_t>( RevReg::a1 );
+  auto nbytes = RegFile->GetX<uint64_t>( RevReg::a2 );
 
-  auto lsq_hash = LSQHash( RevReg::a0, RevRegClass::RegGPR, HartToExecID );  // Cached hash value
+  // Do the write on the host, straight from the buffer inside of Rev where possible
+  return EcallHostIO( fd, { { addr, nbytes } }, -1, false );
+}
 
-  if( EcallState.bytesRead && LSQueue->count( lsq_hash ) == 0 ) {
-    EcallState.string += std::string_view( EcallState.buf.data(), EcallState.bytesRead );
-    EcallState.bytesRead = 0;
+// 65, rev_readv(unsigned long fd, const struct iovec  *vec, unsigned long vlen)
+EcallStatus RevCore::ECALL_readv() {
+  auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
+  if( EcallState.bytesRead == 0 && EcallState.iov.empty() ) {
+    output->verbose(
+      CALL_INFO, 2, 0, "ECALL: readv called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
+    );
   }
+  auto fd   = RegFile->GetX<int>( RevReg::a0 );
+  auto vec  = RegFile->GetX<uint64_t>( RevReg::a1 );
+  auto vlen = RegFile->GetX<uint64_t>( RevReg::a2 );
 
-  auto nleft = nbytes - EcallState.string.size();
-  if( nleft == 0 && LSQueue->count( lsq_hash ) == 0 ) {
-    int rc = write( fd, EcallState.string.data(), EcallState.string.size() );
-    RegFile->SetX( RevReg::a0, rc );
-    DependencyClear( HartToExecID, RevReg::a0, RevRegClass::RegGPR );
+  if( !Harts.at( HartToExecID )->Thread->FindFD( fd ) ) {
+    RegFile->SetX( RevReg::a0, -EBADF );
     return EcallStatus::SUCCESS;
   }
-
-  if( LSQueue->count( lsq_hash ) == 0 ) {
-    MemReq req(
-      addr + EcallState.string.size(),
-      RevReg::a0,
-      RevRegClass::RegGPR,
-      HartToExecID,
-      MemOp::MemOpREAD,
-      true,
-      RegFile->GetMarkLoadComplete()
-    );
-    LSQueue->insert( req.LSQHashPair() );
-
-    if( nleft >= 8 ) {
-      mem->ReadVal(
-        HartToExecID, addr + EcallState.string.size(), reinterpret_cast<uint64_t*>( EcallState.buf.data() ), req, RevFlag::F_NONE
-      );
-      EcallState.bytesRead = 8;
-    } else if( nleft >= 4 ) {
-      mem->ReadVal(
-        HartToExecID, addr + EcallState.string.size(), reinterpret_cast<uint32_t*>( EcallState.buf.data() ), req, RevFlag::F_NONE
-      );
-      EcallState.bytesRead = 4;
-    } else if( nleft >= 2 ) {
-      mem->ReadVal(
-        HartToExecID, addr + EcallState.string.size(), reinterpret_cast<uint16_t*>( EcallState.buf.data() ), req, RevFlag::F_NONE
-      );
-      EcallState.bytesRead = 2;
-    } else {
-      mem->ReadVal(
-        HartToExecID, addr + EcallState.string.size(), reinterpret_cast<uint8_t*>( EcallState.buf.data() ), req, RevFlag::F_NONE
-      );
-      EcallState.bytesRead = 1;
-    }
-
-    DependencySet( HartToExecID, RevReg::a0, RevRegClass::RegGPR );
-    return EcallStatus::CONTINUE;
+  if( vlen > IOV_MAX ) {
+    RegFile->SetX( RevReg::a0, -EINVAL );
+    return EcallStatus::SUCCESS;
   }
 
-  return EcallStatus::CONTINUE;
-}
-
-// 65, rev_readv(unsigned long fd, const struct iovec  *vec, unsigned long vlen)
-EcallStatus RevCore::ECALL_readv() {
-  output->verbose(
-    CALL_INFO, 2, 0, "ECALL: readv called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
-  );
-  return EcallStatus::SUCCESS;
+  if( auto rtval = EcallLoadIovec( vec, vlen ); rtval != EcallStatus::SUCCESS )
+    return rtval;
+  return EcallHostIO( fd, EcallState.iov, -1, true );
 }
 
 // 66, rev_writev(unsigned long fd, const struct iovec  *vec, unsigned long vlen)
 EcallStatus RevCore::ECALL_writev() {
-  output->verbose(
-    CALL_INFO, 2, 0, "ECALL: writev called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
-  );
-  return EcallStatus::SUCCESS;
+  auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
+  if( EcallState.bytesRead == 0 && EcallState.iov.empty() ) {
+    output->verbose(
+      CALL_INFO, 2, 0, "ECALL: writev called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
+    );
+  }
+  auto fd   = RegFile->GetX<int>( RevReg::a0 );
+  auto vec  = RegFile->GetX<uint64_t>( RevReg::a1 );
+  auto vlen = RegFile->GetX<uint64_t>( RevReg::a2 );
+
+  if( !Harts.at( HartToExecID )->Thread->FindFD( fd ) ) {
+    RegFile->SetX( RevReg::a0, -EBADF );
+    return EcallStatus::SUCCESS;
+  }
+  if( vlen > IOV_MAX ) {
+    RegFile->SetX( RevReg::a0, -EINVAL );
+    return EcallStatus::SUCCESS;
+  }
+
+  if( auto rtval = EcallLoadIovec( vec, vlen ); rtval != EcallStatus::SUCCESS )
+    return rtval;
+  return EcallHostIO( fd, EcallState.iov, -1, false );
 }
 
 // 67, rev_pread64(unsigned int fd, char  *buf, size_t count, loff_t pos)
 EcallStatus RevCore::ECALL_pread64() {
-  output->verbose(
-    CALL_INFO, 2, 0, "ECALL: pread64 called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
-  );
-  return EcallStatus::SUCCESS;
+  auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
+  if( EcallState.bytesRead == 0 ) {
+    output->verbose(
+      CALL_INFO, 2, 0, "ECALL: pread64 called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
+    );
+  }
+  auto fd    = RegFile->GetX<int>( RevReg::a0 );
+  auto buf   = RegFile->GetX<uint64_t>( RevReg::a1 );
+  auto count = RegFile->GetX<uint64_t>( RevReg::a2 );
+  auto pos   = RegFile->GetX<int64_t>( RevReg::a3 );
+
+  if( !Harts.at( HartToExecID )->Thread->FindFD( fd ) ) {
+    RegFile->SetX( RevReg::a0, -EBADF );
+    return EcallStatus::SUCCESS;
+  }
+  if( pos < 0 ) {
+    RegFile->SetX( RevReg::a0, -EINVAL );
+    return EcallStatus::SUCCESS;
+  }
+  return EcallHostIO( fd, { { buf, count } }, pos, true );
 }
 
 // 68, rev_pwrite64(unsigned int fd, const char  *buf, size_t count, loff_t pos)
 EcallStatus RevCore::ECALL_pwrite64() {
-  output->verbose(
-    CALL_INFO, 2, 0, "ECALL: pwrite64 called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
-  );
-  return EcallStatus::SUCCESS;
+  auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
+  if( EcallState.bytesRead == 0 ) {
+    output->verbose(
+      CALL_INFO, 2, 0, "ECALL: pwrite64 called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
+    );
+  }
+  auto fd    = RegFile->GetX<int>( RevReg::a0 );
+  auto buf   = RegFile->GetX<uint64_t>( RevReg::a1 );
+  auto count = RegFile->GetX<uint64_t>( RevReg::a2 );
+  auto pos   = RegFile->GetX<int64_t>( RevReg::a3 );
+
+  if( !Harts.at( HartToExecID )->Thread->FindFD( fd ) ) {
+    RegFile->SetX( RevReg::a0, -EBADF );
+    return EcallStatus::SUCCESS;
+  }
+  if( pos < 0 ) {
+    RegFile->SetX( RevReg::a0, -EINVAL );
+    return EcallStatus::SUCCESS;
+  }
+  return EcallHostIO( fd, { { buf, count } }, pos, false );
 }
 
 // 69, rev_preadv(unsigned long fd, const struct iovec  *vec, unsigned long vlen, unsigned long pos_l, unsigned long pos_h)
 EcallStatus RevCore::ECALL_preadv() {
-  output->verbose(
-    CALL_INFO, 2, 0, "ECALL: preadv called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
-  );
-  return EcallStatus::SUCCESS;
+  auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
+  if( EcallState.bytesRead == 0 && EcallState.iov.empty() ) {
+    output->verbose(
+      CALL_INFO, 2, 0, "ECALL: preadv called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
+    );
+  }
+  auto fd   = RegFile->GetX<int>( RevReg::a0 );
+  auto vec  = RegFile->GetX<uint64_t>( RevReg::a1 );
+  auto vlen = RegFile->GetX<uint64_t>( RevReg::a2 );
+  auto pos  = RegFile->GetX<int64_t>( RevReg::a3 );  // pos_h is 0 on rv64
+
+  if( !Harts.at( HartToExecID )->Thread->FindFD( fd ) ) {
+    RegFile->SetX( RevReg::a0, -EBADF );
+    return EcallStatus::SUCCESS;
+  }
+  if( vlen > IOV_MAX || pos < 0 ) {
+    RegFile->SetX( RevReg::a0, -EINVAL );
+    return EcallStatus::SUCCESS;
+  }
+
+  if( auto rtval = EcallLoadIovec( vec, vlen ); rtval != EcallStatus::SUCCESS )
+    return rtval;
+  return EcallHostIO( fd, EcallState.iov, pos, true );
 }
 
 // 70, rev_pwritev(unsigned long fd, const struct iovec  *vec, unsigned long vlen, unsigned long pos_l, unsigned long pos_h)
 EcallStatus RevCore::ECALL_pwritev() {
-  output->verbose(
-    CALL_INFO, 2, 0, "ECALL: pwritev called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
-  );
-  return EcallStatus::SUCCESS;
+  auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
+  if( EcallState.bytesRead == 0 && EcallState.iov.empty() ) {
+    output->verbose(
+      CALL_INFO, 2, 0, "ECALL: pwritev called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
+    );
+  }
+  auto fd   = RegFile->GetX<int>( RevReg::a0 );
+  auto vec  = RegFile->GetX<uint64_t>( RevReg::a1 );
+  auto vlen = RegFile->GetX<uint64_t>( RevReg::a2 );
+  auto pos  = RegFile->GetX<int64_t>( RevReg::a3 );  // pos_h is 0 on rv64
+
+  if( !Harts.at( HartToExecID )->Thread->FindFD( fd ) ) {
+    RegFile->SetX( RevReg::a0, -EBADF );
+    return EcallStatus::SUCCESS;
+  }
+  if( vlen > IOV_MAX || pos < 0 ) {
+    RegFile->SetX( RevReg::a0, -EINVAL );
+    return EcallStatus::SUCCESS;
+  }
+
+  if( auto rtval = EcallLoadIovec( vec, vlen ); rtval != EcallStatus::SUCCESS )
+    return rtval;
+  return EcallHostIO( fd, EcallState.iov, pos, false );
 }
 
 // 71, rev_sendfile64(int out_fd, int in_fd, loff_t  *offset, size_t count)
@@ -905,10 +1186,34 @@ EcallStatus RevCore::ECALL_tee() {
 
 // 78, rev_readlinkat(int dfd, const char  *path, char  *buf, int bufsiz)
 EcallStatus RevCore::ECALL_readlinkat() {
-  output->verbose(
-    CALL_INFO, 2, 0, "ECALL: readlinkat called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
-  );
-  return EcallStatus::SUCCESS;
+  auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
+  if( EcallState.string.empty() ) {
+    output->verbose(
+      CALL_INFO, 2, 0, "ECALL: readlinkat called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
+    );
+  }
+  auto dirfd   = RegFile->GetX<int>( RevReg::a0 );
+  auto path    = RegFile->GetX<uint64_t>( RevReg::a1 );
+  auto bufAddr = RegFile->GetX<uint64_t>( RevReg::a2 );
+  auto bufsiz  = RegFile->GetX<int>( RevReg::a3 );
+
+  auto action  = [&] {
+    if( bufsiz <= 0 ) {
+      RegFile->SetX( RevReg::a0, -EINVAL );
+      return;
+    }
+    // resolve the link on the host and copy the target (not 0-terminated) to the user buffer
+    std::vector<char> Target( static_cast<size_t>( bufsiz ) );
+    ssize_t           rc = readlinkat( dirfd, EcallState.string.c_str(), Target.data(), Target.size() );
+    if( rc < 0 ) {
+      RegFile->SetX( RevReg::a0, -errno );
+      return;
+    }
+    EcallWriteGuest( bufAddr, size_t( rc ), Target.data() );
+    RegFile->SetX( RevReg::a0, rc );
+  };
+
+  return EcallLoadAndParseString( path, action );
 }
 
 // 79, rev_newfstatat(int dfd, const char  *filename, struct stat  *statbuf, int flag)
@@ -1086,10 +1391,55 @@ EcallStatus RevCore::ECALL_unshare() {
 
 // 98, rev_futex(u32  *uaddr, int op, u32 val, struct __kernel_timespec  *utime, u32  *uaddr2, u32 val3)
 EcallStatus RevCore::ECALL_futex() {
-  output->verbose(
-    CALL_INFO, 2, 0, "ECALL: futex called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
-  );
-  return EcallStatus::SUCCESS;
+  auto&    EcallState = Harts.at( HartToExecID )->GetEcallState();
+  uint64_t uaddr      = RegFile->GetX<uint64_t>( RevReg::a0 );
+  int      op         = RegFile->GetX<int>( RevReg::a1 ) & REV_FUTEX_CMD_MASK;
+  uint32_t val        = RegFile->GetX<uint32_t>( RevReg::a2 );
+  uint64_t utime      = RegFile->GetX<uint64_t>( RevReg::a3 );
+
+  if( EcallState.bytesRead == 0 ) {
+    output->verbose(
+      CALL_INFO, 2, 0, "ECALL: futex called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
+    );
+  }
+
+  switch( op ) {
+  case REV_FUTEX_WAIT:
+  case REV_FUTEX_WAIT_BITSET: {
+    // A wake that lands between reading *uaddr and blocking is detected by
+    // RevCPU through the wake count taken before the read
+    if( EcallState.bytesRead == 0 )
+      EcallState.waitSeq = SchedOps.FutexWakeCount( uaddr );
+    if( auto rtval = EcallLoadBytes( uaddr, sizeof( uint32_t ), 0 ); rtval != EcallStatus::SUCCESS )
+      return rtval;
+    uint32_t cur;
+    memcpy( &cur, EcallState.buf.data(), sizeof( cur ) );
+    if( cur != val ) {
+      RegFile->SetX( RevReg::a0, -EAGAIN );
+      return EcallStatus::SUCCESS;
+    }
+
+    // The FUTEX_WAIT timeout is relative, the FUTEX_WAIT_BITSET timeout absolute
+    uint64_t WakeCycle = 0;
+    if( utime ) {
+      if( auto rtval = EcallLoadBytes( utime, 16, 8 ); rtval != EcallStatus::SUCCESS )
+        return rtval;
+      uint64_t Ns = TimespecNs( EcallState.buf.data() + 8 );
+      if( Ns == ~uint64_t{ 0 } ) {
+        RegFile->SetX( RevReg::a0, -EINVAL );
+        return EcallStatus::SUCCESS;
+      }
+      if( op == REV_FUTEX_WAIT_BITSET )
+        Ns = Ns > GuestTimeNs() ? Ns - GuestTimeNs() : 0;
+      WakeCycle = currentSimCycle + NsToCycles( Ns );
+    }
+    RegFile->SetX( RevReg::a0, 0 );
+    return EcallBlockThread( WakeCycle, uaddr );
+  }
+  case REV_FUTEX_WAKE:
+  case REV_FUTEX_WAKE_BITSET: RegFile->SetX( RevReg::a0, SchedOps.FutexWake( uaddr, val ) ); return EcallStatus::SUCCESS;
+  default: RegFile->SetX( RevReg::a0, -ENOSYS ); return EcallStatus::SUCCESS;
+  }
 }
 
 // 99, rev_set_robust_list(struct robust_list_head  *head, size_t len)
@@ -1110,10 +1460,31 @@ EcallStatus RevCore::ECALL_get_robust_list() {
 
 // 101, rev_nanosleep(struct __kernel_timespec  *rqtp, struct __kernel_timespec  *rmtp)
 EcallStatus RevCore::ECALL_nanosleep() {
-  output->verbose(
-    CALL_INFO, 2, 0, "ECALL: nanosleep called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
-  );
-  return EcallStatus::SUCCESS;
+  auto&    EcallState = Harts.at( HartToExecID )->GetEcallState();
+  uint64_t rqtp       = RegFile->GetX<uint64_t>( RevReg::a0 );
+  uint64_t rmtp       = RegFile->GetX<uint64_t>( RevReg::a1 );
+
+  if( EcallState.bytesRead == 0 ) {
+    output->verbose(
+      CALL_INFO, 2, 0, "ECALL: nanosleep called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
+    );
+  }
+  if( auto rtval = EcallLoadBytes( rqtp, 16, 0 ); rtval != EcallStatus::SUCCESS )
+    return rtval;
+
+  uint64_t Ns = TimespecNs( EcallState.buf.data() );
+  if( Ns == ~uint64_t{ 0 } ) {
+    RegFile->SetX( RevReg::a0, -EINVAL );
+    return EcallStatus::SUCCESS;
+  }
+
+  // The sleep is never interrupted, so no time remains
+  if( rmtp ) {
+    std::array<uint64_t, 2> remain{};
+    mem->WriteMem( HartToExecID, rmtp, sizeof( remain ), remain.data() );
+  }
+  RegFile->SetX( RevReg::a0, 0 );
+  return Ns ? EcallBlockThread( currentSimCycle + NsToCycles( Ns ) ) : EcallStatus::SUCCESS;
 }
 
 // 102, rev_getitimer(int which, struct __kernel_old_itimerval  *value)
@@ -1216,9 +1587,9 @@ EcallStatus RevCore::ECALL_clock_gettime() {
     return EcallStatus::SUCCESS;
   }
   memset( &src, 0, sizeof( *tp ) );
-  SimTime_t x = timeConverter->convertToCoreTime( Stats.totalCycles );
-  src.tv_sec  = x / 1000000000000ull;
-  src.tv_nsec = ( x / 1000 ) % 1000000000ull;
+  uint64_t ns = GuestTimeNs();
+  src.tv_sec  = ns / 1000000000ull;
+  src.tv_nsec = ns % 1000000000ull;
   mem->WriteMem( HartToExecID, (size_t) tp, sizeof( *tp ), &src );
   RegFile->SetX( RevReg::a0, 0 );
   return EcallStatus::SUCCESS;
@@ -1234,10 +1605,28 @@ EcallStatus RevCore::ECALL_clock_getres() {
 
 // 115, rev_clock_nanosleep(clockid_t which_clock, int flags, const struct __kernel_timespec  *rqtp, struct __kernel_timespec  *rmtp)
 EcallStatus RevCore::ECALL_clock_nanosleep() {
-  output->verbose(
-    CALL_INFO, 2, 0, "ECALL: clock_nanosleep called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
-  );
-  return EcallStatus::SUCCESS;
+  auto&    EcallState = Harts.at( HartToExecID )->GetEcallState();
+  int      flags      = RegFile->GetX<int>( RevReg::a1 );
+  uint64_t rqtp       = RegFile->GetX<uint64_t>( RevReg::a2 );
+
+  if( EcallState.bytesRead == 0 ) {
+    output->verbose(
+      CALL_INFO, 2, 0, "ECALL: clock_nanosleep called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
+    );
+  }
+  if( auto rtval = EcallLoadBytes( rqtp, 16, 0 ); rtval != EcallStatus::SUCCESS )
+    return rtval;
+
+  // clock_nanosleep returns the error number itself; all clocks share the simulated time
+  uint64_t Ns = TimespecNs( EcallState.buf.data() );
+  if( Ns == ~uint64_t{ 0 } ) {
+    RegFile->SetX( RevReg::a0, EINVAL );
+    return EcallStatus::SUCCESS;
+  }
+  if( flags & REV_TIMER_ABSTIME )
+    Ns = Ns > GuestTimeNs() ? Ns - GuestTimeNs() : 0;
+  RegFile->SetX( RevReg::a0, 0 );
+  return Ns ? EcallBlockThread( currentSimCycle + NsToCycles( Ns ) ) : EcallStatus::SUCCESS;
 }
 
 // 116, rev_syslog(int type, char  *buf, int len)
@@ -1309,6 +1698,18 @@ EcallStatus RevCore::ECALL_sched_yield() {
   output->verbose(
     CALL_INFO, 2, 0, "ECALL: sched_yield called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
   );
+  RegFile->SetX( RevReg::a0, 0 );
+
+  // Keep the hart when no other thread is waiting for one
+  if( SchedOps.NumReady() == 0 )
+    return EcallStatus::SUCCESS;
+  if( !HartHasNoDependencies( HartToExecID ) )
+    return EcallStatus::CONTINUE;
+
+  // Hand the thread back to RevCPU as READY; it is queued behind the ready threads
+  std::unique_ptr<RevThread> YieldedThread = PopThreadFromHart( HartToExecID );
+  YieldedThread->SetState( ThreadState::READY );
+  AddThreadsThatChangedState( std::move( YieldedThread ) );
   return EcallStatus::SUCCESS;
 }
 
@@ -2064,10 +2465,29 @@ EcallStatus RevCore::ECALL_brk() {
 
 // 215, rev_munmap(unsigned long addr, size_t len)
 EcallStatus RevCore::ECALL_munmap() {
-  output->verbose( CALL_INFO, 2, 0, "ECALL: munmap called\n" );
+  auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
+  if( EcallState.bytesRead == 0 ) {
+    output->verbose( CALL_INFO, 2, 0, "ECALL: munmap called\n" );
+  }
   auto Addr = RegFile->GetX<uint64_t>( RevReg::a0 );
   auto Size = RegFile->GetX<uint64_t>( RevReg::a1 );
 
+  // file mappings are unmapped whole, after writing back copied MAP_SHARED contents
+  uint64_t Base;
+  if( const RevMem::FileMap* Map = mem->FindFileMap( Addr, Base ); Map && Base == Addr ) {
+    if( Size < Map->Len ) {
+      RegFile->SetX( RevReg::a0, -EINVAL );
+      return EcallStatus::SUCCESS;
+    }
+    if( !Map->Host && Map->Shared ) {
+      if( auto rtval = EcallWriteBack( *Map, Base, Addr, Map->Len ); rtval != EcallStatus::SUCCESS )
+        return rtval;
+    }
+    mem->UnmapFile( Addr );
+    RegFile->SetX( RevReg::a0, 0 );
+    return EcallStatus::SUCCESS;
+  }
+
   int rc    = mem->DeallocMem( Addr, Size ) == uint64_t( -1 );
   if( rc == -1 ) {
     output->fatal(
@@ -2275,31 +2695,79 @@ EcallStatus RevCore::ECALL_execve() {
   return EcallStatus::SUCCESS;
 }
 
-// 222, rev_old_mmap(struct mmap_arg_struct  *arg)
+// 222, rev_mmap(unsigned long addr, unsigned long len, int prot, int flags, int fd, off_t offset)
 EcallStatus RevCore::ECALL_mmap() {
   output->verbose( CALL_INFO, 2, 0, "ECALL: mmap called\n" );
 
-  auto addr = RegFile->GetX<uint64_t>( RevReg::a0 );
-  auto size = RegFile->GetX<uint64_t>( RevReg::a1 );
-  // auto prot = RegFile->GetX<int>(RevReg::a2);
-  // auto Flags = RegFile->GetX<int>(RevReg::a3);
-  // auto fd = RegFile->GetX<int>(RevReg::a4);
-  // auto offset = RegFile->GetX<off_t>(RevReg::a5);
-
-  if( !addr ) {
-    // If address is NULL... We add it to MemSegs.end()->getTopAddr()+1
-    addr = mem->AllocMem( size );
-    // addr = mem->AddMemSeg(Size);
-  } else {
-    // We were passed an address... try to put a segment there.
-    // Currently there is no handling of getting it 'close' to the
-    // suggested address... instead if it can't allocate a new segment
-    // there it fails.
-    if( !mem->AllocMemAt( addr, size ) ) {
+  auto addr   = RegFile->GetX<uint64_t>( RevReg::a0 );
+  auto size   = RegFile->GetX<uint64_t>( RevReg::a1 );
+  auto prot   = RegFile->GetX<int>( RevReg::a2 );
+  auto Flags  = RegFile->GetX<int>( RevReg::a3 );
+  auto fd     = RegFile->GetX<int>( RevReg::a4 );
+  auto offset = RegFile->GetX<uint64_t>( RevReg::a5 );
+
+  if( ( Flags & REV_MAP_ANONYMOUS ) || fd < 0 ) {
+    if( !addr ) {
+      // If address is NULL... We add it to MemSegs.end()->getTopAddr()+1
+      addr = mem->AllocMem( size );
+      // addr = mem->AddMemSeg(Size);
+    } else {
+      // We were passed an address... try to put a segment there.
+      // Currently there is no handling of getting it 'close' to the
+      // suggested address... instead if it can't allocate a new segment
+      // there it fails.
+      if( !mem->AllocMemAt( addr, size ) ) {
+        output->fatal( CALL_INFO, 11, "Failed to add mem segment\n" );
+      }
+    }
+    RegFile->SetX( RevReg::a0, addr );
+    return EcallStatus::SUCCESS;
+  }
+
+  // file-backed mapping
+  struct stat st;
+  bool        Shared = Flags & REV_MAP_SHARED;
+  if( !Harts.at( HartToExecID )->Thread->FindFD( fd ) ) {
+    RegFile->SetX( RevReg::a0, -EBADF );
+    return EcallStatus::SUCCESS;
+  }
+  if( !size || offset % 4096 || !( Flags & ( REV_MAP_SHARED | REV_MAP_PRIVATE ) ) ) {
+    RegFile->SetX( RevReg::a0, -EINVAL );
+    return EcallStatus::SUCCESS;
+  }
+  if( fstat( fd, &st ) ) {
+    RegFile->SetX( RevReg::a0, -errno );
+    return EcallStatus::SUCCESS;
+  }
+  uint64_t FileLen = offset < uint64_t( st.st_size ) ? std::min<uint64_t>( size, st.st_size - offset ) : 0;
+
+  // With the internal memory model the file is mapped over the backing pages
+  // by the host. Otherwise its contents are copied in; a copied MAP_SHARED
+  // mapping is written back to the file on msync and munmap.
+  uint64_t Base = 0;
+  if( !( Flags & REV_MAP_FIXED ) )
+    Base = mem->MapFile( size, fd, offset, FileLen, Shared, prot & REV_PROT_WRITE );
+  if( !Base ) {
+    if( !( Flags & REV_MAP_FIXED ) ) {
+      Base = mem->AllocMem( size );
+    } else if( mem->AllocMemAt( addr, size ) ) {
+      Base = addr;
+    } else {
       output->fatal( CALL_INFO, 11, "Failed to add mem segment\n" );
     }
+    RevMem::FileMap Map{ Base, size, size, FileLen, offset, Shared ? dup( fd ) : -1, Shared, nullptr, 0 };
+    mem->AddFileMap( Base, Map );
+    if( FileLen )
+      EcallHostIO( fd, { { Base, FileLen } }, int64_t( offset ), true );
+
+    // the rest of the last file page reads as zero, even if the segment is reused
+    static const char Zeros[4096]{};
+    uint64_t          Tail = std::min( size, ( FileLen + 4095 ) / 4096 * 4096 ) - FileLen;
+    if( Tail )
+      EcallWriteGuest( Base + FileLen, Tail, Zeros );
   }
-  RegFile->SetX( RevReg::a0, addr );
+
+  RegFile->SetX( RevReg::a0, Base );
   return EcallStatus::SUCCESS;
 }
 
@@ -2337,9 +2805,27 @@ EcallStatus RevCore::ECALL_mprotect() {
 
 // 227, rev_msync(unsigned long start, size_t len, int flags)
 EcallStatus RevCore::ECALL_msync() {
-  output->verbose(
-    CALL_INFO, 2, 0, "ECALL: msync called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
-  );
+  auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
+  if( EcallState.bytesRead == 0 ) {
+    output->verbose(
+      CALL_INFO, 2, 0, "ECALL: msync called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
+    );
+  }
+  auto start = RegFile->GetX<uint64_t>( RevReg::a0 );
+  auto len   = RegFile->GetX<uint64_t>( RevReg::a1 );
+  auto Flags = RegFile->GetX<int>( RevReg::a2 );
+
+  // only MAP_SHARED file mappings have anything to flush
+  uint64_t Base;
+  const RevMem::FileMap* Map = mem->FindFileMap( start, Base );
+  if( !Map || !Map->Shared ) {
+    RegFile->SetX( RevReg::a0, 0 );
+    return EcallStatus::SUCCESS;
+  }
+  if( !Map->Host )
+    return EcallWriteBack( *Map, Base, start, len );
+
+  RegFile->SetX( RevReg::a0, mem->SyncFile( *Map, Base, start, len, Flags & REV_MS_SYNC ) );
   return EcallStatus::SUCCESS;
 }
 
@@ -3241,22 +3727,19 @@ EcallStatus RevCore::ECALL_dump_mem_range() {
   auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
   if( EcallState.bytesRead == 0 ) {
     output->verbose(
-      CALL_INFO, 2, 0, "ECALL: openat called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
+      CALL_INFO, 2, 0, "ECALL: dump_mem_range called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
     );
   }
-  auto addr = RegFile->GetX<uint64_t>( RevReg::a1 );
-  auto size = RegFile->GetX<uint64_t>( RevReg::a2 );
-
-  // TODO: Add error handling if memh is enabled
-  mem->DumpMem( addr, size, 16 );
+  auto addr = RegFile->GetX<uint64_t>( RevReg::a0 );
+  auto size = RegFile->GetX<uint64_t>( RevReg::a1 );
 
-  return EcallStatus::SUCCESS;
+  return EcallDumpRange( nullptr, addr, size );
 }
 
 // 9001, rev_dump_mem_range(const char* outputFile, uint64_t addr, uint64_t size)
 EcallStatus RevCore::ECALL_dump_mem_range_to_file() {
   auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
-  if( EcallState.bytesRead == 0 ) {
+  if( EcallState.path_string.empty() && EcallState.bytesRead == 0 ) {
     output->verbose(
       CALL_INFO, 2, 0, "ECALL: dump_mem_range called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
     );
@@ -3265,54 +3748,102 @@ EcallStatus RevCore::ECALL_dump_mem_range_to_file() {
   auto addr     = RegFile->GetX<uint64_t>( RevReg::a1 );
   auto size     = RegFile->GetX<uint64_t>( RevReg::a2 );
 
-  /* Read the filename from memory one character at a time until we find '\0' */
-  auto action   = [&] {
-    // open the current directory and the file
-    // open the file in write mode
-    std::ofstream outputFile( EcallState.string, std::ios::out | std::ios::binary );
-    mem->DumpMem( addr, size, 16, outputFile );
-  };
+  // parse the filename into EcallState.path_string, then read the range
+  if( EcallState.path_string.empty() ) {
+    auto action = [&] {
+      EcallState.path_string = std::move( EcallState.string );
+      EcallState.string.clear();
+    };
+    auto rtval = EcallLoadAndParseString( pathname, action );
+    if( rtval != EcallStatus::SUCCESS )
+      return rtval;
+  }
 
-  return EcallLoadAndParseString( pathname, action );
+  return EcallDumpRange( EcallState.path_string.c_str(), addr, size );
 }
 
 // 9002, rev_mem_dump_stack()
 EcallStatus RevCore::ECALL_dump_stack() {
-  output->verbose( CALL_INFO, 2, 0, "ECALL: dump_stack called" );
+  auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
+  if( EcallState.bytesRead == 0 ) {
+    output->verbose( CALL_INFO, 2, 0, "ECALL: dump_stack called\n" );
+  }
   // TODO: Factor in TLS
   // Check if sp + _STACK_SIZE_ is in the valid memory range
   // if not, dump the memory that is valid
-  mem->DumpMem(
-    RegFile->GetX<uint64_t>( RevReg::sp ), RegFile->GetX<uint64_t>( RevReg::tp ) - RegFile->GetX<uint64_t>( RevReg::sp )
-  );
-  return EcallStatus::SUCCESS;
+  auto sp = RegFile->GetX<uint64_t>( RevReg::sp );
+  return EcallDumpRange( nullptr, sp, RegFile->GetX<uint64_t>( RevReg::tp ) - sp );
 }
 
 // 9003, rev_dump_stck_to_file(const char* outputFile)
 EcallStatus RevCore::ECALL_dump_stack_to_file() {
   auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
-  if( EcallState.bytesRead == 0 ) {
+  if( EcallState.path_string.empty() && EcallState.bytesRead == 0 ) {
     output->verbose(
       CALL_INFO, 2, 0, "ECALL: dump_stack_to_file called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
     );
   }
   auto pathname = RegFile->GetX<uint64_t>( RevReg::a0 );
 
-  /* Read the filename from memory one character at a time until we find '\0' */
-  auto action   = [&] {
-    // open the current directory and the file
-    // open the file in write mode
-    std::ofstream outputFile( EcallState.string, std::ios::out | std::ios::binary );
-
-    mem->DumpMem(
-      RegFile->GetX<uint64_t>( RevReg::sp ),
-      RegFile->GetX<uint64_t>( RevReg::tp ) - RegFile->GetX<uint64_t>( RevReg::sp ),
-      16,
-      outputFile
-    );
-  };
+  // parse the filename into EcallState.path_string, then read the stack
+  if( EcallState.path_string.empty() ) {
+    auto action = [&] {
+      EcallState.path_string = std::move( EcallState.string );
+      EcallState.string.clear();
+    };
+    auto rtval = EcallLoadAndParseString( pathname, action );
+    if( rtval != EcallStatus::SUCCESS )
+      return rtval;
+  }
 
-  return EcallLoadAndParseString( pathname, action );
+  auto sp = RegFile->GetX<uint64_t>( RevReg::sp );
+  return EcallDumpRange( EcallState.path_string.c_str(), sp, RegFile->GetX<uint64_t>( RevReg::tp ) - sp );
+}
+
+/// Read Size bytes at Addr through the memory model, so memHierarchy
+/// returns current data, and dump them to the file Path or to stdout
+EcallStatus RevCore::EcallDumpRange( const char* Path, uint64_t Addr, uint64_t Size ) {
+  auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
+  EcallState.string.resize( Size );
+  if( auto rtval = EcallReadGuest( Addr, Size, EcallState.string.data() ); rtval != EcallStatus::SUCCESS )
+    return rtval;
+
+  auto data = reinterpret_cast<const uint8_t*>( EcallState.string.data() );
+  if( Path ) {
+    mem->WriteDumpFile( Path, "", { { "", Addr, Size, data } } );
+  } else {
+    RevMem::DumpBytes( Addr, data, Size, 16 );
+  }
+  return EcallStatus::SUCCESS;
+}
+
+/// With a memory controller every section is read through the memory model
+/// first, in order, so memHierarchy returns current data; the internal model
+/// is dumped in place
+EcallStatus RevCore::EcallDumpSections( const char* Path, const std::string& Title ) {
+  auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
+  if( mem->HasMemCtrl() ) {
+    size_t Total = 0;
+    for( const auto& Sec : EcallState.dump )
+      Total += Sec.Size;
+    EcallState.string.resize( Total );
+
+    size_t Off = 0;
+    for( auto& Sec : EcallState.dump ) {
+      char* Buf = EcallState.string.data() + Off;
+      if( auto rtval = EcallReadGuest( Sec.Base, Sec.Size, Buf, Off ); rtval != EcallStatus::SUCCESS )
+        return rtval;
+      Sec.Data = reinterpret_cast<const uint8_t*>( Buf );
+      Off += Sec.Size;
+    }
+  }
+
+  if( Path ) {
+    mem->WriteDumpFile( Path, Title, EcallState.dump );
+  } else {
+    mem->WriteDump( Title, EcallState.dump, 16, std::cout );
+  }
+  return EcallStatus::SUCCESS;
 }
 
 EcallStatus RevCore::ECALL_dump_valid_mem() {
@@ -3323,13 +3854,14 @@ EcallStatus RevCore::ECALL_dump_valid_mem() {
     );
   }
 
-  mem->DumpValidMem();
-  return EcallStatus::SUCCESS;
+  if( EcallState.dump.empty() )
+    EcallState.dump = mem->GetValidMemSections();
+  return EcallDumpSections( nullptr, "Memory Segments:" );
 }
 
 EcallStatus RevCore::ECALL_dump_valid_mem_to_file() {
   auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
-  if( EcallState.bytesRead == 0 ) {
+  if( EcallState.path_string.empty() && EcallState.bytesRead == 0 ) {
     output->verbose(
       CALL_INFO,
       2,
@@ -3341,15 +3873,20 @@ EcallStatus RevCore::ECALL_dump_valid_mem_to_file() {
   }
   auto pathname = RegFile->GetX<uint64_t>( RevReg::a0 );
 
-  /* Read the filename from memory one character at a time until we find '\0' */
-  auto action   = [&] {
-    // open the current directory and the file
-    // open the file in write mode
-    std::ofstream outputFile( EcallState.string, std::ios::out | std::ios::binary );
-    mem->DumpValidMem( 16, outputFile );
-  };
+  // parse the filename into EcallState.path_string, then dump the sections
+  if( EcallState.path_string.empty() ) {
+    auto action = [&] {
+      EcallState.path_string = std::move( EcallState.string );
+      EcallState.string.clear();
+    };
+    auto rtval = EcallLoadAndParseString( pathname, action );
+    if( rtval != EcallStatus::SUCCESS )
+      return rtval;
+  }
 
-  return EcallLoadAndParseString( pathname, action );
+  if( EcallState.dump.empty() )
+    EcallState.dump = mem->GetValidMemSections();
+  return EcallDumpSections( EcallState.path_string.c_str(), "Memory Segments:" );
 }
 
 EcallStatus RevCore::ECALL_dump_thread_mem() {
@@ -3360,13 +3897,14 @@ EcallStatus RevCore::ECALL_dump_thread_mem() {
     );
   }
 
-  mem->DumpThreadMem();
-  return EcallStatus::SUCCESS;
+  if( EcallState.dump.empty() )
+    EcallState.dump = mem->GetThreadMemSections();
+  return EcallDumpSections( nullptr, "Thread Memory Segments:" );
 }
 
 EcallStatus RevCore::ECALL_dump_thread_mem_to_file() {
   auto& EcallState = Harts.at( HartToExecID )->GetEcallState();
-  if( EcallState.bytesRead == 0 ) {
+  if( EcallState.path_string.empty() && EcallState.bytesRead == 0 ) {
     output->verbose(
       CALL_INFO,
       2,
@@ -3378,15 +3916,32 @@ EcallStatus RevCore::ECALL_dump_thread_mem_to_file() {
   }
   auto pathname = RegFile->GetX<uint64_t>( RevReg::a0 );
 
-  /* Read the filename from memory one character at a time until we find '\0' */
-  auto action   = [&] {
-    // open the current directory and the file
-    // open the file in write mode
-    std::ofstream outputFile( EcallState.string, std::ios::out | std::ios::binary );
-    mem->DumpThreadMem( 16, outputFile );
-  };
+  // parse the filename into EcallState.path_string, then dump the sections
+  if( EcallState.path_string.empty() ) {
+    auto action = [&] {
+      EcallState.path_string = std::move( EcallState.string );
+      EcallState.string.clear();
+    };
+    auto rtval = EcallLoadAndParseString( pathname, action );
+    if( rtval != EcallStatus::SUCCESS )
+      return rtval;
+  }
 
-  return EcallLoadAndParseString( pathname, action );
+  if( EcallState.dump.empty() )
+    EcallState.dump = mem->GetThreadMemSections();
+  return EcallDumpSections( EcallState.path_string.c_str(), "Thread Memory Segments:" );
+}
+
+// 9020, rev_checkpoint()
+//  Asks RevCPU for a checkpoint. The calling thread continues; the checkpoint
+//  is written once every thread has been taken off its hart, so it holds the
+//  state after this call returned 0.
+EcallStatus RevCore::ECALL_checkpoint() {
+  output->verbose(
+    CALL_INFO, 2, 0, "ECALL: checkpoint called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
+  );
+  RegFile->SetX( RevReg::a0, SchedOps.Checkpoint ? SchedOps.Checkpoint() : -ENOSYS );
+  return EcallStatus::SUCCESS;
 }
 
 // 9110, rev_fast_printf(const char *, ...)
@@ -3431,11 +3986,43 @@ EcallStatus RevCore::ECALL_fast_printf() {
   return EcallLoadAndParseString( pFormat, action );
 }
 
+// 9200, rev_xbgas_get_nb(void* dest, uint64_t nmspace, const void* src, size_t nbytes, uint64_t* counter)
+//  Split-phase remote get: issues the read and returns without waiting for the data.
+//  *counter is incremented in local memory once dest has been written, so a hart can
+//  keep many gets in flight and wait on a single counter.
+EcallStatus RevCore::ECALL_xbgas_get_nb() {
+  output->verbose(
+    CALL_INFO, 2, 0, "ECALL: xbgas_get_nb called by thread %" PRIu32 " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID
+  );
+  auto dest    = RegFile->GetX<uint64_t>( RevReg::a0 );
+  auto nmspace = RegFile->GetX<uint64_t>( RevReg::a1 );
+  auto src     = RegFile->GetX<uint64_t>( RevReg::a2 );
+  auto nbytes  = RegFile->GetX<uint64_t>( RevReg::a3 );
+  auto counter = RegFile->GetX<uint64_t>( RevReg::a4 );
+
+  if( !mem->isXBGASEnabled() || nmspace == 0 || nbytes == 0 || counter % sizeof( uint64_t ) ) {
+    RegFile->SetX( RevReg::a0, -EINVAL );
+    return EcallStatus::SUCCESS;
+  }
+
+  // Move whole words when everything is aligned
+  size_t size  = ( ( dest | src | nbytes ) % sizeof( uint64_t ) ) ? 1 : sizeof( uint64_t );
+  auto   nelem = nbytes / size;
+  if( nelem > std::numeric_limits<uint32_t>::max() ) {
+    RegFile->SetX( RevReg::a0, -EINVAL );
+    return EcallStatus::SUCCESS;
+  }
+
+  mem->RmtGetNB( HartToExecID, nmspace, src, size, uint32_t( nelem ), dest, counter );
+  RegFile->SetX( RevReg::a0, 0 );
+  return EcallStatus::SUCCESS;
+}
+
 /* ========================================= */
 /* System Call (ecall) Implementations Below */
 /* ========================================= */
 // clang-format off
-const std::unordered_map<uint32_t, EcallStatus(RevCore::*)()> RevCore::Ecalls = {
+const std::unordered_map<uint32_t, RevCore::EcallHandler> RevCore::Ecalls = {
     { 0,   &RevCore::ECALL_io_setup },                  //  rev_io_setup(unsigned nr_reqs, aio_context_t  *ctx)
     { 1,   &RevCore::ECALL_io_destroy },                //  rev_io_destroy(aio_context_t ctx)
     { 2,   &RevCore::ECALL_io_submit },                 //  rev_io_submit(aio_context_t, long, struct iocb  *  *)
@@ -3498,7 +4085,7 @@ const std::unordered_map<uint32_t, EcallStatus(RevCore::*)()> RevCore::Ecalls =
     { 59,  &RevCore::ECALL_pipe2 },                     //  rev_pipe2(int  *fildes, int flags)
     { 60,  &RevCore::ECALL_quotactl },                  //  rev_quotactl(unsigned int cmd, const char  *special, qid_t id, void  *addr)
     { 61,  &RevCore::ECALL_getdents64 },                //  rev_getdents64(unsigned int fd, struct linux_dirent64  *dirent, unsigned int count)
-    { 62,  &RevCore::ECALL_lseek },                     //  rev_llseek(unsigned int fd, unsigned long offset_high, unsigned long offset_low, loff_t  *result, unsigned int whence)
+    { 62,  &RevCore::ECALL_lseek },                     //  rev_lseek(unsigned int fd, off_t offset, unsigned int whence)
     { 63,  &RevCore::ECALL_read },                      //  rev_read(unsigned int fd, char  *buf, size_t count)
     { 64,  &RevCore::ECALL_write },                     //  rev_write(unsigned int fd, const char  *buf, size_t count)
     { 65,  &RevCore::ECALL_readv },                     //  rev_readv(unsigned long fd, const struct iovec  *vec, unsigned long vlen)
@@ -3658,7 +4245,7 @@ const std::unordered_map<uint32_t, EcallStatus(RevCore::*)()> RevCore::Ecalls =
     { 219, &RevCore::ECALL_keyctl },                    //  rev_keyctl(int cmd, unsigned long arg2, unsigned long arg3, unsigned long arg4, unsigned long arg5)
     { 220, &RevCore::ECALL_clone },                     //  rev_clone(unsigned long, unsigned long, int  *, unsigned long, int  *)
     { 221, &RevCore::ECALL_execve },                    //  rev_execve(const char  *filename, const char  *const  *argv, const char  *const  *envp)
-    { 222, &RevCore::ECALL_mmap },                      //  rev_old_mmap(struct mmap_arg_struct  *arg)
+    { 222, &RevCore::ECALL_mmap },                      //  rev_mmap(unsigned long addr, unsigned long len, int prot, int flags, int fd, off_t offset)
     { 223, &RevCore::ECALL_fadvise64_64 },              //  rev_fadvise64_64(int fd, loff_t offset, loff_t len, int advice)
     { 224, &RevCore::ECALL_swapon },                    //  rev_swapon(const char  *specialfile, int swap_flags)
     { 225, &RevCore::ECALL_swapoff },                   //  rev_swapoff(const char  *specialfile)
@@ -3760,8 +4347,37 @@ const std::unordered_map<uint32_t, EcallStatus(RevCore::*)()> RevCore::Ecalls =
     { 9005, &RevCore::ECALL_dump_valid_mem_to_file },   // rev_dump_valid_mem_to_file(const char* filename)
     { 9004, &RevCore::ECALL_dump_thread_mem },          // rev_dump_thread_mem()
     { 9005, &RevCore::ECALL_dump_thread_mem_to_file },  // rev_dump_thread_mem_to_file(const char* filename)
+    { 9020, &RevCore::ECALL_checkpoint },               // rev_checkpoint()
     { 9110, &RevCore::ECALL_fast_printf },              // rev_fast_printf(const char *, ...)
+    { 9200, &RevCore::ECALL_xbgas_get_nb },             // rev_xbgas_get_nb(void* dest, uint64_t nmspace, const void* src, size_t nbytes, uint64_t* counter)
 };
 // clang-format on
 
+const RevCore::EcallDispatch& RevCore::GetEcallDispatch() {
+  static const EcallDispatch Dispatch = [] {
+    EcallDispatch D;
+    for( const auto& Code : Ecalls )
+      D.codes.push_back( Code.first );
+    std::sort( D.codes.begin(), D.codes.end() );
+    for( unsigned Slot = 0; Slot < D.codes.size(); Slot++ ) {
+      uint32_t   Code = D.codes[Slot];
+      EcallEntry Entry{ Ecalls.at( Code ), Slot };
+      if( Code < ECALL_TABLE_SIZE )
+        D.table[Code] = Entry;
+      else
+        D.sparse.emplace_back( Code, Entry );
+    }
+    return D;
+  }();
+  return Dispatch;
+}
+
+const RevCore::EcallEntry* RevCore::FindEcall( uint32_t Code ) {
+  const EcallDispatch& D = GetEcallDispatch();
+  if( Code < ECALL_TABLE_SIZE )
+    return D.table[Code].handler ? &D.table[Code] : nullptr;
+  auto it = std::lower_bound( D.sparse.begin(), D.sparse.end(), Code, []( const auto& E, uint32_t C ) { return E.first < C; } );
+  return it != D.sparse.end() && it->first == Code ? &it->second : nullptr;
+}
+
 }  // namespace SST::RevCPU
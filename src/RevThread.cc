@@ -10,6 +10,7 @@
 //
 
 #include "RevThread.h"
+#include "RevCore.h"
 
 namespace SST::RevCPU {
 
@@ -53,4 +54,73 @@ std::ostream& operator<<( std::ostream& os, const RevThread& Thread ) {
   return os;
 }
 
+// Threads are checkpointed off their harts, so the register state is always
+// held by the thread. File descriptors are saved by number only; RevCPU
+// reopens the host files before the threads are restored.
+void RevThread::SaveSnapshot( RevSnapshotOut& Snap ) const {
+  Snap.Put( ID );
+  Snap.Put( ParentID );
+  Snap.Put( ThreadMem ? ThreadMem->getBaseAddr() : _INVALID_ADDR_ );
+  Snap.Put( State );
+  Snap.Put( std::vector<uint32_t>( ChildrenIDs.begin(), ChildrenIDs.end() ) );
+  Snap.Put( std::vector<int>( fildes.begin(), fildes.end() ) );
+  Snap.Put( WaitingToJoinTID );
+  Snap.Put( Runtime );
+  Snap.Put( ContextSwitches );
+  Snap.Put( LastCore );
+  Snap.Put( ReadySeq );
+  Snap.Put( FutexAddr );
+  Snap.Put( FutexSeq );
+  Snap.Put( WakeCycle );
+  Snap.Put( VirtRegState->GetCore()->GetId() );
+  VirtRegState->SaveSnapshot( Snap );
+}
+
+std::unique_ptr<RevThread>
+  RevThread::LoadSnapshot( RevSnapshotIn& Snap, RevMem* Mem, const std::vector<std::unique_ptr<RevCore>>& Procs ) {
+  uint32_t              ID, ParentID;
+  uint64_t              MemBase;
+  std::vector<uint32_t> Children;
+  std::vector<int>      FDs;
+  Snap.Get( ID );
+  Snap.Get( ParentID );
+  Snap.Get( MemBase );
+
+  std::shared_ptr<RevMem::MemSegment> ThreadMem;
+  for( auto& Seg : Mem->GetThreadMemSegs() ) {
+    if( Seg->getBaseAddr() == MemBase )
+      ThreadMem = Seg;
+  }
+  if( !ThreadMem && MemBase != _INVALID_ADDR_ )
+    Snap.GetOutput()->fatal(
+      CALL_INFO, -1, "Error: checkpoint %s has no thread memory at 0x%" PRIx64 "\n", Snap.GetPath().c_str(), MemBase
+    );
+
+  // The register file is filled in below, once its core is known
+  auto Thread = std::make_unique<RevThread>( ID, ParentID, ThreadMem, nullptr );
+  Snap.Get( Thread->State );
+  Snap.Get( Children );
+  Snap.Get( FDs );
+  Thread->ChildrenIDs = { Children.begin(), Children.end() };
+  Thread->fildes      = { FDs.begin(), FDs.end() };
+  Snap.Get( Thread->WaitingToJoinTID );
+  Snap.Get( Thread->Runtime );
+  Snap.Get( Thread->ContextSwitches );
+  Snap.Get( Thread->LastCore );
+  Snap.Get( Thread->ReadySeq );
+  Snap.Get( Thread->FutexAddr );
+  Snap.Get( Thread->FutexSeq );
+  Snap.Get( Thread->WakeCycle );
+
+  unsigned Core;
+  Snap.Get( Core );
+  if( Core >= Procs.size() )
+    Snap.GetOutput()->fatal(
+      CALL_INFO, -1, "Error: checkpoint %s has a thread of core %u; this run has %zu cores\n", Snap.GetPath().c_str(), Core, Procs.size()
+    );
+  Thread->VirtRegState = std::make_unique<RevRegFile>( Procs[Core].get() );
+  Thread->VirtRegState->LoadSnapshot( Snap );
+  return Thread;
+}
+
 }  // namespace SST::RevCPU
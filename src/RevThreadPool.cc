@@ -0,0 +1,101 @@
+//
+// _RevThreadPool_cc_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include "RevThreadPool.h"
+
+namespace SST::RevCPU {
+
+RevThreadPool::RevThreadPool( unsigned Threads ) {
+  for( unsigned i = 1; i < Threads; i++ )
+    workers.emplace_back( &RevThreadPool::WorkerLoop, this );
+}
+
+RevThreadPool::~RevThreadPool() {
+  generation.fetch_add( 1 );
+  while( active.load() )
+    std::this_thread::yield();
+  stop = true;
+  {
+    std::lock_guard<std::mutex> lock( sleepMutex );
+    generation.fetch_add( 1, std::memory_order_release );
+  }
+  sleepCV.notify_all();
+  for( auto& w : workers )
+    w.join();
+}
+
+// A Run is published in two steps. The odd generation turns workers away
+// while the fields are rewritten; a worker that read the previous generation
+// before that is counted in 'active' and finds nothing left to claim
+void RevThreadPool::Run( size_t N, const std::function<void( size_t )>& Func ) {
+  if( workers.empty() || N < 2 ) {
+    for( size_t i = 0; i < N; i++ )
+      Func( i );
+    return;
+  }
+
+  generation.fetch_add( 1 );
+  while( active.load() )
+    std::this_thread::yield();
+  job     = &Func;
+  jobSize = N;
+  next.store( 0, std::memory_order_relaxed );
+  done.store( 0, std::memory_order_relaxed );
+  {
+    std::lock_guard<std::mutex> lock( sleepMutex );
+    generation.fetch_add( 1, std::memory_order_release );
+  }
+  sleepCV.notify_all();
+
+  Work();
+  while( done.load( std::memory_order_acquire ) < N )
+    std::this_thread::yield();
+}
+
+void RevThreadPool::Work() {
+  for( size_t i; ( i = next.fetch_add( 1, std::memory_order_relaxed ) ) < jobSize; ) {
+    ( *job )( i );
+    done.fetch_add( 1, std::memory_order_release );
+  }
+}
+
+void RevThreadPool::WorkerLoop() {
+  uint64_t seen  = 0;
+  unsigned spins = 0;
+  for( ;; ) {
+    active.fetch_add( 1 );
+    uint64_t gen  = generation.load( std::memory_order_acquire );
+    bool     idle = gen == seen || ( gen & 1 );
+    if( !idle ) {
+      seen  = gen;
+      spins = 0;
+      if( stop ) {
+        active.fetch_sub( 1 );
+        return;
+      }
+      Work();
+    }
+    active.fetch_sub( 1 );
+
+    if( !idle ) {
+      continue;
+    } else if( ++spins < SpinLimit ) {
+      std::this_thread::yield();
+    } else {
+      std::unique_lock<std::mutex> lock( sleepMutex );
+      sleepCV.wait( lock, [&] { return generation.load( std::memory_order_acquire ) != seen; } );
+      spins = 0;
+    }
+  }
+}
+
+}  // namespace SST::RevCPU
+
+// EOF
@@ -9,6 +9,9 @@
 //
 //
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <string>
@@ -17,6 +20,59 @@
 
 namespace SST::RevCPU {
 
+RevTraceBinWriter::RevTraceBinWriter( const std::string& path, bool compress ) {
+  buf.reserve( TRC_BIN_BUFFER_SIZE );
+  file = std::fopen( path.c_str(), "wb" );
+#ifdef REV_TRACE_ZSTD
+  if( file && compress ) {
+    cctx = ZSTD_createCCtx();
+    zbuf.resize( ZSTD_CStreamOutSize() );
+  }
+#endif
+}
+
+RevTraceBinWriter::~RevTraceBinWriter() {
+  if( file ) {
+    Flush( true );
+    std::fclose( file );
+  }
+#ifdef REV_TRACE_ZSTD
+  if( cctx )
+    ZSTD_freeCCtx( cctx );
+#endif
+}
+
+bool RevTraceBinWriter::HasCompression() {
+#ifdef REV_TRACE_ZSTD
+  return true;
+#else
+  return false;
+#endif
+}
+
+void RevTraceBinWriter::Flush( bool end ) {
+  if( !file )
+    return;
+#ifdef REV_TRACE_ZSTD
+  if( cctx ) {
+    ZSTD_inBuffer     in{ buf.data(), buf.size(), 0 };
+    ZSTD_EndDirective mode = end ? ZSTD_e_end : ZSTD_e_continue;
+    size_t            remaining;
+    do {
+      ZSTD_outBuffer out{ zbuf.data(), zbuf.size(), 0 };
+      remaining = ZSTD_compressStream2( cctx, &out, &in, mode );
+      if( ZSTD_isError( remaining ) )
+        break;
+      std::fwrite( zbuf.data(), 1, out.pos, file );
+    } while( end ? remaining != 0 : in.pos != in.size );
+    buf.clear();
+    return;
+  }
+#endif
+  std::fwrite( buf.data(), 1, buf.size(), file );
+  buf.clear();
+}
+
 RevTracer::RevTracer( std::string Name, SST::Output* o ) : name( Name ), pOutput( o ) {
 
   enableQ.resize( MAX_ENABLE_Q );
@@ -43,6 +99,8 @@ RevTracer::RevTracer( std::string Name, SST::Output* o ) : name( Name ), pOutput
 }
 
 RevTracer::~RevTracer() {
+  if( writer.joinable() )
+    Finish();
 #ifdef REV_USE_SPIKE
   if( diasm )
     delete diasm;
@@ -66,7 +124,7 @@ int RevTracer::SetDisassembler( std::string machine ) {
 #endif
 }
 
-void RevTracer::SetTraceSymbols( std::map<uint64_t, std::string>* TraceSymbols ) {
+void RevTracer::SetTraceSymbols( const std::map<uint64_t, std::string>* TraceSymbols ) {
   traceSymbols = TraceSymbols;
 }
 
@@ -78,6 +136,85 @@ void RevTracer::SetCycleLimit( uint64_t c ) {
   cycleLimit = c;
 }
 
+void RevTracer::SetSampling( uint64_t every, uint64_t window, uint64_t period ) {
+  sampleEvery  = every;
+  sampleWindow = window;
+  samplePeriod = period;
+}
+
+int RevTracer::SetROI( const std::string& func ) {
+  if( !traceSymbols )
+    return 1;
+  for( auto it = traceSymbols->begin(); it != traceSymbols->end(); it++ ) {
+    if( it->second != func )
+      continue;
+    // the function is assumed to end at the next symbol
+    auto next           = std::next( it );
+    roiFuncs[it->first] = next == traceSymbols->end() ? ~0ULL : next->first;
+    return 0;
+  }
+  return 1;
+}
+
+int RevTracer::SetBinaryOutput( const std::string& path, unsigned core, bool compress ) {
+  if( compress && !RevTraceBinWriter::HasCompression() )
+    return 2;
+  binWriter = std::make_unique<RevTraceBinWriter>( path, compress );
+  if( !binWriter->IsOpen() ) {
+    binWriter.reset();
+    return 1;
+  }
+
+  TraceBinFileHdr_t fh{};
+  std::memcpy( fh.magic, TRC_BIN_MAGIC, sizeof( fh.magic ) );
+  fh.version = TRC_BIN_VERSION;
+  fh.core    = core;
+#ifdef REV_USE_SPIKE
+  fh.flags = TRC_BIN_SPIKE_REGS;
+#endif
+  fh.nameLen = uint32_t( name.size() );
+  binWriter->Write( &fh, sizeof( fh ) );
+  binWriter->Write( name.data(), name.size() );
+
+  // The decoder needs the symbols to annotate branch targets
+  if( traceSymbols ) {
+    for( const auto& [addr, sym] : *traceSymbols )
+      BinText( TraceBinKind::Symbol, 0, addr, sym );
+  }
+  return 0;
+}
+
+int RevTracer::SetAsyncOutput( size_t slots, bool drop ) {
+  if( slots == 0 || writer.joinable() )
+    return 1;
+  ring.resize( slots );
+  ringDrop = drop;
+  ringStop.store( false );
+  writer = std::thread( &RevTracer::WriterLoop, this );
+  return 0;
+}
+
+void RevTracer::Finish() {
+  if( writer.joinable() ) {
+    ringStop.store( true, std::memory_order_release );
+    writer.join();
+    pOutput->verbose(
+      CALL_INFO,
+      1,
+      0,
+      "Tracer ring: %zu slots; %" PRIu64 " records; high water %" PRIu64 "; %" PRIu64 " producer stalls; %" PRIu64 " dropped\n",
+      ring.size(),
+      ringHead.load(),
+      ringHighWater,
+      ringStalls,
+      ringDropped
+    );
+  }
+  if( binWriter )
+    binWriter->Flush( false );
+  std::fflush( stdout );
+}
+
 void RevTracer::SetCmdTemplate( std::string cmd ) {
   if( s2op.find( cmd ) == s2op.end() ) {
     std::stringstream s;
@@ -197,37 +334,42 @@ void RevTracer::Render( size_t cycle ) {
   // Trace on/off controls
   CheckUserControls( cycle );
 
-  // memory completions
-  if( completionRecs.size() > 0 ) {
-    if( OutputOK() ) {
-      for( auto r : completionRecs ) {
-        std::string       data_str = fmt_data( r.len, r.data );
-        std::stringstream s;
-        s << data_str << "<-[0x" << std::hex << r.addr << "," << std::dec << r.len << "] ";
-        s << fmt_reg( r.destReg ) << "<-" << data_str << " ";
-        pOutput->verbose( CALL_INFO, 5, 0, "Hart %" PRIu32 "; *A %s\n", r.hart, s.str().c_str() );
+  // Region of interest, filters and sampling
+  if( instHeader.valid && !roiFuncs.empty() )
+    TrackROI();
+  if( !completionRecs.empty() && ( !hartFilter.empty() || !roiFuncs.empty() ) ) {
+    completionRecs.erase(
+      std::remove_if(
+        completionRecs.begin(), completionRecs.end(), [this]( const CompletionRec_t& r ) { return !HartSelected( r.hart ); }
+      ),
+      completionRecs.end()
+    );
+  }
+
+  bool inst  = instHeader.valid && ( events.f.trc_ctl || ( outputEnabled && InstSelected( cycle ) ) );
+  bool comps = !completionRecs.empty() && OutputOK();
+  if( inst || comps ) {
+    // count rendered lines here so trcLimit does not depend on the writer
+    if( inst && !traceRecs.empty() )
+      traceCycles++;
+
+    if( writer.joinable() ) {
+      if( TraceSlot_t* slot = AcquireSlot() ) {
+        Capture( *slot, cycle, inst, comps );
+        uint64_t head = ringHead.load( std::memory_order_relaxed ) + 1;
+        ringHead.store( head, std::memory_order_release );
+        ringHighWater = std::max( ringHighWater, head - ringTail.load( std::memory_order_relaxed ) );
       }
+    } else {
+      Capture( syncSlot, cycle, inst, comps );
+      Emit( syncSlot );
     }
-    // reset completion reqs
-    completionRecs.clear();
   }
 
-  // Instruction Trace
-  if( instHeader.valid ) {
-    if( OutputOK() ) {
-      pOutput->verbose(
-        CALL_INFO,
-        5,
-        0,
-        "Core %" PRIu32 "; Hart %" PRIu32 "; Thread %" PRIu32 "; *I %s\n",
-        instHeader.id,
-        instHeader.hart,
-        instHeader.tid,
-        RenderExec( instHeader.fallbackMnemonic ).c_str()
-      );
-    }
+  // reset completion reqs
+  completionRecs.clear();
+  if( instHeader.valid )
     InstTraceReset();
-  }
 }
 
 void SST::RevCPU::RevTracer::Reset() {
@@ -235,12 +377,151 @@ void SST::RevCPU::RevTracer::Reset() {
   completionRecs.clear();
 }
 
-std::string RevTracer::RenderExec( const std::string& fallbackMnemonic ) {
+void RevTracer::TrackROI() {
+  if( instHeader.hart >= roiHarts.size() )
+    roiHarts.resize( instHeader.hart + 1 );
+  RoiHart_t& h = roiHarts[instHeader.hart];
+
+  // leaving an ROI function: the return address of the innermost call is reached
+  if( !h.returns.empty() && pc == h.returns.back() )
+    h.returns.pop_back();
+
+  // entering an ROI function from outside of it (not a loop back to its entry)
+  auto f = roiFuncs.find( pc );
+  if( f != roiFuncs.end() && ( h.prevPC < f->first || h.prevPC >= f->second ) )
+    h.returns.push_back( h.prevPC + h.prevLen );
+
+  h.prevPC  = pc;
+  h.prevLen = ( ~insn & 3 ) ? 2 : 4;
+}
+
+bool RevTracer::HartSelected( unsigned hart ) const {
+  if( !hartFilter.empty() && std::find( hartFilter.begin(), hartFilter.end(), hart ) == hartFilter.end() )
+    return false;
+  if( !roiFuncs.empty() && ( hart >= roiHarts.size() || roiHarts[hart].returns.empty() ) )
+    return false;
+  return true;
+}
+
+bool RevTracer::InstSelected( uint64_t cycle ) {
+  if( !HartSelected( instHeader.hart ) )
+    return false;
+  if( !threadFilter.empty() && std::find( threadFilter.begin(), threadFilter.end(), instHeader.tid ) == threadFilter.end() )
+    return false;
+
+  // window sampling: the first sampleWindow instructions of each period
+  if( samplePeriod ) {
+    uint64_t idx = cycle / samplePeriod;
+    if( idx != sampleIdx ) {
+      sampleIdx         = idx;
+      sampleWindowCount = 0;
+    }
+    if( sampleWindowCount >= sampleWindow )
+      return false;
+    sampleWindowCount++;
+  }
+
+  // 1 in N sampling
+  if( sampleEvery > 1 && sampleCount++ % sampleEvery != 0 )
+    return false;
+  return true;
+}
+
+void RevTracer::Capture( TraceSlot_t& slot, uint64_t cycle, bool inst, bool comps ) {
+  slot.cycle = cycle;
+  slot.inst  = inst;
+  if( comps )
+    slot.comps.swap( completionRecs );
+  else
+    slot.comps.clear();
+  if( !inst ) {
+    slot.recs.clear();
+    return;
+  }
+  slot.pc      = pc;
+  slot.insn    = insn;
+  slot.id      = instHeader.id;
+  slot.hart    = instHeader.hart;
+  slot.tid     = instHeader.tid;
+  slot.events  = events;
+  slot.enabled = outputEnabled;
+  slot.mnemonic.assign( instHeader.fallbackMnemonic );
+  slot.recs.swap( traceRecs );
+}
+
+void RevTracer::Emit( const TraceSlot_t& slot ) {
+  if( binWriter ) {
+    RenderBinCompletions( slot );
+    if( slot.inst )
+      RenderBinExec( slot );
+    return;
+  }
+
+  // memory completions
+  for( const auto& r : slot.comps ) {
+    std::string       data_str = fmt_data( r.len, r.data );
+    std::stringstream s;
+    s << "Hart " << r.hart << "; *A ";
+    s << data_str << "<-[0x" << std::hex << r.addr << "," << std::dec << r.len << "] ";
+    s << fmt_reg( r.destReg ) << "<-" << data_str << " ";
+    EmitLine( slot.cycle, s.str() );
+  }
+
+  // Instruction Trace
+  if( slot.inst ) {
+    std::stringstream s;
+    s << "Core " << slot.id << "; Hart " << slot.hart << "; Thread " << slot.tid << "; *I " << RenderExec( slot );
+    EmitLine( slot.cycle, s.str() );
+  }
+}
+
+void RevTracer::EmitLine( uint64_t cycle, const std::string& line ) {
+  if( !ring.empty() ) {
+    // SST::Output is not thread safe; the core cycle replaces the simulation time in the prefix
+    std::fprintf( stdout, "RevCPU[%s:Render:%" PRIu64 "]: %s\n", name.c_str(), cycle, line.c_str() );
+  } else {
+    pOutput->verbose( __LINE__, __FILE__, "Render", 5, 0, "%s\n", line.c_str() );
+  }
+}
+
+TraceSlot_t* RevTracer::AcquireSlot() {
+  uint64_t head = ringHead.load( std::memory_order_relaxed );
+  if( head - ringTail.load( std::memory_order_acquire ) < ring.size() )
+    return &ring[head % ring.size()];
+
+  // back-pressure: wait for the writer unless records may be dropped
+  if( ringDrop ) {
+    ringDropped++;
+    return nullptr;
+  }
+  ringStalls++;
+  while( head - ringTail.load( std::memory_order_acquire ) >= ring.size() )
+    std::this_thread::yield();
+  return &ring[head % ring.size()];
+}
+
+void RevTracer::WriterLoop() {
+  while( true ) {
+    // read the stop flag first so a stopped, empty ring is really drained
+    bool     stop = ringStop.load( std::memory_order_acquire );
+    uint64_t tail = ringTail.load( std::memory_order_relaxed );
+    if( tail == ringHead.load( std::memory_order_acquire ) ) {
+      if( stop )
+        break;
+      std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+      continue;
+    }
+    Emit( ring[tail % ring.size()] );
+    ringTail.store( tail + 1, std::memory_order_release );
+  }
+}
+
+std::string RevTracer::RenderExec( const TraceSlot_t& slot ) {
   // Flow Control Events
   std::stringstream ss_events;
-  if( events.v ) {
-    if( events.f.trc_ctl ) {
-      EVENT_SYMBOL e = outputEnabled ? EVENT_SYMBOL::TRACE_ON : EVENT_SYMBOL::TRACE_OFF;
+  if( slot.events.v ) {
+    if( slot.events.f.trc_ctl ) {
+      EVENT_SYMBOL e = slot.enabled ? EVENT_SYMBOL::TRACE_ON : EVENT_SYMBOL::TRACE_OFF;
       ss_events << event2char.at( e );
     }
   }
@@ -249,7 +530,7 @@ std::string RevTracer::RenderExec( const std::string& fallbackMnemonic ) {
   std::stringstream ss_disasm;
 #ifdef REV_USE_SPIKE
   if( diasm )
-    ss_disasm << std::hex << diasm->disassemble( insn ) << "\t";
+    ss_disasm << std::hex << diasm->disassemble( slot.insn ) << "\t";
   else
 #endif
   {
@@ -257,34 +538,31 @@ std::string RevTracer::RenderExec( const std::string& fallbackMnemonic ) {
 // TODO internal rev disassembler
 #if 0
         // only show mnemonic
-        auto pos = fallbackMnemonic.find(' ');
+        auto pos = slot.mnemonic.find(' ');
         if (pos != std::string::npos)
-            ss_disasm << fallbackMnemonic.substr(0, pos) << "\t";
+            ss_disasm << slot.mnemonic.substr(0, pos) << "\t";
         else
             ss_disasm << "?" << "\n";
 #else
     // show mnemonic and field format strings.
-    ss_disasm << std::left << std::setw( 20 ) << fallbackMnemonic << std::right << "\t";
+    ss_disasm << std::left << std::setw( 20 ) << slot.mnemonic << std::right << "\t";
 #endif
   }
 
   // Initial rendering
   std::stringstream os;
-  os << "0x" << std::hex << pc << ":" << std::setfill( '0' );
-  if( ~insn & 3 ) {
-    os << std::setw( 4 ) << ( insn & 0xffff ) << "    ";
+  os << "0x" << std::hex << slot.pc << ":" << std::setfill( '0' );
+  if( ~slot.insn & 3 ) {
+    os << std::setw( 4 ) << ( slot.insn & 0xffff ) << "    ";
   } else {
-    os << std::setw( 8 ) << insn;
+    os << std::setw( 8 ) << slot.insn;
   }
   os << " " << std::setfill( ' ' ) << std::setw( 2 ) << ss_events.str() << " " << ss_disasm.str();
 
   // register and memory read/write events preserving code ordering
-  if( traceRecs.empty() )
+  if( slot.recs.empty() )
     return os.str();
 
-  // We got something, count it and render it
-  traceCycles++;
-
   // For Memh, the target register is corrupted after ReadVal (See RevInstHelpers.h::load)
   // This is a transitory value that would only be observed if the register file is accessible
   // by an external agent (e.g. IO or JTAG scan). A functional issue would occur
@@ -296,7 +574,7 @@ std::string RevTracer::RenderExec( const std::string& fallbackMnemonic ) {
   bool squashNextSetX = false;
 
   std::stringstream ss_rw;
-  for( TraceRec_t r : traceRecs ) {
+  for( const TraceRec_t& r : slot.recs ) {
     switch( r.key ) {
     case RegRead:
       // a:reg b:data
@@ -327,6 +605,9 @@ std::string RevTracer::RenderExec( const std::string& fallbackMnemonic ) {
       ss_rw << " ";
       squashNextSetX = true;  // register corrupted after ReadVal in RevInstHelpers.h::load
       break;
+    case MemCompletion:
+      // only recorded in binary traces
+      break;
     case PcWrite:
       // a:pc
       uint64_t pc = r.a;
@@ -347,6 +628,107 @@ std::string RevTracer::RenderExec( const std::string& fallbackMnemonic ) {
   return os.str();
 }
 
+void RevTracer::RenderBinCompletions( const TraceSlot_t& slot ) {
+  for( const auto& r : slot.comps ) {
+    TraceBinHdr_t h{};
+    h.kind       = uint8_t( TraceBinKind::Completion );
+    h.nrecs      = 1;
+    h.hart       = r.hart;
+    h.cycleDelta = slot.cycle - binCycle;
+    binCycle     = slot.cycle;
+
+    TraceBinRec_t rec{};
+    rec.key = MemCompletion;
+    rec.reg = r.destReg;
+    rec.len = uint32_t( r.len );
+    rec.a   = r.addr;
+    rec.b   = r.data;
+
+    binWriter->Write( &h, sizeof( h ) );
+    binWriter->Write( &rec, sizeof( rec ) );
+  }
+}
+
+void RevTracer::RenderBinExec( const TraceSlot_t& slot ) {
+  TraceBinHdr_t h{};
+  h.kind = uint8_t( TraceBinKind::Inst );
+  if( slot.events.v && slot.events.f.trc_ctl )
+    h.event = uint8_t( event2char.at( slot.enabled ? EVENT_SYMBOL::TRACE_ON : EVENT_SYMBOL::TRACE_OFF ) );
+  h.nrecs      = uint16_t( slot.recs.size() );
+  h.insn       = slot.insn;
+  h.hart       = slot.hart;
+  h.tid        = slot.tid;
+  h.str        = BinDisasmId( slot.insn, slot.mnemonic );
+  h.cycleDelta = slot.cycle - binCycle;
+  h.pcDelta    = slot.pc - binPC;
+  binCycle     = slot.cycle;
+  binPC        = slot.pc;
+  binWriter->Write( &h, sizeof( h ) );
+
+  // Mirror the state updates made by RenderExec
+  for( const TraceRec_t& r : slot.recs ) {
+    TraceBinRec_t rec{};
+    rec.key = uint16_t( r.key );
+    switch( r.key ) {
+    case RegRead:
+    case RegWrite:
+      rec.reg = uint16_t( r.a );
+      rec.a   = r.b;
+      break;
+    case MemLoad:
+    case MemStore:
+      rec.len = uint32_t( r.b );
+      rec.a   = r.a;
+      rec.b   = r.c;
+      break;
+    case MemhSendLoad:
+      rec.reg = uint16_t( r.c );
+      rec.len = uint32_t( r.b );
+      rec.a   = r.a;
+      break;
+    case PcWrite:
+      rec.a  = r.a;
+      lastPC = r.a;
+      break;
+    default: break;
+    }
+    binWriter->Write( &rec, sizeof( rec ) );
+  }
+}
+
+uint32_t RevTracer::BinDisasmId( uint32_t word, const std::string& fallbackMnemonic ) {
+#ifdef REV_USE_SPIKE
+  if( diasm ) {
+    auto it = binInsnStrings.find( word );
+    if( it != binInsnStrings.end() )
+      return it->second;
+    uint32_t id = uint32_t( binStrings.size() + binInsnStrings.size() );
+    binInsnStrings.emplace( word, id );
+    BinText( TraceBinKind::String, id, 0, diasm->disassemble( word ) + "\t" );
+    return id;
+  }
+#endif
+  auto it = binStrings.find( fallbackMnemonic );
+  if( it != binStrings.end() )
+    return it->second;
+  uint32_t id = uint32_t( binStrings.size() + binInsnStrings.size() );
+  binStrings.emplace( fallbackMnemonic, id );
+  std::stringstream ss_disasm;
+  ss_disasm << std::left << std::setw( 20 ) << fallbackMnemonic << std::right << "\t";
+  BinText( TraceBinKind::String, id, 0, ss_disasm.str() );
+  return id;
+}
+
+void RevTracer::BinText( TraceBinKind kind, uint32_t id, uint64_t addr, const std::string& text ) {
+  TraceBinHdr_t h{};
+  h.kind    = uint8_t( kind );
+  h.insn    = uint32_t( text.size() );
+  h.str     = id;
+  h.pcDelta = addr;
+  binWriter->Write( &h, sizeof( h ) );
+  binWriter->Write( text.data(), text.size() );
+}
+
 void RevTracer::InstTraceReset() {
   events.v = 0;
   insn     = 0;
@@ -18,18 +18,50 @@ std::atomic<uint32_t> SST::RevCPU::xbgasNicEvent::main_id( 0 );
 bool xbgasNicEvent::setData( uint8_t* In, uint32_t TotalSz ) {
   if( TotalSz == 0 )
     return true;
-  for( unsigned i = 0; i < TotalSz; i++ ) {
-    Data.push_back( In[i] );
-  }
+  Data.insert( Data.end(), In, In + TotalSz );
   return true;
 }
 
 void xbgasNicEvent::getData( uint8_t* Buffer ) {
   if( Size == 0 )
     return;
-  for( size_t i = 0; i < Size * Nelem; i++ ) {
-    Buffer[i] = Data[i];
-  }
+  std::memcpy( Buffer, Data.data(), std::min( Data.size(), Size * Nelem ) );
+}
+
+bool xbgasNicEvent::isEqual( const xbgasNicEvent& Other ) const {
+  return Hart == Other.Hart && Id == Other.Id && SrcId == Other.SrcId && SrcAddr == Other.SrcAddr &&
+         DestAddr == Other.DestAddr && Size == Other.Size && Nelem == Other.Nelem && Data == Other.Data &&
+         Opcode == Other.Opcode && Flags == Other.Flags && isSeg == Other.isSeg && SegSz == Other.SegSz;
+}
+
+void xbgasNicEvent::packHdr( xbgasNicWireHdr& Hdr ) {
+  Hdr.SrcAddr  = SrcAddr;
+  Hdr.DestAddr = DestAddr;
+  Hdr.Id       = Id;
+  Hdr.SrcId    = SrcId;
+  Hdr.Size     = static_cast<uint32_t>( Size );
+  Hdr.Nelem    = Nelem;
+  Hdr.SegSz    = SegSz;
+  Hdr.Flags    = static_cast<uint32_t>( Flags );
+  Hdr.Hart     = Hart;
+  Hdr.DataLen  = static_cast<uint32_t>( Data.size() );
+  Hdr.Opcode   = static_cast<uint8_t>( Opcode );
+  Hdr.isSeg    = isSeg ? 1 : 0;
+}
+
+void xbgasNicEvent::unpackHdr( const xbgasNicWireHdr& Hdr ) {
+  SrcAddr  = Hdr.SrcAddr;
+  DestAddr = Hdr.DestAddr;
+  Id       = Hdr.Id;
+  SrcId    = Hdr.SrcId;
+  Size     = Hdr.Size;
+  Nelem    = Hdr.Nelem;
+  SegSz    = Hdr.SegSz;
+  Flags    = static_cast<RevFlag>( Hdr.Flags );
+  Hart     = Hdr.Hart;
+  Opcode   = static_cast<RmtMemOp>( Hdr.Opcode );
+  isSeg    = Hdr.isSeg != 0;
+  Data.resize( Hdr.DataLen );
 }
 
 bool xbgasNicEvent::buildREADRqst( uint64_t SrcAddr, uint64_t DestAddr, size_t Size, RevFlag Fl ) {
@@ -121,14 +153,12 @@ bool xbgasNicEvent::buildBulkWRITERqst( uint64_t DestAddr, size_t Size, uint32_t
 }
 
 bool xbgasNicEvent::buildSegBulkWRITERqst(
-  uint32_t SegId, uint64_t DestAddr, size_t Size, uint32_t Nelem, RevFlag Fl, uint32_t SegSz, uint8_t* Buffer
+  uint64_t Id, uint64_t DestAddr, size_t Size, uint32_t Nelem, RevFlag Fl, uint32_t SegSz, uint8_t* Buffer
 ) {
-  if( SegId == 0 ) {
-    if( !setId( main_id++ ) )
-      return false;
-  }
   if( !setOp( RmtMemOp::BulkWRITERqst ) )
     return false;
+  if( !setId( Id ) )
+    return false;
   if( !setDestAddr( DestAddr ) )
     return false;
   if( !setSize( Size ) )
@@ -312,11 +342,22 @@ bool xbgasNicEvent::buildAMOResp( uint64_t Id, size_t Size, uint8_t* Buffer ) {
   return true;
 }
 
+bool xbgasNicEvent::buildSegACK( uint64_t Id, uint32_t SrcId ) {
+  if( !setOp( RmtMemOp::SegACK ) )
+    return false;
+  if( !setId( Id ) )
+    return false;
+  if( !setSrcId( SrcId ) )
+    return false;
+  return true;
+}
+
 XbgasNIC::XbgasNIC( ComponentId_t id, Params& params ) : xbgasNicAPI( id, params ) {
 
   // setup the initial logging functions
   int         verbosity = params.find<int>( "verbose", 0 );
   std::string ClockFreq = params.find<std::string>( "clock", "1Ghz" );
+  serializeBench        = params.find<uint64_t>( "serialize_bench", 0 );
 
   output                = new SST::Output( "", verbosity, 0, SST::Output::STDOUT );
   registerClock( ClockFreq, new Clock::Handler<XbgasNIC>( this, &XbgasNIC::clockTick ) );
@@ -389,6 +430,76 @@ void XbgasNIC::setup() {
       getName().c_str()
     );
   }
+  if( serializeBench > 0 )
+    runSerializeBench();
+}
+
+void XbgasNIC::runSerializeBench() {
+  struct BenchCase {
+    const char* Name;
+    RmtMemOp    Op;
+    size_t      Size;
+    uint32_t    Nelem;
+  };
+
+  // Typical packet shapes: scalar requests, scalar responses and bulk payloads
+  const BenchCase Cases[] = {
+    { "READRqst",           RmtMemOp::READRqst,      8, 1   },
+    { "READResp",           RmtMemOp::READResp,      8, 1   },
+    { "WRITERqst",          RmtMemOp::WRITERqst,     8, 1   },
+    { "WRITEResp",          RmtMemOp::WRITEResp,     8, 1   },
+    { "BulkWRITERqst-512B", RmtMemOp::BulkWRITERqst, 8, 64  },
+    { "BulkREADResp-4KiB",  RmtMemOp::BulkREADResp,  8, 512 },
+  };
+
+  // a byte pattern, so a shifted or truncated payload does not compare equal
+  std::vector<uint8_t> Payload( _MAX_PAYLOAD_ );
+  for( size_t i = 0; i < Payload.size(); i++ )
+    Payload[i] = uint8_t( i * 7 + 1 );
+  std::vector<char>    Buf;
+
+  for( const BenchCase& C : Cases ) {
+    xbgasNicEvent Ev;
+    switch( C.Op ) {
+    case RmtMemOp::READRqst: Ev.buildREADRqst( 0x1000, 0x2000, C.Size, RevFlag::F_NONE ); break;
+    case RmtMemOp::READResp: Ev.buildREADResp( 1, 0x2000, C.Size, C.Nelem, RevFlag::F_NONE, Payload.data() ); break;
+    case RmtMemOp::WRITERqst: Ev.buildWRITERqst( 0x2000, C.Size, RevFlag::F_NONE, Payload.data() ); break;
+    case RmtMemOp::WRITEResp: Ev.buildWRITEResp( 1 ); break;
+    case RmtMemOp::BulkWRITERqst: Ev.buildBulkWRITERqst( 0x2000, C.Size, C.Nelem, RevFlag::F_NONE, Payload.data() ); break;
+    default: Ev.buildBulkREADResp( 1, 0x2000, C.Size, C.Nelem, RevFlag::F_NONE, Payload.data() ); break;
+    }
+    Ev.setSrcId( static_cast<uint32_t>( getAddress() ) );
+
+    SST::Core::Serialization::serializer ser;
+    size_t                               WireSz = 0;
+    auto                                 Start  = std::chrono::steady_clock::now();
+    for( uint64_t i = 0; i < serializeBench; i++ ) {
+      ser.start_sizing();
+      Ev.serialize_order( ser );
+      WireSz = ser.size();
+      Buf.resize( WireSz );
+
+      ser.start_packing( Buf.data(), WireSz );
+      Ev.serialize_order( ser );
+
+      xbgasNicEvent Out;
+      ser.start_unpacking( Buf.data(), WireSz );
+      Out.serialize_order( ser );
+
+      // every iteration packs the same event; the first one checks the round trip
+      if( i == 0 && !Out.isEqual( Ev ) )
+        output->fatal( CALL_INFO, -1, "Error: serialize_bench %s: the unpacked event differs from the original\n", C.Name );
+    }
+    std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+
+    output->output(
+      "%s: serialize_bench %-20s %6zu bytes/event %14.0f events/sec\n",
+      getName().c_str(),
+      C.Name,
+      WireSz,
+      Elapsed.count() > 0 ? serializeBench / Elapsed.count() : 0.0
+    );
+  }
 }
 
 void XbgasNIC::finish() {
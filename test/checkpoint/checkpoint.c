@@ -0,0 +1,75 @@
+/*
+ * checkpoint.c
+ *
+ * RISC-V ISA: RV64IMAFDC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * Writes "before" to out.txt (created by run_checkpoint.sh), starts the
+ * workers and requests a checkpoint while they run. A run restarted from
+ * any checkpoint must finish the sums and append "after" at the restored
+ * file offset.
+ */
+
+#include "../../common/syscalls/syscalls.h"
+#include <fcntl.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#define N        4096
+#define REPS     8
+#define NTHREADS 2
+
+#define assert( x )               \
+  do                              \
+    if( !( x ) ) {                \
+      asm( ".dword 0x00000000" ); \
+    }                             \
+  while( 0 )
+
+uint64_t          data[N];
+volatile uint64_t sums[NTHREADS];
+
+void* worker( void* arg ) {
+  uintptr_t id = (uintptr_t) arg;
+  uint64_t  s  = 0;
+  for( int r = 0; r < REPS; r++ )
+    for( uint64_t i = id; i < N; i += NTHREADS )
+      s += data[i];
+  sums[id] = s;
+  return 0;
+}
+
+static void msg( const char* s ) {
+  size_t n = 0;
+  while( s[n] )
+    n++;
+  rev_write( STDOUT_FILENO, s, n );
+}
+
+int main() {
+  int fd = rev_openat( AT_FDCWD, "out.txt", 0, O_WRONLY );
+  assert( fd >= 0 );
+  assert( rev_write( fd, "before\n", 7 ) == 7 );
+  for( uint64_t i = 0; i < N; i++ )
+    data[i] = 3 * i + 1;
+  msg( "checkpoint: workers starting\n" );
+
+  rev_pthread_t tids[NTHREADS];
+  for( uintptr_t i = 0; i < NTHREADS; i++ )
+    rev_pthread_create( &tids[i], NULL, (void*) worker, (void*) i );
+  assert( rev_checkpoint() == 0 );
+
+  for( int i = 0; i < NTHREADS; i++ )
+    rev_pthread_join( tids[i] );
+  assert( sums[0] + sums[1] == REPS * ( 3 * (uint64_t) N * ( N - 1 ) / 2 + N ) );
+
+  assert( rev_write( fd, "after\n", 6 ) == 6 );
+  rev_close( fd );
+  msg( "checkpoint: sums verified\n" );
+  return 0;
+}
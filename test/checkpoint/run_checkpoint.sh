@@ -0,0 +1,69 @@
+#!/bin/bash
+#
+# Checkpoint/restart: the guest requests a checkpoint with rev_checkpoint()
+# while its workers run, and a second run also takes periodic checkpoints.
+# Every run restarted from a checkpoint must finish the program and append
+# to out.txt at the restored file offset, and the periodic checkpoints must
+# not count as context switches.
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [[ ! -x checkpoint.exe ]]; then
+	echo "Test CHECKPOINT: checkpoint.exe not Found - likely build failed"
+	exit 1
+fi
+
+run() {
+	sst --add-lib-path=../../build/src/ ../rev-model-options-config.py -- --program=checkpoint.exe \
+		--numCores=$cores --numHarts=$harts "$@" > $log 2>&1
+	if ! grep -q "sums verified" $log || ! grep -q "Simulation is complete" $log; then
+		echo "Test CHECKPOINT: $log did not complete"
+		exit 1
+	fi
+	if [[ "$(cat out.txt)" != $'before\nafter' ]]; then
+		echo "Test CHECKPOINT: $log left out.txt with unexpected contents"
+		exit 1
+	fi
+}
+
+for config in "1 1" "2 2"; do
+	read -r cores harts <<<"$config"
+	rm -f *.ckpt
+
+	# the checkpoint requested by the guest
+	: > out.txt
+	log=checkpoint.${cores}c.${harts}h.log
+	run --checkpoint=ecall
+	ckpts=(ecall.cpu.*.ckpt)
+	if [[ ${#ckpts[@]} -ne 1 || ! -f ${ckpts[0]} ]]; then
+		echo "Test CHECKPOINT: $cores core(s) with $harts hart(s) wrote ${#ckpts[@]} guest checkpoint(s)"
+		exit 1
+	fi
+	printf 'before\n' > out.txt
+	log=checkpoint.${cores}c.${harts}h.restart.log
+	run --loadSnapshot=${ckpts[0]}
+	if grep -q "workers starting" $log; then
+		echo "Test CHECKPOINT: $log restarted the program instead of the checkpoint"
+		exit 1
+	fi
+
+	# periodic checkpoints
+	: > out.txt
+	log=checkpoint.${cores}c.${harts}h.period.log
+	run --checkpoint=period --checkpointPeriod=20000 --verbose=3
+	# without a quantum no thread is switched out; a checkpoint is not a switch
+	if ! grep -q "Context Switches:" $log || grep "Context Switches:" $log | grep -qv "Context Switches: 0$"; then
+		echo "Test CHECKPOINT: $log counted checkpoints as context switches"
+		exit 1
+	fi
+	for ckpt in period.cpu.*.ckpt; do
+		printf 'before\n' > out.txt
+		log=${ckpt%.ckpt}.${cores}c.${harts}h.log
+		run --loadSnapshot=$ckpt
+	done
+done
+
+rm -f *.ckpt out.txt
+echo "Test CHECKPOINT: Simulation is complete"
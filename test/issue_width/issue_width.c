@@ -0,0 +1,68 @@
+/*
+ * issue_width.c
+ *
+ * RISC-V ISA: RV64GC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdint.h>
+
+#define assert( x )               \
+  do                              \
+    if( !( x ) ) {                \
+      asm( ".dword 0x00000000" ); \
+    }                             \
+  while( 0 )
+
+#define N 256
+
+uint64_t a[N];
+double   d[N];
+
+int main() {
+  // independent integer, multiply, floating point and memory streams
+  // that a multi-issue core can overlap
+  for( uint64_t i = 0; i < N; i++ ) {
+    a[i] = i * 3 + 1;
+    d[i] = (double) i * 0.5;
+  }
+
+  uint64_t s0 = 0, s1 = 0, p = 1;
+  double   f  = 0.0;
+  for( uint64_t i = 0; i < N; i += 2 ) {
+    s0 += a[i];
+    s1 += a[i + 1];
+    p = p * 3 + i;
+    f += d[i] * 2.0;
+  }
+
+  uint64_t q = 0;
+  for( uint64_t i = 1; i < N; i++ )
+    q += a[i] / i;
+
+  // expected values computed on the host
+  uint64_t e0 = 0, e1 = 0, ep = 1, eq = 0;
+  double   ef = 0.0;
+  for( uint64_t i = 0; i < N; i += 2 ) {
+    e0 += i * 3 + 1;
+    e1 += ( i + 1 ) * 3 + 1;
+    ep = ep * 3 + i;
+    ef += (double) i;
+  }
+  for( uint64_t i = 1; i < N; i++ )
+    eq += ( i * 3 + 1 ) / i;
+
+  assert( s0 == e0 );
+  assert( s1 == e1 );
+  assert( p == ep );
+  assert( f == ef );
+  assert( q == eq );
+
+  return 0;
+}
@@ -0,0 +1,63 @@
+#!/bin/bash
+#
+# Run issue_width.exe with the scalar model and with the multi-issue model
+# at issue widths 1, 2 and 4. The multi-issue model at width 1 with the table
+# costs must take exactly as many cycles as the scalar model. For each latency
+# configuration every width must retire the same number of instructions, and
+# the wider cores must not take more cycles than the narrower ones.
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [[ ! -x issue_width.exe ]]; then
+	echo "Test ISSUE_WIDTH: issue_width.exe not Found - likely build failed"
+	exit 1
+fi
+
+# run <name> <options>: sets cycles[name] and retired[name]
+declare -A cycles retired
+run() {
+	local name=$1
+	shift
+	sst --add-lib-path=../../build/src/ ../rev-model-options-config.py -- --program="issue_width.exe" \
+		--verbose=3 "$@" > issue_width.$name.log 2>&1
+	if ! grep -q "Simulation is complete" issue_width.$name.log; then
+		echo "Test ISSUE_WIDTH: $name did not complete"
+		exit 1
+	fi
+	cycles[$name]=$(grep -o "Total Cycles: [0-9]*" issue_width.$name.log | head -1 | awk '{print $3}')
+	retired[$name]=$(grep -o "Inst Retired: [0-9]*" issue_width.$name.log | head -1 | awk '{print $3}')
+	echo "$name cycles=${cycles[$name]} retired=${retired[$name]}"
+}
+
+# the multi-issue model reduces to the scalar one
+run scalar --issueWidth=1
+for lat in 0:0:0:0 1:4:4:2; do
+	for width in 1 2 4; do
+		run wide$width.$lat --wideIssue=1 --issueWidth=$width --fuLatency=$lat
+	done
+done
+if [[ ${cycles[wide1.0:0:0:0]} -ne ${cycles[scalar]} || ${retired[wide1.0:0:0:0]} -ne ${retired[scalar]} ]]; then
+	echo "Test ISSUE_WIDTH: width 1 with the multi-issue model differs from the scalar model"
+	exit 1
+fi
+
+# wider cores under the same latencies
+for lat in 0:0:0:0 1:4:4:2; do
+	prev=
+	for width in 1 2 4; do
+		name=wide$width.$lat
+		if [[ ${retired[$name]} -ne ${retired[scalar]} ]]; then
+			echo "Test ISSUE_WIDTH: $name retired ${retired[$name]} instructions, expected ${retired[scalar]}"
+			exit 1
+		fi
+		if [[ -n $prev && ${cycles[$name]} -gt ${cycles[$prev]} ]]; then
+			echo "Test ISSUE_WIDTH: $name took ${cycles[$name]} cycles, more than the ${cycles[$prev]} of $prev"
+			exit 1
+		fi
+		prev=$name
+	done
+done
+
+echo "Test ISSUE_WIDTH: Simulation is complete"
@@ -0,0 +1,38 @@
+#!/bin/bash
+#
+# Startup benchmark: large_bss.exe (12 MiB .bss, empty main) is run with
+# the ELF loader and from a snapshot of the loaded program, with the
+# internal memory model and with memHierarchy. Reports the host time of the
+# load or restore and of the whole run.
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [[ ! -x large_bss.exe ]]; then
+	echo "Test LARGE_BSS: large_bss.exe not Found - likely build failed"
+	exit 1
+fi
+
+run() {
+	local log=$1
+	shift
+	local start=$(date +%s.%N)
+	sst --add-lib-path=../../build/src/ ../rev-model-options-config.py -- --program=large_bss.exe "$@" > $log 2>&1
+	local end=$(date +%s.%N)
+	if ! grep -q "Simulation is complete" $log; then
+		echo "Test LARGE_BSS: run $log did not complete"
+		exit 1
+	fi
+	printf "%-26s %10s %10s\n" $log "$(grep -o "in [0-9.]* s" $log | head -1 | awk '{print $2}')" \
+		"$(awk -v s=$start -v e=$end 'BEGIN { printf "%.2f", e - s }')"
+}
+
+printf "%-26s %10s %10s\n" "run" "load_sec" "host_sec"
+run large_bss.revmem.log --enableMemH=0 --saveSnapshot=large_bss.snap
+run large_bss.memh.log --enableMemH=1
+run large_bss.revmem.snap.log --enableMemH=0 --loadSnapshot=large_bss.snap
+run large_bss.memh.snap.log --enableMemH=1 --loadSnapshot=large_bss.snap
+
+rm -f large_bss.snap
+echo "Test LARGE_BSS: Simulation is complete"
@@ -1,7 +1,7 @@
 /*
- * ex2.c
+ * many_core.c
  *
- * RISC-V ISA: RV64I
+ * RISC-V ISA: RV64GC
  *
  * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
  * All Rights Reserved
@@ -9,12 +9,65 @@
  *
  * See LICENSE in the top level directory for licensing details
  *
+ * Main creates a worker for every other core. The workers compute and store
+ * independently of each other, so with parallelThreads their cores are
+ * ticked in parallel.
  */
 
-#include <stdlib.h>
+#include "../../common/syscalls/syscalls.h"
+#include <stdint.h>
+
+#define assert( x )               \
+  do                              \
+    if( !( x ) ) {                \
+      asm( ".dword 0x00000000" ); \
+    }                             \
+  while( 0 )
+
+#ifndef NTHREADS
+#define NTHREADS 95
+#endif
+
+#ifndef WORK
+#define WORK 2000
+#endif
+
+#define WORDS 64
+
+volatile uint64_t results[NTHREADS];
+
+void* worker( void* arg ) {
+  uintptr_t id = (uintptr_t) arg;
+  uint64_t  buf[WORDS];
+  for( uint64_t k = 0; k < WORDS; k++ ) {
+    buf[k] = k + id;
+  }
+  uint64_t sum = 0;
+  for( uint64_t k = 0; k < WORK; k++ ) {
+    sum += buf[k % WORDS] * k;
+  }
+  results[id] = sum;
+  return 0;
+}
 
 int main( int argc, char** argv ) {
-  int i = 9;
-  i     = i + argc;
-  return i;
+  rev_pthread_t tids[NTHREADS];
+  for( uintptr_t i = 0; i < NTHREADS; i++ ) {
+    rev_pthread_create( &tids[i], NULL, (void*) worker, (void*) i );
+  }
+  for( int i = 0; i < NTHREADS; i++ ) {
+    rev_pthread_join( tids[i] );
+  }
+
+  for( uint64_t i = 0; i < NTHREADS; i++ ) {
+    uint64_t sum = 0;
+    for( uint64_t k = 0; k < WORK; k++ ) {
+      sum += ( k % WORDS + i ) * k;
+    }
+    assert( results[i] == sum );
+  }
+
+  const char msg[20] = "All workers joined\n";
+  rev_write( STDOUT_FILENO, msg, sizeof( msg ) );
+  return 0;
 }
@@ -8,9 +8,24 @@
 # rev-test-ex1.py
 #
 
+import argparse
 import os
 import sst
 
+# Setup argument parser
+parser = argparse.ArgumentParser(description="Run the many core test")
+parser.add_argument(
+    "--parallelThreads", type=int, help="Host threads ticking the cores", default=1
+)
+parser.add_argument(
+    "--parallelValidate",
+    type=int,
+    choices=[0, 1],
+    help="Report accesses whose parallel order could differ from the sequential one",
+    default=0,
+)
+args = parser.parse_args()
+
 # Define SST core options
 sst.setProgramOption("timebase", "1ps")
 
@@ -28,12 +43,16 @@ comp_cpu.addParams({
         "memSize": 1024*1024*1024,                         # Memory size in bytes
         "machine": "[CORES:RV64GC]",                       # Core:Config; RV64I for core 0
         "startAddr": "[0:0x00000000]",                     # Starting address for core 0
-        "memCost": "[0:1:10]",                             # Memory loads required 1-10 cycles
+        "memCost": "[CORES:1:10]",                         # Memory loads required 1-10 cycles
         "program": os.getenv("REV_EXE", "many_core.exe"),  # Target executable
+        "parallelThreads": args.parallelThreads,           # Host threads ticking the cores
+        "parallelValidate": args.parallelValidate,         # Check the parallel order
         "splash": 1                                        # Display the splash message
 })
 
+# only the conflict count is checked; the per core and per ECALL statistics
+# of 96 cores would write tens of thousands of rows
 sst.setStatisticOutput("sst.statOutputCSV")
-sst.enableAllStatisticsForAllComponents()
+comp_cpu.enableStatistics(["ParallelConflicts"])
 
 # EOF
@@ -1,12 +1,67 @@
 #!/bin/bash
+#
+# Run many_core.exe sequentially, on a thread pool and validated against the
+# sequential order. Every run must report the same cycles and retired
+# instructions summed over the cores, and the validated run must not find an
+# isolated core tick whose order could differ from the sequential one.
 
 #Build the test
 make clean && make
 
 # Check that the exec was built...
-if [[ -x many_core.exe ]]; then
-	sst --add-lib-path=../../build/src/ ./rev-many-core.py
-else
+if [[ ! -x many_core.exe ]]; then
 	echo "Test MANY_CORE: many_core.exe not Found - likely build failed"
 	exit 1
 fi
+
+# at least a few pool threads, so that the parallel order is exercised on small hosts too
+threads=$(nproc)
+if [[ $threads -lt 4 ]]; then
+	threads=4
+fi
+
+for opts in "" "--parallelThreads=$threads" "--parallelValidate=1"; do
+	rm -f StatisticOutput.csv
+	start=$(date +%s.%N)
+	sst --add-lib-path=../../build/src/ ./rev-many-core.py -- $opts > many_core.log 2>&1
+	rc=$?
+	end=$(date +%s.%N)
+	if [[ $rc -ne 0 ]]; then
+		# the pass pattern must only come from the last line of this script
+		grep -v "Simulation is complete" many_core.log
+		echo "Test MANY_CORE: sst exited with status $rc with options '$opts'"
+		exit 1
+	fi
+	if ! grep -q "All workers joined" many_core.log; then
+		echo "Test MANY_CORE: workers did not complete with options '$opts'"
+		exit 1
+	fi
+
+	# totals over every core
+	cycles=$(grep -o "Total Cycles: [0-9]*" many_core.log | awk '{ n += $3 } END { print n + 0 }')
+	retired=$(grep -o "Inst Retired: [0-9]*" many_core.log | awk '{ n += $3 } END { print n + 0 }')
+	echo "Test MANY_CORE: options '$opts' took $(awk "BEGIN { print $end - $start }") s, cycles=$cycles retired=$retired"
+	if [[ -z $base_cycles ]]; then
+		base_cycles=$cycles
+		base_retired=$retired
+	elif [[ $cycles -ne $base_cycles || $retired -ne $base_retired ]]; then
+		echo "Test MANY_CORE: options '$opts' differ from the sequential cycles=$base_cycles retired=$base_retired"
+		exit 1
+	fi
+
+	if [[ $opts == --parallelValidate=1 ]]; then
+		if [[ ! -f StatisticOutput.csv ]]; then
+			echo "Test MANY_CORE: no statistics written with options '$opts'"
+			exit 1
+		fi
+		conflicts=$(awk -F', *' 'NR == 1 { for( i = 1; i <= NF; i++ ) col[$i] = i; next }
+			$col["StatisticName"] == "ParallelConflicts" { n += $col["Sum.u64"] } END { print n + 0 }' StatisticOutput.csv)
+		if [[ $conflicts -ne 0 ]] || grep -q "Warning: cycle" many_core.log; then
+			grep "Warning: cycle" many_core.log
+			echo "Test MANY_CORE: $conflicts core ticks could differ from the sequential order"
+			exit 1
+		fi
+	fi
+done
+
+echo "Test MANY_CORE: Simulation is complete"
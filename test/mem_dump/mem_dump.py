@@ -45,6 +45,12 @@ parser.add_argument(
 parser.add_argument(
     "--startSymbol", help="ELF Symbol Rev should begin execution at", default="[0:main]"
 )
+parser.add_argument(
+    "--memDumpFormat",
+    choices=["text", "binary"],
+    help="Format of the memory dump files",
+    default="text",
+)
 
 # Parse arguments
 args = parser.parse_args()
@@ -74,6 +80,7 @@ comp_cpu.addParams(
         "args": args.args,
         "splash": 1,
         "memDumpRanges": ["range1", "range2"],
+        "memDumpFormat": args.memDumpFormat,
         "range1.startAddr": 0x010000,
         "range1.size": 0x100000,
         "range2.startAddr": 0x090000,
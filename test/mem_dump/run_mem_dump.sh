@@ -5,7 +5,20 @@ make clean && make
 
 # Check that the exec was built...
 if [[ -x basic.exe ]]; then
-	sst --add-lib-path=../../build/src/ ./mem_dump.py
+	sst --add-lib-path=../../build/src/ ./mem_dump.py || exit 1
+
+	# The binary dumps must convert back to the text dumps
+	for f in range1.dump.init range1.dump.final range2.dump.init range2.dump.final; do
+		mv $f $f.txt || exit 1
+	done
+	sst --add-lib-path=../../build/src/ ./mem_dump.py -- --memDumpFormat=binary || exit 1
+	for f in range1.dump.init range1.dump.final range2.dump.init range2.dump.final; do
+		python3 ../../scripts/rev-dump-convert.py $f -o $f.conv || exit 1
+		if ! cmp -s $f.conv $f.txt; then
+			echo "Test mem_dump: $f does not convert to the text dump"
+			exit 1
+		fi
+	done
 else
 	echo "Test mem_dump (python config options - not syscall version): basic.exe not Found - likely build failed"
 	exit 1
@@ -30,6 +30,16 @@ parser.add_argument("--args", help="Command line arguments to pass to the target
 parser.add_argument("--startSymbol", help="ELF Symbol Rev should begin execution at", default="[0:main]")
 parser.add_argument("--trcStartCycle", help="Starting cycle for rev tracer [default: 0 (off)]")
 parser.add_argument("--trcLimit", help="Max trace records per core [default: 0 (no limit)]", default=0)
+parser.add_argument("--issueWidth", help="Instructions issued per cycle by core 0", default=1)
+parser.add_argument("--fuLatency", help="ALU:MULDIV:FPU:LSU latencies of core 0 (0 uses the table cost)", default="0:0:0:0")
+parser.add_argument("--wideIssue", type=int, choices=[0, 1], help="Use the multi-issue model at issueWidth 1", default=0)
+parser.add_argument("--quantum", help="Cycles a thread runs before it may be preempted [default: 0 (off)]", default=0)
+parser.add_argument("--coreAffinity", type=int, choices=[0, 1], help="Queue threads on their creating or last core", default=1)
+parser.add_argument("--workStealing", type=int, choices=[0, 1], help="Idle cores steal threads queued on other cores", default=1)
+parser.add_argument("--saveSnapshot", help="Save the loaded program state to this file", default="")
+parser.add_argument("--loadSnapshot", help="Start from a saved snapshot or checkpoint instead of loading the program", default="")
+parser.add_argument("--checkpoint", help="Checkpoint file prefix", default="checkpoint")
+parser.add_argument("--checkpointPeriod", help="Cycles between checkpoints [default: 0 (off)]", default=0)
 parser.add_argument("--statDir", help="Location for statistics files", default=".")
 
 # Parse arguments
@@ -60,6 +70,16 @@ comp_cpu.addParams({
     "args": args.args,
     "trcStartCycle": args.trcStartCycle,
     "trcLimit": args.trcLimit,
+    "issueWidth": f"[0:{args.issueWidth}]",
+    "fuLatency": f"[0:{args.fuLatency}]",
+    "wideIssue": args.wideIssue,
+    "quantum": args.quantum,
+    "coreAffinity": args.coreAffinity,
+    "workStealing": args.workStealing,
+    "saveSnapshot": args.saveSnapshot,
+    "loadSnapshot": args.loadSnapshot,
+    "checkpoint": args.checkpoint,
+    "checkpointPeriod": args.checkpointPeriod,
     "splash": 1
 })
 
@@ -0,0 +1,116 @@
+/*
+ * file_io_bench.c
+ *
+ * RISC-V ISA: RV64IMAFDC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * Reads bench.dat (FILE_SIZE bytes, created by run_file_io_bench.sh) with
+ * read, pread64, readv and preadv, checks that every path returns the same
+ * data and the right short counts, then writes it back out with write,
+ * pwrite64, writev and pwritev to /dev/null.
+ */
+
+#include "../../../common/syscalls/syscalls.h"
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#define FILE_SIZE  ( 1024 * 1024 )
+#define READ_CHUNK ( 64 * 1024 )
+
+#define assert( x )               \
+  do                              \
+    if( !( x ) ) {                \
+      asm( ".dword 0x00000000" ); \
+    }                             \
+  while( 0 )
+
+static uint64_t data[FILE_SIZE / 8];
+
+static uint64_t checksum( void ) {
+  uint64_t sum = 0;
+  for( unsigned i = 0; i < FILE_SIZE / 8; i++ )
+    sum = ( sum ^ data[i] ) * 0x100000001b3ULL;
+  return sum;
+}
+
+static void clear( void ) {
+  for( unsigned i = 0; i < FILE_SIZE / 8; i++ )
+    data[i] = 0;
+}
+
+static void msg( const char* s ) {
+  size_t n = 0;
+  while( s[n] )
+    n++;
+  rev_write( STDOUT_FILENO, s, n );
+}
+
+int main() {
+  char* buf = (char*) data;
+  int   fd  = rev_openat( AT_FDCWD, "bench.dat", 0, O_RDONLY );
+  assert( fd >= 0 );
+
+  // read: sequential chunks, then 0 at end of file
+  ssize_t total = 0;
+  ssize_t rc;
+  while( ( rc = rev_read( fd, buf + total, READ_CHUNK ) ) > 0 )
+    total += rc;
+  assert( rc == 0 );
+  assert( total == FILE_SIZE );
+  uint64_t sum = checksum();
+
+  // lseek: file position and size
+  assert( rev_lseek( fd, 0, SEEK_CUR ) == FILE_SIZE );
+  assert( rev_lseek( fd, 0, SEEK_END ) == FILE_SIZE );
+  assert( rev_lseek( fd, 0, SEEK_SET ) == 0 );
+
+  // pread64: the whole file in one call, without moving the file position
+  clear();
+  assert( rev_pread64( fd, buf, FILE_SIZE, 0 ) == FILE_SIZE );
+  assert( checksum() == sum );
+  assert( rev_lseek( fd, 0, SEEK_CUR ) == 0 );
+
+  // short reads past the end of the file
+  assert( rev_pread64( fd, buf, 4096, FILE_SIZE - 100 ) == 100 );
+  assert( rev_pread64( fd, buf, 4096, FILE_SIZE ) == 0 );
+
+  // readv: uneven segments that straddle page boundaries
+  clear();
+  struct iovec iov[4] = {
+    { buf, 100 },
+    { buf + 100, 4000 },
+    { buf + 4100, FILE_SIZE / 2 },
+    { buf + 4100 + FILE_SIZE / 2, FILE_SIZE / 2 - 4100 },
+  };
+  assert( rev_readv( fd, iov, 4 ) == FILE_SIZE );
+  assert( checksum() == sum );
+
+  // preadv: the same segments at offset 0, then a short one at the end
+  clear();
+  assert( rev_preadv( fd, iov, 4, 0, 0 ) == FILE_SIZE );
+  assert( checksum() == sum );
+  assert( rev_preadv( fd, iov, 4, FILE_SIZE - 200, 0 ) == 200 );
+  rev_close( fd );
+
+  // write paths
+  int null = rev_openat( AT_FDCWD, "/dev/null", 0, O_WRONLY );
+  assert( null >= 0 );
+  assert( rev_write( null, buf, FILE_SIZE ) == FILE_SIZE );
+  assert( rev_pwrite64( null, buf, FILE_SIZE, 0 ) == FILE_SIZE );
+  assert( rev_writev( null, iov, 4 ) == FILE_SIZE );
+  assert( rev_pwritev( null, iov, 4, 0, 0 ) == FILE_SIZE );
+  rev_close( null );
+
+  // bad descriptors are reported, not fatal
+  assert( rev_pread64( 1000, buf, 16, 0 ) < 0 );
+
+  msg( "file_io_bench: all transfers verified\n" );
+  return 0;
+}
@@ -0,0 +1,47 @@
+#!/bin/bash
+#
+# File I/O throughput benchmark: the guest moves a 1 MiB file through
+# read, pread64, readv, preadv and the matching write calls (about 10 MiB
+# in total) with the internal memory model and with memHierarchy. Reports
+# the simulated and host time and the host-side throughput of every run.
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [[ ! -x file_io_bench.exe ]]; then
+	echo "Test FILE_IO_BENCH: file_io_bench.exe not Found - likely build failed"
+	exit 1
+fi
+
+# input file read by the guest
+head -c 1048576 /dev/urandom > bench.dat
+
+# simulated time of a log in ns
+simtime() {
+	grep -o "simulated time: [0-9.]* [a-z]*" "$1" | awk '{
+		scale["ps"] = 1e-3; scale["ns"] = 1; scale["us"] = 1e3; scale["ms"] = 1e6; scale["s"] = 1e9
+		printf "%.0f\n", $3 * scale[$4]
+	}'
+}
+
+printf "%-8s %14s %10s %10s\n" "memory" "sim_ns" "host_sec" "MiB/s"
+for memh in 0 1; do
+	model=revmem
+	[[ $memh == 1 ]] && model=memh
+	log=file_io_bench.$model.log
+	start=$(date +%s.%N)
+	sst --add-lib-path=../../../build/src/ ../../rev-model-options-config.py -- --program=file_io_bench.exe \
+		--enableMemH=$memh > $log 2>&1
+	end=$(date +%s.%N)
+	if ! grep -q "all transfers verified" $log || ! grep -q "Simulation is complete" $log; then
+		echo "Test FILE_IO_BENCH: run with $model did not complete"
+		exit 1
+	fi
+	printf "%-8s %14s %10s %10s\n" $model "$(simtime $log)" \
+		"$(awk -v s=$start -v e=$end 'BEGIN { printf "%.2f", e - s }')" \
+		"$(awk -v s=$start -v e=$end 'BEGIN { printf "%.1f", 10 / ( e - s ) }')"
+done
+
+rm -f bench.dat
+echo "Test FILE_IO_BENCH: Simulation is complete"
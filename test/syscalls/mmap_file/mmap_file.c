@@ -0,0 +1,102 @@
+/*
+ * mmap_file.c
+ *
+ * RISC-V ISA: RV64IMAFDC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * Maps data.txt ("00000\n" .. "99999\n", created by run_mmap_file.sh)
+ * private and shared: checks the contents, the file offset, the zeroed
+ * tail past the end of the file, that private stores stay private and
+ * that shared stores reach the file on msync and munmap.
+ */
+
+#include "../../../common/syscalls/syscalls.h"
+#include <fcntl.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#define LINES     100000
+#define FILE_SIZE ( LINES * 6 )
+
+#define assert( x )               \
+  do                              \
+    if( !( x ) ) {                \
+      asm( ".dword 0x00000000" ); \
+    }                             \
+  while( 0 )
+
+// byte of data.txt at offset off
+static char expected( uint64_t off ) {
+  uint64_t line = off / 6, col = off % 6;
+  if( col == 5 )
+    return '\n';
+  for( uint64_t i = col; i < 4; i++ )
+    line /= 10;
+  return '0' + line % 10;
+}
+
+static void msg( const char* s ) {
+  size_t n = 0;
+  while( s[n] )
+    n++;
+  rev_write( STDOUT_FILENO, s, n );
+}
+
+int main() {
+  char buf[8];
+  int  fd = rev_openat( AT_FDCWD, "data.txt", 0, O_RDWR );
+  assert( fd >= 0 );
+
+  // private mapping of the whole file
+  char* p = (char*) rev_mmap( 0, FILE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+  assert( (int64_t) p > 0 );
+  for( uint64_t off = 0; off < FILE_SIZE; off += 7 )
+    assert( p[off] == expected( off ) );
+
+  // private stores are not written to the file
+  p[0] = 'X';
+  assert( rev_pread64( fd, buf, 1, 0 ) == 1 && buf[0] == '0' );
+  assert( rev_munmap( (uint64_t) p, FILE_SIZE ) == 0 );
+
+  // a mapping at a page offset of the file
+  p = (char*) rev_mmap( 0, 8192, PROT_READ, MAP_PRIVATE, fd, 4096 );
+  assert( (int64_t) p > 0 );
+  for( uint64_t off = 0; off < 8192; off++ )
+    assert( p[off] == expected( 4096 + off ) );
+  assert( rev_munmap( (uint64_t) p, 8192 ) == 0 );
+
+  // the rest of the last page past the end of the file reads as zero
+  uint64_t len = ( FILE_SIZE + 4095 ) / 4096 * 4096;
+  p            = (char*) rev_mmap( 0, len, PROT_READ, MAP_PRIVATE, fd, 0 );
+  assert( (int64_t) p > 0 );
+  assert( p[FILE_SIZE - 1] == '\n' );
+  for( uint64_t off = FILE_SIZE; off < len; off++ )
+    assert( p[off] == 0 );
+  assert( rev_munmap( (uint64_t) p, len ) == 0 );
+
+  // shared stores reach the file on msync and on munmap
+  char* q = (char*) rev_mmap( 0, FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+  assert( (int64_t) q > 0 );
+  for( int i = 0; i < 5; i++ )
+    q[5 * 6 + i] = 'A' + i;
+  assert( rev_msync( (uint64_t) q, 4096, MS_SYNC ) == 0 );
+  assert( rev_pread64( fd, buf, 5, 5 * 6 ) == 5 );
+  for( int i = 0; i < 5; i++ )
+    assert( buf[i] == 'A' + i );
+
+  for( int i = 0; i < 5; i++ )
+    q[FILE_SIZE - 6 + i] = 'Z';
+  assert( rev_munmap( (uint64_t) q, FILE_SIZE ) == 0 );
+  assert( rev_pread64( fd, buf, 5, FILE_SIZE - 6 ) == 5 );
+  for( int i = 0; i < 5; i++ )
+    assert( buf[i] == 'Z' );
+
+  rev_close( fd );
+  msg( "mmap_file: all mappings verified\n" );
+  return 0;
+}
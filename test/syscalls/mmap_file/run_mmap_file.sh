@@ -0,0 +1,33 @@
+#!/bin/bash
+#
+# File-backed mmap: the guest maps data.txt private and shared with the
+# internal memory model (host mapping of the file) and with memHierarchy
+# (contents copied in, shared stores written back). The shared stores must
+# end up in the host file.
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [[ ! -x mmap_file.exe ]]; then
+	echo "Test MMAP_FILE: mmap_file.exe not Found - likely build failed"
+	exit 1
+fi
+
+for memh in 0 1; do
+	seq -w 0 99999 > data.txt
+	log=mmap_file.memh$memh.log
+	sst --add-lib-path=../../../build/src/ ../../rev-model-options-config.py -- --program=mmap_file.exe \
+		--enableMemH=$memh > $log 2>&1
+	if ! grep -q "all mappings verified" $log || ! grep -q "Simulation is complete" $log; then
+		echo "Test MMAP_FILE: run with enableMemH=$memh did not complete"
+		exit 1
+	fi
+	if [[ "$(sed -n 6p data.txt)" != "ABCDE" || "$(tail -n 1 data.txt)" != "ZZZZZ" ]]; then
+		echo "Test MMAP_FILE: shared stores with enableMemH=$memh did not reach data.txt"
+		exit 1
+	fi
+done
+
+rm -f data.txt
+echo "Test MMAP_FILE: Simulation is complete"
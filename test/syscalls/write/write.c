@@ -16,12 +16,22 @@ int main() {
     rev_exit( 1 );
   }
 
-  //The test below fails - we are reaching into invalid address space, this appears unrealted to most recent changes
-  /*  const char msg3[98] = "Greetings - this is a much longer message and some nice text, in fact, it is bigger than 64 bytes\n";
-  ssize_t bytes_written3 = rev_write(STDOUT_FILENO, msg3, sizeof(msg3));
+  const char msg3[98]       = "Greetings - this is a much longer message and some nice text, in fact, it is bigger than 64 bytes\n";
+  ssize_t    bytes_written3 = rev_write( STDOUT_FILENO, msg3, sizeof( msg3 ) );
+
+  if( bytes_written3 != sizeof( msg3 ) ) {
+    rev_exit( 1 );
+  }
+
+  // a buffer larger than a page, written in one call
+  static char big[5000];
+  for( int i = 0; i < (int) sizeof( big ); i++ )
+    big[i] = ( i % 50 == 49 ) ? '\n' : 'a' + ( i / 50 ) % 26;
+  ssize_t bytes_written4 = rev_write( STDOUT_FILENO, big, sizeof( big ) );
+
+  if( bytes_written4 != sizeof( big ) ) {
+    rev_exit( 1 );
+  }
 
-  if( bytes_written3 < 0 ){
-    rev_exit(1);
-  }*/
   return 0;
 }
@@ -0,0 +1,52 @@
+/*
+ * futex_timeout.c
+ *
+ * A worker waits on a futex with a long timeout and main wakes it right
+ * away. The early wake must drop the deadline of the wait, so the program
+ * ends long before the timeout would have expired.
+ */
+#include "../../../../common/syscalls/syscalls.h"
+#include <stdint.h>
+
+#define assert( x )               \
+  do                              \
+    if( !( x ) ) {                \
+      asm( ".dword 0x00000000" ); \
+    }                             \
+  while( 0 )
+
+// struct __kernel_timespec
+struct kernel_timespec {
+  int64_t tv_sec;
+  int64_t tv_nsec;
+};
+
+volatile uint32_t word   = 0;
+volatile int      result = 1;
+volatile int      done   = 0;
+
+void* worker( void* arg ) {
+  // 100 simulated seconds; the wake arrives within a few thousand cycles
+  struct kernel_timespec timeout = { 100, 0 };
+  result = rev_futex( (uint32_t*) &word, FUTEX_WAIT_PRIVATE, 0, (struct timespec*) &timeout, NULL, 0 );
+  done   = 1;
+  return 0;
+}
+
+int main( int argc, char** argv ) {
+  rev_pthread_t tid;
+  rev_pthread_create( &tid, NULL, (void*) worker, NULL );
+
+  // wake the worker once it waits
+  int woken = 0;
+  while( !woken && !done )
+    woken = rev_futex( (uint32_t*) &word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0 );
+  rev_pthread_join( tid );
+
+  assert( woken == 1 );
+  assert( result == 0 );
+
+  const char msg[] = "Timed wait woken\n";
+  rev_write( STDOUT_FILENO, msg, sizeof( msg ) - 1 );
+  return 0;
+}
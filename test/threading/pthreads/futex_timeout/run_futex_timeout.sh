@@ -0,0 +1,43 @@
+#!/bin/bash
+#
+# Run futex_timeout.exe: a timed futex wait is woken long before its
+# deadline, so the run must end promptly instead of idling until the
+# deadline of the wait.
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [[ ! -x futex_timeout.exe ]]; then
+	echo "Test FUTEX_TIMEOUT: futex_timeout.exe not Found - likely build failed"
+	exit 1
+fi
+
+# simulated time of a log in ns
+simtime() {
+	grep -o "simulated time: [0-9.]* [a-z]*" "$1" | awk '{
+		scale["ps"] = 1e-3; scale["ns"] = 1; scale["us"] = 1e3; scale["ms"] = 1e6; scale["s"] = 1e9
+		printf "%.0f\n", $3 * scale[$4]
+	}'
+}
+
+for config in "1 1" "1 2"; do
+	read -r cores harts <<<"$config"
+	log=futex_timeout.${cores}c.${harts}h.log
+	sst --add-lib-path=../../../../build/src/ ../../../rev-model-options-config.py -- --program="futex_timeout.exe" \
+		--numCores=$cores --numHarts=$harts > $log 2>&1
+	if ! grep -q "Timed wait woken" $log || ! grep -q "Simulation is complete" $log; then
+		echo "Test FUTEX_TIMEOUT: $cores core(s) with $harts hart(s) did not complete"
+		exit 1
+	fi
+
+	# the deadline of the wait is 100 simulated seconds away
+	ns=$(simtime $log)
+	echo "numCores=$cores numHarts=$harts sim_ns=$ns"
+	if [[ -z $ns || $ns -ge 1000000000 ]]; then
+		echo "Test FUTEX_TIMEOUT: $cores core(s) with $harts hart(s) ran ${ns} ns; the woken wait kept its deadline"
+		exit 1
+	fi
+done
+
+echo "Test FUTEX_TIMEOUT: Simulation is complete"
@@ -0,0 +1,57 @@
+/*
+ * pthread_imbalance.c
+ *
+ * Load balancing benchmark: main creates NTHREADS workers whose work grows
+ * linearly with their index, then joins them. All workers are created on
+ * the core running main, so without migration they queue behind each other.
+ */
+#include "../../../../common/syscalls/syscalls.h"
+#include <stdint.h>
+
+#define assert( x )               \
+  do                              \
+    if( !( x ) ) {                \
+      asm( ".dword 0x00000000" ); \
+    }                             \
+  while( 0 )
+
+#ifndef NTHREADS
+#define NTHREADS 8
+#endif
+
+#ifndef WORK
+#define WORK 400
+#endif
+
+volatile uint64_t results[NTHREADS];
+
+void* worker( void* arg ) {
+  uintptr_t id  = (uintptr_t) arg;
+  uint64_t  n   = ( id + 1 ) * WORK;
+  uint64_t  sum = 0;
+  for( uint64_t k = 0; k < n; k++ ) {
+    sum += k * k;
+  }
+  results[id] = sum;
+  return 0;
+}
+
+int main( int argc, char** argv ) {
+  rev_pthread_t tids[NTHREADS];
+  for( uintptr_t i = 0; i < NTHREADS; i++ ) {
+    rev_pthread_create( &tids[i], NULL, (void*) worker, (void*) i );
+  }
+  for( int i = 0; i < NTHREADS; i++ ) {
+    rev_pthread_join( tids[i] );
+  }
+
+  // sum of k^2 for k < n is (n - 1) n (2n - 1) / 6
+  for( uint64_t i = 0; i < NTHREADS; i++ ) {
+    uint64_t n = ( i + 1 ) * WORK;
+    assert( results[i] == ( n - 1 ) * n * ( 2 * n - 1 ) / 6 );
+  }
+
+  const char msg[20] = "All workers joined\n";
+  rev_write( STDOUT_FILENO, msg, sizeof( msg ) );
+  return 0;
+}
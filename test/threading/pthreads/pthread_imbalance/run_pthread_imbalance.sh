@@ -0,0 +1,47 @@
+#!/bin/bash
+#
+# Run pthread_imbalance.exe on 4 cores with 2 harts each under three
+# scheduling configurations and report the simulated time of each:
+#   shared    one shared ready queue (coreAffinity=0)
+#   affinity  threads stay on their creating core (workStealing=0)
+#   stealing  idle cores steal threads from busy cores (default)
+# Work stealing must not be slower than pure affinity.
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [[ ! -x pthread_imbalance.exe ]]; then
+	echo "Test PTHREAD_IMBALANCE: pthread_imbalance.exe not Found - likely build failed"
+	exit 1
+fi
+
+# simulated time of a log in ns
+simtime() {
+	grep -o "simulated time: [0-9.]* [a-z]*" "$1" | awk '{
+		scale["ps"] = 1e-3; scale["ns"] = 1; scale["us"] = 1e3; scale["ms"] = 1e6; scale["s"] = 1e9
+		printf "%.0f\n", $3 * scale[$4]
+	}'
+}
+
+declare -A ns
+for config in "shared 0 0" "affinity 1 0" "stealing 1 1"; do
+	read -r name affinity stealing <<<"$config"
+	log=pthread_imbalance.$name.log
+	sst --add-lib-path=../../../../build/src/ ../../../rev-model-options-config.py -- --program="pthread_imbalance.exe" \
+		--numCores=4 --numHarts=2 --coreAffinity=$affinity --workStealing=$stealing > $log 2>&1
+	if ! grep -q "All workers joined" $log || ! grep -q "Simulation is complete" $log; then
+		echo "Test PTHREAD_IMBALANCE: $name scheduling did not complete"
+		exit 1
+	fi
+	ns[$name]=$(simtime $log)
+	stolen=$(awk -F', *' '$2 == "ThreadsStolen" { s += $7 } END { print s + 0 }' StatisticOutput.csv)
+	echo "$name: simulated time ${ns[$name]} ns, threads stolen $stolen"
+done
+
+if [[ ${ns[stealing]} -gt ${ns[affinity]} ]]; then
+	echo "Test PTHREAD_IMBALANCE: work stealing (${ns[stealing]} ns) is slower than affinity (${ns[affinity]} ns)"
+	exit 1
+fi
+
+echo "Test PTHREAD_IMBALANCE: Simulation is complete"
@@ -0,0 +1,87 @@
+/*
+ * pthread_mutex.c
+ *
+ * Mutex contention benchmark: NTHREADS workers increment a shared counter
+ * under one lock. With USE_FUTEX=1 contended waiters sleep in FUTEX_WAIT
+ * and give up their hart; with USE_FUTEX=0 they spin on the lock word.
+ */
+#include "../../../../common/syscalls/syscalls.h"
+#include <stdint.h>
+
+#define assert( x )               \
+  do                              \
+    if( !( x ) ) {                \
+      asm( ".dword 0x00000000" ); \
+    }                             \
+  while( 0 )
+
+#ifndef USE_FUTEX
+#define USE_FUTEX 1
+#endif
+
+#ifndef NTHREADS
+#define NTHREADS 4
+#endif
+
+#ifndef ITERS
+#define ITERS 64
+#endif
+
+// lock word: 0 unlocked, 1 locked, 2 locked with waiters
+volatile uint32_t lock_word = 0;
+volatile uint64_t counter   = 0;
+
+static void mutex_lock( volatile uint32_t* m ) {
+  uint32_t c = 0;
+  if( __atomic_compare_exchange_n( m, &c, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+    return;
+  if( c != 2 )
+    c = __atomic_exchange_n( m, 2, __ATOMIC_ACQUIRE );
+  while( c != 0 ) {
+#if USE_FUTEX
+    rev_futex( (uint32_t*) m, FUTEX_WAIT_PRIVATE, 2, NULL, NULL, 0 );
+#else
+    while( __atomic_load_n( m, __ATOMIC_RELAXED ) != 0 )
+      ;
+#endif
+    c = __atomic_exchange_n( m, 2, __ATOMIC_ACQUIRE );
+  }
+}
+
+static void mutex_unlock( volatile uint32_t* m ) {
+  if( __atomic_fetch_sub( m, 1, __ATOMIC_RELEASE ) != 1 ) {
+    __atomic_store_n( m, 0, __ATOMIC_RELEASE );
+#if USE_FUTEX
+    rev_futex( (uint32_t*) m, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0 );
+#endif
+  }
+}
+
+void* worker( void* arg ) {
+  for( int i = 0; i < ITERS; i++ ) {
+    mutex_lock( &lock_word );
+    // a critical section long enough for the other threads to contend
+    uint64_t v = counter;
+    for( volatile int k = 0; k < 32; k++ )
+      ;
+    counter = v + 1;
+    mutex_unlock( &lock_word );
+  }
+  return 0;
+}
+
+int main( int argc, char** argv ) {
+  rev_pthread_t tids[NTHREADS];
+  for( uintptr_t i = 0; i < NTHREADS; i++ ) {
+    rev_pthread_create( &tids[i], NULL, (void*) worker, (void*) i );
+  }
+  for( int i = 0; i < NTHREADS; i++ ) {
+    rev_pthread_join( tids[i] );
+  }
+  assert( counter == NTHREADS * ITERS );
+  assert( lock_word == 0 );
+
+  const char msg[20] = "All workers joined\n";
+  rev_write( STDOUT_FILENO, msg, sizeof( msg ) );
+  return 0;
+}
@@ -0,0 +1,47 @@
+#!/bin/bash
+#
+# Run the mutex contention benchmark with futex waits and with spinning
+# waiters on one core with 2 harts (4 workers, time-sliced) and on 2 cores
+# with 2 harts each. Reports the simulated and host time of every run;
+# each run must complete with the correct count.
+
+#Build the test
+make clean && make
+
+# Check that the execs were built...
+for exe in pthread_mutex.exe pthread_mutex_spin.exe; do
+	if [[ ! -x $exe ]]; then
+		echo "Test PTHREAD_MUTEX: $exe not Found - likely build failed"
+		exit 1
+	fi
+done
+
+# simulated time of a log in ns
+simtime() {
+	grep -o "simulated time: [0-9.]* [a-z]*" "$1" | awk '{
+		scale["ps"] = 1e-3; scale["ns"] = 1; scale["us"] = 1e3; scale["ms"] = 1e6; scale["s"] = 1e9
+		printf "%.0f\n", $3 * scale[$4]
+	}'
+}
+
+printf "%-8s %-6s %-6s %14s %10s\n" "waiters" "cores" "harts" "sim_ns" "host_sec"
+for config in "1 2" "2 2"; do
+	read -r cores harts <<<"$config"
+	for variant in futex spin; do
+		exe=pthread_mutex.exe
+		[[ $variant == spin ]] && exe=pthread_mutex_spin.exe
+		log=pthread_mutex.$variant.${cores}c.${harts}h.log
+		start=$(date +%s.%N)
+		sst --add-lib-path=../../../../build/src/ ../../../rev-model-options-config.py -- --program="$exe" \
+			--numCores=$cores --numHarts=$harts --quantum=2000 > $log 2>&1
+		end=$(date +%s.%N)
+		if ! grep -q "All workers joined" $log || ! grep -q "Simulation is complete" $log; then
+			echo "Test PTHREAD_MUTEX: $variant waiters on $cores core(s) with $harts hart(s) did not complete"
+			exit 1
+		fi
+		printf "%-8s %-6s %-6s %14s %10s\n" $variant $cores $harts "$(simtime $log)" \
+			"$(awk -v s=$start -v e=$end 'BEGIN { printf "%.2f", e - s }')"
+	done
+done
+
+echo "Test PTHREAD_MUTEX: Simulation is complete"
@@ -0,0 +1,44 @@
+/*
+ * pthread_preempt.c
+ *
+ * Every worker spins until all workers have started. With more workers than
+ * harts this only completes when the scheduler preempts spinning threads.
+ */
+#include "../../../../common/syscalls/syscalls.h"
+#include <stdint.h>
+
+#define assert( x )               \
+  do                              \
+    if( !( x ) ) {                \
+      asm( ".dword 0x00000000" ); \
+    }                             \
+  while( 0 )
+
+#define NTHREADS 6
+
+volatile int      arrived = 0;
+volatile uint64_t spins[NTHREADS];
+
+void* worker( void* arg ) {
+  uintptr_t id = (uintptr_t) arg;
+  __atomic_fetch_add( &arrived, 1, __ATOMIC_SEQ_CST );
+  while( __atomic_load_n( &arrived, __ATOMIC_SEQ_CST ) < NTHREADS ) {
+    spins[id]++;
+  }
+  return 0;
+}
+
+int main( int argc, char** argv ) {
+  rev_pthread_t tids[NTHREADS];
+  for( uintptr_t i = 0; i < NTHREADS; i++ ) {
+    rev_pthread_create( &tids[i], NULL, (void*) worker, (void*) i );
+  }
+  for( int i = 0; i < NTHREADS; i++ ) {
+    rev_pthread_join( tids[i] );
+  }
+  assert( arrived == NTHREADS );
+
+  const char msg[20] = "All workers joined\n";
+  rev_write( STDOUT_FILENO, msg, sizeof( msg ) );
+  return 0;
+}
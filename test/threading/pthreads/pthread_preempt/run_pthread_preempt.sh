@@ -0,0 +1,33 @@
+#!/bin/bash
+#
+# Run pthread_preempt.exe with more spinning threads than harts. The program
+# can only finish if the scheduler time-slices the threads, so every
+# configuration must complete and record context switches.
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [[ ! -x pthread_preempt.exe ]]; then
+	echo "Test PTHREAD_PREEMPT: pthread_preempt.exe not Found - likely build failed"
+	exit 1
+fi
+
+for config in "1 1" "1 2" "2 1" "2 2"; do
+	read -r cores harts <<<"$config"
+	log=pthread_preempt.${cores}c.${harts}h.log
+	sst --add-lib-path=../../../../build/src/ ../../../rev-model-options-config.py -- --program="pthread_preempt.exe" \
+		--numCores=$cores --numHarts=$harts --quantum=2000 --verbose=3 > $log 2>&1
+	if ! grep -q "All workers joined" $log || ! grep -q "Simulation is complete" $log; then
+		echo "Test PTHREAD_PREEMPT: $cores core(s) with $harts hart(s) did not complete"
+		exit 1
+	fi
+	switches=$(awk -F', *' '$2 == "ContextSwitches" { s += $7 } END { print s + 0 }' StatisticOutput.csv)
+	echo "numCores=$cores numHarts=$harts context switches=$switches"
+	if [[ $switches -eq 0 ]]; then
+		echo "Test PTHREAD_PREEMPT: $cores core(s) with $harts hart(s) recorded no context switches"
+		exit 1
+	fi
+done
+
+echo "Test PTHREAD_PREEMPT: Simulation is complete"
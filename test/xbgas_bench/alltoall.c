@@ -0,0 +1,60 @@
+/*
+ * alltoall.c
+ *
+ * RISC-V ISA: RV64GX
+ *
+ * All-to-all exchange: every PE writes one block into a dedicated slot
+ * of every other PE with ebsd, sweeping the block size from 8 B up to
+ * XB_MAX_BYTES / npes
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+#include "isa_test_macros.h"
+#include "xbgas_bench.h"
+
+#define NELEM ( XB_MAX_BYTES / sizeof( uint64_t ) )
+
+static uint64_t src[NELEM];
+static uint64_t dst[NELEM];
+
+int main( int argc, char** argv ) {
+  int id   = __xbrtime_asm_get_id();
+  int npes = __xbrtime_asm_get_npes();
+
+  for( uint64_t i = 0; i < NELEM; i++ ) {
+    src[i] = ( (uint64_t) id << 48 ) | i;
+  }
+  xb_barrier( id, npes );
+
+  for( uint64_t bytes = sizeof( uint64_t ); bytes * npes <= XB_MAX_BYTES; bytes <<= 1 ) {
+    uint64_t nelem = bytes / sizeof( uint64_t );
+    uint64_t iters = xb_iters_for( bytes * npes );
+
+    uint64_t start = xb_rdcycle();
+    for( uint64_t i = 0; i < iters; i++ ) {
+      // Stagger the targets so that all PEs do not hit the same PE at once
+      for( int step = 1; step < npes; step++ ) {
+        int pe = ( id + step ) % npes;
+        xb_bput64( pe, &dst[id * nelem], src, nelem );
+      }
+    }
+    uint64_t cycles = xb_rdcycle() - start;
+    XB_REPORT( "alltoall", id, npes, bytes, iters, cycles );
+
+    for( int pe = 0; pe < npes; pe++ ) {
+      if( pe != id ) {
+        xb_wait_until( &dst[pe * nelem + nelem - 1], ( (uint64_t) pe << 48 ) | ( nelem - 1 ) );
+      }
+    }
+
+    // Nobody overwrites a slot before every PE has seen the current round
+    xb_barrier( id, npes );
+  }
+
+  return 0;
+}
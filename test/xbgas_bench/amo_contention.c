@@ -0,0 +1,62 @@
+/*
+ * amo_contention.c
+ *
+ * RISC-V ISA: RV64GX
+ *
+ * Remote AMO contention: every PE other than PE 0 issues a burst of
+ * eamoadd.d to the same word on PE 0 so that the target can combine them.
+ * Run with XB_NPES between 8 and 64; the old values returned to all PEs
+ * must still be the distinct prefix sums 0 .. N-1
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+#include "isa_test_macros.h"
+#include "xbgas_bench.h"
+
+static uint64_t          hot_count = 0;
+static uint64_t          old_sum   = 0;
+static uint64_t          done      = 0;
+static volatile uint64_t sink      = 0;
+
+int main( int argc, char** argv ) {
+  int id   = __xbrtime_asm_get_id();
+  int npes = __xbrtime_asm_get_npes();
+
+  if( npes < 2 )
+    return 0;
+
+  xb_barrier( id, npes );
+
+  uint64_t start = xb_rdcycle();
+  if( id != 0 ) {
+    uint64_t sum = 0;
+    for( int i = 0; i < XB_ITERS; i++ ) {
+      sum += xb_amoadd64( 0, &hot_count, 1 );
+    }
+    sink            = sum;
+    uint64_t cycles = xb_rdcycle() - start;
+    XB_REPORT( "amo_contention", id, npes, sizeof( uint64_t ), XB_ITERS, cycles );
+
+    // Publish the sum of the old values observed by this PE; consuming the
+    // response orders it ahead of the completion count
+    sink = xb_amoadd64( 0, &old_sum, sum );
+    xb_amoadd64( 0, &done, 1 );
+  } else {
+    uint64_t total = (uint64_t) XB_ITERS * ( npes - 1 );
+    xb_wait_until( &done, npes - 1 );
+    uint64_t cycles = xb_rdcycle() - start;
+    XB_REPORT( "amo_contention_target", id, npes, sizeof( uint64_t ), total, cycles );
+
+    // Every requester must have seen a distinct intermediate value
+    assert( hot_count == total );
+    assert( old_sum == total * ( total - 1 ) / 2 );
+  }
+
+  xb_barrier( id, npes );
+  return 0;
+}
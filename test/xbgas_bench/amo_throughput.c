@@ -0,0 +1,66 @@
+/*
+ * amo_throughput.c
+ *
+ * RISC-V ISA: RV64GX
+ *
+ * Remote AMO throughput: every PE issues eamoadd.d to its right neighbor
+ * (uncontended) and then to a single counter on PE 0 (contended)
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+#include "isa_test_macros.h"
+#include "xbgas_bench.h"
+
+static uint64_t          neighbor_count = 0;
+static uint64_t          hot_count      = 0;
+static volatile uint64_t sink           = 0;
+
+int main( int argc, char** argv ) {
+  int id    = __xbrtime_asm_get_id();
+  int npes  = __xbrtime_asm_get_npes();
+  int right = ( id + 1 ) % npes;
+
+  if( npes < 2 )
+    return 0;
+
+  xb_barrier( id, npes );
+
+  // Uncontended: one requester per target
+  uint64_t last  = 0;
+  uint64_t start = xb_rdcycle();
+  for( int i = 0; i < XB_ITERS; i++ ) {
+    last = xb_amoadd64( right, &neighbor_count, 1 );
+  }
+  // Consuming the last result waits for its response
+  sink            = last;
+  uint64_t cycles = xb_rdcycle() - start;
+  XB_REPORT( "amo_neighbor", id, npes, sizeof( uint64_t ), XB_ITERS, cycles );
+
+  xb_barrier( id, npes );
+
+  // Contended: every PE targets the same word on PE 0, which updates it locally
+  start = xb_rdcycle();
+  for( int i = 0; i < XB_ITERS; i++ ) {
+    if( id == 0 ) {
+      last = __atomic_fetch_add( &hot_count, 1, __ATOMIC_SEQ_CST );
+    } else {
+      last = xb_amoadd64( 0, &hot_count, 1 );
+    }
+  }
+  sink   = last;
+  cycles = xb_rdcycle() - start;
+  XB_REPORT( "amo_hot", id, npes, sizeof( uint64_t ), XB_ITERS, cycles );
+
+  xb_wait_until( &neighbor_count, XB_ITERS );
+  if( id == 0 ) {
+    xb_wait_until( &hot_count, (uint64_t) XB_ITERS * npes );
+  }
+
+  xb_barrier( id, npes );
+  return 0;
+}
@@ -0,0 +1,64 @@
+/*
+ * bulk_bw.c
+ *
+ * RISC-V ISA: RV64GX
+ *
+ * Remote bulk bandwidth: PE 0 sweeps ebld and ebsd message sizes from
+ * 8 B up to XB_MAX_BYTES against the most distant PE
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+#include "isa_test_macros.h"
+#include "xbgas_bench.h"
+
+#define NELEM ( XB_MAX_BYTES / sizeof( uint64_t ) )
+
+static uint64_t src[NELEM];
+static uint64_t dst[NELEM];
+
+int main( int argc, char** argv ) {
+  int id   = __xbrtime_asm_get_id();
+  int npes = __xbrtime_asm_get_npes();
+  int peer = npes - 1;
+
+  for( uint64_t i = 0; i < NELEM; i++ ) {
+    src[i] = ( (uint64_t) id << 48 ) | i;
+  }
+  xb_barrier( id, npes );
+
+  if( id == 0 && npes > 1 ) {
+    for( uint64_t bytes = sizeof( uint64_t ); bytes <= XB_MAX_BYTES; bytes <<= 1 ) {
+      uint64_t nelem = bytes / sizeof( uint64_t );
+      uint64_t iters = xb_iters_for( bytes );
+
+      xb_bget64( dst, peer, src, nelem );
+      uint64_t start = xb_rdcycle();
+      for( uint64_t i = 0; i < iters; i++ ) {
+        xb_bget64( dst, peer, src, nelem );
+      }
+      uint64_t cycles = xb_rdcycle() - start;
+      assert( dst[nelem - 1] == ( ( (uint64_t) peer << 48 ) | ( nelem - 1 ) ) );
+      XB_REPORT( "bget_bw", id, npes, bytes, iters, cycles );
+
+      xb_bput64( peer, dst, src, nelem );
+      start = xb_rdcycle();
+      for( uint64_t i = 0; i < iters; i++ ) {
+        xb_bput64( peer, dst, src, nelem );
+      }
+      cycles = xb_rdcycle() - start;
+      XB_REPORT( "bput_bw", id, npes, bytes, iters, cycles );
+    }
+  }
+
+  xb_barrier( id, npes );
+
+  if( id == peer && npes > 1 ) {
+    xb_wait_until( &dst[NELEM - 1], NELEM - 1 );
+  }
+  return 0;
+}
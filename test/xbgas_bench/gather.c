@@ -0,0 +1,78 @@
+/*
+ * gather.c
+ *
+ * RISC-V ISA: RV64GX
+ *
+ * Remote gather: PE 0 collects XB_ITERS pseudo-randomly chosen 8-byte
+ * elements from the tables of the other PEs, first with consumed eld loads
+ * and then with rev_xbgas_get_nb into a local buffer followed by a single
+ * wait on the completion counter
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+#include "isa_test_macros.h"
+#include "xbgas_bench.h"
+
+// Elements per PE
+#define XB_TABLE 4096
+
+static uint64_t table[XB_TABLE];
+static uint64_t buf[XB_ITERS];
+
+// Element i of the gather reads from PE pe_of(i) at index idx_of(i)
+static inline int pe_of( uint64_t i, int npes ) {
+  return 1 + (int) ( ( i * 2654435761u ) % ( npes - 1 ) );
+}
+
+static inline uint64_t idx_of( uint64_t i ) {
+  return ( i * 40503u + 17 ) % XB_TABLE;
+}
+
+int main( int argc, char** argv ) {
+  int id   = __xbrtime_asm_get_id();
+  int npes = __xbrtime_asm_get_npes();
+
+  if( npes < 2 )
+    return 0;
+
+  for( uint64_t i = 0; i < XB_TABLE; i++ ) {
+    table[i] = ( (uint64_t) id << 32 ) | i;
+  }
+
+  xb_barrier( id, npes );
+
+  if( id == 0 ) {
+    // Blocking: each load is consumed before the next one is issued
+    uint64_t sum   = 0;
+    uint64_t start = xb_rdcycle();
+    for( uint64_t i = 0; i < XB_ITERS; i++ ) {
+      sum += xb_get64( pe_of( i, npes ), &table[idx_of( i )] );
+    }
+    uint64_t cycles = xb_rdcycle() - start;
+    XB_REPORT( "gather_blocking", id, npes, sizeof( uint64_t ), XB_ITERS, cycles );
+
+    // Split-phase: issue every get, then wait once
+    uint64_t count = 0;
+    start          = xb_rdcycle();
+    for( uint64_t i = 0; i < XB_ITERS; i++ ) {
+      xb_get_nb( &buf[i], pe_of( i, npes ), &table[idx_of( i )], sizeof( uint64_t ), &count );
+    }
+    xb_wait_until( (volatile uint64_t*) &count, XB_ITERS );
+    cycles = xb_rdcycle() - start;
+    XB_REPORT( "gather_nb", id, npes, sizeof( uint64_t ), XB_ITERS, cycles );
+
+    uint64_t nb_sum = 0;
+    for( uint64_t i = 0; i < XB_ITERS; i++ ) {
+      nb_sum += ( (volatile uint64_t*) buf )[i];
+    }
+    assert( nb_sum == sum );
+  }
+
+  xb_barrier( id, npes );
+  return 0;
+}
@@ -0,0 +1,48 @@
+/*
+ * get_latency.c
+ *
+ * RISC-V ISA: RV64GX
+ *
+ * Remote get latency: PE 0 issues dependent eld operations to the most
+ * distant PE and reports the cycles per round trip
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+#include "isa_test_macros.h"
+#include "xbgas_bench.h"
+
+static uint64_t target = 0;
+
+int main( int argc, char** argv ) {
+  int id   = __xbrtime_asm_get_id();
+  int npes = __xbrtime_asm_get_npes();
+  int peer = npes - 1;
+
+  target   = 0x1000 + id;
+  xb_barrier( id, npes );
+
+  if( id == 0 && npes > 1 ) {
+    uint64_t sum = 0;
+    for( int i = 0; i < XB_WARMUP; i++ ) {
+      sum += xb_get64( peer, &target );
+    }
+
+    uint64_t start = xb_rdcycle();
+    for( int i = 0; i < XB_ITERS; i++ ) {
+      // Each value is consumed before the next get is issued
+      sum += xb_get64( peer, &target );
+    }
+    uint64_t cycles = xb_rdcycle() - start;
+
+    assert( sum == (uint64_t) ( XB_WARMUP + XB_ITERS ) * ( 0x1000 + peer ) );
+    XB_REPORT( "get_lat", id, npes, sizeof( uint64_t ), XB_ITERS, cycles );
+  }
+
+  xb_barrier( id, npes );
+  return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * hart_chase.c
+ *
+ * RISC-V ISA: RV64GX
+ *
+ * Multi-hart remote pointer chasing: XB_HARTS threads on PE 0 (the main
+ * thread and XB_HARTS-1 pthreads) each follow their own linked list whose
+ * nodes are spread over the other PEs. Every hop is a blocking eld, so a
+ * core only hides remote latency by switching to another hart; run it
+ * with numHarts=XB_HARTS and compare the hart interleaving policies
+ * (see run_hart_policy.sh)
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+#include "isa_test_macros.h"
+#include "xbgas_bench.h"
+
+// Threads chasing on PE 0, including the main thread
+#ifndef XB_HARTS
+#define XB_HARTS 4
+#endif
+
+// Nodes per PE
+#define XB_NODES 1024
+
+// A node reference packs the owning PE into the upper 32 bits
+#define XB_NODE( pe, idx ) ( ( (uint64_t) ( pe ) << 32 ) | ( idx ) )
+#define XB_NODE_PE( n )    ( (int) ( ( n ) >> 32 ) )
+#define XB_NODE_IDX( n )   ( ( n ) & 0xFFFFFFFF )
+
+static uint64_t nodes[XB_NODES];
+static uint64_t cur[XB_HARTS];
+static int      npes;
+
+// The node that 'n' points at; every PE fills its nodes the same way
+static uint64_t next_node( uint64_t n ) {
+  int owner = ( XB_NODE_PE( n ) % ( npes - 1 ) ) + 1;
+  return XB_NODE( owner, ( XB_NODE_IDX( n ) * 7 + 3 ) % XB_NODES );
+}
+
+static uint64_t first_node( uint64_t t ) {
+  return XB_NODE( 1 + t % ( npes - 1 ), ( t * 37 ) % XB_NODES );
+}
+
+static void* chase( void* arg ) {
+  uint64_t t = (uint64_t) arg;
+  uint64_t n = first_node( t );
+  for( int h = 0; h < XB_ITERS; h++ ) {
+    n = xb_get64( XB_NODE_PE( n ), &nodes[XB_NODE_IDX( n )] );
+  }
+  cur[t] = n;
+  return 0;
+}
+
+int main( int argc, char** argv ) {
+  int id = __xbrtime_asm_get_id();
+  npes   = __xbrtime_asm_get_npes();
+
+  if( npes < 2 )
+    return 0;
+
+  int owner = ( id % ( npes - 1 ) ) + 1;
+  for( uint64_t i = 0; i < XB_NODES; i++ ) {
+    nodes[i] = XB_NODE( owner, ( i * 7 + 3 ) % XB_NODES );
+  }
+
+  xb_barrier( id, npes );
+
+  if( id == 0 ) {
+    rev_pthread_t tid[XB_HARTS];
+
+    uint64_t start = xb_rdcycle();
+    for( uint64_t t = 1; t < XB_HARTS; t++ ) {
+      rev_pthread_create( &tid[t], NULL, (void*) chase, (void*) t );
+    }
+    chase( (void*) 0 );
+    for( int t = 1; t < XB_HARTS; t++ ) {
+      rev_pthread_join( tid[t] );
+    }
+    uint64_t cycles = xb_rdcycle() - start;
+    XB_REPORT( "hart_chase", id, npes, sizeof( uint64_t ), (uint64_t) XB_HARTS * XB_ITERS, cycles );
+
+    // Replay the chains locally
+    for( uint64_t t = 0; t < XB_HARTS; t++ ) {
+      uint64_t n = first_node( t );
+      for( int h = 0; h < XB_ITERS; h++ ) {
+        n = next_node( n );
+      }
+      assert( cur[t] == n );
+    }
+  }
+
+  xb_barrier( id, npes );
+  return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * pointer_chase.c
+ *
+ * RISC-V ISA: RV64GX
+ *
+ * Remote pointer chasing: PE 0 follows XB_CHAINS independent linked lists
+ * whose nodes are spread over the other PEs. The blocking variant walks the
+ * chains one hop at a time with eld; the split-phase variant issues the next
+ * hop of every chain with rev_xbgas_get_nb and waits on a single counter,
+ * so up to XB_CHAINS remote reads are in flight at once
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+#include "isa_test_macros.h"
+#include "xbgas_bench.h"
+
+// Independent chains walked concurrently by the split-phase variant
+#ifndef XB_CHAINS
+#define XB_CHAINS 16
+#endif
+
+// Nodes per PE
+#define XB_NODES 1024
+
+// A node reference packs the owning PE into the upper 32 bits
+#define XB_NODE( pe, idx ) ( ( (uint64_t) ( pe ) << 32 ) | ( idx ) )
+#define XB_NODE_PE( n )    ( (int) ( ( n ) >> 32 ) )
+#define XB_NODE_IDX( n )   ( ( n ) & 0xFFFFFFFF )
+
+static uint64_t nodes[XB_NODES];
+static uint64_t cur[XB_CHAINS];
+static uint64_t next[XB_CHAINS];
+
+int main( int argc, char** argv ) {
+  int id   = __xbrtime_asm_get_id();
+  int npes = __xbrtime_asm_get_npes();
+
+  if( npes < 2 )
+    return 0;
+
+  // Every node points at a pseudo-random node on the next remote PE
+  int owner = ( id % ( npes - 1 ) ) + 1;
+  for( uint64_t i = 0; i < XB_NODES; i++ ) {
+    nodes[i] = XB_NODE( owner, ( i * 7 + 3 ) % XB_NODES );
+  }
+
+  xb_barrier( id, npes );
+
+  if( id == 0 ) {
+    uint64_t end[XB_CHAINS];
+
+    // Blocking: every hop waits for the previous one
+    for( int c = 0; c < XB_CHAINS; c++ ) {
+      cur[c] = XB_NODE( 1 + c % ( npes - 1 ), c );
+    }
+    uint64_t start = xb_rdcycle();
+    for( int c = 0; c < XB_CHAINS; c++ ) {
+      for( int h = 0; h < XB_ITERS; h++ ) {
+        cur[c] = xb_get64( XB_NODE_PE( cur[c] ), &nodes[XB_NODE_IDX( cur[c] )] );
+      }
+      end[c] = cur[c];
+    }
+    uint64_t cycles = xb_rdcycle() - start;
+    XB_REPORT( "ptrchase_blocking", id, npes, sizeof( uint64_t ), (uint64_t) XB_CHAINS * XB_ITERS, cycles );
+
+    // Split-phase: advance all chains by one hop per round
+    for( int c = 0; c < XB_CHAINS; c++ ) {
+      cur[c] = XB_NODE( 1 + c % ( npes - 1 ), c );
+    }
+    uint64_t count = 0;
+    start          = xb_rdcycle();
+    for( int h = 0; h < XB_ITERS; h++ ) {
+      for( int c = 0; c < XB_CHAINS; c++ ) {
+        xb_get_nb( &next[c], XB_NODE_PE( cur[c] ), &nodes[XB_NODE_IDX( cur[c] )], sizeof( uint64_t ), &count );
+      }
+      xb_wait_until( (volatile uint64_t*) &count, (uint64_t) ( h + 1 ) * XB_CHAINS );
+      for( int c = 0; c < XB_CHAINS; c++ ) {
+        cur[c] = ( (volatile uint64_t*) next )[c];
+      }
+    }
+    cycles = xb_rdcycle() - start;
+    XB_REPORT( "ptrchase_nb", id, npes, sizeof( uint64_t ), (uint64_t) XB_CHAINS * XB_ITERS, cycles );
+
+    for( int c = 0; c < XB_CHAINS; c++ ) {
+      assert( cur[c] == end[c] );
+    }
+  }
+
+  xb_barrier( id, npes );
+  return 0;
+}
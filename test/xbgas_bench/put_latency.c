@@ -0,0 +1,59 @@
+/*
+ * put_latency.c
+ *
+ * RISC-V ISA: RV64GX
+ *
+ * Remote put latency: PE 0 measures the issue cost of back-to-back esd
+ * operations and the completion latency of a put followed by a get
+ * of the same word from the most distant PE
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+#include "isa_test_macros.h"
+#include "xbgas_bench.h"
+
+static uint64_t target = 0;
+
+int main( int argc, char** argv ) {
+  int id   = __xbrtime_asm_get_id();
+  int npes = __xbrtime_asm_get_npes();
+  int peer = npes - 1;
+
+  xb_barrier( id, npes );
+
+  if( id == 0 && npes > 1 ) {
+    for( int i = 0; i < XB_WARMUP; i++ ) {
+      xb_put64( peer, &target, i );
+    }
+
+    // Back-to-back puts: cost to inject a remote store
+    uint64_t start = xb_rdcycle();
+    for( int i = 0; i < XB_ITERS; i++ ) {
+      xb_put64( peer, &target, i );
+    }
+    uint64_t cycles = xb_rdcycle() - start;
+    XB_REPORT( "put_issue", id, npes, sizeof( uint64_t ), XB_ITERS, cycles );
+
+    // Put followed by a get of the same word: remote store completion
+    uint64_t sum = 0;
+    start        = xb_rdcycle();
+    for( int i = 0; i < XB_ITERS; i++ ) {
+      xb_put64( peer, &target, i );
+      sum += xb_get64( peer, &target );
+    }
+    cycles = xb_rdcycle() - start;
+    XB_REPORT( "put_lat", id, npes, sizeof( uint64_t ), XB_ITERS, cycles );
+  }
+
+  xb_barrier( id, npes );
+
+  if( id == npes - 1 && npes > 1 ) {
+    xb_wait_until( &target, XB_ITERS - 1 );
+  }
+  return 0;
+}
@@ -0,0 +1,209 @@
+#
+# Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-xbgas-bench.py
+#
+# Scalable xBGAS system for the communication micro-benchmarks
+#
+# usage: sst rev-xbgas-bench.py -- --program get_latency.exe --npes 8 --topology torus --shape 4x2
+#
+
+# ---------------------------------------------------------------
+#
+#  xbgas_host0 ... xbgas_hostN-1
+#      |                |
+#  rmt_mem_ctrl     rmt_mem_ctrl
+#      |                |
+#     nic              nic
+#      |                |
+#    iface  <----->   iface
+#           topology
+#
+#   singlerouter: every PE hangs off one crossbar router
+#   torus:        one router per PE, wired as the torus given by --shape
+#
+#   <-> is a link
+#   | is a subcomponent relationship
+
+import argparse
+import os
+import sst
+
+parser = argparse.ArgumentParser(description="Run the xBGAS communication benchmarks")
+parser.add_argument("--program", help="The benchmark executable to run on every PE", required=True)
+parser.add_argument("--npes", type=int, help="Number of PEs", default=int(os.getenv("XB_NPES", "2")))
+parser.add_argument("--topology", choices=["singlerouter", "torus"], help="Network topology",
+                    default=os.getenv("XB_TOPOLOGY", "singlerouter"))
+parser.add_argument("--shape", help="Torus shape, e.g. 4x2 (default: a ring of NPES)", default=os.getenv("XB_SHAPE", ""))
+parser.add_argument("--linkBW", help="Network link bandwidth", default="10GB/s")
+parser.add_argument("--linkLat", help="Network link latency", default="20ns")
+parser.add_argument("--mtu", help="xBGAS packet payload size in bytes", default="4096")
+parser.add_argument("--amoCombine", type=int, help="Combine commutative remote AMOs at the target",
+                    default=int(os.getenv("XB_AMO_COMBINE", "1")))
+parser.add_argument("--amoWindow", type=int, help="Cycles a remote AMO waits for others to combine with",
+                    default=int(os.getenv("XB_AMO_WINDOW", "0")))
+parser.add_argument("--numHarts", type=int, help="Harts per core",
+                    default=int(os.getenv("XB_HARTS", "1")))
+parser.add_argument("--hartPolicy", help="Hart interleaving policy",
+                    choices=["switch-on-stall", "switch-on-hazard", "round-robin", "icount"],
+                    default=os.getenv("XB_HART_POLICY", "switch-on-stall"))
+parser.add_argument("--verbose", type=int, help="Verbosity level", default=0)
+args = parser.parse_args()
+
+NPES = args.npes
+CLOCK = "2.5GHz"
+MEMSIZE = 1024*1024*1024
+
+memctrl_params = {
+  "clock": CLOCK,
+  "addr_range_start": 0,
+  "addr_range_end": MEMSIZE-1,
+  "backing": "malloc"
+}
+
+mem_params = {
+  "access_time" : "100ns",
+  "mem_size" : "8GB"
+}
+
+net_params = {
+  "input_buf_size" : "512B",
+  "output_buf_size" : "512B",
+  "link_bw" : args.linkBW
+}
+
+router_params = {
+  "xbar_bw" : args.linkBW,
+  "link_bw" : args.linkBW,
+  "flit_size" : "32B",
+  "input_buf_size" : "512B",
+  "output_buf_size" : "512B"
+}
+
+# ---------------------------------------------------------------
+# Network: returns the (router, port) pair each PE attaches to
+# ---------------------------------------------------------------
+def build_singlerouter():
+  router = sst.Component("router", "merlin.hr_router")
+  router.setSubComponent("topology", "merlin.singlerouter")
+  router.addParams(router_params)
+  router.addParams({
+    "num_ports" : str(NPES),
+    "id" : 0
+  })
+  return [(router, f"port{i}") for i in range(NPES)]
+
+def build_torus():
+  shape = [int(d) for d in args.shape.split("x")] if args.shape else [NPES]
+  count = 1
+  for d in shape:
+    count *= d
+  if count != NPES:
+    raise SystemExit(f"Torus shape {args.shape} does not match {NPES} PEs")
+
+  # Ports 2*dim and 2*dim+1 are the +/- links of each dimension; the PE uses the last port
+  ndims = len(shape)
+  local_port = 2 * ndims
+  routers = []
+  for i in range(NPES):
+    router = sst.Component(f"router{i}", "merlin.hr_router")
+    router.addParams(router_params)
+    router.addParams({
+      "num_ports" : str(local_port + 1),
+      "id" : i
+    })
+    topo = router.setSubComponent("topology", "merlin.torus")
+    topo.addParams({
+      "shape" : args.shape if args.shape else str(NPES),
+      "width" : "x".join(["1"] * ndims),
+      "local_ports" : 1
+    })
+    routers.append(router)
+
+  def coords(i):
+    c = []
+    for d in shape:
+      c.append(i % d)
+      i //= d
+    return c
+
+  def index(c):
+    i = 0
+    for dim in reversed(range(ndims)):
+      i = i * shape[dim] + c[dim]
+    return i
+
+  for i in range(NPES):
+    for dim in range(ndims):
+      if shape[dim] < 2:
+        continue
+      c = coords(i)
+      c[dim] = (c[dim] + 1) % shape[dim]
+      j = index(c)
+      link = sst.Link(f"torus_{i}_{dim}")
+      link.connect((routers[i], f"port{2 * dim}", args.linkLat), (routers[j], f"port{2 * dim + 1}", args.linkLat))
+
+  return [(routers[i], f"port{local_port}") for i in range(NPES)]
+
+if args.topology == "torus":
+  endpoints = build_torus()
+else:
+  endpoints = build_singlerouter()
+
+# ---------------------------------------------------------------
+# PEs
+# ---------------------------------------------------------------
+for i in range(0, NPES):
+  xbgas_cpu = sst.Component("cpu" + str(i), "revcpu.RevCPU")
+  xbgas_cpu.addParams({
+    "verbose" : args.verbose,                     # Verbosity
+    "clock" : CLOCK,                              # Clock
+    "program" : args.program,                     # Target executable
+    "numHarts" : args.numHarts,                   # Harts per core
+    "hartPolicy" : args.hartPolicy,               # Hart interleaving policy
+    "memSize" : MEMSIZE,                          # Memory size in bytes
+    "startAddr" : "[0:0x00000000]",               # Starting address for core 0
+    "machine" : "[0:RV64GC_Zicntr_Xbgas]",        # Machine type
+    "memCost" : "[0:1:10]",                       # Memory loads required 1-10 cycles
+    "enable_xbgas" : 1,                           # Enable XBGAS support
+    "enableMemH": 1,                              # Enable memHierarchy support
+    "splash" : 0                                  # Display the splash message
+  })
+
+  # Setup the memory controllers
+  lsq = xbgas_cpu.setSubComponent("memory", "revcpu.RevBasicMemCtrl")
+  miface = lsq.setSubComponent("memIface", "memHierarchy.standardInterface")
+
+  memctrl = sst.Component("memory" + str(i), "memHierarchy.MemController")
+  memctrl.addParams(memctrl_params)
+  memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+  memory.addParams(mem_params)
+
+  link_miface_mem = sst.Link("link_miface_mem" + str(i))
+  link_miface_mem.connect( (miface, "port", "50ps"), (memctrl, "direct_link", "50ps") )
+
+  # Create remote memory controllers
+  rmt_lsq = xbgas_cpu.setSubComponent("remote_memory", "revcpu.RevBasicRmtMemCtrl")
+  rmt_lsq.addParams({
+    "mtu" : args.mtu,
+    "amo_combine" : args.amoCombine,
+    "amo_combine_window" : args.amoWindow
+  })
+  rmt_lsq.enableStatistics(["RmtAMOCombined", "RmtAMOGroups"])
+  rmt_nic = rmt_lsq.setSubComponent("xbgasNicIface", "revcpu.XbgasNIC")
+  rmt_nic_iface = rmt_nic.setSubComponent("iface", "merlin.linkcontrol")
+  rmt_nic_iface.addParams(net_params)
+
+  router, port = endpoints[i]
+  link = sst.Link("link" + str(i))
+  link.connect( (rmt_nic_iface, "rtr_port", args.linkLat), (router, port, args.linkLat) )
+
+# Report the remote AMO combining counters at the end of the run
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
+
+# EOF
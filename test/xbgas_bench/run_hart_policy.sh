@@ -0,0 +1,58 @@
+#!/bin/bash
+#
+# run_hart_policy.sh
+#
+# Runs hart_chase with every hart interleaving policy for each hart count in
+# XB_HARTS_LIST (default "4 8 16") and appends one CSV row per run to
+# hart_policy.csv:
+#
+#   policy,harts,npes,hops,cycles,hops_per_kcycle,wall_sec
+#
+# Environment: XB_HARTS_LIST, XB_POLICIES, XB_NPES (2), XB_ITERS (hops per thread)
+#
+
+CSV=hart_policy.csv
+HARTS_LIST=${XB_HARTS_LIST:-"4 8 16"}
+POLICIES=${XB_POLICIES:-"switch-on-stall switch-on-hazard round-robin icount"}
+
+if [[ ! -f $CSV ]]; then
+	echo "policy,harts,npes,hops,cycles,hops_per_kcycle,wall_sec" > $CSV
+fi
+
+for HARTS in $HARTS_LIST; do
+	# The thread count is a build-time constant
+	make clean && make XB_HARTS=$HARTS hart_chase.exe
+	if [[ ! -x hart_chase.exe ]]; then
+		echo "Test HART_POLICY: hart_chase.exe not Found - likely build failed"
+		exit 1
+	fi
+
+	for POLICY in $POLICIES; do
+		LOG=hart_chase.$POLICY.$HARTS.log
+		START=$(date +%s.%N)
+		sst --add-lib-path=../../build/src/ ./rev-xbgas-bench.py -- --program hart_chase.exe \
+			--numHarts $HARTS --hartPolicy $POLICY > $LOG 2>&1
+		RC=$?
+		END=$(date +%s.%N)
+		WALL=$(awk -v s=$START -v e=$END 'BEGIN { printf "%.2f", e - s }')
+
+		if [[ $RC -ne 0 ]]; then
+			cat $LOG
+			echo "Test HART_POLICY $POLICY $HARTS: sst exited with status $RC"
+			exit 1
+		fi
+
+		if ! grep -q "XBGAS_BENCH,hart_chase" $LOG; then
+			cat $LOG
+			echo "Test HART_POLICY $POLICY $HARTS: no results found"
+			exit 1
+		fi
+
+		grep -o "XBGAS_BENCH,[^<]*" $LOG | awk -F, -v policy=$POLICY -v harts=$HARTS -v wall=$WALL '{
+			rate = $7 > 0 ? ( 1000 * $6 ) / $7 : 0;
+			printf "%s,%s,%s,%s,%s,%.3f,%.2f\n", policy, harts, $4, $6, $7, rate, wall
+		}' | tee -a $CSV
+	done
+done
+
+echo "Test HART_POLICY: all policies passed"
@@ -0,0 +1,71 @@
+#!/bin/bash
+#
+# run_xbgas_bench.sh [bench ...]
+#
+# Runs the xBGAS communication benchmarks (all of them by default) and appends
+# one CSV row per result record to xbgas_bench.csv:
+#
+#   bench,pe,npes,bytes,iters,cycles,cycles_per_iter,sim_GBps,topology,wall_sec
+#
+# Environment: XB_NPES (2), XB_TOPOLOGY (singlerouter|torus), XB_SHAPE,
+#              XB_MAX_BYTES and XB_ITERS (build-time sweep limits),
+#              XB_AMO_COMBINE and XB_AMO_WINDOW (target-side AMO combining)
+#
+# The amo_contention benchmark is meant to be swept over XB_NPES=8..64, e.g.
+#   for n in 8 16 32 64; do XB_NPES=$n ./run_xbgas_bench.sh amo_contention; done
+#
+# pointer_chase and gather report a *_blocking and a *_nb record each; the
+# ratio of their cycles is the latency hidden by split-phase gets
+#
+
+CLOCK_GHZ=2.5
+CSV=xbgas_bench.csv
+TOPOLOGY=${XB_TOPOLOGY:-singlerouter}
+
+#Build the benchmarks
+make clean && make
+
+BENCHES="$@"
+if [[ -z "$BENCHES" ]]; then
+	BENCHES=$(ls *.c | sed 's/\.c$//')
+fi
+
+if [[ ! -f $CSV ]]; then
+	echo "bench,pe,npes,bytes,iters,cycles,cycles_per_iter,sim_GBps,topology,wall_sec" > $CSV
+fi
+
+for BENCH in $BENCHES; do
+	# Check that the exec was built...
+	if [[ ! -x $BENCH.exe ]]; then
+		echo "Test XBGAS_BENCH $BENCH: $BENCH.exe not Found - likely build failed"
+		exit 1
+	fi
+
+	START=$(date +%s.%N)
+	sst --add-lib-path=../../build/src/ ./rev-xbgas-bench.py -- --program $BENCH.exe > $BENCH.log 2>&1
+	RC=$?
+	END=$(date +%s.%N)
+	WALL=$(awk -v s=$START -v e=$END 'BEGIN { printf "%.2f", e - s }')
+
+	if [[ $RC -ne 0 ]]; then
+		cat $BENCH.log
+		echo "Test XBGAS_BENCH $BENCH: sst exited with status $RC"
+		exit 1
+	fi
+
+	if ! grep -q "XBGAS_BENCH," $BENCH.log; then
+		cat $BENCH.log
+		echo "Test XBGAS_BENCH $BENCH: no results found"
+		exit 1
+	fi
+
+	grep -o "XBGAS_BENCH,[^<]*" $BENCH.log | awk -F, -v clk=$CLOCK_GHZ -v topo=$TOPOLOGY -v wall=$WALL '{
+		cpi = $6 > 0 ? $7 / $6 : 0;
+		gbps = $7 > 0 ? ( $5 * $6 * clk ) / $7 : 0;
+		printf "%s,%s,%s,%s,%s,%s,%.2f,%.4f,%s,%.2f\n", $2, $3, $4, $5, $6, $7, cpi, gbps, topo, wall
+	}' >> $CSV
+
+	cat $BENCH.log
+done
+
+echo "Test XBGAS_BENCH: all benchmarks passed"
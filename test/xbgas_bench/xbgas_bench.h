@@ -0,0 +1,173 @@
+/*
+ * xbgas_bench.h
+ *
+ * RISC-V ISA: RV64GX
+ *
+ * Common helpers for the xBGAS communication micro-benchmarks
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#ifndef _XBGAS_BENCH_H_
+#define _XBGAS_BENCH_H_
+
+#include "syscalls.h"
+#include <stdint.h>
+
+#define printf rev_fast_printf
+
+// Largest message of the bandwidth sweeps in bytes
+#ifndef XB_MAX_BYTES
+#define XB_MAX_BYTES ( 16 * 1024 * 1024 )
+#endif
+
+// Timed iterations per data point
+#ifndef XB_ITERS
+#define XB_ITERS 100
+#endif
+
+// Untimed warm-up iterations per data point
+#ifndef XB_WARMUP
+#define XB_WARMUP 10
+#endif
+
+extern int __xbrtime_asm_get_id();
+extern int __xbrtime_asm_get_npes();
+
+// The namespace of a PE is its network endpoint id plus one
+#define XB_NMSPACE( pe ) ( (uint64_t) ( pe ) + 1 )
+
+// Emit one machine-readable result record:
+//   XBGAS_BENCH,<bench>,<pe>,<npes>,<bytes>,<iters>,<cycles>
+// rev_fast_printf only accepts scalar arguments, so the name is pasted into the format
+#define XB_REPORT( name, pe, npes, bytes, iters, cycles )                                                            \
+  printf(                                                                                                            \
+    "XBGAS_BENCH," name ",%lu,%lu,%lu,%lu,%lu\n",                                                                    \
+    (uint64_t) ( pe ),                                                                                               \
+    (uint64_t) ( npes ),                                                                                             \
+    (uint64_t) ( bytes ),                                                                                            \
+    (uint64_t) ( iters ),                                                                                            \
+    (uint64_t) ( cycles )                                                                                            \
+  )
+
+static inline uint64_t xb_rdcycle( void ) {
+  uint64_t c;
+  asm volatile( "rdcycle %0" : "=r"( c ) );
+  return c;
+}
+
+// The helpers below pin the remote address into x16/x17 so that the
+// namespace can be placed into the matching extended register (e16/e17);
+// e10-e14 hold the runtime state and must not be touched.
+
+// Blocking remote 8-byte load
+static inline uint64_t xb_get64( int pe, const uint64_t* addr ) {
+  uint64_t v;
+  asm volatile( " eaddie e16, %1, 0 \n\t"
+                " mv x16, %2 \n\t"
+                " eld %0, 0(x16) \n\t"
+                : "=r"( v )
+                : "r"( XB_NMSPACE( pe ) ), "r"( addr )
+                : "x16", "memory" );
+  return v;
+}
+
+// Remote 8-byte store
+static inline void xb_put64( int pe, uint64_t* addr, uint64_t v ) {
+  asm volatile( " eaddie e16, %0, 0 \n\t"
+                " mv x16, %1 \n\t"
+                " esd %2, 0(x16) \n\t"
+                :
+                : "r"( XB_NMSPACE( pe ) ), "r"( addr ), "r"( v )
+                : "x16", "memory" );
+}
+
+// Remote bulk load of nelem 8-byte elements; spins on the completion flag
+static inline void xb_bget64( uint64_t* dest, int pe, const uint64_t* src, uint64_t nelem ) {
+  asm volatile( " eaddie e17, %0, 0 \n\t"
+                " mv x17, %2 \n\t"
+                " li t1, 0 \n\t"
+                " ebld t1, %1, x17, %3 \n\t"
+                "1: beqz t1, 1b \n\t"
+                :
+                : "r"( XB_NMSPACE( pe ) ), "r"( dest ), "r"( src ), "r"( nelem )
+                : "x17", "t1", "memory" );
+}
+
+// Remote bulk store of nelem 8-byte elements; spins on the completion flag
+static inline void xb_bput64( int pe, uint64_t* dest, const uint64_t* src, uint64_t nelem ) {
+  asm volatile( " eaddie e17, %0, 0 \n\t"
+                " mv x17, %1 \n\t"
+                " li t1, 0 \n\t"
+                " ebsd t1, %2, x17, %3 \n\t"
+                "1: beqz t1, 1b \n\t"
+                :
+                : "r"( XB_NMSPACE( pe ) ), "r"( dest ), "r"( src ), "r"( nelem )
+                : "x17", "t1", "memory" );
+}
+
+// Remote 8-byte atomic add; returns the previous value
+static inline uint64_t xb_amoadd64( int pe, uint64_t* addr, uint64_t v ) {
+  uint64_t old;
+  asm volatile( " eaddie e16, %1, 0 \n\t"
+                " mv x16, %2 \n\t"
+                " eamoadd.d %0, %3, (x16) \n\t"
+                : "=r"( old )
+                : "r"( XB_NMSPACE( pe ) ), "r"( addr ), "r"( v )
+                : "x16", "memory" );
+  return old;
+}
+
+// Split-phase get of nbytes; returns at once and *counter is incremented
+// once dest has been written
+static inline void xb_get_nb( void* dest, int pe, const void* src, size_t nbytes, uint64_t* counter ) {
+  rev_xbgas_get_nb( dest, XB_NMSPACE( pe ), src, nbytes, counter );
+}
+
+// Idle for a few cycles between polls so waiting PEs do not flood the network
+static inline void xb_backoff( void ) {
+  for( int i = 0; i < 64; i++ ) {
+    asm volatile( " nop " );
+  }
+}
+
+// Bulk stores signal completion once the data has left the source PE, so
+// the receiver waits for the last word of a transfer to land
+static inline void xb_wait_until( volatile uint64_t* addr, uint64_t v ) {
+  while( *addr != v ) {
+    xb_backoff();
+  }
+}
+
+// Centralized barrier: a counter on PE 0 that every PE increments once per round
+static volatile uint64_t xb_barrier_count = 0;
+static uint64_t          xb_barrier_round = 0;
+
+static inline void xb_barrier( int id, int npes ) {
+  uint64_t target = ++xb_barrier_round * (uint64_t) npes;
+  if( id == 0 ) {
+    __atomic_fetch_add( &xb_barrier_count, 1, __ATOMIC_SEQ_CST );
+    while( xb_barrier_count < target ) {
+      asm volatile( " nop " );
+    }
+  } else {
+    xb_amoadd64( 0, (uint64_t*) &xb_barrier_count, 1 );
+    while( xb_get64( 0, (const uint64_t*) &xb_barrier_count ) < target ) {
+      xb_backoff();
+    }
+  }
+}
+
+// Number of timed iterations for a message of the given size; large
+// messages are scaled down so that every data point moves a similar volume
+static inline uint64_t xb_iters_for( uint64_t bytes ) {
+  uint64_t iters = bytes <= 65536 ? XB_ITERS : ( (uint64_t) XB_ITERS * 65536 ) / bytes;
+  return iters ? iters : 1;
+}
+
+#endif  // _XBGAS_BENCH_H_
@@ -0,0 +1,21 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [[ ! -x xbgas_serialize.exe ]]; then
+	echo "Test XBGAS_SERIALIZE: xbgas_serialize.exe not Found - likely build failed"
+	exit 1
+fi
+
+sst --add-lib-path=../../build/src/ --model-options=xbgas_serialize.exe ./rev-xbgas-serialize.py > xbgas_serialize.log 2>&1
+
+# Both NICs must report every benchmark case
+if [[ $(grep -c "events/sec" xbgas_serialize.log) -ne 12 ]]; then
+	cat xbgas_serialize.log
+	echo "Test XBGAS_SERIALIZE: missing serialization benchmark results"
+	exit 1
+fi
+
+cat xbgas_serialize.log
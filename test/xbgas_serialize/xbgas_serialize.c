@@ -0,0 +1,45 @@
+/*
+ * xbgas_serialize.c
+ *
+ * RISC-V ISA: RV64GX
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+#include "isa_test_macros.h"
+#include "syscalls.h"
+#include <stdint.h>
+#define printf rev_fast_printf
+
+extern int __xbrtime_asm_get_id();
+extern int __xbrtime_asm_get_npes();
+
+int main( int argc, char** argv ) {
+
+  int id   = __xbrtime_asm_get_id();
+  int npes = __xbrtime_asm_get_npes();
+
+  printf( "Hello from PE %d of %d\n", id, npes );
+
+  // Exchange one value so that serialized events also cross the network
+  uint64_t namespace = ( id == 0 ) ? 2 : 1;
+  uint64_t dest      = 0xdeadbeefdeadbeef;
+  uint64_t src       = 0x1000 + id;
+
+  asm volatile( " eaddie e15, %0, 0 \n\t " : : "r"( namespace ) );
+  asm volatile( " mv x5, %0 \n\t " : : "r"( src ) );
+  asm volatile( " esd x5, 0(%0) \n\t " : : "r"( &dest ) );
+
+  while( dest == 0xdeadbeefdeadbeef ) {
+    asm volatile( " nop " );
+  }
+
+  printf( "PE %d: dest = 0x%lx\n", id, dest );
+  assert( dest == (uint64_t) ( 0x1000 + ( 1 - id ) ) );
+
+  return 0;
+}